@@ -0,0 +1,408 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// brkpool.cpp
+// created: 2018oct29
+//
+// BreakIteratorPool and its C API.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_BREAK_ITERATION
+
+#include "unicode/brkiter.h"
+#include "unicode/locid.h"
+#include "unicode/ubrk.h"
+#include "unicode/unistr.h"
+#include "unicode/utext.h"
+#include "cmemory.h"
+#include "hash.h"
+#include "mutex.h"
+#include "sharedobject.h"
+#include "uhash.h"
+#include "umutex.h"
+#include "unifiedcache.h"
+#include "utypeinfo.h"  // for 'typeid' to work
+#include "uvector.h"
+
+U_NAMESPACE_BEGIN
+
+/**
+ * An immutable break iterator for one (type, locale), shared through the UnifiedCache.
+ * Pools clone it when they have no idle iterator to hand out.
+ * Building it is what costs: Loading the rules and dictionaries from the resource bundles.
+ */
+class BreakIteratorPrototype : public SharedObject {
+public:
+    BreakIteratorPrototype(BreakIterator *adopted) : fIterator(adopted) {}
+    virtual ~BreakIteratorPrototype();
+
+    BreakIterator *cloneIterator() const { return fIterator->clone(); }
+
+private:
+    LocalPointer<BreakIterator> fIterator;
+};
+
+BreakIteratorPrototype::~BreakIteratorPrototype() {
+}
+
+template<> U_COMMON_API
+const BreakIteratorPrototype *LocaleCacheKey<BreakIteratorPrototype>::createObject(
+        const void * /*creationContext*/, UErrorCode &status) const {
+    status = U_UNSUPPORTED_ERROR;
+    return NULL;
+}
+
+class BreakIteratorCacheKey : public LocaleCacheKey<BreakIteratorPrototype> {
+private:
+    UBreakIteratorType fType;
+public:
+    BreakIteratorCacheKey(const Locale &loc, UBreakIteratorType type)
+            : LocaleCacheKey<BreakIteratorPrototype>(loc), fType(type) {}
+    BreakIteratorCacheKey(const BreakIteratorCacheKey &other)
+            : LocaleCacheKey<BreakIteratorPrototype>(other), fType(other.fType) {}
+    virtual ~BreakIteratorCacheKey();
+    virtual int32_t hashCode() const {
+        return (int32_t)(37u * (uint32_t)LocaleCacheKey<BreakIteratorPrototype>::hashCode() + (uint32_t)fType);
+    }
+    virtual UBool operator==(const CacheKeyBase &other) const {
+        // reflexive
+        if (this == &other) {
+            return TRUE;
+        }
+        if (!LocaleCacheKey<BreakIteratorPrototype>::operator==(other)) {
+            return FALSE;
+        }
+        // We know that this and other are of same class if we get this far.
+        const BreakIteratorCacheKey &realOther =
+                static_cast<const BreakIteratorCacheKey &>(other);
+        return realOther.fType == fType;
+    }
+    virtual CacheKeyBase *clone() const {
+        return new BreakIteratorCacheKey(*this);
+    }
+    virtual const BreakIteratorPrototype *createObject(
+            const void * /*unused*/, UErrorCode &status) const {
+        LocalPointer<BreakIterator> bi;
+        switch (fType) {
+        case UBRK_CHARACTER:
+            bi.adoptInstead(BreakIterator::createCharacterInstance(fLoc, status));
+            break;
+        case UBRK_WORD:
+            bi.adoptInstead(BreakIterator::createWordInstance(fLoc, status));
+            break;
+        case UBRK_LINE:
+            bi.adoptInstead(BreakIterator::createLineInstance(fLoc, status));
+            break;
+        case UBRK_SENTENCE:
+            bi.adoptInstead(BreakIterator::createSentenceInstance(fLoc, status));
+            break;
+        case UBRK_TITLE:
+            bi.adoptInstead(BreakIterator::createTitleInstance(fLoc, status));
+            break;
+        default:
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        if (bi.isNull()) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return NULL;
+        }
+        LocalPointer<BreakIteratorPrototype> prototype(
+                new BreakIteratorPrototype(bi.getAlias()), status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        bi.orphan();
+        BreakIteratorPrototype *result = prototype.orphan();
+        result->addRef();
+        return result;
+    }
+};
+
+BreakIteratorCacheKey::~BreakIteratorCacheKey() { }
+
+namespace {
+
+/** The idle iterators for one (type, locale). */
+struct PoolBucket : public UMemory {
+    PoolBucket(UErrorCode &status) : idle(uprv_deleteUObject, NULL, status) {}
+    ~PoolBucket() { SharedObject::clearPtr(prototype); }
+
+    /** NULL until the first clone is needed. */
+    const BreakIteratorPrototype *prototype = NULL;
+    /** Owns the BreakIterator objects that are ready to be handed out. */
+    UVector idle;
+};
+
+U_CDECL_BEGIN
+
+static void U_CALLCONV
+deletePoolBucket(void *obj) {
+    delete static_cast<PoolBucket *>(obj);
+}
+
+static int32_t U_CALLCONV
+hashPointer(const UHashTok key) {
+    uintptr_t p = (uintptr_t)key.pointer;
+    return (int32_t)((p >> 3) ^ (p >> 19));
+}
+
+static UBool U_CALLCONV
+comparePointers(const UHashTok key1, const UHashTok key2) {
+    return key1.pointer == key2.pointer;
+}
+
+U_CDECL_END
+
+UnicodeString makeBucketKey(UBreakIteratorType type, const Locale &locale) {
+    UnicodeString key((UChar)(0x30 + type));
+    return key.append((UChar)0x2f).append(UnicodeString(locale.getName(), -1, US_INV));
+}
+
+}  // namespace
+
+class BreakIteratorPoolImpl : public UMemory {
+public:
+    BreakIteratorPoolImpl(int32_t maxIdlePerKey, UErrorCode &status)
+            : fMaxIdlePerKey(maxIdlePerKey), fBuckets(status) {
+        fLent = uhash_open(hashPointer, comparePointers, NULL, &status);
+        fBuckets.setValueDeleter(deletePoolBucket);
+    }
+    ~BreakIteratorPoolImpl() {
+        uhash_close(fLent);
+    }
+
+    /** The pool's lock, guarding all of the following fields. */
+    UMutex fMutex = U_MUTEX_INITIALIZER;
+    const int32_t fMaxIdlePerKey;
+    /** Maps "type/locale" keys to PoolBucket objects. */
+    Hashtable fBuckets;
+    /** Maps each iterator that was handed out and not yet returned to its PoolBucket. */
+    UHashtable *fLent;
+    int32_t fIdleCount = 0;
+    int64_t fAcquired = 0;
+    int64_t fReused = 0;
+    int64_t fReleased = 0;
+    int64_t fDiscarded = 0;
+};
+
+BreakIteratorPool::BreakIteratorPool(int32_t maxIdlePerKey, UErrorCode &status) : fImpl(NULL) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (maxIdlePerKey < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    LocalPointer<BreakIteratorPoolImpl> impl(new BreakIteratorPoolImpl(maxIdlePerKey, status), status);
+    if (U_SUCCESS(status)) {
+        fImpl = impl.orphan();
+    }
+}
+
+BreakIteratorPool::~BreakIteratorPool() {
+    delete fImpl;
+}
+
+BreakIterator *
+BreakIteratorPool::acquire(UBreakIteratorType type, const Locale &locale, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (fImpl == NULL) {
+        status = U_INVALID_STATE_ERROR;
+        return NULL;
+    }
+    if ((uint32_t)type > (uint32_t)UBRK_TITLE) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UnicodeString key = makeBucketKey(type, locale);
+    PoolBucket *bucket;
+    BreakIterator *bi = NULL;
+    const BreakIteratorPrototype *prototype = NULL;
+    {
+        Mutex lock(&fImpl->fMutex);
+        bucket = static_cast<PoolBucket *>(fImpl->fBuckets.get(key));
+        if (bucket == NULL) {
+            LocalPointer<PoolBucket> newBucket(new PoolBucket(status), status);
+            if (U_FAILURE(status)) {
+                return NULL;
+            }
+            bucket = newBucket.orphan();
+            fImpl->fBuckets.put(key, bucket, status);
+            if (U_FAILURE(status)) {
+                return NULL;
+            }
+        }
+        ++fImpl->fAcquired;
+        int32_t size = bucket->idle.size();
+        if (size > 0) {
+            bi = static_cast<BreakIterator *>(bucket->idle.orphanElementAt(size - 1));
+            --fImpl->fIdleCount;
+            ++fImpl->fReused;
+            uhash_put(fImpl->fLent, bi, bucket, &status);
+            if (U_FAILURE(status)) {
+                delete bi;
+                return NULL;
+            }
+            return bi;
+        }
+        SharedObject::copyPtr(bucket->prototype, prototype);
+    }
+
+    // Miss: Clone a new iterator, without holding the pool's lock.
+    if (prototype == NULL) {
+        const UnifiedCache *cache = UnifiedCache::getInstance(status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        cache->get(BreakIteratorCacheKey(locale, type), prototype, status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+    }
+    bi = prototype->cloneIterator();
+    Mutex lock(&fImpl->fMutex);
+    if (bucket->prototype == NULL) {
+        // Keep the prototype alive in the UnifiedCache for as long as the pool uses it.
+        SharedObject::copyPtr(prototype, bucket->prototype);
+    }
+    SharedObject::clearPtr(prototype);
+    if (bi == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    uhash_put(fImpl->fLent, bi, bucket, &status);
+    if (U_FAILURE(status)) {
+        delete bi;
+        return NULL;
+    }
+    return bi;
+}
+
+void
+BreakIteratorPool::release(BreakIterator *bi) {
+    if (bi == NULL) {
+        return;
+    }
+    if (fImpl != NULL) {
+        // Drop the reference to the caller's text so that it can go away
+        // while the iterator is idle.
+        UErrorCode status = U_ZERO_ERROR;
+        UText empty = UTEXT_INITIALIZER;
+        utext_openUChars(&empty, NULL, 0, &status);
+        bi->setText(&empty, status);
+        utext_close(&empty);
+        if (U_SUCCESS(status)) {
+            Mutex lock(&fImpl->fMutex);
+            PoolBucket *bucket = static_cast<PoolBucket *>(uhash_remove(fImpl->fLent, bi));
+            if (bucket != NULL) {
+                ++fImpl->fReleased;
+                if (bucket->idle.size() < fImpl->fMaxIdlePerKey) {
+                    bucket->idle.addElement(bi, status);
+                    if (U_SUCCESS(status)) {
+                        ++fImpl->fIdleCount;
+                        return;
+                    }
+                }
+                ++fImpl->fDiscarded;
+            }
+        }
+    }
+    delete bi;
+}
+
+void
+BreakIteratorPool::getStatistics(UBreakIteratorPoolStatistics &stats) const {
+    uprv_memset(&stats, 0, sizeof(stats));
+    if (fImpl == NULL) {
+        return;
+    }
+    Mutex lock(&fImpl->fMutex);
+    stats.acquired = fImpl->fAcquired;
+    stats.reused = fImpl->fReused;
+    stats.released = fImpl->fReleased;
+    stats.discarded = fImpl->fDiscarded;
+    stats.idle = fImpl->fIdleCount;
+    stats.inUse = uhash_count(fImpl->fLent);
+}
+
+U_NAMESPACE_END
+
+// C API ------------------------------------------------------------------- ***
+
+U_NAMESPACE_USE
+
+U_CAPI UBreakIteratorPool * U_EXPORT2
+ubrk_openPool(int32_t maxIdlePerKey, UErrorCode *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    LocalPointer<BreakIteratorPool> pool(new BreakIteratorPool(maxIdlePerKey, *status), *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    return reinterpret_cast<UBreakIteratorPool *>(pool.orphan());
+}
+
+U_CAPI void U_EXPORT2
+ubrk_closePool(UBreakIteratorPool *pool) {
+    delete reinterpret_cast<BreakIteratorPool *>(pool);
+}
+
+U_CAPI UBreakIterator * U_EXPORT2
+ubrk_openFromPool(UBreakIteratorPool *pool,
+                  UBreakIteratorType type,
+                  const char *locale,
+                  const UChar *text,
+                  int32_t textLength,
+                  UErrorCode *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (pool == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    BreakIterator *bi = reinterpret_cast<BreakIteratorPool *>(pool)->acquire(type, Locale(locale), *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    UBreakIterator *uBI = reinterpret_cast<UBreakIterator *>(bi);
+    if (text != NULL) {
+        ubrk_setText(uBI, text, textLength, status);
+        if (U_FAILURE(*status)) {
+            reinterpret_cast<BreakIteratorPool *>(pool)->release(bi);
+            return NULL;
+        }
+    }
+    return uBI;
+}
+
+U_CAPI void U_EXPORT2
+ubrk_returnToPool(UBreakIteratorPool *pool, UBreakIterator *bi) {
+    if (pool == NULL) {
+        ubrk_close(bi);
+        return;
+    }
+    reinterpret_cast<BreakIteratorPool *>(pool)->release(reinterpret_cast<BreakIterator *>(bi));
+}
+
+U_CAPI void U_EXPORT2
+ubrk_getPoolStatistics(const UBreakIteratorPool *pool, UBreakIteratorPoolStatistics *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (pool == NULL) {
+        uprv_memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    reinterpret_cast<const BreakIteratorPool *>(pool)->getStatistics(*stats);
+}
+
+#endif  // !UCONFIG_NO_BREAK_ITERATION
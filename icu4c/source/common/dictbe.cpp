@@ -16,6 +16,7 @@
 #include "unicode/uniset.h"
 #include "unicode/chariter.h"
 #include "unicode/ubrk.h"
+#include "unicode/utf16.h"
 #include "uvectr32.h"
 #include "uvector.h"
 #include "uassert.h"
@@ -1239,28 +1240,29 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                 
     // bestSnlp[i] is the snlp of the best segmentation of the first i
     // code points in the range to be matched.
-    UVector32 bestSnlp(numCodePts + 1, status);
-    bestSnlp.addElement(0, status);
-    for(int32_t i = 1; i <= numCodePts; i++) {
-        bestSnlp.addElement(kuint32max, status);
-    }
-
-
+    MaybeStackArray<uint32_t, 128> bestSnlp(numCodePts + 1);
     // prev[i] is the index of the last CJK code point in the previous word in 
     // the best segmentation of the first i characters.
-    UVector32 prev(numCodePts + 1, status);
+    MaybeStackArray<int32_t, 128> prev(numCodePts + 1);
+    if (bestSnlp.getCapacity() <= numCodePts || prev.getCapacity() <= numCodePts) {
+        return 0;
+    }
+    bestSnlp[0] = 0;
+    for(int32_t i = 1; i <= numCodePts; i++) {
+        bestSnlp[i] = kuint32max;
+    }
     for(int32_t i = 0; i <= numCodePts; i++){
-        prev.addElement(-1, status);
+        prev[i] = -1;
     }
 
+    // The dictionary matches at most maxWordSize words, plus one for the
+    // single-character fallback word below.
     const int32_t maxWordSize = 20;
-    UVector32 values(numCodePts, status);
-    values.setSize(numCodePts);
-    UVector32 lengths(numCodePts, status);
-    lengths.setSize(numCodePts);
+    int32_t values[maxWordSize + 1];
+    int32_t lengths[maxWordSize + 1];
 
-    UText fu = UTEXT_INITIALIZER;
-    utext_openUnicodeString(&fu, &inString, &status);
+    const UChar *text = inString.getBuffer();
+    int32_t textLength = inString.length();
 
     // Dynamic programming to find the best segmentation.
 
@@ -1268,16 +1270,18 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     //                ix is the corresponding string (code unit) index.
     //    They differ when the string contains supplementary characters.
     int32_t ix = 0;
+    int32_t nextIx = 0;
     bool is_prev_katakana = false;
-    for (int32_t i = 0;  i < numCodePts;  ++i, ix = inString.moveIndex32(ix, 1)) {
-        if ((uint32_t)bestSnlp.elementAti(i) == kuint32max) {
+    for (int32_t i = 0;  i < numCodePts;  ++i, ix = nextIx) {
+        UChar32 c;
+        U16_NEXT(text, nextIx, textLength, c);
+        if (bestSnlp[i] == kuint32max) {
             continue;
         }
 
-        int32_t count;
-        utext_setNativeIndex(&fu, ix);
-        count = fDictionary->matches(&fu, maxWordSize, numCodePts,
-                             NULL, lengths.getBuffer(), values.getBuffer(), NULL);
+        // Match the dictionary directly on the string buffer, one trie walk per position.
+        int32_t count = fDictionary->matches(text + ix, textLength - ix, maxWordSize, maxWordSize,
+                             NULL, lengths, values, NULL);
                              // Note: lengths is filled with code point lengths
                              //       The NULL parameter is the ignored code unit lengths.
 
@@ -1286,18 +1290,18 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // with the highest value possible, i.e. the least likely to occur.
         // Exclude Korean characters from this treatment, as they should be left
         // together by default.
-        if ((count == 0 || lengths.elementAti(0) != 1) &&
-                !fHangulWordSet.contains(inString.char32At(ix))) {
-            values.setElementAt(maxSnlp, count);   // 255
-            lengths.setElementAt(1, count++);
+        if ((count == 0 || lengths[0] != 1) &&
+                !fHangulWordSet.contains(c)) {
+            values[count] = maxSnlp;   // 255
+            lengths[count++] = 1;
         }
 
         for (int32_t j = 0; j < count; j++) {
-            uint32_t newSnlp = (uint32_t)bestSnlp.elementAti(i) + (uint32_t)values.elementAti(j);
-            int32_t ln_j_i = lengths.elementAti(j) + i;
-            if (newSnlp < (uint32_t)bestSnlp.elementAti(ln_j_i)) {
-                bestSnlp.setElementAt(newSnlp, ln_j_i);
-                prev.setElementAt(i, ln_j_i);
+            uint32_t newSnlp = bestSnlp[i] + (uint32_t)values[j];
+            int32_t ln_j_i = lengths[j] + i;
+            if (newSnlp < bestSnlp[ln_j_i]) {
+                bestSnlp[ln_j_i] = newSnlp;
+                prev[ln_j_i] = i;
             }
         }
 
@@ -1307,52 +1311,49 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // characters is considered a candidate word with a default cost
         // specified in the katakanaCost table according to its length.
 
-        bool is_katakana = isKatakana(inString.char32At(ix));
+        bool is_katakana = isKatakana(c);
         int32_t katakanaRunLength = 1;
         if (!is_prev_katakana && is_katakana) {
-            int32_t j = inString.moveIndex32(ix, 1);
+            int32_t j = nextIx;
             // Find the end of the continuous run of Katakana characters
-            while (j < inString.length() && katakanaRunLength < kMaxKatakanaGroupLength &&
+            while (j < textLength && katakanaRunLength < kMaxKatakanaGroupLength &&
                     isKatakana(inString.char32At(j))) {
                 j = inString.moveIndex32(j, 1);
                 katakanaRunLength++;
             }
             if (katakanaRunLength < kMaxKatakanaGroupLength) {
-                uint32_t newSnlp = bestSnlp.elementAti(i) + getKatakanaCost(katakanaRunLength);
-                if (newSnlp < (uint32_t)bestSnlp.elementAti(i+katakanaRunLength)) {
-                    bestSnlp.setElementAt(newSnlp, i+katakanaRunLength);
-                    prev.setElementAt(i, i+katakanaRunLength);  // prev[j] = i;
+                uint32_t newSnlp = bestSnlp[i] + getKatakanaCost(katakanaRunLength);
+                if (newSnlp < bestSnlp[i+katakanaRunLength]) {
+                    bestSnlp[i+katakanaRunLength] = newSnlp;
+                    prev[i+katakanaRunLength] = i;  // prev[j] = i;
                 }
             }
         }
         is_prev_katakana = is_katakana;
     }
-    utext_close(&fu);
 
     // Start pushing the optimal offset index into t_boundary (t for tentative).
     // prev[numCodePts] is guaranteed to be meaningful.
     // We'll first push in the reverse order, i.e.,
     // t_boundary[0] = numCodePts, and afterwards do a swap.
-    UVector32 t_boundary(numCodePts+1, status);
+    // Reuses the values of bestSnlp, which are no longer needed.
+    int32_t *t_boundary = reinterpret_cast<int32_t *>(bestSnlp.getAlias());
 
     int32_t numBreaks = 0;
     // No segmentation found, set boundary to end of range
-    if ((uint32_t)bestSnlp.elementAti(numCodePts) == kuint32max) {
-        t_boundary.addElement(numCodePts, status);
-        numBreaks++;
+    if (bestSnlp[numCodePts] == kuint32max) {
+        t_boundary[numBreaks++] = numCodePts;
     } else {
-        for (int32_t i = numCodePts; i > 0; i = prev.elementAti(i)) {
-            t_boundary.addElement(i, status);
-            numBreaks++;
+        for (int32_t i = numCodePts; i > 0; i = prev[i]) {
+            t_boundary[numBreaks++] = i;
         }
-        U_ASSERT(prev.elementAti(t_boundary.elementAti(numBreaks - 1)) == 0);
+        U_ASSERT(prev[t_boundary[numBreaks - 1]] == 0);
     }
 
     // Add a break for the start of the dictionary range if there is not one
     // there already.
     if (foundBreaks.size() == 0 || foundBreaks.peeki() < rangeStart) {
-        t_boundary.addElement(0, status);
-        numBreaks++;
+        t_boundary[numBreaks++] = 0;
     }
 
     // Now that we're done, convert positions in t_boundary[] (indices in 
@@ -1361,7 +1362,7 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     int32_t prevCPPos = -1;
     int32_t prevUTextPos = -1;
     for (int32_t i = numBreaks-1; i >= 0; i--) {
-        int32_t cpPos = t_boundary.elementAti(i);
+        int32_t cpPos = t_boundary[i];
         U_ASSERT(cpPos > prevCPPos);
         int32_t utextPos =  inputMap.isValid() ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
         U_ASSERT(utextPos >= prevUTextPos);
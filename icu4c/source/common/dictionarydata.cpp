@@ -14,6 +14,7 @@
 #include "dictionarydata.h"
 #include "unicode/ucharstrie.h"
 #include "unicode/bytestrie.h"
+#include "unicode/utf16.h"
 #include "unicode/udata.h"
 #include "cmemory.h"
 
@@ -34,6 +35,18 @@ const int32_t  DictionaryData::TRANSFORM_OFFSET_MASK = 0x1fffff;
 DictionaryMatcher::~DictionaryMatcher() {
 }
 
+int32_t DictionaryMatcher::matches(const UChar *text, int32_t length, int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                            int32_t *prefix) const {
+    UErrorCode status = U_ZERO_ERROR;
+    UText ut = UTEXT_INITIALIZER;
+    utext_openUChars(&ut, text, length, &status);
+    int32_t count = U_SUCCESS(status) ?
+        matches(&ut, maxLength, limit, lengths, cpLengths, values, prefix) : 0;
+    utext_close(&ut);
+    return count;
+}
+
 UCharsDictionaryMatcher::~UCharsDictionaryMatcher() {
     udata_close(file);
 }
@@ -86,6 +99,52 @@ int32_t UCharsDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     return wordCount;
 }
 
+int32_t UCharsDictionaryMatcher::matches(const UChar *text, int32_t length, int32_t maxLength,
+                            int32_t limit,
+                            int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                            int32_t *prefix) const {
+
+    UCharsTrie uct(characters);
+    int32_t wordCount = 0;
+    int32_t codePointsMatched = 0;
+
+    for (int32_t i = 0; i < length;) {
+        UChar32 c;
+        U16_NEXT(text, i, length, c);
+        UStringTrieResult result = (codePointsMatched == 0) ? uct.first(c) : uct.next(c);
+        int32_t lengthMatched = i;
+        codePointsMatched += 1;
+        if (USTRINGTRIE_HAS_VALUE(result)) {
+            if (wordCount < limit) {
+                if (values != NULL) {
+                    values[wordCount] = uct.getValue();
+                }
+                if (lengths != NULL) {
+                    lengths[wordCount] = lengthMatched;
+                }
+                if (cpLengths != NULL) {
+                    cpLengths[wordCount] = codePointsMatched;
+                }
+                ++wordCount;
+            }
+            if (result == USTRINGTRIE_FINAL_VALUE) {
+                break;
+            }
+        }
+        else if (result == USTRINGTRIE_NO_MATCH) {
+            break;
+        }
+        if (lengthMatched >= maxLength) {
+            break;
+        }
+    }
+
+    if (prefix != NULL) {
+        *prefix = codePointsMatched;
+    }
+    return wordCount;
+}
+
 BytesDictionaryMatcher::~BytesDictionaryMatcher() {
     udata_close(file);
 }
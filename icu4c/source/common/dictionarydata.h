@@ -94,6 +94,18 @@ class U_COMMON_API DictionaryMatcher : public UMemory {
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const = 0;
 
+    /*  Same as the UText version, for UTF-16 text in a buffer.
+     *  Matching begins at text[0]; maxLength and the output lengths are in UTF-16 code units.
+     *  Avoids the per-character UText overhead for callers that already have the text
+     *  in a UnicodeString. The default implementation wraps the buffer in a UText.
+     *
+     *  @param text      The text in which to look for matching words.
+     *  @param length    The length of the text.
+     */
+    virtual int32_t matches(const UChar *text, int32_t length, int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                            int32_t *prefix) const;
+
     /** @return DictionaryData::TRIE_TYPE_XYZ */
     virtual int32_t getType() const = 0;
 };
@@ -108,6 +120,9 @@ class U_COMMON_API UCharsDictionaryMatcher : public DictionaryMatcher {
     virtual int32_t matches(UText *text, int32_t maxLength, int32_t limit,
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const;
+    virtual int32_t matches(const UChar *text, int32_t length, int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                            int32_t *prefix) const;
     virtual int32_t getType() const;
 private:
     const UChar *characters;
@@ -126,6 +141,7 @@ class U_COMMON_API BytesDictionaryMatcher : public DictionaryMatcher {
     virtual int32_t matches(UText *text, int32_t maxLength, int32_t limit,
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const;
+    using DictionaryMatcher::matches;
     virtual int32_t getType() const;
 private:
     UChar32 transform(UChar32 c) const;
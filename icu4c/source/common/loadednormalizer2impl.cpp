@@ -107,7 +107,11 @@ LoadedNormalizer2Impl::load(const char *packageName, const char *name, UErrorCod
     offset=nextOffset;
     const uint8_t *inSmallFCD=inBytes+offset;
 
-    init(inIndexes, ownedTrie, inExtraData, inSmallFCD);
+    // compositionsHash: new in formatVersion 4.1, empty if absent
+    offset=inIndexes[IX_COMPOSITIONS_HASH_OFFSET];
+    const uint32_t *inCompositionsHash=(const uint32_t *)(inBytes+offset);
+
+    init(inIndexes, ownedTrie, inExtraData, inSmallFCD, inCompositionsHash);
 }
 
 // instance cache ---------------------------------------------------------- ***
@@ -11,11 +11,11 @@
 
 #ifdef INCLUDED_FROM_NORMALIZER2_CPP
 
-static const UVersionInfo norm2_nfc_data_formatVersion={4,0,0,0};
+static const UVersionInfo norm2_nfc_data_formatVersion={4,1,0,0};
 static const UVersionInfo norm2_nfc_data_dataVersion={0xc,0,0,0};
 
 static const int32_t norm2_nfc_data_indexes[Normalizer2Impl::IX_COUNT]={
-0x50,0x4ae0,0x8738,0x8838,0x8838,0x8838,0x8838,0x8838,0xc0,0x300,0xadc,0x29d0,0x3c56,0xfc00,0x1282,0x3b8c,
+0x50,0x4ae0,0x8738,0x8838,0xc83c,0xc83c,0xc83c,0xc83c,0xc0,0x300,0xadc,0x29d0,0x3c56,0xfc00,0x1282,0x3b8c,
 0x3c24,0x3c56,0x300,0
 };
 
@@ -1137,4 +1137,264 @@ static const uint8_t norm2_nfc_data_smallFCD[256]={
 0,0,0,0,0,0,0,0,0,0,0,7,0,0,2,0
 };
 
+static const uint32_t norm2_nfc_data_compositionsHash[4097]={
+0xb,0x6d70300,0x3fc4,0x32c0314,0x3e73,0x3e60308,0x9d8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0xf6030c,0x2b0,0,0xffffffff,0x7b60300,0x3e26,0,0xffffffff,0,0xffffffff,0x7d60342,0x3e4f,0x222032d,0x3c7a,0x85d0301,
+0x3e78,0x2880307,0x3cd6,0x2980328,0x2e6,0,0xffffffff,0x4e83099,0x60b8,0x1220311,0x42c,0,0xffffffff,0,0xffffffff,0x6fe0304,
+0x3cba,0,0xffffffff,0,0xffffffff,0xf20307,0x3cac,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x40e0308,0x9ea,0x80309,
+0x3d44,0x60e0309,0x3d64,0x840301,0x19a,0x1a00301,0x20e,0x2460306,0x29e,0,0xffffffff,0,0xffffffff,0x15c0308,0x2f0,0,
+0xffffffff,0,0xffffffff,0x2f40300,0x3fda,0,0xffffffff,0,0xffffffff,0,0xffffffff,0xc00327,0x28a,0x7f80345,0x3f2a,0,
+0xffffffff,0x5103099,0x615c,0,0xffffffff,0,0xffffffff,0xa4030c,0x3d0,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x56b15af,
+0x422b76,0,0xffffffff,0x80b0301,0x3e59,0x840323,0x3d94,0x2460328,0x3d7,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6750301,0x3db6,0x4a20338,0x44da,0,0xffffffff,0x2340331,
+0x3c92,0,0xffffffff,0x3fa0304,0x9c6,0x3bc0308,0x9a4,0,0xffffffff,0xd20309,0x3d9c,0x33a0313,0x3e91,0x5383099,0x61b2,0x26a0301,
+0x2aa,0,0xffffffff,0,0xffffffff,0x7e30345,0x3f24,0x1e8030c,0x43e,0,0xffffffff,0x5f50304,0x45a,0x6ea0dca,0x1bba,0,
+0xffffffff,0x17a0306,0x207,0,0xffffffff,0,0xffffffff,0x76f0342,0x3e1d,0x2d40302,0x2ee,0,0xffffffff,0x88b0342,0x3eac,0x6750323,
+0x3dc6,0x16e030c,0x2fa,0x30c0301,0x70c,0x4ca0338,0x455c,0x3440300,0x3fd4,0,0xffffffff,0,0xffffffff,0x3e40308,0x9f0,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x26a0323,0x3cb7,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1e8032e,0x3c56,0x80b0345,
+0x3f30,0x54a10ba,0x422134,0,0xffffffff,0,0xffffffff,0x17a0328,0x20a,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4e63099,
+0x60b4,0,0xffffffff,0x2180301,0x3c62,0,0xffffffff,0x3da0306,0x81c,0x73a0300,0x3e07,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x840330,0x3c58,0,0xffffffff,0x6bf0304,0x462,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1220309,
+0x3dcc,0x406030b,0x9e6,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x760307,0x3c44,0x3d60301,0x818,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x80301,0x182,0x60e0301,0x3d5c,0,0xffffffff,0x1da0327,0x246,0x2180323,0x3c66,0x30c0345,0x3f78,0x50e3099,
+0x6158,0x15c0300,0x3de4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4780301,0x3f9c,0x5cb0304,0x3be,0,0xffffffff,0x440327,
+0x451,0x2340307,0x3c8a,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x38032d,
+0x3c24,0,0xffffffff,0x4a00338,0x4492,0,0xffffffff,0x31a0300,0x3f90,0x80323,0x3d41,0x1f80303,0x252,0x3ba0308,0x80e,0x298030b,
+0x2e2,0x44e0cd5,0x198e,0x14c0301,0x3d04,0x4fe309a,0x60ee,0x93a0345,0x3f8e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6680303,
+0x3dc0,0,0xffffffff,0x8a60300,0x3ec5,0,0xffffffff,0x37e0304,0x3fa2,0,0xffffffff,0x1b60302,0x1d5,0xd20301,0x1a6,0,
+0xffffffff,0,0xffffffff,0xf60311,0x424,0x418030f,0x8ee,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4c80338,0x455a,0,
+0xffffffff,0x288030c,0x2ca,0,0xffffffff,0x298032d,0x3cee,0x3e20308,0x9e8,0x14c0323,0x3d10,0,0xffffffff,0x8460345,0x3f3e,0x77a0301,
+0x3e1b,0x47e0342,0x3fbe,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x840306,
+0x258,0,0xffffffff,0xd20323,0x3d99,0x246030b,0x2a2,0,0xffffffff,0x4e43099,0x60b0,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x5a70301,0x3c98,0x8b10342,0x3ecf,0,0xffffffff,0,0xffffffff,0x8540300,0x3e66,0x32c0304,0x3fb2,0x36a0300,0x3ee4,0x60338,
+0x44de,0x3500314,0x3ed3,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x59c0303,
+0x3dac,0x1580308,0x3d18,0,0xffffffff,0x8310345,0x3f38,0x840328,0x25c,0,0xffffffff,0x3ce0304,0x9c4,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x1220301,0x1b4,0x50c3099,0x61e8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x35a0301,0x759,0x5561127,
+0x42225e,0,0xffffffff,0,0xffffffff,0x8d30345,0x3f4a,0,0xffffffff,0x1b6030f,0x40a,0x77a0345,0x3f12,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x27a0327,0x2be,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x8e60301,0x3ed9,0x1140331,0x3cdc,0x49e0338,
+0x448e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2e0301,0x20c,0x1220323,0x3dc8,0x2d40307,0x3d1e,0x44c0cd5,0x1980,0x5343099,
+0x61ac,0x30c0306,0x3f70,0x2660301,0x3caa,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x2980303,0x2d3,0,0xffffffff,0,0xffffffff,0x4220654,0xc46,0x8be0345,0x3f44,0,0xffffffff,0x416030f,
+0x8ec,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4c60338,0x4558,0x5b50300,0x3b6,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x35a0345,0x3f66,0x3da030b,0x9e4,0,0xffffffff,0x5720303,
+0x3d54,0x8940301,0x3eaa,0x3aa0301,0x79d,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x4e23099,0x60ac,0x6820309,0x3dd8,0x8e60345,0x3f50,0x76030c,0x43c,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x80306,0x205,0xd2031b,0x341,0x2460303,0x1eb,0x40338,0x44c0,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2880326,0x436,0,0xffffffff,0x234030c,
+0x290,0,0xffffffff,0,0xffffffff,0x1220330,0x3ce8,0x6b00306,0x3c38,0,0xffffffff,0,0xffffffff,0x30c0313,0x3e11,0x76032e,
+0x3c54,0x50a3099,0x613c,0,0xffffffff,0,0xffffffff,0xae032d,0x3c78,0,0xffffffff,0x80328,0x208,0x1f80308,0x1df,0x1140307,
+0x3cd4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x19a0323,0x3c0a,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3aa0345,
+0x3fe6,0x6a60304,0x3c0,0x85d0342,0x3e7c,0,0xffffffff,0x49c0338,0x4488,0,0xffffffff,0,0xffffffff,0x1b60307,0x22e,0xd20306,
+0x29c,0x3b60308,0x7a8,0x6320301,0x3ca4,0x4fa309a,0x60e8,0,0xffffffff,0,0xffffffff,0x45a0ddf,0x1bbc,0,0xffffffff,0,
+0xffffffff,0x5f50301,0x3c9a,0,0xffffffff,0,0xffffffff,0x17a0303,0x1c6,0,0xffffffff,0,0xffffffff,0x122031b,0x35f,0x680327,
+0x244,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5ea0303,0x3dae,0x7630345,
+0x3f0c,0x4c40338,0x45c6,0,0xffffffff,0xd20328,0x3d5,0x2c20308,0x3d0a,0x3000304,0x3c6,0,0xffffffff,0x1480323,0x3cfc,0,
+0xffffffff,0x559133e,0x422696,0,0xffffffff,0x80b0342,0x3e5d,0,0xffffffff,0,0xffffffff,0,0xffffffff,0xc00331,0x3c90,0x17a0325,
+0x3c02,0,0xffffffff,0x9210345,0x3f5e,0,0xffffffff,0x2be0303,0x3cfa,0x1da0302,0x23a,0xf60301,0x2a8,0x4e03099,0x60a8,0,
+0xffffffff,0,0xffffffff,0x45a0dca,0x1bb4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x440302,
+0x195,0x20338,0x44dc,0x1220306,0x2d8,0x74e0345,0x3f06,0x4060308,0x9e2,0x6820301,0x3dd0,0x43809d7,0x1398,0,0xffffffff,0x35a0306,
+0x3f60,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7d60300,0x3e47,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x87d0301,0x3e98,0x58c0309,0x3d84,0xf60323,0x3cb5,0,0xffffffff,0,0xffffffff,0x90c0345,0x3f58,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6030300,0x3b8,0x1220328,0x2e4,0x38e0300,0x3ef0,0x6820323,
+0x3de0,0xa40301,0x3c60,0x22e0307,0x3c82,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5c00303,0x3d56,0x1f80300,
+0x1d8,0x49a0338,0x4482,0,0xffffffff,0x2980308,0x1f9,0,0xffffffff,0,0xffffffff,0x7140302,0x3d5a,0x2d00307,0x3d16,0,
+0xffffffff,0,0xffffffff,0x5303099,0x61a6,0x6680300,0x3db8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x37e0301,0x75e,0,
+0xffffffff,0,0xffffffff,0x62b0300,0x3c2a,0,0xffffffff,0xa40323,0x3c64,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5b00304,
+0x454,0x7030307,0x3cd0,0,0xffffffff,0,0xffffffff,0x3040301,0x3fe,0,0xffffffff,0x6190309,0x3d66,0x44030f,0x408,0xc00307,
+0x3c88,0x4c20338,0x45c4,0x6e50cd5,0x1996,0x3220314,0x3e53,0,0xffffffff,0,0xffffffff,0x16e0301,0x2f2,0x35a0313,0x3e01,0x4780342,
+0x3f9e,0,0xffffffff,0,0xffffffff,0x840303,0x250,0,0xffffffff,0x2460308,0x1ed,0x2c20300,0x3d02,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x76f0300,0x3e15,0,0xffffffff,0x1aa0327,0x3c22,0x88b0300,0x3ea4,0x1e80323,0x3c4a,0x8160301,0x3e5b,0x6f40304,
+0x3c72,0x32c0301,0x714,0x4de3099,0x60a4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4040308,
+0x9ce,0x16e0323,0x3d24,0x27a0302,0x2ba,0x59c0300,0x3da4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x114030c,0x2c8,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6750303,
+0x3dc2,0x5063099,0x60f8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3fa0306,0x872,0,0xffffffff,0x1b6030c,0x236,0,
+0xffffffff,0x77a0342,0x3e1f,0x8760300,0x3e86,0xd2030b,0x2a0,0x58c0301,0x3d7c,0x3720314,0x3e43,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x3aa0313,0x3ec1,0x7c40301,0x3e3a,0,0xffffffff,0,0xffffffff,0x17a0308,0x1c9,0x4980338,0x444c,0x2d40304,0x466,0,
+0xffffffff,0x4540d57,0x1a98,0,0xffffffff,0x4f6309a,0x60e2,0,0xffffffff,0x8160345,0x3f32,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x8660301,0x3e7a,0,0xffffffff,0,0xffffffff,0x2980300,0x1f2,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x79c0345,0x3f1a,0x39a0314,0x3ea3,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x4c00338,0x4512,0,0xffffffff,0x33a0300,0x3ff0,0x7af0301,0x3e28,0x1da0307,0x242,0x35a0342,
+0x3f6d,0x5da0309,0x3d86,0x5720300,0x3d4c,0x1060327,0x2bc,0x2220327,0x278,0x3da0308,0x9e0,0x45a0dcf,0x1bb9,0x460102e,0x204c,0x6190301,
+0x3d5e,0x64a0307,0x3ccc,0x440307,0x22c,0x122030b,0x2e0,0x280323,0x3c08,0,0xffffffff,0,0xffffffff,0x8e60342,0x3edd,0xf20301,
+0x3ca8,0x4dc3099,0x60a0,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x80303,0x186,0x7870345,0x3f14,0x60e0303,0x3d68,0x2460300,
+0x1e4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x15c0302,0x2ec,0x47e0300,0x3fba,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x2880323,0x3cda,0,0xffffffff,0,0xffffffff,0x7250302,0x3db0,0,0xffffffff,0x122032d,0x3cec,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x8b10300,0x3ec7,0x5fe0304,
+0x456,0x80325,0x3c00,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x680302,0x238,0,
+0xffffffff,0x8940342,0x3eae,0,0xffffffff,0x3aa0342,0x3fed,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x37e0306,0x3fa0,0,
+0xffffffff,0,0xffffffff,0x1b60304,0x227,0xd20303,0x1ab,0x4960338,0x4448,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x7bd0300,0x3e34,0,0xffffffff,0,0xffffffff,0x1140326,0x434,0x9300345,0x3fe4,0x52c3099,0x61a0,0xc0030c,0x28e,0x17a0300,
+0x1c0,0,0xffffffff,0x68f0309,0x3dda,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x6ce0301,0x720,0x5ea0300,0x3da6,0,0xffffffff,0x840308,0x19f,0,0xffffffff,0x3000301,0x3fa,0x44e0cc2,0x1995,0x4be0338,
+0x4510,0,0xffffffff,0x2fa0304,0x3c4,0x1d80307,0x3c3e,0,0xffffffff,0x3d80308,0x9cc,0x6540301,0x3cf0,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x32c0306,0x3fb0,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7ff0345,0x3f2c,0x4440bd7,0x1798,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x5da0301,0x3d7e,0x27a0307,0x3cc2,0,0xffffffff,0x4da3099,0x609c,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x3ce0306,0x832,0,0xffffffff,0,0xffffffff,0x1220303,0x2d1,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x8f10301,0x3edb,0,0xffffffff,0,0xffffffff,0x37e0313,0x3e61,0,0xffffffff,0x1b60311,
+0x40e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x7ea0345,0x3f26,0x5023099,0x60f2,0,0xffffffff,0x2340301,0x288,0,0xffffffff,0,0xffffffff,0x2d40309,
+0x3dee,0x3500301,0x71e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x380327,0x3c20,0x760323,0x3c48,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x5c00300,0x3d4e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x70d0306,0x3d6c,0,0xffffffff,0x4940338,
+0x4418,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2340323,
+0x3c8e,0x32c0313,0x3e71,0x52a3099,0x6192,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1da030c,0x3ce,0,
+0xffffffff,0x8f10345,0x3f52,0,0xffffffff,0,0xffffffff,0x3960314,0x3fca,0,0xffffffff,0x85d0300,0x3e74,0,0xffffffff,0,
+0xffffffff,0x44030c,0x234,0,0xffffffff,0x2fe0301,0x3fc,0,0xffffffff,0x68f0301,0x3dd2,0xba0307,0x3c80,0x4bc0338,0x450a,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x80308,0x189,0x840300,0x198,0x3500345,
+0x3ff8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4420bd7,0x1728,0x15c0307,0x3d1c,0,0xffffffff,0x39a0304,0x3fc2,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x4d83099,0x6098,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x68f0323,
+0x3de2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3440314,0x3eb3,0x37e0342,
+0x3fac,0x80b0300,0x3e55,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x14c0308,0x3d08,0x680307,0x240,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x6750300,0x3dba,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x1b60309,0x3d76,0xd20308,0x1ad,0x3f40306,0x984,0,0xffffffff,0,0xffffffff,0x1480303,0x3cf8,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x65e0308,0x3cf4,0x69c0304,0x3d8,0x2d40301,0x1fa,0x4920338,0x4412,0x30c0300,0x3f74,0,0xffffffff,0x8160342,
+0x3e5f,0x1060302,0x2b8,0x89d0301,0x3eba,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2c2030a,0x3d30,0x5283099,0x618e,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5a70308,0x3c9c,0x1aa0331,0x3c1e,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2d40323,0x3dea,0x43c0b57,0x1698,0,0xffffffff,0,
+0xffffffff,0x1da0304,0x3c42,0x4ba0338,0x4508,0,0xffffffff,0x27a030c,0x2c3,0,0xffffffff,0x31a0314,0x3e33,0,0xffffffff,0,
+0xffffffff,0x8380345,0x3f3a,0,0xffffffff,0x440304,0x225,0,0xffffffff,0,0xffffffff,0x1220308,0x1b9,0,0xffffffff,0x6820303,
+0x3ddc,0,0xffffffff,0x72f0301,0x3e09,0,0xffffffff,0x84b0301,0x3e68,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x80300,
+0x180,0x60e0300,0x3d60,0x8da0345,0x3f4c,0x4d63099,0x6128,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x8660342,0x3e7e,0x4780300,0x3f9a,0x3420314,0x3fd8,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x660307,0x3c3c,0x8230345,0x3f34,0,0xffffffff,0,0xffffffff,0x93f0345,
+0x3fee,0x4761b35,0x3686,0xae0327,0x276,0x1f80302,0x1dc,0,0xffffffff,0x436093c,0x1268,0x298030a,0x2de,0x4fe3099,0x60ec,0x14c0300,
+0x3d00,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x8c50345,0x3f46,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x36a0314,0x3e23,0,0xffffffff,0,0xffffffff,0x1b60301,0x1d2,0xd20300,0x1a4,0,0xffffffff,0x72f0345,0x3f00,0,
+0xffffffff,0x4900338,0x4408,0,0xffffffff,0,0xffffffff,0x1aa0307,0x3c16,0x2220331,0x3c76,0,0xffffffff,0x1140323,0x3cd8,0,
+0xffffffff,0,0xffffffff,0x440311,0x40c,0x5263099,0x618a,0x54d10ba,0x422138,0,0xffffffff,0,0xffffffff,0x77a0300,0x3e17,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1b60323,0x3d73,0x2c20302,
+0x2ea,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2fa0301,0x3f8,0,0xffffffff,0,0xffffffff,0x4b80338,0x45c2,0,
+0xffffffff,0,0xffffffff,0x288032d,0x3ce2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3500313,0x3ed1,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1580307,0x3d14,0,
+0xffffffff,0,0xffffffff,0x1f8030f,0x412,0,0xffffffff,0,0xffffffff,0x1a00327,0x1cf,0,0xffffffff,0,0xffffffff,0x1220300,
+0x1b2,0x5970301,0x3c5c,0x68030c,0x3cc,0x3220301,0x712,0x3c80306,0x982,0,0xffffffff,0x35a0300,0x3ee1,0,0xffffffff,0,
+0xffffffff,0x3fa0308,0x9ca,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x58c0303,0x3d88,0,
+0xffffffff,0x6390301,0x3ca6,0x6ce0342,0x3fae,0x27a0326,0x432,0x8e60300,0x3ed5,0x5f50308,0x3c9e,0x4741b35,0x3682,0,0xffffffff,0x17a030a,
+0x1cb,0,0xffffffff,0x434093c,0x1262,0,0xffffffff,0x22e0301,0x3c7e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x1060307,0x3cc0,0,0xffffffff,0x3440304,0x3fd2,0,0xffffffff,0x5820301,0x3f4,0x76a0345,0x3f0e,0x1b60330,0x3c36,0x2980302,
+0x1f6,0,0xffffffff,0x26a0327,0x2ae,0x4220653,0xc44,0,0xffffffff,0,0xffffffff,0x48e0338,0x439c,0x3ec0301,0x8a6,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6240301,0x3c2c,0,0xffffffff,0x22e0323,0x3c86,0x3220345,
+0x3f98,0x5243099,0x6184,0,0xffffffff,0x8f10342,0x3edf,0x3720301,0x75d,0,0xffffffff,0,0xffffffff,0x8940300,0x3ea6,0x3aa0300,
+0x3ef9,0,0xffffffff,0,0xffffffff,0x6190303,0x3d6a,0x440309,0x3d74,0xc00301,0x286,0x2980324,0x3ce6,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x7550345,0x3f08,0,0xffffffff,0x4b60338,0x45c0,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x2460302,0x1e9,0x2180327,0x26e,0,0xffffffff,0,0xffffffff,0x6b50306,0x3c3a,0x8840301,
+0x3e9a,0x15c0304,0x464,0x6400307,0x3cc8,0x39a0301,0x79a,0,0xffffffff,0x9130345,0x3f5a,0,0xffffffff,0xc00323,0x3c8c,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x2e80302,0x3d22,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x380331,0x3c1c,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6ab0304,0x3c2,0x3f80308,0x9be,0x298030f,0x42a,0x53c309a,
+0x61ba,0,0xffffffff,0x680304,0x3c40,0x3720345,0x3f86,0,0xffffffff,0x71b0302,0x3d8c,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x5b5030c,0x3b2,0x234032d,0x3c96,0x86f0301,0x3e88,0x1b60306,0x22a,0x37e0308,0x795,0x3fa0300,0x8ba,0x6320300,
+0x3ca0,0x8fe0345,0x3f54,0x432093c,0x1252,0x3ee0306,0x9ae,0x4721b35,0x3680,0x1aa030c,0x21e,0x1e80308,0x3c4e,0x4fa3099,0x60e6,0,
+0xffffffff,0,0xffffffff,0x17a0302,0x1c5,0x4200308,0x9d6,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x48c0338,0x439e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1b60328,
+0x232,0x246030f,0x41a,0x2c20307,0x3d0e,0,0xffffffff,0x5223099,0x6180,0,0xffffffff,0x9260345,0x3f64,0,0xffffffff,0x5e50301,
+0x3c5e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x32c0308,0x754,0,0xffffffff,0,0xffffffff,0x38e0314,
+0x3e83,0,0xffffffff,0,0xffffffff,0x1da0301,0x3ea,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5da0303,0x3d8a,0,
+0xffffffff,0x4b40338,0x4502,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3ce0308,0x9c8,0x440301,0x192,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x6820300,0x3dd4,0,0xffffffff,0,0xffffffff,0x380307,0x3c14,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5d00301,0x3f6,0x2e80331,0x3d2a,0,0xffffffff,0x87d0300,0x3e94,0x56815af,
+0x422b74,0,0xffffffff,0,0xffffffff,0x89d0342,0x3ebe,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7cb0301,
+0x3e49,0x440323,0x3d71,0x17a030f,0x402,0x2340303,0x1e2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x106030c,0x2c1,0,0xffffffff,0x3c00301,0x806,0x222030c,0x27c,0,0xffffffff,0x4701b35,0x367a,0x6c40345,
+0x3f68,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x7a30345,0x3f1c,0,0xffffffff,0x6d70301,0x760,0x5b50304,0x3aa,0x7080307,0x3cd2,0x2e0327,0x18f,0x37e0300,0x3eec,0x41e0308,
+0x9d4,0,0xffffffff,0x72f0342,0x3e0d,0,0xffffffff,0x7b60301,0x3e2a,0x84b0342,0x3e6c,0,0xffffffff,0,0xffffffff,0x48a0338,
+0x439a,0,0xffffffff,0x2880308,0x3d2e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x68f0303,
+0x3dde,0x3220313,0x3e51,0x5203099,0x617c,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7cb0345,0x3f20,0,0xffffffff,0,
+0xffffffff,0x8030a,0x18b,0x840302,0x19c,0x2460307,0x45f,0x6f90304,0x3cb8,0x78e0345,0x3f16,0x1a00302,0x212,0,0xffffffff,0x15c0309,
+0x3dec,0,0xffffffff,0x39a0306,0x3fc0,0x2f40301,0x70a,0,0xffffffff,0,0xffffffff,0x8160300,0x3e57,0x440330,0x3c34,0x32c0300,
+0x3fb4,0x603030c,0x3b4,0x3cc0308,0x9bc,0x2e80307,0x2f8,0x4b20338,0x4500,0,0xffffffff,0,0xffffffff,0x5483099,0x61fc,0x27a0301,
+0x2b7,0,0xffffffff,0,0xffffffff,0xae0331,0x3c74,0x1f8030c,0x3a0,0,0xffffffff,0,0xffffffff,0x3ce0300,0x81a,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5591357,0x422698,0,0xffffffff,0,0xffffffff,0x3c20306,0x9ac,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x33a0314,0x3e93,0x3f40308,
+0x9ba,0x538309a,0x61b4,0x58c0300,0x3d80,0x27a0323,0x3cc7,0x3720313,0x3e41,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7c40300,
+0x3e36,0x114032d,0x3ce0,0,0xffffffff,0x17a0307,0x44f,0x46e1b35,0x3676,0,0xffffffff,0x2d40303,0x3df2,0,0xffffffff,0,
+0xffffffff,0x4f63099,0x60e0,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3440301,0x71c,0,0xffffffff,0x8660300,
+0x3e76,0x84030f,0x410,0x1b6032d,0x3c32,0,0xffffffff,0,0xffffffff,0x41c0308,0x9b6,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x39a0313,0x3ea1,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4880338,0x435c,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7af0300,0x3e24,0x64f0307,0x3cce,0x73a0301,0x3e0b,0x8060345,0x3f2e,0x1da0306,
+0x23e,0x1060326,0x430,0x51e3099,0x6178,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6190300,0x3d62,0x440306,0x228,0,
+0xffffffff,0x122030a,0x2dc,0xba0301,0x3c7c,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x38030c,0x21c,0x760308,0x3c4c,0x6ba0304,
+0x460,0,0xffffffff,0x4b00338,0x44f2,0,0xffffffff,0x80302,0x185,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x72a0302,
+0x3db2,0xf60327,0x2ac,0x26a030f,0x422,0x15c0301,0x1ba,0x5463099,0x61f4,0x44a0c56,0x1890,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x7f10345,0x3f28,0x440328,0x230,0x6030304,0x3ac,0,0xffffffff,0xba0323,0x3c84,0,0xffffffff,0,0xffffffff,0x5531127,
+0x42225c,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x31a0301,0x710,0,0xffffffff,0x1f80304,0x256,0,
+0xffffffff,0x298030c,0x3a8,0x44e0cd6,0x1990,0x26a0331,0x3cbe,0x73a0345,0x3f02,0x7140306,0x3d6e,0x15c0323,0x3de8,0x680301,0x3e8,0x14c0302,
+0x2e8,0x3720342,0x3f8d,0,0xffffffff,0,0xffffffff,0x8a60301,0x3ec9,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1b60303,
+0x3d7a,0x9350345,0x3f6e,0xd20302,0x1a9,0xa40327,0x26c,0x46c1b35,0x3624,0,0xffffffff,0x4f43099,0x60d2,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x3e80306,0x9a2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x39a0342,0x3fcc,0x41a0308,0x9b4,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6ce0300,0x3fa4,0,
+0xffffffff,0,0xffffffff,0x6590301,0x3cf2,0x8030f,0x400,0x840307,0x260,0x1a00307,0x216,0x246030c,0x3a4,0x2180331,0x3c6a,0x4860338,
+0x4336,0x55f14b0,0x422978,0,0xffffffff,0x1e80327,0x3c52,0x51c3099,0x6174,0,0xffffffff,0x8540301,0x3e6a,0,0xffffffff,0xc0032d,
+0x3c94,0x36a0301,0x75a,0,0xffffffff,0,0xffffffff,0x2e8030c,0x2fc,0x4580d3e,0x1a96,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x5da0300,0x3d82,0x8a60345,0x3f40,0,0xffffffff,0x1f80311,0x416,0,0xffffffff,0x4ae0338,0x44f0,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x1220302,0x1b6,0x4060304,0x9de,0x3c80308,0x9b8,0,0xffffffff,0,0xffffffff,0x5443099,
+0x61f2,0x8f10300,0x3ed7,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0xd2030f,0x418,0,
+0xffffffff,0,0xffffffff,0x26a0307,0x3cb2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x17a030c,0x39c,0x2340300,0x3f2,0x2e0302,0x210,0x1220324,0x3ce4,0x2d40308,
+0x1fe,0x3500300,0x3ff4,0x534309a,0x61ae,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x3440306,0x3fd0,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x55f14bd,0x42297c,0,0xffffffff,0x2980304,0x2d7,0x46a1b35,0x361c,0,0xffffffff,0x4220655,0xc4a,0,
+0xffffffff,0,0xffffffff,0x43809be,0x1396,0x4f23099,0x60ce,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x5b50301,0x3ae,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x3960313,0x3fc8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0xc00303,0x1a2,0x83f0345,
+0x3f3c,0x4840338,0x4334,0x122030f,0x428,0x68f0300,0x3dd6,0,0xffffffff,0,0xffffffff,0x2140302,0x26a,0,0xffffffff,0x51a3099,
+0x6170,0x7cb0342,0x3e4d,0,0xffffffff,0xae030c,0x27a,0x80307,0x44d,0,0xffffffff,0x2460304,0x29b,0,0xffffffff,0x8e10345,
+0x3f4e,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x1aa0323,0x3c1a,0,0xffffffff,0,0xffffffff,0x2880327,
+0x2c6,0,0xffffffff,0x44032d,0x3c30,0,0xffffffff,0x4ac0338,0x44ea,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x30c0314,0x3e13,0,0xffffffff,0,0xffffffff,0x6d70342,0x3fce,0x82a0345,0x3f36,0x5423099,0x61f0,0x1f80309,0x3d92,0,
+0xffffffff,0,0xffffffff,0x2980311,0x42e,0,0xffffffff,0x14c0307,0x3d0c,0,0xffffffff,0x680306,0x23c,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x4300654,0xd80,0x6680309,0x3dbc,0x8cc0345,0x3f48,0,0xffffffff,0x3bc0306,0x9a0,0,0xffffffff,0x1b60308,
+0x1d6,0,0xffffffff,0xd20307,0x45d,0x4480bbe,0x1796,0x4d40338,0x45da,0x6630308,0x3cf6,0x6a10304,0x3da,0x3ee0308,0x8a2,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x17a0304,0x202,0,0xffffffff,0,
+0xffffffff,0x2d40300,0x3de6,0x4681b35,0x3618,0,0xffffffff,0x2f40342,0x3f82,0,0xffffffff,0,0xffffffff,0x1060301,0x2b5,0x89d0300,
+0x3eb6,0x4f03099,0x60ca,0x2220301,0x274,0x84030c,0x39e,0,0xffffffff,0x2460311,0x41e,0x1a0030c,0x21a,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x43c0b56,0x1690,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x3da0304,0x9dc,0x59c0309,0x3da8,0x1060323,0x3cc5,0,0xffffffff,0x2220323,0x3c6f,0x31a0313,0x3e31,0x5183099,0x616c,0,
+0xffffffff,0x440303,0x3d78,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x19a0331,0x3c0e,0x4540d3e,0x1a94,0,0xffffffff,0x72f0300,
+0x3e05,0,0xffffffff,0,0xffffffff,0x84b0300,0x3e64,0,0xffffffff,0x7d60301,0x3e4b,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x4aa0338,0x44e8,0,0xffffffff,0x26a030c,0x2b2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x5403099,0x61ee,0,0xffffffff,0x17a0311,0x406,0,0xffffffff,0x6030301,0x3b0,0x2e0307,0x214,0x38e0301,
+0x798,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x760327,0x3c50,0x2660307,0x3cae,0,0xffffffff,0x42e0654,0xda6,0,
+0xffffffff,0x1f80301,0x1da,0,0xffffffff,0,0xffffffff,0x2980309,0x3dce,0,0xffffffff,0,0xffffffff,0x73a0342,0x3e0f,0x2d00308,
+0x3d1a,0x4d20338,0x45d8,0,0xffffffff,0,0xffffffff,0x530309a,0x61a8,0x6680301,0x3db4,0,0xffffffff,0x2340327,0x28c,0x36a0313,
+0x3e21,0,0xffffffff,0,0xffffffff,0x62b0301,0x3c2e,0x1b60300,0x1d0,0x218030c,0x3d2,0x3b60301,0x7a6,0xf6030f,0x420,0x3ee0300,
+0x8a0,0x4661b35,0x3614,0x5720309,0x3d50,0x7d60345,0x3f22,0x1f80323,0x3d96,0x1e80302,0x24a,0x4ee3099,0x60c4,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x6680323,
+0x3dc4,0x75c0345,0x3f0a,0x16e0302,0x3d20,0x35a0314,0x3e03,0x4140308,0x8ae,0x8030c,0x39a,0x840304,0x254,0x2460309,0x3d9e,0x2c20301,
+0x3d06,0,0xffffffff,0xf60331,0x3cbc,0,0xffffffff,0x76f0301,0x3e19,0x19a0307,0x3c06,0x88b0301,0x3ea8,0x39a0308,0x797,0,
+0xffffffff,0,0xffffffff,0x5163099,0x6168,0x91a0345,0x3f5c,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x59c0301,0x3da0,0x6ef0304,0x3c70,0x8a60342,0x3ecd,0,
+0xffffffff,0,0xffffffff,0x2c20323,0x3d12,0,0xffffffff,0x7470345,0x3f04,0,0xffffffff,0x4a80338,0x44e2,0,0xffffffff,0x3220300,
+0x3f94,0,0xffffffff,0,0xffffffff,0x3c20308,0x802,0x506309a,0x60fa,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x8760301,0x3e8a,0xd2030c,0x3a2,0xa40331,0x3c68,0,0xffffffff,0,0xffffffff,0x6390300,0x3ca2,0x9050345,
+0x3f56,0xa20302,0x268,0x30a030c,0x3de,0x1f80330,0x3c5a,0x3aa0314,0x3ec3,0x42c0654,0xd84,0x17a0309,0x3d46,0,0xffffffff,0x5870301,
+0x3c10,0x76f0345,0x3f10,0,0xffffffff,0x4d00338,0x45d6,0x4440bbe,0x1794,0x30c0304,0x3f72,0x380323,0x3c18,0x8540342,0x3e6e,0,
+0xffffffff,0x3060307,0x3d36,0x5ea0309,0x3daa,0,0xffffffff,0x840311,0x414,0x55f14ba,0x422976,0x2980301,0x1f4,0x70d0302,0x3d58,0,
+0xffffffff,0,0xffffffff,0x55010ba,0x422156,0,0xffffffff,0x1e80331,0x3d2c,0x4641b35,0x3610,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x4ec3099,0x60c0,0x6240300,0x3c28,0,0xffffffff,0,0xffffffff,0x33a0301,0x718,0,0xffffffff,0,
+0xffffffff,0xf60307,0x3cb0,0x16e0331,0x3d28,0x3720300,0x3ee9,0x5720301,0x3d48,0x4120308,0x9da,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0x2980323,0x3dca,0x440308,0x196,0xc00300,0x3f0,0,0xffffffff,0x122030c,0x3a6,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x6e00345,0x3fe8,0,0xffffffff,0,0xffffffff,0x6450307,0x3cca,0x80304,0x200,0x5143099,
+0x6164,0x2460301,0x1e6,0,0xffffffff,0,0xffffffff,0x26a0311,0x426,0,0xffffffff,0x8840300,0x3e96,0x15c0303,0x3df0,0x39a0300,
+0x3ef4,0x47e0301,0x3fbc,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x2e030c,0x218,0,
+0xffffffff,0x2e80301,0x2f4,0,0xffffffff,0x4a60338,0x44e0,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x7200302,
+0x3d8e,0x8b10301,0x3ecb,0x5c00309,0x3d52,0x1f80306,0x25a,0x2460323,0x3d9b,0x53c3099,0x61b8,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x308030c,0x3dc,0x3c20300,0x800,0,0xffffffff,0x7aa0345,
+0x3f1e,0x42a0654,0xc4c,0x86f0300,0x3e84,0,0xffffffff,0xd20304,0x299,0x2e80323,0x3d26,0x280331,0x3c0c,0,0xffffffff,0x4ce0338,
+0x45d4,0,0xffffffff,0,0xffffffff,0x7bd0301,0x3e38,0x1e80307,0x3c46,0x1f80328,0x25e,0x1140327,0x2c4,0x3e80308,0x9a6,0x17a0301,
+0x1c2,0x2980330,0x3cea,0x52c309a,0x61a2,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x214030c,0x3e0,0x16e0307,
+0x2f6,0x92b0345,0x3f84,0x4621b35,0x360c,0,0xffffffff,0x5ea0301,0x3da2,0,0xffffffff,0x80311,0x404,0x840309,0x3d90,0x1b60327,
+0x453,0x4ea3099,0x60bc,0,0xffffffff,0,0xffffffff,0x7950345,0x3f18,0,0xffffffff,0x1aa032d,0x3c26,0x5a70304,0x458,0x8b10345,
+0x3f42,0x2880331,0x3cde,0x4100308,0x9f2,0x17a0323,0x3d43,0,0xffffffff,0,0xffffffff,0x38e0313,0x3e81,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0,0xffffffff,0x298031b,0x361,0x440300,0x190,0x5123099,0x6160,0,0xffffffff,0x1220304,0x2d5,0x5d50301,
+0x3c12,0x4060306,0x8bc,0,0xffffffff,0x6750309,0x3dbe,0x760302,0x248,0x35a0304,0x3f62,0,0xffffffff,0,0xffffffff,0xae0301,
+0x272,0x37e0314,0x3e63,0,0xffffffff,0xd20311,0x41c,0x2be0323,0x3cfe,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4a40338,
+0x44c4,0x4020301,0x8b8,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x502309a,0x60f4,0,0xffffffff,0x7cb0300,0x3e45,0,
+0xffffffff,0,0xffffffff,0x2d4030a,0x3d32,0x6c90345,0x3f88,0x43c0b3e,0x1696,0x280307,0x3c04,0,0xffffffff,0,0xffffffff,0,
+0xffffffff,0,0xffffffff,0x3440308,0x756,0xae0323,0x3c6d,0x5c00301,0x3d4a,0,0xffffffff,0x246031b,0x343,0x2980306,0x2da,0x4280654,
+0xc48,0,0xffffffff,0,0xffffffff,0,0xffffffff,0,0xffffffff,0x4cc0338,0x455e,0x57d0304,0x3bc,0,0xffffffff,0,
+0xffffffff
+};
+
 #endif  // INCLUDED_FROM_NORMALIZER2_CPP
@@ -198,12 +198,36 @@ class DecomposeNormalizer2 : public Normalizer2WithImpl {
         impl.decompose(src, limit, &buffer, errorCode);
     }
     using Normalizer2WithImpl::normalize;  // Avoid warning about hiding base class function.
+
+    void
+    normalizeUTF8(uint32_t options, StringPiece src, ByteSink &sink,
+                  Edits *edits, UErrorCode &errorCode) const U_OVERRIDE {
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        if (edits != nullptr && (options & U_EDITS_NO_RESET) == 0) {
+            edits->reset();
+        }
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(src.data());
+        impl.decomposeUTF8(options, s, s + src.length(), &sink, edits, errorCode);
+        sink.Flush();
+    }
+
     virtual void
     normalizeAndAppend(const UChar *src, const UChar *limit, UBool doNormalize,
                        UnicodeString &safeMiddle,
                        ReorderingBuffer &buffer, UErrorCode &errorCode) const {
         impl.decomposeAndAppend(src, limit, doNormalize, safeMiddle, buffer, errorCode);
     }
+    virtual UBool
+    isNormalizedUTF8(StringPiece sp, UErrorCode &errorCode) const U_OVERRIDE {
+        if(U_FAILURE(errorCode)) {
+            return FALSE;
+        }
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(sp.data());
+        const uint8_t *sLimit = s + sp.length();
+        return sLimit == impl.decomposeUTF8(0, s, sLimit, nullptr, nullptr, errorCode);
+    }
     virtual const UChar *
     spanQuickCheckYes(const UChar *src, const UChar *limit, UErrorCode &errorCode) const {
         return impl.decompose(src, limit, NULL, errorCode);
@@ -220,7 +244,8 @@ class DecomposeNormalizer2 : public Normalizer2WithImpl {
 class ComposeNormalizer2 : public Normalizer2WithImpl {
 public:
     ComposeNormalizer2(const Normalizer2Impl &ni, UBool fcc) :
-        Normalizer2WithImpl(ni), onlyContiguous(fcc) {}
+        Normalizer2WithImpl(ni), onlyContiguous(fcc),
+        hasASCIIMap(ni.getCompASCIIMap(asciiMap)) {}
     virtual ~ComposeNormalizer2();
 
 private:
@@ -241,8 +266,8 @@ class ComposeNormalizer2 : public Normalizer2WithImpl {
             edits->reset();
         }
         const uint8_t *s = reinterpret_cast<const uint8_t *>(src.data());
-        impl.composeUTF8(options, onlyContiguous, s, s + src.length(),
-                         &sink, edits, errorCode);
+        impl.composeUTF8(options, onlyContiguous, hasASCIIMap ? asciiMap : nullptr,
+                         s, s + src.length(), &sink, edits, errorCode);
         sink.Flush();
     }
 
@@ -276,7 +301,8 @@ class ComposeNormalizer2 : public Normalizer2WithImpl {
             return FALSE;
         }
         const uint8_t *s = reinterpret_cast<const uint8_t *>(sp.data());
-        return impl.composeUTF8(0, onlyContiguous, s, s + sp.length(), nullptr, nullptr, errorCode);
+        return impl.composeUTF8(0, onlyContiguous, nullptr,
+                                s, s + sp.length(), nullptr, nullptr, errorCode);
     }
     virtual UNormalizationCheckResult
     quickCheck(const UnicodeString &s, UErrorCode &errorCode) const U_OVERRIDE {
@@ -311,6 +337,12 @@ class ComposeNormalizer2 : public Normalizer2WithImpl {
     }
 
     const UBool onlyContiguous;
+    /**
+     * Composed forms of the ASCII characters, for example lowercase letters for NFKC_Casefold.
+     * Only used if hasASCIIMap.
+     */
+    uint8_t asciiMap[0x80];
+    const UBool hasASCIIMap;
 };
 
 class FCDNormalizer2 : public Normalizer2WithImpl {
@@ -325,12 +357,36 @@ class FCDNormalizer2 : public Normalizer2WithImpl {
         impl.makeFCD(src, limit, &buffer, errorCode);
     }
     using Normalizer2WithImpl::normalize;  // Avoid warning about hiding base class function.
+
+    void
+    normalizeUTF8(uint32_t options, StringPiece src, ByteSink &sink,
+                  Edits *edits, UErrorCode &errorCode) const U_OVERRIDE {
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        if (edits != nullptr && (options & U_EDITS_NO_RESET) == 0) {
+            edits->reset();
+        }
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(src.data());
+        impl.makeFCDUTF8(options, s, s + src.length(), &sink, edits, errorCode);
+        sink.Flush();
+    }
+
     virtual void
     normalizeAndAppend(const UChar *src, const UChar *limit, UBool doNormalize,
                        UnicodeString &safeMiddle,
                        ReorderingBuffer &buffer, UErrorCode &errorCode) const {
         impl.makeFCDAndAppend(src, limit, doNormalize, safeMiddle, buffer, errorCode);
     }
+    virtual UBool
+    isNormalizedUTF8(StringPiece sp, UErrorCode &errorCode) const U_OVERRIDE {
+        if(U_FAILURE(errorCode)) {
+            return FALSE;
+        }
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(sp.data());
+        const uint8_t *sLimit = s + sp.length();
+        return sLimit == impl.makeFCDUTF8(0, s, sLimit, nullptr, nullptr, errorCode);
+    }
     virtual const UChar *
     spanQuickCheckYes(const UChar *src, const UChar *limit, UErrorCode &errorCode) const {
         return impl.makeFCD(src, limit, NULL, errorCode);
@@ -239,7 +239,8 @@ Norm2AllModes::createNFCInstance(UErrorCode &errorCode) {
         return NULL;
     }
     impl->init(norm2_nfc_data_indexes, &norm2_nfc_data_trie,
-               norm2_nfc_data_extraData, norm2_nfc_data_smallFCD);
+               norm2_nfc_data_extraData, norm2_nfc_data_smallFCD,
+               norm2_nfc_data_compositionsHash);
     return createInstance(impl, errorCode);
 }
 
@@ -0,0 +1,281 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// normalizer2batch.cpp
+// created: 2018oct17
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/bytestream.h"
+#include "unicode/normalizer2.h"
+#include "unicode/stringpiece.h"
+#include "unicode/unistr.h"
+#include "unicode/unorm2.h"
+#include "bytesinkutil.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "uparallel.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * A batch is only split across threads if each thread gets at least this many strings.
+ * Starting a thread costs about as much as normalizing a few hundred short strings.
+ */
+constexpr int32_t MIN_STRINGS_PER_THREAD = 256;
+
+/** Forwards to another ByteSink and counts the appended bytes. */
+class CountingByteSink : public ByteSink {
+public:
+    CountingByteSink(ByteSink &s) : sink(s), length(0) {}
+    virtual ~CountingByteSink();
+
+    virtual void Append(const char *bytes, int32_t n) U_OVERRIDE {
+        sink.Append(bytes, n);
+        length += n;
+    }
+    virtual char *GetAppendBuffer(int32_t min_capacity,
+                                  int32_t desired_capacity_hint,
+                                  char *scratch, int32_t scratch_capacity,
+                                  int32_t *result_capacity) U_OVERRIDE {
+        return sink.GetAppendBuffer(min_capacity, desired_capacity_hint,
+                                    scratch, scratch_capacity, result_capacity);
+    }
+    virtual void Flush() U_OVERRIDE { sink.Flush(); }
+
+    int32_t getLength() const { return length; }
+
+private:
+    ByteSink &sink;
+    int32_t length;
+};
+
+CountingByteSink::~CountingByteSink() {}
+
+/** Output of one chunk of a batch other than the first. */
+struct BatchChunk : public UMemory {
+    CharString output;
+    int32_t length = 0;
+};
+
+/**
+ * Normalizes stringAt(i) for i in [start, limit[ and appends the results to the sink.
+ * Sets offsets[i] (if not NULL) relative to the start of this range's output.
+ * @return the length of this range's output
+ */
+template<typename StringAt>
+int32_t normalizeUTF8Range(const Normalizer2 &n2, const StringAt &stringAt,
+                           int32_t start, int32_t limit,
+                           ByteSink &sink, int32_t *offsets, UErrorCode &errorCode) {
+    CountingByteSink counter(sink);
+    for (int32_t i = start; i < limit && U_SUCCESS(errorCode); ++i) {
+        if (offsets != nullptr) {
+            offsets[i] = counter.getLength();
+        }
+        n2.normalizeUTF8(0, stringAt(i), counter, nullptr, errorCode);
+    }
+    return counter.getLength();
+}
+
+template<typename StringAt>
+int32_t normalizeUTF8Strings(const Normalizer2 &n2, const StringAt &stringAt, int32_t count,
+                             ByteSink &sink, int32_t *offsets,
+                             int32_t numThreads, UErrorCode &errorCode) {
+    int32_t numChunks = getNumParallelChunks(count, numThreads, MIN_STRINGS_PER_THREAD);
+    int32_t length;
+    if (numChunks == 1) {
+        length = normalizeUTF8Range(n2, stringAt, 0, count, sink, offsets, errorCode);
+    } else {
+        LocalArray<BatchChunk> chunks(new BatchChunk[numChunks], errorCode);
+        if (U_FAILURE(errorCode)) {
+            return 0;
+        }
+        // Only the calling thread writes to the caller's sink.
+        // The other threads normalize into their own buffers which are appended afterwards.
+        BatchChunk *chunksArray = chunks.getAlias();
+        auto rangeFn = [&n2, &stringAt, &sink, offsets, chunksArray](
+                int32_t i, int32_t start, int32_t limit, UErrorCode &ec) {
+            BatchChunk &chunk = chunksArray[i];
+            if (i == 0) {
+                chunk.length = normalizeUTF8Range(n2, stringAt, start, limit, sink, offsets, ec);
+            } else {
+                CharStringByteSink chunkSink(&chunk.output);
+                chunk.length = normalizeUTF8Range(n2, stringAt, start, limit,
+                                                  chunkSink, offsets, ec);
+            }
+        };
+        runInChunks(count, numThreads, MIN_STRINGS_PER_THREAD, rangeFn, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return 0;
+        }
+        length = chunks[0].length;
+        for (int32_t i = 1; i < numChunks; ++i) {
+            BatchChunk &chunk = chunks[i];
+            if (chunk.output.length() != chunk.length) {
+                // CharStringByteSink ignores allocation failures.
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return 0;
+            }
+            if (offsets != nullptr) {
+                int32_t limit = getParallelChunkStart(count, i + 1, numChunks);
+                for (int32_t j = getParallelChunkStart(count, i, numChunks); j < limit; ++j) {
+                    offsets[j] += length;
+                }
+            }
+            sink.Append(chunk.output.data(), chunk.length);
+            length += chunk.length;
+        }
+    }
+    if (U_SUCCESS(errorCode) && offsets != nullptr) {
+        offsets[count] = length;
+    }
+    return length;
+}
+
+/** Calls checkAt(i, errorCode) for i in [0, count[, which stores the i-th result. */
+template<typename CheckAt>
+void checkBatch(int32_t count, const CheckAt &checkAt,
+                int32_t numThreads, UErrorCode &errorCode) {
+    auto rangeFn = [&checkAt](int32_t /* chunkIndex */, int32_t start, int32_t limit,
+                              UErrorCode &ec) {
+        for (int32_t i = start; i < limit && U_SUCCESS(ec); ++i) {
+            checkAt(i, ec);
+        }
+    };
+    runInChunks(count, numThreads, MIN_STRINGS_PER_THREAD, rangeFn, errorCode);
+}
+
+}  // namespace
+
+void
+Normalizer2::normalizeUTF8Batch(const StringPiece *src, int32_t count,
+                                ByteSink &sink, int32_t *offsets,
+                                int32_t numThreads, UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (count < 0 || (src == nullptr && count != 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    auto stringAt = [src](int32_t i) { return src[i]; };
+    normalizeUTF8Strings(*this, stringAt, count, sink, offsets,
+                         numThreads, errorCode);
+}
+
+void
+Normalizer2::quickCheckBatch(const UnicodeString *src, int32_t count,
+                             UNormalizationCheckResult *results,
+                             int32_t numThreads, UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (count < 0 || ((src == nullptr || results == nullptr) && count != 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    auto checkAt = [this, src, results](int32_t i, UErrorCode &ec) {
+        results[i] = quickCheck(src[i], ec);
+    };
+    checkBatch(count, checkAt, numThreads, errorCode);
+}
+
+void
+Normalizer2::isNormalizedUTF8Batch(const StringPiece *src, int32_t count,
+                                   UBool *results,
+                                   int32_t numThreads, UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (count < 0 || ((src == nullptr || results == nullptr) && count != 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    auto checkAt = [this, src, results](int32_t i, UErrorCode &ec) {
+        results[i] = isNormalizedUTF8(src[i], ec);
+    };
+    checkBatch(count, checkAt, numThreads, errorCode);
+}
+
+U_NAMESPACE_END
+
+// C API ------------------------------------------------------------------- ***
+
+U_NAMESPACE_USE
+
+namespace {
+
+/**
+ * Checks the arrays of source strings and their lengths
+ * as passed into the C batch functions.
+ */
+template<typename Char>
+UBool areValidBatchStrings(const Char *const *src, const int32_t *lengths, int32_t count) {
+    if (count < 0 || (src == nullptr && count != 0)) {
+        return FALSE;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        int32_t length = lengths == nullptr ? -1 : lengths[i];
+        if ((src[i] == nullptr && length != 0) || length < -1) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+}  // namespace
+
+U_CAPI int32_t U_EXPORT2
+unorm2_normalizeUTF8Batch(const UNormalizer2 *norm2,
+                          const char *const *src, const int32_t *lengths, int32_t count,
+                          char *dest, int32_t capacity, int32_t *destOffsets,
+                          int32_t numThreads, UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if (!areValidBatchStrings(src, lengths, count) ||
+            (dest == nullptr ? capacity != 0 : capacity < 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    auto stringAt = [src, lengths](int32_t i) {
+        int32_t length = lengths == nullptr ? -1 : lengths[i];
+        return length < 0 ?
+            StringPiece(src[i]) : StringPiece(src[i], length);
+    };
+    CheckedArrayByteSink sink(dest, capacity);
+    int32_t length = normalizeUTF8Strings(*reinterpret_cast<const Normalizer2 *>(norm2),
+                                          stringAt, count, sink, destOffsets,
+                                          numThreads, *pErrorCode);
+    if (U_SUCCESS(*pErrorCode) && sink.Overflowed()) {
+        *pErrorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return length;
+}
+
+U_CAPI void U_EXPORT2
+unorm2_quickCheckBatch(const UNormalizer2 *norm2,
+                       const UChar *const *src, const int32_t *lengths, int32_t count,
+                       UNormalizationCheckResult *results,
+                       int32_t numThreads, UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if (!areValidBatchStrings(src, lengths, count) || (results == nullptr && count != 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const Normalizer2 *n2 = reinterpret_cast<const Normalizer2 *>(norm2);
+    auto checkAt = [n2, src, lengths, results](int32_t i, UErrorCode &ec) {
+        int32_t length = lengths == nullptr ? -1 : lengths[i];
+        UnicodeString s(length < 0, src[i], length);
+        results[i] = n2->quickCheck(s, ec);
+    };
+    checkBatch(count, checkAt, numThreads, *pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_NORMALIZATION
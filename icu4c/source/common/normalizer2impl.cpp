@@ -37,6 +37,7 @@
 #include "mutex.h"
 #include "normalizer2impl.h"
 #include "putilimp.h"
+#include "simdutil.h"
 #include "uassert.h"
 #include "ucptrie_impl.h"
 #include "uset_imp.h"
@@ -165,6 +166,48 @@ appendCodePointDelta(const uint8_t *cpStart, const uint8_t *cpLimit, int32_t del
     sink.Append(buffer, length);
 }
 
+/**
+ * Appends the ASCII characters in [src, limit[ mapped via asciiMap.
+ */
+void mapASCII(const uint8_t asciiMap[0x80], uint32_t options,
+              const uint8_t *src, const uint8_t *limit,
+              ByteSink &sink, Edits *edits, UErrorCode &errorCode) {
+    if (edits == nullptr && (options & U_OMIT_UNCHANGED_TEXT) == 0) {
+        // Map directly into the sink's buffer where possible.
+        char scratch[256];
+        while (src != limit) {
+            int32_t length = (int32_t)(limit - src);
+            int32_t capacity;
+            char *buffer = sink.GetAppendBuffer(1, length, scratch, UPRV_LENGTHOF(scratch), &capacity);
+            if (capacity > length) {
+                capacity = length;
+            }
+            for (int32_t i = 0; i < capacity; ++i) {
+                buffer[i] = (char)asciiMap[src[i]];
+            }
+            sink.Append(buffer, capacity);
+            src += capacity;
+        }
+        return;
+    }
+    const uint8_t *prevUnchanged = src;
+    for (; src != limit; ++src) {
+        uint8_t c = asciiMap[*src];
+        if (c != *src) {
+            if (prevUnchanged != src &&
+                    !ByteSinkUtil::appendUnchanged(prevUnchanged, src,
+                                                   sink, options, edits, errorCode)) {
+                return;
+            }
+            ByteSinkUtil::appendCodePoint(1, c, sink, edits);
+            prevUnchanged = src + 1;
+        }
+    }
+    if (prevUnchanged != limit) {
+        ByteSinkUtil::appendUnchanged(prevUnchanged, limit, sink, options, edits, errorCode);
+    }
+}
+
 }  // namespace
 
 // ReorderingBuffer -------------------------------------------------------- ***
@@ -429,7 +472,8 @@ Normalizer2Impl::~Normalizer2Impl() {
 
 void
 Normalizer2Impl::init(const int32_t *inIndexes, const UCPTrie *inTrie,
-                      const uint16_t *inExtraData, const uint8_t *inSmallFCD) {
+                      const uint16_t *inExtraData, const uint8_t *inSmallFCD,
+                      const uint32_t *inCompositionsHash) {
     minDecompNoCP = static_cast<UChar>(inIndexes[IX_MIN_DECOMP_NO_CP]);
     minCompNoMaybeCP = static_cast<UChar>(inIndexes[IX_MIN_COMP_NO_MAYBE_CP]);
     minLcccCP = static_cast<UChar>(inIndexes[IX_MIN_LCCC_CP]);
@@ -451,6 +495,35 @@ Normalizer2Impl::init(const int32_t *inIndexes, const UCPTrie *inTrie,
     extraData=maybeYesCompositions+((MIN_NORMAL_MAYBE_YES-minMaybeYes)>>OFFSET_SHIFT);
 
     smallFCD=inSmallFCD;
+
+    // compositionsHash: new in formatVersion 4.1, optional
+    int32_t hashLength=
+        (inIndexes[IX_COMPOSITIONS_HASH_OFFSET+1]-inIndexes[IX_COMPOSITIONS_HASH_OFFSET])/4;
+    if(inCompositionsHash!=NULL && hashLength>1 &&
+            0<inCompositionsHash[0] && inCompositionsHash[0]<=COMP_HASH_MAX_BITS &&
+            hashLength==1+(2<<inCompositionsHash[0]) &&
+            hasEmptyCompositionsHashSlot(inCompositionsHash+1, hashLength-1)) {
+        compositionsHash=inCompositionsHash+1;
+        compositionsHashMask=((uint32_t)1<<inCompositionsHash[0])-1;
+        compositionsHashShift=32-(int32_t)inCompositionsHash[0];
+    } else {
+        compositionsHash=NULL;
+        compositionsHashMask=0;
+        compositionsHashShift=0;
+    }
+}
+
+/*
+ * A lookup for a missing pair stops at an empty slot.
+ * Data without any empty slot is corrupt, and then the compositions lists are used instead.
+ */
+UBool Normalizer2Impl::hasEmptyCompositionsHashSlot(const uint32_t *hash, int32_t length) {
+    for(int32_t i=1; i<length; i+=2) {
+        if(hash[i]==0xffffffff) {
+            return TRUE;
+        }
+    }
+    return FALSE;
 }
 
 U_CDECL_BEGIN
@@ -606,7 +679,10 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
 
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
-        for(prevSrc=src; src!=limit;) {
+        prevSrc=src;
+        // skip whole blocks of code units below the minimum
+        src=SIMDUtil::skipBelow(src, limit, (UChar)minNoCP);
+        while(src!=limit) {
             if( (c=*src)<minNoCP ||
                 isMostDecompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))
             ) {
@@ -734,7 +810,7 @@ UBool Normalizer2Impl::decompose(UChar32 c, uint16_t norm16,
 
 const uint8_t *
 Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
-                                UBool stopAtCompBoundary, UBool onlyContiguous,
+                                StopAt stopAt, UBool onlyContiguous,
                                 ReorderingBuffer &buffer, UErrorCode &errorCode) const {
     if (U_FAILURE(errorCode)) {
         return nullptr;
@@ -747,21 +823,28 @@ Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
         UChar32 c = U_SENTINEL;
         if (norm16 >= limitNoNo) {
             if (isMaybeOrNonZeroCC(norm16)) {
-                // No boundaries around this character.
+                // No comp boundaries around this character.
+                uint8_t cc = getCCFromYesOrMaybe(norm16);
+                if (cc == 0 && stopAt == STOP_AT_DECOMP_BOUNDARY) {
+                    return prevSrc;
+                }
                 c = codePointFromValidUTF8(prevSrc, src);
-                if (!buffer.append(c, getCCFromYesOrMaybe(norm16), errorCode)) {
+                if (!buffer.append(c, cc, errorCode)) {
                     return nullptr;
                 }
+                if (stopAt == STOP_AT_DECOMP_BOUNDARY && buffer.getLastCC() <= 1) {
+                    return src;
+                }
                 continue;
             }
             // Maps to an isCompYesAndZeroCC.
-            if (stopAtCompBoundary) {
+            if (stopAt != STOP_AT_LIMIT) {
                 return prevSrc;
             }
             c = codePointFromValidUTF8(prevSrc, src);
             c = mapAlgorithmic(c, norm16);
             norm16 = getRawNorm16(c);
-        } else if (stopAtCompBoundary && norm16 < minNoNoCompNoMaybeCC) {
+        } else if (stopAt != STOP_AT_LIMIT && norm16 < minNoNoCompNoMaybeCC) {
             return prevSrc;
         }
         // norm16!=INERT guarantees that [prevSrc, src[ is valid UTF-8.
@@ -799,17 +882,142 @@ Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
             } else {
                 leadCC = 0;
             }
+            if (leadCC == 0 && stopAt == STOP_AT_DECOMP_BOUNDARY) {
+                return prevSrc;
+            }
             if (!buffer.append((const char16_t *)mapping+1, length, TRUE, leadCC, trailCC, errorCode)) {
                 return nullptr;
             }
         }
-        if (stopAtCompBoundary && norm16HasCompBoundaryAfter(norm16, onlyContiguous)) {
+        if ((stopAt == STOP_AT_COMP_BOUNDARY && norm16HasCompBoundaryAfter(norm16, onlyContiguous)) ||
+                (stopAt == STOP_AT_DECOMP_BOUNDARY && buffer.getLastCC() <= 1)) {
             return src;
         }
     }
     return src;
 }
 
+// Very similar to composeUTF8(): Make the same changes in both places if relevant.
+// sink!=nullptr: normalize
+// sink==nullptr: isNormalized/spanQuickCheckYes
+const uint8_t *
+Normalizer2Impl::decomposeUTF8(uint32_t options,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, Edits *edits, UErrorCode &errorCode) const {
+    U_ASSERT(limit != nullptr);
+    UnicodeString s16;
+    uint8_t minNoLead = leadByteForCP(minDecompNoCP);
+    const uint8_t *prevBoundary = src;
+    // only for quick check
+    uint8_t prevCC = 0;
+
+    for (;;) {
+        // Fast path: Scan over a sequence of characters below the minimum "no" code point,
+        // or with (decompYes && ccc==0) properties.
+        const uint8_t *fastStart = src;
+        const uint8_t *prevSrc;
+        uint16_t norm16 = 0;
+        src = SIMDUtil::skipBelow(src, limit, minNoLead);
+        for (;;) {
+            if (src == limit) {
+                if (prevBoundary != limit && sink != nullptr) {
+                    ByteSinkUtil::appendUnchanged(prevBoundary, limit,
+                                                  *sink, options, edits, errorCode);
+                }
+                return src;
+            }
+            if (*src < minNoLead) {
+                ++src;
+            } else {
+                prevSrc = src;
+                UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, src, limit, norm16);
+                if (!isMostDecompYesAndZeroCC(norm16)) {
+                    break;
+                }
+            }
+        }
+        // isMostDecompYesAndZeroCC(norm16) is false, that is, norm16>=minYesNo,
+        // and the current character at [prevSrc..src[ is not a common case with cc=0
+        // (MIN_NORMAL_MAYBE_YES or JAMO_VT).
+        // It could still be a maybeYes with cc=0.
+        if (prevSrc != fastStart) {
+            // The fast path looped over yes/0 characters before the current one.
+            if (sink != nullptr &&
+                    !ByteSinkUtil::appendUnchanged(prevBoundary, prevSrc,
+                                                   *sink, options, edits, errorCode)) {
+                break;
+            }
+            prevBoundary = prevSrc;
+            prevCC = 0;
+        }
+
+        // Medium-fast path: Quick check.
+        if (isMaybeOrNonZeroCC(norm16)) {
+            // Does not decompose.
+            uint8_t cc = getCCFromYesOrMaybe(norm16);
+            if (prevCC <= cc || cc == 0) {
+                prevCC = cc;
+                if (cc <= 1) {
+                    if (sink != nullptr &&
+                            !ByteSinkUtil::appendUnchanged(prevBoundary, src,
+                                                           *sink, options, edits, errorCode)) {
+                        break;
+                    }
+                    prevBoundary = src;
+                }
+                continue;
+            }
+        }
+        if (sink == nullptr) {
+            return prevBoundary;  // quick check: "no" or cc out of order
+        }
+
+        // Slow path
+        // Decompose up to and including the current character.
+        if (prevBoundary != prevSrc && norm16HasDecompBoundaryBefore(norm16)) {
+            if (!ByteSinkUtil::appendUnchanged(prevBoundary, prevSrc,
+                                               *sink, options, edits, errorCode)) {
+                break;
+            }
+            prevBoundary = prevSrc;
+        }
+        ReorderingBuffer buffer(*this, s16, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        decomposeShort(prevBoundary, src, STOP_AT_LIMIT, FALSE /* onlyContiguous */,
+                       buffer, errorCode);
+        // Decompose until the next boundary.
+        if (buffer.getLastCC() > 1) {
+            src = decomposeShort(src, limit, STOP_AT_DECOMP_BOUNDARY, FALSE /* onlyContiguous */,
+                                 buffer, errorCode);
+        }
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        if ((src - prevBoundary) > INT32_MAX) {  // guard before buffer.equals()
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            break;
+        }
+        // We already know there was a change if the original character decomposed;
+        // otherwise compare.
+        if (isMaybeOrNonZeroCC(norm16) && buffer.equals(prevBoundary, src)) {
+            if (!ByteSinkUtil::appendUnchanged(prevBoundary, src,
+                                               *sink, options, edits, errorCode)) {
+                break;
+            }
+        } else {
+            if (!ByteSinkUtil::appendChange(prevBoundary, src, buffer.getStart(), buffer.length(),
+                                            *sink, edits, errorCode)) {
+                break;
+            }
+        }
+        prevBoundary = src;
+        prevCC = 0;
+    }
+    return src;
+}
+
 const UChar *
 Normalizer2Impl::getDecomposition(UChar32 c, UChar buffer[4], int32_t &length) const {
     uint16_t norm16;
@@ -998,11 +1206,12 @@ UBool Normalizer2Impl::norm16HasDecompBoundaryAfter(uint16_t norm16) const {
  *
  * The list is sorted by ascending trail characters (there are no duplicates).
  * A linear search is used.
+ * combine() uses the compositionsHash instead if the data has one.
  *
  * See normalizer2impl.h for a more detailed description
  * of the compositions list format.
  */
-int32_t Normalizer2Impl::combine(const uint16_t *list, UChar32 trail) {
+int32_t Normalizer2Impl::combineFromList(const uint16_t *list, UChar32 trail) {
     uint16_t key1, firstUnit;
     if(trail<COMP_1_TRAIL_LIMIT) {
         // trail character is 0..33FF
@@ -1049,6 +1258,28 @@ int32_t Normalizer2Impl::combine(const uint16_t *list, UChar32 trail) {
     return -1;
 }
 
+/*
+ * Same as combineFromList() but with a lookup in the compositionsHash.
+ * The list pointer must point to the start of a compositions list.
+ */
+int32_t Normalizer2Impl::combineFromHash(const uint16_t *list, UChar32 trail) const {
+    uint32_t key=((uint32_t)(list-maybeYesCompositions)<<16)|(uint32_t)(trail&0xffff);
+    uint32_t trailHigh=(uint32_t)(trail>>16)<<COMP_HASH_TRAIL_HIGH_SHIFT;
+    uint32_t i=compositionsHashSlot(key, compositionsHashShift);
+    // init() checks for an empty slot; still visit each slot at most once.
+    for(uint32_t count=0; count<=compositionsHashMask; ++count) {
+        const uint32_t *entry=compositionsHash+2*i;
+        uint32_t value=entry[1];
+        if(value==0xffffffff) {
+            break;  // empty slot
+        } else if(entry[0]==key && (value&~COMP_HASH_VALUE_MASK)==trailHigh) {
+            return (int32_t)(value&COMP_HASH_VALUE_MASK);
+        }
+        i=(i+1)&compositionsHashMask;
+    }
+    return -1;
+}
+
 /**
   * @param list some character's compositions list
   * @param set recursively receives the composites from these compositions
@@ -1333,6 +1564,7 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
         const UChar *prevSrc;
         UChar32 c = 0;
         uint16_t norm16 = 0;
+        src = SIMDUtil::skipBelow(src, limit, (UChar)minNoMaybeCP);
         for (;;) {
             if (src == limit) {
                 if (prevBoundary != limit && doCompose) {
@@ -1597,6 +1829,7 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
         const UChar *prevSrc;
         UChar32 c = 0;
         uint16_t norm16 = 0;
+        src = SIMDUtil::skipBelow(src, limit, (UChar)minNoMaybeCP);
         for (;;) {
             if(src==limit) {
                 return src;
@@ -1731,7 +1964,7 @@ void Normalizer2Impl::composeAndAppend(const UChar *src, const UChar *limit,
 }
 
 UBool
-Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
+Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous, const uint8_t *asciiMap,
                              const uint8_t *src, const uint8_t *limit,
                              ByteSink *sink, Edits *edits, UErrorCode &errorCode) const {
     U_ASSERT(limit != nullptr);
@@ -1744,6 +1977,7 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
         // or with (compYes && ccc==0) properties.
         const uint8_t *prevSrc;
         uint16_t norm16 = 0;
+        src = SIMDUtil::skipBelow(src, limit, minNoMaybeLead);
         for (;;) {
             if (src == limit) {
                 if (prevBoundary != limit && sink != nullptr) {
@@ -1754,12 +1988,40 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
             }
             if (*src < minNoMaybeLead) {
                 ++src;
-            } else {
-                prevSrc = src;
-                UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, src, limit, norm16);
-                if (!isCompYesAndZeroCC(norm16)) {
-                    break;
+                continue;
+            }
+            if (asciiMap != nullptr && U8_IS_SINGLE(*src) && sink != nullptr) {
+                uint8_t b = *src;
+                if (asciiMap[b] == b) {
+                    ++src;
+                    continue;
+                }
+                // Map the run of ASCII characters starting with this changed one.
+                // They have boundaries before them and do not combine with each other,
+                // but the last one before non-ASCII text might combine with what follows:
+                // Leave that one for the normal code.
+                const uint8_t *runLimit = src + 1;
+                while (runLimit != limit && U8_IS_SINGLE(*runLimit)) {
+                    ++runLimit;
+                }
+                if (runLimit != limit) {
+                    --runLimit;
                 }
+                if (runLimit != src) {
+                    if (prevBoundary != src &&
+                            !ByteSinkUtil::appendUnchanged(prevBoundary, src,
+                                                           *sink, options, edits, errorCode)) {
+                        return TRUE;
+                    }
+                    mapASCII(asciiMap, options, src, runLimit, *sink, edits, errorCode);
+                    prevBoundary = src = runLimit;
+                    continue;
+                }
+            }
+            prevSrc = src;
+            UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, src, limit, norm16);
+            if (!isCompYesAndZeroCC(norm16)) {
+                break;
             }
         }
         // isCompYesAndZeroCC(norm16) is false, that is, norm16>=minNoNo.
@@ -1955,10 +2217,10 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
             break;
         }
         // We know there is not a boundary here.
-        decomposeShort(prevSrc, src, FALSE /* !stopAtCompBoundary */, onlyContiguous,
+        decomposeShort(prevSrc, src, STOP_AT_LIMIT, onlyContiguous,
                        buffer, errorCode);
         // Decompose until the next boundary.
-        src = decomposeShort(src, limit, TRUE /* stopAtCompBoundary */, onlyContiguous,
+        src = decomposeShort(src, limit, STOP_AT_COMP_BOUNDARY, onlyContiguous,
                              buffer, errorCode);
         if (U_FAILURE(errorCode)) {
             break;
@@ -1987,6 +2249,27 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
     return TRUE;
 }
 
+UBool
+Normalizer2Impl::getCompASCIIMap(uint8_t asciiMap[0x80]) const {
+    UBool someChange = FALSE;
+    for (UChar32 c = 0; c < 0x80; ++c) {
+        uint16_t norm16 = getNorm16(c);
+        UChar32 mapped = c;
+        if (!isCompYesAndZeroCC(norm16)) {
+            if (isMaybeOrNonZeroCC(norm16) || !isDecompNoAlgorithmic(norm16)) {
+                return FALSE;
+            }
+            mapped = mapAlgorithmic(c, norm16);
+            if (mapped < 0 || 0x80 <= mapped || !isCompYesAndZeroCC(getNorm16(mapped))) {
+                return FALSE;
+            }
+            someChange = TRUE;
+        }
+        asciiMap[c] = (uint8_t)mapped;
+    }
+    return someChange;
+}
+
 UBool Normalizer2Impl::hasCompBoundaryBefore(const UChar *src, const UChar *limit) const {
     if (src == limit || *src < minCompNoMaybeCP) {
         return TRUE;
@@ -2163,7 +2446,13 @@ Normalizer2Impl::makeFCD(const UChar *src, const UChar *limit,
 
     for(;;) {
         // count code units with lccc==0
-        for(prevSrc=src; src!=limit;) {
+        prevSrc=src;
+        // skip whole blocks of code units below minLcccCP
+        src=SIMDUtil::skipBelow(src, limit, minLcccCP);
+        if(src!=prevSrc) {
+            prevFCD16=~*(src-1);
+        }
+        while(src!=limit) {
             if((c=*src)<minLcccCP) {
                 prevFCD16=~c;
                 ++src;
@@ -2300,6 +2589,123 @@ void Normalizer2Impl::makeFCDAndAppend(const UChar *src, const UChar *limit,
     }
 }
 
+// Very similar to makeFCD(): Make the same changes in both places if relevant.
+// sink!=nullptr: normalize
+// sink==nullptr: isNormalized/spanQuickCheckYes
+const uint8_t *
+Normalizer2Impl::makeFCDUTF8(uint32_t options,
+                             const uint8_t *src, const uint8_t *limit,
+                             ByteSink *sink, Edits *edits, UErrorCode &errorCode) const {
+    U_ASSERT(limit != nullptr);
+    UnicodeString s16;
+    uint8_t minLcccLead = leadByteForCP(minLcccCP);
+    // Tracks the last FCD-safe boundary, before lccc=0 or after properly-ordered tccc<=1.
+    const uint8_t *prevBoundary = src;
+    // Start of the text that has not yet been written to the sink.
+    // Unchanged text is appended lazily, when a change is needed or at the end.
+    const uint8_t *unwritten = src;
+    int32_t prevFCD16 = 0;
+
+    for (;;) {
+        // count code points with lccc==0
+        const uint8_t *runStart = src;
+        const uint8_t *prevSrc = src;  // start of the last looked-up character with lccc==0
+        const uint8_t *cpStart = src;
+        uint16_t fcd16 = 0;
+        src = SIMDUtil::skipBelow(src, limit, minLcccLead);
+        // TRUE if the fcd16 of the character before src was not fetched.
+        UBool deferred = src != runStart;
+        for (;;) {
+            if (src == limit) {
+                if (unwritten != limit && sink != nullptr) {
+                    ByteSinkUtil::appendUnchanged(unwritten, limit,
+                                                  *sink, options, edits, errorCode);
+                }
+                return src;
+            }
+            if (*src < minLcccLead) {
+                ++src;
+                deferred = TRUE;
+            } else {
+                cpStart = src;
+                UChar32 c;
+                int32_t i = 0;
+                int32_t length = (limit - src) >= 4 ? 4 : (int32_t)(limit - src);
+                U8_NEXT(src, i, length, c);
+                src += i;
+                // Ill-formed sequences are inert.
+                fcd16 = c < 0 ? 0 : getFCD16(c);
+                if (fcd16 > 0xff) {
+                    break;
+                }
+                prevSrc = cpStart;
+                prevFCD16 = fcd16;
+                deferred = FALSE;
+            }
+        }
+        // The current character at [cpStart..src[ has a non-zero lead combining class.
+        if (cpStart != runStart) {
+            // The previous character has lccc==0, so there is a boundary before it.
+            if (deferred) {
+                // Fetching the fcd16 value was deferred for this below-minLcccLead character.
+                int32_t i = (int32_t)(cpStart - runStart);
+                UChar32 prev;
+                U8_PREV(runStart, 0, i, prev);
+                prevSrc = runStart + i;
+                prevFCD16 = prev < 0 ? 0 : getFCD16(prev);
+            }
+            prevBoundary = prevFCD16 > 1 ? prevSrc : cpStart;
+        }
+
+        // Check for proper order, and decompose locally if necessary.
+        if ((prevFCD16 & 0xff) <= (fcd16 >> 8)) {
+            // proper order: prev tccc <= current lccc
+            if ((fcd16 & 0xff) <= 1) {
+                prevBoundary = src;
+            }
+            prevFCD16 = fcd16;
+            continue;
+        } else if (sink == nullptr) {
+            return prevBoundary;  // quick check "no"
+        }
+        if (unwritten != prevBoundary &&
+                !ByteSinkUtil::appendUnchanged(unwritten, prevBoundary,
+                                               *sink, options, edits, errorCode)) {
+            break;
+        }
+        // Find the part of the source that needs to be decomposed,
+        // up to the next safe boundary.
+        src = findNextFCDBoundary(src, limit);
+        if ((src - prevBoundary) > INT32_MAX) {  // guard before buffer.equals()
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            break;
+        }
+        // The source text does not fulfill the conditions for FCD.
+        // Decompose and reorder a limited piece of the text.
+        ReorderingBuffer buffer(*this, s16, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        decomposeShort(prevBoundary, src, STOP_AT_LIMIT, FALSE /* onlyContiguous */,
+                       buffer, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        if (buffer.equals(prevBoundary, src)) {
+            if (!ByteSinkUtil::appendUnchanged(prevBoundary, src,
+                                               *sink, options, edits, errorCode)) {
+                break;
+            }
+        } else if (!ByteSinkUtil::appendChange(prevBoundary, src, buffer.getStart(), buffer.length(),
+                                               *sink, edits, errorCode)) {
+            break;
+        }
+        unwritten = prevBoundary = src;
+        prevFCD16 = 0;
+    }
+    return src;
+}
+
 const UChar *Normalizer2Impl::findPreviousFCDBoundary(const UChar *start, const UChar *p) const {
     while(start<p) {
         const UChar *codePointLimit = p;
@@ -2332,6 +2738,21 @@ const UChar *Normalizer2Impl::findNextFCDBoundary(const UChar *p, const UChar *l
     return p;
 }
 
+const uint8_t *Normalizer2Impl::findNextFCDBoundary(const uint8_t *p, const uint8_t *limit) const {
+    while (p < limit) {
+        const uint8_t *codePointStart = p;
+        uint16_t norm16;
+        UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, p, limit, norm16);
+        if (norm16HasDecompBoundaryBefore(norm16)) {
+            return codePointStart;
+        }
+        if (norm16HasDecompBoundaryAfter(norm16)) {
+            return p;
+        }
+    }
+    return p;
+}
+
 // CanonicalIterator data -------------------------------------------------- ***
 
 CanonIterData::CanonIterData(UErrorCode &errorCode) :
@@ -2651,6 +3072,11 @@ unorm2_swap(const UDataSwapper *ds,
         nextOffset=indexes[Normalizer2Impl::IX_SMALL_FCD_OFFSET+1];
         offset=nextOffset;
 
+        /* swap the optional uint32_t compositionsHash[] (new in formatVersion 4.1) */
+        nextOffset=indexes[Normalizer2Impl::IX_COMPOSITIONS_HASH_OFFSET+1];
+        ds->swapArray32(ds, inBytes+offset, nextOffset-offset, outBytes+offset, pErrorCode);
+        offset=nextOffset;
+
         U_ASSERT(offset==size);
     }
 
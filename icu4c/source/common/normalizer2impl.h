@@ -251,7 +251,8 @@ class U_COMMON_API Normalizer2Impl : public UObject {
     virtual ~Normalizer2Impl();
 
     void init(const int32_t *inIndexes, const UCPTrie *inTrie,
-              const uint16_t *inExtraData, const uint8_t *inSmallFCD);
+              const uint16_t *inExtraData, const uint8_t *inSmallFCD,
+              const uint32_t *inCompositionsHash=NULL);
 
     void addLcccChars(UnicodeSet &set) const;
     void addPropertyStarts(const USetAdder *sa, UErrorCode &errorCode) const;
@@ -422,7 +423,7 @@ class U_COMMON_API Normalizer2Impl : public UObject {
         IX_NORM_TRIE_OFFSET,
         IX_EXTRA_DATA_OFFSET,
         IX_SMALL_FCD_OFFSET,
-        IX_RESERVED3_OFFSET,
+        IX_COMPOSITIONS_HASH_OFFSET,
         IX_RESERVED4_OFFSET,
         IX_RESERVED5_OFFSET,
         IX_RESERVED6_OFFSET,
@@ -472,6 +473,22 @@ class U_COMMON_API Normalizer2Impl : public UObject {
         COMP_2_TRAIL_MASK=0xffc0
     };
 
+    enum {
+        // compositionsHash[] entry second word: bits 26..22 = trail>>16, bits 21..0 = compositeAndFwd
+        COMP_HASH_TRAIL_HIGH_SHIFT=22,
+        COMP_HASH_VALUE_MASK=0x3fffff,
+        COMP_HASH_MAX_BITS=16
+    };
+
+    /**
+     * Returns the compositions hash table slot for a key,
+     * for a table with 1<<(32-shift) slots.
+     * Shared with gennorm2 which builds the table.
+     */
+    static inline uint32_t compositionsHashSlot(uint32_t key, int32_t shift) {
+        return (key*0x9e3779b1u)>>shift;
+    }
+
     // higher-level functionality ------------------------------------------ ***
 
     // NFD without an NFD Normalizer2 instance.
@@ -508,13 +525,40 @@ class U_COMMON_API Normalizer2Impl : public UObject {
                           ReorderingBuffer &buffer,
                           UErrorCode &errorCode) const;
 
-    /** sink==nullptr: isNormalized() */
-    UBool composeUTF8(uint32_t options, UBool onlyContiguous,
+    /**
+     * sink==nullptr: isNormalized()
+     * asciiMap: NULL, or a table from getCompASCIIMap() for mapping ASCII characters
+     * without trie lookups; only used if sink!=nullptr
+     */
+    UBool composeUTF8(uint32_t options, UBool onlyContiguous, const uint8_t *asciiMap,
                       const uint8_t *src, const uint8_t *limit,
                       ByteSink *sink, icu::Edits *edits, UErrorCode &errorCode) const;
+    /**
+     * Sets asciiMap[c] to the composed form of each ASCII character c
+     * if every ASCII character either passes the "yes && ccc==0" quick check
+     * or maps algorithmically to an ASCII character which does,
+     * as for NFKC_Casefold which lowercases A..Z.
+     * @return TRUE if asciiMap is usable for composeUTF8()
+     *         and some ASCII character changes
+     */
+    UBool getCompASCIIMap(uint8_t asciiMap[0x80]) const;
+    /**
+     * NFD/NFKD of UTF-8 text.
+     * sink==nullptr: isNormalized()/spanQuickCheckYes(), returns the end of the "yes" span
+     */
+    const uint8_t *decomposeUTF8(uint32_t options,
+                                 const uint8_t *src, const uint8_t *limit,
+                                 ByteSink *sink, icu::Edits *edits, UErrorCode &errorCode) const;
 
     const UChar *makeFCD(const UChar *src, const UChar *limit,
                          ReorderingBuffer *buffer, UErrorCode &errorCode) const;
+    /**
+     * FCD of UTF-8 text.
+     * sink==nullptr: isNormalized()/spanQuickCheckYes(), returns the end of the "yes" span
+     */
+    const uint8_t *makeFCDUTF8(uint32_t options,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, icu::Edits *edits, UErrorCode &errorCode) const;
     void makeFCDAndAppend(const UChar *src, const UChar *limit,
                           UBool doMakeFCD,
                           UnicodeString &safeMiddle,
@@ -657,11 +701,19 @@ class U_COMMON_API Normalizer2Impl : public UObject {
     UBool decompose(UChar32 c, uint16_t norm16,
                     ReorderingBuffer &buffer, UErrorCode &errorCode) const;
 
+    enum StopAt { STOP_AT_LIMIT, STOP_AT_DECOMP_BOUNDARY, STOP_AT_COMP_BOUNDARY };
+
     const uint8_t *decomposeShort(const uint8_t *src, const uint8_t *limit,
-                                  UBool stopAtCompBoundary, UBool onlyContiguous,
+                                  StopAt stopAt, UBool onlyContiguous,
                                   ReorderingBuffer &buffer, UErrorCode &errorCode) const;
 
-    static int32_t combine(const uint16_t *list, UChar32 trail);
+    int32_t combine(const uint16_t *list, UChar32 trail) const {
+        return compositionsHash!=NULL ?
+            combineFromHash(list, trail) : combineFromList(list, trail);
+    }
+    static int32_t combineFromList(const uint16_t *list, UChar32 trail);
+    int32_t combineFromHash(const uint16_t *list, UChar32 trail) const;
+    static UBool hasEmptyCompositionsHashSlot(const uint32_t *hash, int32_t length);
     void addComposites(const uint16_t *list, UnicodeSet &set) const;
     void recompose(ReorderingBuffer &buffer, int32_t recomposeStartIndex,
                    UBool onlyContiguous) const;
@@ -693,6 +745,7 @@ class U_COMMON_API Normalizer2Impl : public UObject {
 
     const UChar *findPreviousFCDBoundary(const UChar *start, const UChar *p) const;
     const UChar *findNextFCDBoundary(const UChar *p, const UChar *limit) const;
+    const uint8_t *findNextFCDBoundary(const uint8_t *p, const uint8_t *limit) const;
 
     void makeCanonIterDataFromNorm16(UChar32 start, UChar32 end, const uint16_t norm16,
                                      CanonIterData &newData, UErrorCode &errorCode) const;
@@ -722,6 +775,9 @@ class U_COMMON_API Normalizer2Impl : public UObject {
     const uint16_t *maybeYesCompositions;
     const uint16_t *extraData;  // mappings and/or compositions for yesYes, yesNo & noNo characters
     const uint8_t *smallFCD;  // [0x100] one bit per 32 BMP code points, set if any FCD!=0
+    const uint32_t *compositionsHash;  // optional (starter, trail) lookup table, or NULL
+    uint32_t compositionsHashMask;
+    int32_t compositionsHashShift;
 
     UInitOnce       fCanonIterDataInitOnce;
     CanonIterData  *fCanonIterData;
@@ -778,7 +834,7 @@ unorm_getFCD16(UChar32 c);
 
 /**
  * Format of Normalizer2 .nrm data files.
- * Format version 4.0.
+ * Format version 4.1.
  *
  * Normalizer2 .nrm data files provide data for the Unicode Normalization algorithms.
  * ICU ships with data files for standard Unicode Normalization Forms
@@ -902,6 +958,24 @@ unorm_getFCD16(UChar32 c);
  *
  *      This bit set is most useful for the large blocks of CJK characters with FCD=0.
  *
+ * uint32_t compositionsHash[]; -- optional, new in format version 4.1
+ *
+ *      An open-addressing hash table with all of the (starter, trail) pairs
+ *      from all of the compositions lists, for faster recomposition.
+ *      If this part is empty, then the compositions lists are searched linearly.
+ *
+ *      compositionsHash[0]=bits, the table has 1<<bits slots (1<=bits<=16).
+ *      Slot i occupies compositionsHash[1+2*i] and compositionsHash[2+2*i]:
+ *          key=(listOffset<<16)|(trail&0xffff)
+ *          value=((trail>>16)<<COMP_HASH_TRAIL_HIGH_SHIFT)|compositeAndFwd
+ *      where listOffset is the index of the starter's compositions list
+ *      from the start of the maybeYesCompositions, and compositeAndFwd is as in the list.
+ *      An empty slot has value=0xffffffff.
+ *      A pair is stored at compositionsHashSlot(key, 32-bits) or,
+ *      if that is occupied, in the next free slot (linear probing, wrapping around).
+ *      At most half of the slots are occupied.
+ *      Data whose table has no empty slot is treated as not having a table.
+ *
  * Changes from format version 1 to format version 2 ---------------------------
  *
  * - Addition of data for raw (not recursively decomposed) mappings.
@@ -974,6 +1048,12 @@ unorm_getFCD16(UChar32 c);
  * gennorm2 now has to reject mappings for surrogate code points.
  * UTS #46 maps unpaired surrogates to U+FFFD in code rather than via its
  * custom normalization data file.
+ *
+ * Changes from format version 4.0 to format version 4.1 (ICU 64) --------------
+ *
+ * - Addition of the optional compositionsHash[] at indexes[IX_COMPOSITIONS_HASH_OFFSET],
+ *   formerly reserved.
+ *   Readers of format version 4.0 ignore it.
  */
 
 #endif  /* !UCONFIG_NO_NORMALIZATION */
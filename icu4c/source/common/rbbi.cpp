@@ -34,6 +34,7 @@
 #include "rbbi_cache.h"
 #include "rbbirb.h"
 #include "uassert.h"
+#include "utext_imp.h"
 #include "umutex.h"
 #include "uvectr32.h"
 
@@ -752,6 +753,108 @@ struct LookAheadResults {
 };
 
 
+//-----------------------------------------------------------------------------------
+//
+//  Text readers for the state machine loops.
+//     Each one reads the text forward or backward from a native index
+//     and returns the character category of each code point, or -1 at the end of the text.
+//
+//-----------------------------------------------------------------------------------
+namespace {
+
+// Reads the text through the UText API.
+class UTextReader {
+public:
+    UTextReader(UText *text, const UTrie2 *trie, int32_t index) : fText(text), fTrie(trie), fChar(0) {
+        UTEXT_SETNATIVEINDEX(fText, index);
+    }
+    int32_t getIndex() const { return (int32_t)UTEXT_GETNATIVEINDEX(fText); }
+    int32_t next() {
+        fChar = UTEXT_NEXT32(fText);
+        if (fChar == U_SENTINEL) {
+            return -1;
+        }
+        return UTRIE2_GET16(fTrie, fChar);
+    }
+    int32_t previous() {
+        fChar = UTEXT_PREVIOUS32(fText);
+        if (fChar == U_SENTINEL) {
+            return -1;
+        }
+        return UTRIE2_GET16(fTrie, fChar);
+    }
+    /** The most recently read code point, for tracing. */
+    UChar32 getChar() const { return fChar; }
+private:
+    UText *fText;
+    const UTrie2 *fTrie;
+    UChar32 fChar;
+};
+
+// Reads UTF-8 text directly from its bytes, with the UTF-8 trie lookup macros.
+// Native indexes are byte offsets, as in the UTF-8 UText.
+class UTF8Reader {
+public:
+    UTF8Reader(const uint8_t *s, int32_t length, const UTrie2 *trie, int32_t index) :
+            fStart(s), fLimit(s + length), fTrie(trie) {
+        // Same pinning as by the UTF-8 UText.
+        if (index < 0) {
+            index = 0;
+        } else if (index >= length) {
+            index = length;
+        } else {
+            U8_SET_CP_START(s, 0, index);
+        }
+        fPos = s + index;
+    }
+    int32_t getIndex() const { return (int32_t)(fPos - fStart); }
+    int32_t next() {
+        if (fPos == fLimit) {
+            return -1;
+        }
+        uint16_t category;
+#ifdef RBBI_DEBUG
+        fCharStart = fPos;
+#endif
+        UTRIE2_U8_NEXT16(fTrie, fPos, fLimit, category);
+        return category != 0 ? category : getFFFDCategory();
+    }
+    int32_t previous() {
+        if (fPos == fStart) {
+            return -1;
+        }
+        uint16_t category;
+        UTRIE2_U8_PREV16(fTrie, fStart, fPos, category);
+#ifdef RBBI_DEBUG
+        fCharStart = fPos;
+#endif
+        return category != 0 ? category : getFFFDCategory();
+    }
+#ifdef RBBI_DEBUG
+    UChar32 getChar() const {
+        int32_t i = (int32_t)(fCharStart - fStart);
+        UChar32 c;
+        U8_NEXT_OR_FFFD(fStart, i, (int32_t)(fLimit - fStart), c);
+        return c;
+    }
+#endif
+private:
+    // Category 0 is not assigned to any code point; the trie returns it for ill-formed UTF-8.
+    // The UText reads each ill-formed sequence as U+FFFD.
+    int32_t getFFFDCategory() const { return UTRIE2_GET16(fTrie, 0xfffd); }
+
+    const uint8_t *fStart;
+    const uint8_t *fLimit;
+    const uint8_t *fPos;
+    const UTrie2 *fTrie;
+#ifdef RBBI_DEBUG
+    const uint8_t *fCharStart = nullptr;
+#endif
+};
+
+}  // namespace
+
+
 //-----------------------------------------------------------------------------------
 //
 //  handleNext()
@@ -759,12 +862,24 @@ struct LookAheadResults {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleNext() {
+    int32_t length;
+    const uint8_t *s = utext_getUTF8Bytes(&fText, &length);
+    if (s != NULL) {
+        UTF8Reader reader(s, length, fData->fTrie, fPosition);
+        return handleNext(reader);
+    }
+    UTextReader reader(&fText, fData->fTrie, fPosition);
+    return handleNext(reader);
+}
+
+template<typename TextReader>
+int32_t RuleBasedBreakIterator::handleNext(TextReader &reader) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
 
     RBBIStateTableRow  *row;
-    UChar32             c;
+    int32_t             nextCategory;
     LookAheadResults    lookAheadMatches;
     int32_t             result             = 0;
     int32_t             initialPosition    = 0;
@@ -785,10 +900,9 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
     // if we're already at the end of the text, return DONE.
     initialPosition = fPosition;
-    UTEXT_SETNATIVEINDEX(&fText, initialPosition);
     result          = initialPosition;
-    c               = UTEXT_NEXT32(&fText);
-    if (c==U_SENTINEL) {
+    nextCategory    = reader.next();
+    if (nextCategory < 0) {
         fDone = TRUE;
         return UBRK_DONE;
     }
@@ -810,7 +924,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
     // loop until we reach the end of the text or transition to state 0
     //
     for (;;) {
-        if (c == U_SENTINEL) {
+        if (nextCategory < 0) {
             // Reached end of input string.
             if (mode == RBBI_END) {
                 // We have already run the loop one last time with the
@@ -829,12 +943,10 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //      that we shouldn't get a category from an actual text input character.
         //
         if (mode == RBBI_RUN) {
-            // look up the current character's character category, which tells us
+            // The reader looked up the current character's character category, which tells us
             // which column in the state table to look at.
-            // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
-            //        not the size of the character going in, which is a UChar32.
             //
-            category = UTRIE2_GET16(fData->fTrie, c);
+            category = (uint16_t)nextCategory;
 
             // Check the dictionary bit in the character's category.
             //    Counter is only used by dictionary based iteration.
@@ -850,7 +962,8 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
        #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4" PRId64 "   ", utext_getNativeIndex(&fText));
+                RBBIDebugPrintf("             %4d   ", reader.getIndex());
+                UChar32 c = reader.getChar();
                 if (0x20<=c && c<0x7f) {
                     RBBIDebugPrintf("\"%c\"  ", c);
                 } else {
@@ -874,7 +987,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         if (row->fAccepting == -1) {
             // Match found, common case.
             if (mode != RBBI_START) {
-                result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+                result = reader.getIndex();
             }
             fRuleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
         }
@@ -892,7 +1005,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         int16_t rule = row->fLookAhead;
         if (rule != 0) {
             // At the position of a '/' in a look-ahead match. Record it.
-            int32_t  pos = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+            int32_t  pos = reader.getIndex();
             lookAheadMatches.setPosition(rule, pos);
         }
 
@@ -908,7 +1021,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //    the input position.  The next iteration will be processing the
         //    first real input character.
         if (mode == RBBI_RUN) {
-            c = UTEXT_NEXT32(&fText);
+            nextCategory = reader.next();
         } else {
             if (mode == RBBI_START) {
                 mode = RBBI_RUN;
@@ -949,14 +1062,28 @@ int32_t RuleBasedBreakIterator::handleNext() {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
+    if (fData == NULL) {
+        return BreakIterator::DONE;
+    }
+    int32_t length;
+    const uint8_t *s = utext_getUTF8Bytes(&fText, &length);
+    if (s != NULL) {
+        UTF8Reader reader(s, length, fData->fTrie, fromPosition);
+        return handleSafePrevious(reader);
+    }
+    UTextReader reader(&fText, fData->fTrie, fromPosition);
+    return handleSafePrevious(reader);
+}
+
+template<typename TextReader>
+int32_t RuleBasedBreakIterator::handleSafePrevious(TextReader &reader) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIStateTableRow  *row;
-    UChar32             c;
+    int32_t             prevCategory;
     int32_t             result          = 0;
 
     const RBBIStateTable *stateTable = fData->fReverseTable;
-    UTEXT_SETNATIVEINDEX(&fText, fromPosition);
     #ifdef RBBI_DEBUG
         if (gTrace) {
             RBBIDebugPuts("Handle Previous   pos   char  state category");
@@ -964,32 +1091,31 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
     #endif
 
     // if we're already at the start of the text, return DONE.
-    if (fData == NULL || UTEXT_GETNATIVEINDEX(&fText)==0) {
+    if (reader.getIndex()==0) {
         return BreakIterator::DONE;
     }
 
     //  Set the initial state for the state machine
-    c = UTEXT_PREVIOUS32(&fText);
+    prevCategory = reader.previous();
     state = START_STATE;
     row = (RBBIStateTableRow *)
             (stateTable->fTableData + (stateTable->fRowLen * state));
 
     // loop until we reach the start of the text or transition to state 0
     //
-    for (; c != U_SENTINEL; c = UTEXT_PREVIOUS32(&fText)) {
+    for (; prevCategory >= 0; prevCategory = reader.previous()) {
 
-        // look up the current character's character category, which tells us
+        // The reader looked up the current character's character category, which tells us
         // which column in the state table to look at.
-        // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
-        //        not the size of the character going in, which is a UChar32.
         //
         //  And off the dictionary flag bit. For reverse iteration it is not used.
-        category = UTRIE2_GET16(fData->fTrie, c);
+        category = (uint16_t)prevCategory;
         category &= ~0x4000;
 
         #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4d   ", (int32_t)utext_getNativeIndex(&fText));
+                RBBIDebugPrintf("             %4d   ", reader.getIndex());
+                UChar32 c = reader.getChar();
                 if (0x20<=c && c<0x7f) {
                     RBBIDebugPrintf("\"%c\"  ", c);
                 } else {
@@ -1015,7 +1141,7 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
     }
 
     // The state machine is done.  Check whether it found a match...
-    result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+    result = reader.getIndex();
     #ifdef RBBI_DEBUG
         if (gTrace) {
             RBBIDebugPrintf("result = %d\n\n", result);
@@ -1065,6 +1191,76 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
 }
 
 
+//-------------------------------------------------------------------------------
+//
+//   getBoundaries()   Bulk forward iteration.
+//                     After the first boundary, which comes from the break cache,
+//                     this follows the logic of BreakCache::populateFollowing(),
+//                     but writes the boundaries straight into the caller's arrays
+//                     instead of into the circular cache buffer.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getBoundaries(int32_t start, int32_t *boundaries, int32_t *ruleStatus,
+                                              int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (boundaries == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (capacity == 0) {
+        return 0;
+    }
+
+    // following() handles a start position that is not a boundary,
+    // and any state left in the caches by earlier iteration.
+    int32_t pos = following(start < 0 ? 0 : start);
+    if (pos == UBRK_DONE) {
+        return 0;
+    }
+    const int32_t *statusTable = fData->fRuleStatusTable;
+    int32_t ruleStatusIdx = fRuleStatusIndex;
+    int32_t lastRuleStatusIdx;
+    int32_t length = 0;
+    for (;;) {
+        boundaries[length] = pos;
+        if (ruleStatus != NULL) {
+            ruleStatus[length] = statusTable[ruleStatusIdx + statusTable[ruleStatusIdx]];
+        }
+        lastRuleStatusIdx = ruleStatusIdx;
+        if (++length == capacity) {
+            break;
+        }
+
+        int32_t fromPos = pos;
+        if (fDictionaryCache->following(fromPos, &pos, &ruleStatusIdx)) {
+            continue;
+        }
+        fPosition = fromPos;
+        pos = handleNext();
+        if (pos == UBRK_DONE) {
+            break;
+        }
+        int32_t fromRuleStatusIdx = ruleStatusIdx;
+        ruleStatusIdx = fRuleStatusIndex;
+        if (fDictionaryCharCount > 0) {
+            // Subdivide the rule-based segment. If the dictionary finds no breaks in it,
+            // then following() fails and leaves the rule-based boundary in place.
+            fDictionaryCache->populateDictionary(fromPos, pos, fromRuleStatusIdx, ruleStatusIdx);
+            fDictionaryCache->following(fromPos, &pos, &ruleStatusIdx);
+        }
+    }
+
+    // Leave the iterator on the last boundary, with the cache holding only that one.
+    pos = boundaries[length - 1];
+    fBreakCache->reset(pos, lastRuleStatusIdx);
+    fPosition = pos;
+    fRuleStatusIndex = lastRuleStatusIdx;
+    fDone = FALSE;
+    return length;
+}
+
 
 //-------------------------------------------------------------------------------
 //
@@ -0,0 +1,260 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// rbbi_parallel.cpp
+// created: 2018oct26
+//
+// RuleBasedBreakIterator::getAllBoundaries() and its C API.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_BREAK_ITERATION
+
+#include "unicode/rbbi.h"
+#include "unicode/ubrk.h"
+#include "unicode/utext.h"
+#include "cmemory.h"
+#include "rbbi_cache.h"
+#include "uparallel.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * The text is only split across threads if each thread gets at least this many code units.
+ * Starting a thread costs about as much as segmenting a few thousand characters.
+ */
+constexpr int32_t MIN_UNITS_PER_THREAD = 8192;
+
+/** Number of boundaries fetched per getBoundaries() call. */
+constexpr int32_t BOUNDARIES_PER_CALL = 1024;
+
+/**
+ * One slice [start, limit[ of the text,
+ * with the iterator that segments it, and the resulting boundaries.
+ */
+struct SegmentChunk : public UMemory {
+    int32_t start = 0;
+    int32_t limit = 0;
+    /** Clone of the caller's iterator; not used for the first chunk. */
+    LocalPointer<BreakIterator> clone;
+    LocalMemory<int32_t> boundaries;
+    LocalMemory<int32_t> ruleStatus;
+    int32_t capacity = 0;
+    int32_t length = 0;
+    UErrorCode errorCode = U_ZERO_ERROR;
+
+    UBool ensureCapacity(int32_t minCapacity, UBool withRuleStatus) {
+        if (minCapacity <= capacity) {
+            return TRUE;
+        }
+        int32_t newCapacity = capacity < BOUNDARIES_PER_CALL ? 4 * BOUNDARIES_PER_CALL : 2 * capacity;
+        if (newCapacity < minCapacity) {
+            newCapacity = minCapacity;
+        }
+        if (boundaries.allocateInsteadAndCopy(newCapacity, length) == nullptr ||
+                (withRuleStatus &&
+                    ruleStatus.allocateInsteadAndCopy(newCapacity, length) == nullptr)) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        capacity = newCapacity;
+        return TRUE;
+    }
+};
+
+/**
+ * Returns the native index after the first hard line break
+ * (CR, LF, CR LF, NEL, LS or PS) that starts in [start, limit[, or -1 if there is none.
+ * All of the standard break rules have a boundary there, and nothing before it
+ * affects the boundaries after it.
+ */
+int32_t findHardBreak(UText *text, int32_t start, int32_t limit) {
+    UTEXT_SETNATIVEINDEX(text, start);
+    while ((int32_t)UTEXT_GETNATIVEINDEX(text) < limit) {
+        UChar32 c = UTEXT_NEXT32(text);
+        if (c == 0xa || c == 0x85 || c == 0x2028 || c == 0x2029) {
+            return (int32_t)UTEXT_GETNATIVEINDEX(text);
+        } else if (c == 0xd) {
+            if (UTEXT_CURRENT32(text) == 0xa) {
+                UTEXT_NEXT32(text);
+            }
+            return (int32_t)UTEXT_GETNATIVEINDEX(text);
+        } else if (c < 0) {
+            break;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+int32_t RuleBasedBreakIterator::getAllBoundaries(int32_t *boundaries, int32_t *ruleStatus,
+                                                 int32_t capacity, int32_t numThreads,
+                                                 UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (boundaries == nullptr && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t textLength = (int32_t)utext_nativeLength(&fText);
+    int32_t numChunks = getNumParallelChunks(textLength, numThreads, MIN_UNITS_PER_THREAD);
+    LocalArray<SegmentChunk> chunks(new SegmentChunk[numChunks], status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+
+    // Cut the text after the first hard line break following each equal share of it.
+    // Fewer slices if the text has few line breaks.
+    int32_t n = 1;
+    for (int32_t i = 1; i < numChunks; ++i) {
+        int32_t from = getParallelChunkStart(textLength, i, numChunks);
+        int32_t to = getParallelChunkStart(textLength, i + 1, numChunks);
+        if (from < chunks[n - 1].start) {
+            from = chunks[n - 1].start;
+        }
+        int32_t cut = findHardBreak(&fText, from, to);
+        if (cut > chunks[n - 1].start && cut < textLength) {
+            chunks[n - 1].limit = cut;
+            chunks[n++].start = cut;
+        }
+    }
+    chunks[n - 1].limit = textLength;
+    numChunks = n;
+
+    UBool withRuleStatus = ruleStatus != nullptr;
+    // Segments [from, limit[ starting at from, which must be a boundary,
+    // and keeps the boundaries up to and including the first one at or after limit.
+    auto segmentRange = [withRuleStatus](RuleBasedBreakIterator &bi, int32_t from, int32_t limit,
+                                         SegmentChunk &chunk) {
+        chunk.length = 0;
+        // Continue from a known boundary: Avoid following(from) backing up with the safe rules.
+        bi.fBreakCache->reset(from, 0);
+        bi.fDictionaryCache->reset();
+        int32_t pos = from;
+        while (pos < limit && chunk.ensureCapacity(chunk.length + BOUNDARIES_PER_CALL, withRuleStatus)) {
+            int32_t *b = chunk.boundaries.getAlias() + chunk.length;
+            int32_t length = bi.getBoundaries(
+                pos, b, withRuleStatus ? chunk.ruleStatus.getAlias() + chunk.length : nullptr,
+                BOUNDARIES_PER_CALL, chunk.errorCode);
+            if (length == 0) {
+                break;
+            }
+            int32_t i = 0;
+            while (i < length && b[i] < limit) {
+                ++i;
+            }
+            if (i < length) {
+                chunk.length += i + 1;
+                break;
+            }
+            chunk.length += length;
+            pos = b[length - 1];
+        }
+    };
+
+    for (int32_t i = 1; i < numChunks; ++i) {
+        SegmentChunk &chunk = chunks[i];
+        chunk.clone.adoptInstead(clone());
+        if (chunk.clone.isNull()) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return 0;
+        }
+    }
+    // Each chunk keeps its own error code because the stitching below may redo it.
+    SegmentChunk *chunksArray = chunks.getAlias();
+    runParallelChunks(numChunks, [this, &segmentRange, chunksArray](int32_t i, UErrorCode &) {
+        SegmentChunk &chunk = chunksArray[i];
+        RuleBasedBreakIterator &bi = i == 0 ?
+            *this : *static_cast<RuleBasedBreakIterator *>(chunk.clone.getAlias());
+        segmentRange(bi, chunk.start, chunk.limit, chunk);
+    }, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+
+    // Stitch the slices together. Where the previous slice ended after the cut,
+    // the cut was not a boundary, and this slice is redone from the previous slice's end.
+    int32_t total = 0;
+    int32_t lastBoundary = 0;
+    for (int32_t i = 0; i < numChunks; ++i) {
+        SegmentChunk &chunk = chunks[i];
+        if (lastBoundary != chunk.start) {
+            if (lastBoundary < chunk.limit) {
+                segmentRange(*this, lastBoundary, chunk.limit, chunk);
+            } else {
+                chunk.length = 0;
+            }
+        }
+        if (U_FAILURE(chunk.errorCode)) {
+            status = chunk.errorCode;
+            return 0;
+        }
+        if (chunk.length > 0) {
+            lastBoundary = chunk.boundaries[chunk.length - 1];
+        }
+        total += chunk.length;
+    }
+
+    if (total > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    } else {
+        int32_t length = 0;
+        for (int32_t i = 0; i < numChunks; ++i) {
+            SegmentChunk &chunk = chunks[i];
+            if (chunk.length > 0) {
+                uprv_memcpy(boundaries + length, chunk.boundaries.getAlias(), chunk.length * sizeof(int32_t));
+                if (withRuleStatus) {
+                    uprv_memcpy(ruleStatus + length, chunk.ruleStatus.getAlias(), chunk.length * sizeof(int32_t));
+                }
+                length += chunk.length;
+            }
+        }
+    }
+    last();
+    return total;
+}
+
+U_NAMESPACE_END
+
+// C API ------------------------------------------------------------------- ***
+
+U_NAMESPACE_USE
+
+U_CAPI int32_t U_EXPORT2
+ubrk_getAllBoundaries(UBreakIterator *bi,
+                      int32_t *boundaries, int32_t *ruleStatus, int32_t capacity,
+                      int32_t numThreads, UErrorCode *status) {
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    BreakIterator *brkit = reinterpret_cast<BreakIterator *>(bi);
+    RuleBasedBreakIterator *rbbi = dynamic_cast<RuleBasedBreakIterator *>(brkit);
+    if (rbbi != nullptr) {
+        return rbbi->getAllBoundaries(boundaries, ruleStatus, capacity, numThreads, *status);
+    }
+    // Other BreakIterator subclasses, for example with sentence break suppressions.
+    if (capacity < 0 || (boundaries == nullptr && capacity > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t length = 0;
+    brkit->first();
+    for (int32_t pos; (pos = brkit->next()) != UBRK_DONE; ++length) {
+        if (length < capacity) {
+            boundaries[length] = pos;
+            if (ruleStatus != nullptr) {
+                ruleStatus[length] = brkit->getRuleStatus();
+            }
+        }
+    }
+    if (length > capacity) {
+        *status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return length;
+}
+
+#endif  // !UCONFIG_NO_BREAK_ITERATION
@@ -0,0 +1,524 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// simdutil.h
+// created: 2018oct16
+
+#ifndef __SIMDUTIL_H__
+#define __SIMDUTIL_H__
+
+#include "unicode/utypes.h"
+
+/**
+ * \def U_SIMD_SSE2
+ * 1 if SSE2 intrinsics may be used without runtime CPU detection.
+ * Define to 0 on the command line to force the scalar code paths.
+ * @internal
+ */
+#ifndef U_SIMD_SSE2
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define U_SIMD_SSE2 1
+#   else
+#       define U_SIMD_SSE2 0
+#   endif
+#endif
+
+/**
+ * \def U_SIMD_AVX2
+ * 1 if the compiler targets AVX2 (for example with -mavx2 or /arch:AVX2).
+ * @internal
+ */
+#ifndef U_SIMD_AVX2
+#   if U_SIMD_SSE2 && defined(__AVX2__)
+#       define U_SIMD_AVX2 1
+#   else
+#       define U_SIMD_AVX2 0
+#   endif
+#endif
+
+/**
+ * \def U_SIMD_SSSE3
+ * 1 if SSSE3 byte shuffles may be used, for example with -mssse3 or -mavx2.
+ * @internal
+ */
+#ifndef U_SIMD_SSSE3
+#   if U_SIMD_SSE2 && (defined(__SSSE3__) || U_SIMD_AVX2)
+#       define U_SIMD_SSSE3 1
+#   else
+#       define U_SIMD_SSSE3 0
+#   endif
+#endif
+
+/**
+ * \def U_SIMD_NEON
+ * 1 if AArch64 Advanced SIMD intrinsics are available.
+ * @internal
+ */
+#ifndef U_SIMD_NEON
+#   if defined(__aarch64__) || defined(_M_ARM64)
+#       define U_SIMD_NEON 1
+#   else
+#       define U_SIMD_NEON 0
+#   endif
+#endif
+
+#if U_SIMD_AVX2
+#   include <immintrin.h>
+#elif U_SIMD_SSSE3
+#   include <tmmintrin.h>
+#elif U_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+#if U_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+U_NAMESPACE_BEGIN
+
+/**
+ * Small vectorized scanning helpers for the fast paths of
+ * string processing loops.
+ * Each function has a scalar fallback and returns the same result
+ * regardless of which instruction set is used.
+ */
+class SIMDUtil {
+public:
+    SIMDUtil() = delete;  // all static
+
+    /**
+     * Returns a pointer to the first code unit in [s, limit[ that is >=min,
+     * or limit if there is none.
+     * Skips 8 or 16 code units at a time where possible.
+     */
+    static inline const UChar *skipBelow(const UChar *s, const UChar *limit, UChar min) {
+        if (min == 0) {
+            return s;
+        }
+#if U_SIMD_SSE2
+        // Unsigned saturating subtraction of (min-1) yields 0 exactly for units below min.
+#if U_SIMD_AVX2
+        const __m256i bound32 = _mm256_set1_epi16((short)(min - 1));
+        while ((limit - s) >= 16) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+            __m256i over = _mm256_subs_epu16(v, bound32);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(over, _mm256_setzero_si256())) != -1) {
+                break;
+            }
+            s += 16;
+        }
+#endif
+        const __m128i bound = _mm_set1_epi16((short)(min - 1));
+        while ((limit - s) >= 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+            __m128i over = _mm_subs_epu16(v, bound);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(over, _mm_setzero_si128())) != 0xffff) {
+                break;
+            }
+            s += 8;
+        }
+#elif U_SIMD_NEON
+        while ((limit - s) >= 8) {
+            uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(s));
+            if (vmaxvq_u16(v) >= min) {
+                break;
+            }
+            s += 8;
+        }
+#endif
+        while (s != limit && *s < min) {
+            ++s;
+        }
+        return s;
+    }
+
+    /**
+     * Returns a pointer to the first byte in [s, limit[ that is >=min,
+     * or limit if there is none.
+     * Skips 16 or 32 bytes at a time where possible.
+     */
+    static inline const uint8_t *skipBelow(const uint8_t *s, const uint8_t *limit, uint8_t min) {
+        if (min == 0) {
+            return s;
+        }
+#if U_SIMD_SSE2
+#if U_SIMD_AVX2
+        const __m256i bound32 = _mm256_set1_epi8((char)(min - 1));
+        while ((limit - s) >= 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+            __m256i over = _mm256_subs_epu8(v, bound32);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(over, _mm256_setzero_si256())) != -1) {
+                break;
+            }
+            s += 32;
+        }
+#endif
+        const __m128i bound = _mm_set1_epi8((char)(min - 1));
+        while ((limit - s) >= 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+            __m128i over = _mm_subs_epu8(v, bound);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(over, _mm_setzero_si128())) != 0xffff) {
+                break;
+            }
+            s += 16;
+        }
+#elif U_SIMD_NEON
+        while ((limit - s) >= 16) {
+            uint8x16_t v = vld1q_u8(s);
+            if (vmaxvq_u8(v) >= min) {
+                break;
+            }
+            s += 16;
+        }
+#endif
+        while (s != limit && *s < min) {
+            ++s;
+        }
+        return s;
+    }
+
+    /**
+     * Returns the length of the common prefix of a[0..length[ and b[0..length[,
+     * that is, the index of the first differing code unit, or length if there is none.
+     * Compares 8 or 16 code units at a time where possible.
+     */
+    static inline int32_t equalPrefixLength(const UChar *a, const UChar *b, int32_t length) {
+        // Sorting mostly compares strings that differ right away.
+        if (length <= 0 || a[0] != b[0]) {
+            return 0;
+        }
+        int32_t i = 1;
+#if U_SIMD_SSE2
+#if U_SIMD_AVX2
+        while ((length - i) >= 16) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            uint32_t eq = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(va, vb));
+            if (eq != 0xffffffff) {
+                return i + countTrailingZeros(~eq) / 2;
+            }
+            i += 16;
+        }
+#endif
+        while ((length - i) >= 8) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+            uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(va, vb));
+            if (eq != 0xffff) {
+                return i + countTrailingZeros(~eq) / 2;
+            }
+            i += 8;
+        }
+#elif U_SIMD_NEON
+        while ((length - i) >= 8) {
+            uint16x8_t va = vld1q_u16(reinterpret_cast<const uint16_t *>(a + i));
+            uint16x8_t vb = vld1q_u16(reinterpret_cast<const uint16_t *>(b + i));
+            if (vminvq_u16(vceqq_u16(va, vb)) == 0) {
+                break;  // The scalar loop finds the mismatch.
+            }
+            i += 8;
+        }
+#endif
+        while (i < length && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    /**
+     * Returns the length of the common prefix of a[0..length[ and b[0..length[,
+     * that is, the index of the first differing byte, or length if there is none.
+     * Compares 16 or 32 bytes at a time where possible.
+     */
+    static inline int32_t equalPrefixLength(const uint8_t *a, const uint8_t *b, int32_t length) {
+        // Sorting mostly compares strings that differ right away.
+        if (length <= 0 || a[0] != b[0]) {
+            return 0;
+        }
+        int32_t i = 1;
+#if U_SIMD_SSE2
+#if U_SIMD_AVX2
+        while ((length - i) >= 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            uint32_t eq = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+            if (eq != 0xffffffff) {
+                return i + countTrailingZeros(~eq);
+            }
+            i += 32;
+        }
+#endif
+        while ((length - i) >= 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+            uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+            if (eq != 0xffff) {
+                return i + countTrailingZeros(~eq);
+            }
+            i += 16;
+        }
+#elif U_SIMD_NEON
+        while ((length - i) >= 16) {
+            uint8x16_t va = vld1q_u8(a + i);
+            uint8x16_t vb = vld1q_u8(b + i);
+            if (vminvq_u8(vceqq_u8(va, vb)) == 0) {
+                break;  // The scalar loop finds the mismatch.
+            }
+            i += 16;
+        }
+#endif
+        while (i < length && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    /**
+     * Copies the leading bytes of src[0..length[ that are in the ASCII set
+     * to dest as UTF-16 code units, stopping before the first other byte.
+     * The set is given as a bit set: bit (b&0x1f) of set[b>>5] for each ASCII byte b in it.
+     * Only C0 controls, DEL, and the two bytes recheck0 and recheck1 are looked up in the set;
+     * all other bytes <0x80 must be in it.
+     * Returns the number of bytes copied.
+     * Widens 16 or 32 bytes at a time where possible.
+     */
+    static inline int32_t widenASCII(const uint8_t *src, UChar *dest, int32_t length,
+                                     const uint32_t set[4], uint8_t recheck0, uint8_t recheck1) {
+        int32_t i = 0;
+#if U_SIMD_SSE2
+        const __m128i minPrintable = _mm_set1_epi8(0x20);
+        const __m128i del = _mm_set1_epi8(0x7f);
+        const __m128i r0 = _mm_set1_epi8((char)recheck0);
+        const __m128i r1 = _mm_set1_epi8((char)recheck1);
+#if U_SIMD_AVX2
+        const __m256i minPrintable32 = _mm256_set1_epi8(0x20);
+        const __m256i del32 = _mm256_set1_epi8(0x7f);
+        const __m256i r0_32 = _mm256_set1_epi8((char)recheck0);
+        const __m256i r1_32 = _mm256_set1_epi8((char)recheck1);
+        while ((length - i) >= 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            if (_mm256_movemask_epi8(v) != 0) {
+                break;
+            }
+            __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpgt_epi8(minPrintable32, v), _mm256_cmpeq_epi8(v, del32)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, r0_32), _mm256_cmpeq_epi8(v, r1_32)));
+            uint32_t which = (uint32_t)_mm256_movemask_epi8(special);
+            if (which != 0 && !areInASCIISet(src + i, which, set)) {
+                break;
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i),
+                                _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i + 16),
+                                _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+            i += 32;
+        }
+#endif
+        const __m128i zero = _mm_setzero_si128();
+        while ((length - i) >= 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            if (_mm_movemask_epi8(v) != 0) {
+                break;
+            }
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmplt_epi8(v, minPrintable), _mm_cmpeq_epi8(v, del)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, r0), _mm_cmpeq_epi8(v, r1)));
+            uint32_t which = (uint32_t)_mm_movemask_epi8(special);
+            if (which != 0 && !areInASCIISet(src + i, which, set)) {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 8), _mm_unpackhi_epi8(v, zero));
+            i += 16;
+        }
+#elif U_SIMD_NEON
+        const uint8x16_t r0 = vdupq_n_u8(recheck0);
+        const uint8x16_t r1 = vdupq_n_u8(recheck1);
+        while ((length - i) >= 16) {
+            uint8x16_t v = vld1q_u8(src + i);
+            if (vmaxvq_u8(v) >= 0x7f) {
+                break;  // non-ASCII or DEL
+            }
+            if ((vminvq_u8(v) < 0x20 ||
+                    vmaxvq_u8(vorrq_u8(vceqq_u8(v, r0), vceqq_u8(v, r1))) != 0) &&
+                    !areInASCIISet(src + i, 0xffff, set)) {
+                break;
+            }
+            vst1q_u16(reinterpret_cast<uint16_t *>(dest + i), vmovl_u8(vget_low_u8(v)));
+            vst1q_u16(reinterpret_cast<uint16_t *>(dest + i + 8), vmovl_u8(vget_high_u8(v)));
+            i += 16;
+        }
+#else
+        (void)recheck0;
+        (void)recheck1;
+#endif
+        uint8_t b;
+        while (i < length && isInASCIISet(b = src[i], set)) {
+            dest[i++] = b;
+        }
+        return i;
+    }
+
+    /**
+     * Copies the leading code units of src[0..length[ that are in the ASCII set
+     * to dest as bytes, stopping before the first other code unit.
+     * The set and the recheck0/recheck1 parameters work as for widenASCII().
+     * Returns the number of code units copied.
+     * Narrows 16 code units at a time where possible.
+     */
+    static inline int32_t narrowASCII(const UChar *src, uint8_t *dest, int32_t length,
+                                      const uint32_t set[4], uint8_t recheck0, uint8_t recheck1) {
+        int32_t i = 0;
+#if U_SIMD_SSE2
+        const __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+        const __m128i minPrintable = _mm_set1_epi8(0x20);
+        const __m128i del = _mm_set1_epi8(0x7f);
+        const __m128i r0 = _mm_set1_epi8((char)recheck0);
+        const __m128i r1 = _mm_set1_epi8((char)recheck1);
+        const __m128i zero = _mm_setzero_si128();
+        while ((length - i) >= 16) {
+            __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+            __m128i high = _mm_and_si128(_mm_or_si128(v0, v1), nonASCII);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff) {
+                break;
+            }
+            // All units are <0x80 now, so the packed bytes equal the units.
+            __m128i bytes = _mm_packus_epi16(v0, v1);
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmplt_epi8(bytes, minPrintable), _mm_cmpeq_epi8(bytes, del)),
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, r0), _mm_cmpeq_epi8(bytes, r1)));
+            uint32_t which = (uint32_t)_mm_movemask_epi8(special);
+            if (which != 0) {
+                uint8_t block[16];
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(block), bytes);
+                if (!areInASCIISet(block, which, set)) {
+                    break;
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), bytes);
+            i += 16;
+        }
+#elif U_SIMD_NEON
+        const uint8x16_t r0 = vdupq_n_u8(recheck0);
+        const uint8x16_t r1 = vdupq_n_u8(recheck1);
+        while ((length - i) >= 16) {
+            uint16x8_t v0 = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i));
+            uint16x8_t v1 = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i + 8));
+            if (vmaxvq_u16(vmaxq_u16(v0, v1)) >= 0x7f) {
+                break;  // non-ASCII or DEL
+            }
+            uint8x16_t bytes = vcombine_u8(vmovn_u16(v0), vmovn_u16(v1));
+            if (vminvq_u8(bytes) < 0x20 ||
+                    vmaxvq_u8(vorrq_u8(vceqq_u8(bytes, r0), vceqq_u8(bytes, r1))) != 0) {
+                uint8_t block[16];
+                vst1q_u8(block, bytes);
+                if (!areInASCIISet(block, 0xffff, set)) {
+                    break;
+                }
+            }
+            vst1q_u8(dest + i, bytes);
+            i += 16;
+        }
+#else
+        (void)recheck0;
+        (void)recheck1;
+#endif
+        UChar c;
+        while (i < length && isInASCIISet(c = src[i], set)) {
+            dest[i++] = (uint8_t)c;
+        }
+        return i;
+    }
+
+    /**
+     * Copies the leading bytes of src[0..length[ that are in the ASCII set
+     * to dest, stopping before the first other byte.
+     * The set and the recheck0/recheck1 parameters work as for widenASCII().
+     * Returns the number of bytes copied.
+     * Copies 16 bytes at a time where possible.
+     */
+    static inline int32_t copyASCII(const uint8_t *src, uint8_t *dest, int32_t length,
+                                    const uint32_t set[4], uint8_t recheck0, uint8_t recheck1) {
+        int32_t i = 0;
+#if U_SIMD_SSE2
+        const __m128i minPrintable = _mm_set1_epi8(0x20);
+        const __m128i del = _mm_set1_epi8(0x7f);
+        const __m128i r0 = _mm_set1_epi8((char)recheck0);
+        const __m128i r1 = _mm_set1_epi8((char)recheck1);
+        while ((length - i) >= 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            if (_mm_movemask_epi8(v) != 0) {
+                break;
+            }
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmplt_epi8(v, minPrintable), _mm_cmpeq_epi8(v, del)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, r0), _mm_cmpeq_epi8(v, r1)));
+            uint32_t which = (uint32_t)_mm_movemask_epi8(special);
+            if (which != 0 && !areInASCIISet(src + i, which, set)) {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), v);
+            i += 16;
+        }
+#elif U_SIMD_NEON
+        const uint8x16_t r0 = vdupq_n_u8(recheck0);
+        const uint8x16_t r1 = vdupq_n_u8(recheck1);
+        while ((length - i) >= 16) {
+            uint8x16_t v = vld1q_u8(src + i);
+            if (vmaxvq_u8(v) >= 0x7f) {
+                break;  // non-ASCII or DEL
+            }
+            if ((vminvq_u8(v) < 0x20 ||
+                    vmaxvq_u8(vorrq_u8(vceqq_u8(v, r0), vceqq_u8(v, r1))) != 0) &&
+                    !areInASCIISet(src + i, 0xffff, set)) {
+                break;
+            }
+            vst1q_u8(dest + i, v);
+            i += 16;
+        }
+#else
+        (void)recheck0;
+        (void)recheck1;
+#endif
+        uint8_t b;
+        while (i < length && isInASCIISet(b = src[i], set)) {
+            dest[i++] = b;
+        }
+        return i;
+    }
+
+private:
+    /** Returns TRUE if c is an ASCII character in the bit set. */
+    static inline UBool isInASCIISet(uint32_t c, const uint32_t set[4]) {
+        return c < 0x80 && ((set[c >> 5] >> (c & 0x1f)) & 1) != 0;
+    }
+
+    /** Returns TRUE if each byte p[i] whose bit i is set in which is in the ASCII bit set. */
+    static inline UBool areInASCIISet(const uint8_t *p, uint32_t which, const uint32_t set[4]) {
+        while (which != 0) {
+            if (!isInASCIISet(p[countTrailingZeros(which)], set)) {
+                return FALSE;
+            }
+            which &= which - 1;
+        }
+        return TRUE;
+    }
+
+    /** Returns the number of trailing 0 bits in x, which must not be 0. */
+    static inline int32_t countTrailingZeros(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(x);
+#else
+        int32_t n = 0;
+        while ((x & 1) == 0) {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+};
+
+U_NAMESPACE_END
+
+#endif  // __SIMDUTIL_H__
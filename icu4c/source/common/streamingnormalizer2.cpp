@@ -0,0 +1,384 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// streamingnormalizer2.cpp
+// created: 2018oct16
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/bytestream.h"
+#include "unicode/edits.h"
+#include "unicode/normalizer2.h"
+#include "unicode/stringoptions.h"
+#include "unicode/stringpiece.h"
+#include "unicode/unistr.h"
+#include "unicode/unorm2.h"
+#include "unicode/ustring.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
+#include "bytesinkutil.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "ustr_imp.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Returns the length of a truncated UTF-8 sequence at the end of s[0..length[,
+ * that is, of a lead byte and fewer trail bytes than it requires.
+ * Returns 0 if the text ends with a complete sequence or with an ill-formed one
+ * that cannot be completed.
+ */
+int32_t truncatedUTF8SuffixLength(const uint8_t *s, int32_t length) {
+    for (int32_t i = 1; i <= 3 && i <= length; ++i) {
+        uint8_t b = s[length - i];
+        if (!U8_IS_TRAIL(b)) {
+            if (U8_IS_LEAD(b) && i <= U8_COUNT_TRAIL_BYTES(b)) {
+                return i;
+            }
+            break;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+StreamingNormalizer2::StreamingNormalizer2(const Normalizer2 &n2) :
+        norm2(n2), pending8(nullptr) {}
+
+StreamingNormalizer2::~StreamingNormalizer2() {
+    delete pending8;
+}
+
+void StreamingNormalizer2::reset() {
+    pending.remove();
+    if (pending8 != nullptr) {
+        pending8->clear();
+    }
+}
+
+UBool StreamingNormalizer2::hasPendingText() const {
+    return !pending.isEmpty() || (pending8 != nullptr && !pending8->isEmpty());
+}
+
+// Returns the index of the first code point in [start, limit[ with a boundary before it,
+// or -1 if there is none.
+int32_t
+StreamingNormalizer2::findFirstBoundary(const char16_t *s, int32_t start, int32_t limit) const {
+    int32_t i = start;
+    while (i < limit) {
+        int32_t prev = i;
+        UChar32 c;
+        U16_NEXT(s, i, limit, c);
+        if (norm2.hasBoundaryBefore(c)) {
+            return prev;
+        }
+    }
+    return -1;
+}
+
+// Returns the index of the last code point in [start, limit[ with a boundary before it,
+// or start if there is none.
+int32_t
+StreamingNormalizer2::findLastBoundary(const char16_t *s, int32_t start, int32_t limit) const {
+    int32_t i = limit;
+    while (i > start) {
+        UChar32 c;
+        U16_PREV(s, start, i, c);
+        if (norm2.hasBoundaryBefore(c)) {
+            return i;
+        }
+    }
+    return start;
+}
+
+int32_t
+StreamingNormalizer2::findFirstBoundary(const uint8_t *s, int32_t start, int32_t limit) const {
+    int32_t i = start;
+    while (i < limit) {
+        int32_t prev = i;
+        UChar32 c;
+        U8_NEXT(s, i, limit, c);
+        // Ill-formed sequences are passed through unchanged and do not interact.
+        if (c < 0 || norm2.hasBoundaryBefore(c)) {
+            return prev;
+        }
+    }
+    return -1;
+}
+
+int32_t
+StreamingNormalizer2::findLastBoundary(const uint8_t *s, int32_t start, int32_t limit) const {
+    int32_t i = limit;
+    while (i > start) {
+        UChar32 c;
+        U8_PREV(s, start, i, c);
+        if (c < 0 || norm2.hasBoundaryBefore(c)) {
+            return i;
+        }
+    }
+    return start;
+}
+
+UnicodeString &
+StreamingNormalizer2::normalize(const char16_t *src, int32_t length,
+                                UnicodeString &dest, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return dest;
+    }
+    if ((src == nullptr && length != 0) || length < -1) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return dest;
+    }
+    if (pending8 != nullptr && !pending8->isEmpty()) {
+        errorCode = U_INVALID_STATE_ERROR;
+        return dest;
+    }
+    if (length < 0) {
+        length = u_strlen(src);
+    }
+    // Do not look at a lead surrogate at the end; it may be completed by the next chunk.
+    int32_t limit = length;
+    if (limit > 0 && U16_IS_LEAD(src[limit - 1])) {
+        --limit;
+    }
+    int32_t start = 0;
+    if (!pending.isEmpty()) {
+        // The beginning of the chunk continues the pending segment
+        // up to the first boundary.
+        int32_t i = (length > 0 && U16_IS_TRAIL(src[0])) ? 1 : 0;
+        start = findFirstBoundary(src, i, limit);
+        if (start < 0) {
+            pending.append(src, 0, length);
+            return dest;
+        }
+        pending.append(src, 0, start);
+        norm2.normalizeSecondAndAppend(dest, pending, errorCode);
+        pending.remove();
+    }
+    int32_t last = findLastBoundary(src, start, limit);
+    if (start < last) {
+        // Read-only alias: Normalize this part of the chunk without copying it.
+        norm2.normalizeSecondAndAppend(dest, UnicodeString(FALSE, src + start, last - start),
+                                       errorCode);
+    }
+    pending.append(src, last, length - last);
+    return dest;
+}
+
+UnicodeString &
+StreamingNormalizer2::finish(UnicodeString &dest, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return dest;
+    }
+    if (!pending.isEmpty()) {
+        norm2.normalizeSecondAndAppend(dest, pending, errorCode);
+        pending.remove();
+    }
+    return dest;
+}
+
+void
+StreamingNormalizer2::normalizeUTF8(uint32_t options, StringPiece src, ByteSink &sink,
+                                    Edits *edits, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (!pending.isEmpty()) {
+        errorCode = U_INVALID_STATE_ERROR;
+        return;
+    }
+    if (pending8 == nullptr) {
+        pending8 = new CharString();
+        if (pending8 == nullptr) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+    }
+    options |= U_EDITS_NO_RESET;
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(src.data());
+    int32_t length = src.length();
+    // Do not look at a truncated sequence at the end; it may be completed by the next chunk.
+    int32_t limit = length - truncatedUTF8SuffixLength(s, length);
+    int32_t start = 0;
+    if (!pending8->isEmpty()) {
+        // The beginning of the chunk continues the pending segment
+        // up to the first boundary, including trail bytes
+        // that complete a truncated sequence.
+        int32_t i = 0;
+        while (i < 3 && i < length && U8_IS_TRAIL(s[i])) { ++i; }
+        start = findFirstBoundary(s, i, limit);
+        if (start < 0) {
+            pending8->append(src.data(), length, errorCode);
+            sink.Flush();
+            return;
+        }
+        pending8->append(src.data(), start, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        norm2.normalizeUTF8(options, pending8->toStringPiece(), sink, edits, errorCode);
+        pending8->clear();
+    }
+    int32_t last = findLastBoundary(s, start, limit);
+    if (start < last) {
+        norm2.normalizeUTF8(options, StringPiece(src.data() + start, last - start),
+                            sink, edits, errorCode);
+    }
+    pending8->append(src.data() + last, length - last, errorCode);
+    sink.Flush();
+}
+
+void
+StreamingNormalizer2::finishUTF8(uint32_t options, ByteSink &sink, Edits *edits,
+                                 UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (pending8 != nullptr && !pending8->isEmpty()) {
+        norm2.normalizeUTF8(options | U_EDITS_NO_RESET, pending8->toStringPiece(),
+                            sink, edits, errorCode);
+        pending8->clear();
+    }
+    sink.Flush();
+}
+
+/**
+ * Backs the C API: Keeps the output buffers across calls,
+ * and restores the pending text when the output does not fit,
+ * so that the caller can pass the same chunk again.
+ */
+struct StreamingNormalizer2Wrapper : public UMemory {
+    StreamingNormalizer2Wrapper(const Normalizer2 &n2) : sn(n2) {}
+
+    void savePending(UErrorCode &errorCode) {
+        savedPending = sn.pending;
+        savedPending8.clear();
+        if (sn.pending8 != nullptr) {
+            savedPending8.append(*sn.pending8, errorCode);
+        }
+    }
+    void restorePending() {
+        sn.pending = savedPending;
+        if (sn.pending8 != nullptr) {
+            UErrorCode errorCode = U_ZERO_ERROR;  // no allocation: pending8 had this capacity
+            sn.pending8->clear().append(savedPending8, errorCode);
+        }
+    }
+
+    StreamingNormalizer2 sn;
+    UnicodeString out;
+    CharString out8;
+    UnicodeString savedPending;
+    CharString savedPending8;
+};
+
+U_NAMESPACE_END
+
+U_NAMESPACE_USE
+
+U_CAPI UStreamingNormalizer2 * U_EXPORT2
+unorm2_openStreaming(const UNormalizer2 *norm2, UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if(norm2==NULL) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    StreamingNormalizer2Wrapper *w=
+        new StreamingNormalizer2Wrapper(*reinterpret_cast<const Normalizer2 *>(norm2));
+    if(w==NULL) {
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+    }
+    return reinterpret_cast<UStreamingNormalizer2 *>(w);
+}
+
+U_CAPI void U_EXPORT2
+unorm2_closeStreaming(UStreamingNormalizer2 *sn) {
+    delete reinterpret_cast<StreamingNormalizer2Wrapper *>(sn);
+}
+
+U_CAPI int32_t U_EXPORT2
+unorm2_normalizeStreaming(UStreamingNormalizer2 *sn,
+                          const UChar *src, int32_t length, UBool flush,
+                          UChar *dest, int32_t capacity,
+                          UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(sn==NULL || (src==NULL && length!=0) || length<-1 ||
+            (dest==NULL ? capacity!=0 : capacity<0)) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    StreamingNormalizer2Wrapper &w=*reinterpret_cast<StreamingNormalizer2Wrapper *>(sn);
+    w.savePending(*pErrorCode);
+    w.out.remove();
+    if(length!=0) {
+        w.sn.normalize(src, length, w.out, *pErrorCode);
+    }
+    if(flush) {
+        w.sn.finish(w.out, *pErrorCode);
+    }
+    if(U_FAILURE(*pErrorCode)) {
+        w.restorePending();
+        return 0;
+    }
+    int32_t outLength=w.out.extract(dest, capacity, *pErrorCode);
+    if(*pErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+        w.restorePending();
+    }
+    return outLength;
+}
+
+U_CAPI int32_t U_EXPORT2
+unorm2_normalizeStreamingUTF8(UStreamingNormalizer2 *sn,
+                              const char *src, int32_t length, UBool flush,
+                              char *dest, int32_t capacity,
+                              UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(sn==NULL || (src==NULL && length!=0) || length<-1 ||
+            (dest==NULL ? capacity!=0 : capacity<0)) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    StreamingNormalizer2Wrapper &w=*reinterpret_cast<StreamingNormalizer2Wrapper *>(sn);
+    w.savePending(*pErrorCode);
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    w.out8.clear();
+    {
+        CharStringByteSink sink(&w.out8);
+        if(length!=0) {
+            w.sn.normalizeUTF8(0, length<0 ? StringPiece(src) : StringPiece(src, length),
+                               sink, NULL, *pErrorCode);
+        }
+        if(flush) {
+            w.sn.finishUTF8(0, sink, NULL, *pErrorCode);
+        }
+    }
+    if(U_FAILURE(*pErrorCode)) {
+        w.restorePending();
+        return 0;
+    }
+    int32_t outLength=w.out8.length();
+    if(outLength<=capacity && outLength>0) {
+        uprv_memcpy(dest, w.out8.data(), outLength);
+    }
+    u_terminateChars(dest, capacity, outLength, pErrorCode);
+    if(*pErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+        w.restorePending();
+    }
+    return outLength;
+}
+
+#endif  // !UCONFIG_NO_NORMALIZATION
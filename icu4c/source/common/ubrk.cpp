@@ -353,5 +353,44 @@ ubrk_getBinaryRules(UBreakIterator *bi,
     return (int32_t)rulesLength;
 }
 
+U_CAPI int32_t U_EXPORT2
+ubrk_getBoundaries(UBreakIterator *bi, int32_t start,
+                   int32_t *boundaries, int32_t *ruleStatus, int32_t capacity,
+                   UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    BreakIterator *brkit = reinterpret_cast<BreakIterator*>(bi);
+    RuleBasedBreakIterator *rbbi = dynamic_cast<RuleBasedBreakIterator*>(brkit);
+    if (rbbi != NULL) {
+        return rbbi->getBoundaries(start, boundaries, ruleStatus, capacity, *status);
+    }
+    // Other BreakIterator subclasses, for example with sentence break suppressions.
+    if (capacity < 0 || (boundaries == NULL && capacity > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t length = 0;
+    if (capacity > 0) {
+        int32_t pos = brkit->following(start < 0 ? 0 : start);
+        while (pos != UBRK_DONE) {
+            boundaries[length] = pos;
+            if (ruleStatus != NULL) {
+                ruleStatus[length] = brkit->getRuleStatus();
+            }
+            if (++length == capacity) {
+                break;
+            }
+            pos = brkit->next();
+        }
+        if (length > 0) {
+            // Leave the iterator on the last boundary, not past the end.
+            brkit->isBoundary(boundaries[length - 1]);
+        }
+    }
+    return length;
+}
+
 
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -25,6 +25,9 @@
 
 #if !UCONFIG_NO_CONVERSION
 
+#include <new>
+#include <thread>
+
 #include "unicode/putil.h"
 #include "unicode/udata.h"
 #include "unicode/ucnv.h"
@@ -194,9 +197,73 @@ static struct {
 
 /*initializes some global variables */
 static UHashtable *SHARED_DATA_HASHTABLE = NULL;
-static icu::UMutex cnvCacheMutex = U_MUTEX_INITIALIZER;  /* Mutex for synchronizing cnv cache access. */
-                                                         /*  Note:  the global mutex is used for      */
-                                                         /*         reference count updates.          */
+static icu::UMutex cnvCacheMutex = U_MUTEX_INITIALIZER;  /* Mutex for synchronizing cnv cache changes. */
+                                                         /*  Note:  reference counts are updated      */
+                                                         /*         atomically, without the mutex.    */
+
+/*
+ * Read-only copy of SHARED_DATA_HASHTABLE for looking up cached converters
+ * without cnvCacheMutex. It is an open-addressing table with linear probing,
+ * keyed by staticData->name like the hashtable.
+ *
+ * Whenever the hashtable changes (while holding cnvCacheMutex),
+ * a new snapshot is built and published, and the old one is retired.
+ * After releasing the mutex, the writer frees retired snapshots once
+ * all lookups that might still use them have finished.
+ * Lookups announce themselves in gSnapshotReaders[gSnapshotEpoch];
+ * see ucnv_waitForSnapshotReaders().
+ */
+typedef struct SharedDataSnapshot {
+    struct SharedDataSnapshot *next;    /* next retired snapshot */
+    int32_t mask;                       /* capacity-1, the capacity is a power of 2 */
+    UConverterSharedData *entries[1];   /* NULL for an empty slot */
+} SharedDataSnapshot;
+
+static std::atomic<SharedDataSnapshot *> gSharedDataSnapshot(NULL);
+static SharedDataSnapshot *gRetiredSnapshots = NULL;    /* guarded by cnvCacheMutex */
+/* Serializes ucnv_waitForSnapshotReaders(); lookups never lock it. */
+static icu::UMutex snapshotReadersMutex = U_MUTEX_INITIALIZER;
+static icu::u_atomic_int32_t gSnapshotEpoch = ATOMIC_INT32_T_INITIALIZER(0);
+static icu::u_atomic_int32_t gSnapshotReaders[2] = {
+    ATOMIC_INT32_T_INITIALIZER(0), ATOMIC_INT32_T_INITIALIZER(0)
+};
+
+/*
+ * Reference count value for cached shared data that ucnv_flushCache()
+ * is deleting. Lookups without the mutex must not add references to it.
+ */
+#define UCNV_DELETED_REFERENCE_COUNT (-1)
+
+/*
+ * UConverterSharedData::referenceCounter is a plain int32_t so that C code
+ * sees the same struct layout and static shared data can be initialized.
+ * ucnv_data_unFlattenClone() constructs a u_atomic_int32_t in its place
+ * for each reference-counted shared data, and all further accesses go through that.
+ */
+static_assert(sizeof(icu::u_atomic_int32_t) == sizeof(int32_t) &&
+              alignof(icu::u_atomic_int32_t) == alignof(int32_t),
+              "u_atomic_int32_t must fit into UConverterSharedData::referenceCounter");
+
+static inline void
+ucnv_initReferenceCounter(UConverterSharedData *sharedData) {
+    int32_t count = sharedData->referenceCounter;
+    new(&sharedData->referenceCounter) icu::u_atomic_int32_t(count);
+}
+
+static inline icu::u_atomic_int32_t *
+getReferenceCounter(UConverterSharedData *sharedData) {
+    return reinterpret_cast<icu::u_atomic_int32_t *>(&sharedData->referenceCounter);
+}
+
+/* Frees a list of retired snapshots that no lookup can still be using. */
+static void
+ucnv_freeSnapshots(SharedDataSnapshot *snapshot) {
+    while (snapshot != NULL) {
+        SharedDataSnapshot *next = snapshot->next;
+        uprv_free(snapshot);
+        snapshot = next;
+    }
+}
 
 static const char **gAvailableConverters = NULL;
 static uint16_t gAvailableConverterCount = 0;
@@ -243,6 +310,14 @@ ucnv_flushAvailableConverterCache() {
 /*                Not supported API.                                          */
 static UBool U_CALLCONV ucnv_cleanup(void) {
     ucnv_flushCache();
+    /*
+     * The snapshot may still list converters that are in use.
+     * Cleanup is not thread safe, so no lookup can be using the snapshot itself.
+     * Later lookups fall back to ucnv_load() until a new one is published.
+     */
+    uprv_free(gSharedDataSnapshot.exchange(NULL));
+    ucnv_freeSnapshots(gRetiredSnapshots);
+    gRetiredSnapshots = NULL;
     if (SHARED_DATA_HASHTABLE != NULL && uhash_count(SHARED_DATA_HASHTABLE) == 0) {
         uhash_close(SHARED_DATA_HASHTABLE);
         SHARED_DATA_HASHTABLE = NULL;
@@ -315,6 +390,7 @@ ucnv_data_unFlattenClone(UConverterLoadArgs *pArgs, UDataMemory *pData, UErrorCo
 
     /* copy initial values from the static structure for this type */
     uprv_memcpy(data, converterData[type], sizeof(UConverterSharedData));
+    ucnv_initReferenceCounter(data);
 
     data->staticData = source;
 
@@ -426,6 +502,98 @@ getAlgorithmicTypeFromName(const char *realName)
 */
 #define UCNV_CACHE_LOAD_FACTOR 2
 
+/*
+ * Waits until lookups that may have seen an unpublished snapshot have finished.
+ * Must be called without cnvCacheMutex, after publishing the new snapshot,
+ * so that neither lookups nor other cache changes wait for it.
+ *
+ * A lookup adds itself to gSnapshotReaders[epoch] before it loads the snapshot pointer,
+ * so any lookup that loaded the old pointer is counted in one of the two counters.
+ * Switching the epoch before waiting for a counter lets that counter drain
+ * even while new lookups keep starting.
+ *
+ * A counted lookup only hashes the name, probes the snapshot and
+ * increments a reference counter; it takes no locks and does not allocate.
+ * After the epoch switch no new lookup joins the counter being drained,
+ * so each wait lasts at most as long as the slowest of those in-flight lookups
+ * (plus the time until its thread is scheduled again).
+ * We yield rather than spin so that a descheduled lookup thread can run.
+ */
+static void
+ucnv_waitForSnapshotReaders() {
+    icu::Mutex lock(&snapshotReadersMutex);
+    for (int32_t i = 0; i < 2; ++i) {
+        int32_t epoch = gSnapshotEpoch.load();
+        gSnapshotEpoch.store(epoch ^ 1);
+        while (gSnapshotReaders[epoch].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*
+ * Replaces the lookup snapshot with a copy of the current SHARED_DATA_HASHTABLE,
+ * and adds the old one to gRetiredSnapshots.
+ * Must be called inside umtx_lock(&cnvCacheMutex).
+ * If memory allocation fails, then no snapshot is published and
+ * all lookups fall back to ucnv_load() until the next change.
+ */
+static void
+ucnv_publishSharedDataSnapshot() {
+    SharedDataSnapshot *snapshot = NULL;
+    int32_t count = SHARED_DATA_HASHTABLE != NULL ? uhash_count(SHARED_DATA_HASHTABLE) : 0;
+    if (count > 0) {
+        int32_t capacity = 8;
+        while (capacity < count * UCNV_CACHE_LOAD_FACTOR) {
+            capacity <<= 1;
+        }
+        snapshot = (SharedDataSnapshot *)uprv_malloc(
+            sizeof(SharedDataSnapshot) + (capacity - 1) * sizeof(UConverterSharedData *));
+        if (snapshot != NULL) {
+            snapshot->mask = capacity - 1;
+            uprv_memset(snapshot->entries, 0, capacity * sizeof(UConverterSharedData *));
+            int32_t pos = UHASH_FIRST;
+            const UHashElement *e;
+            while ((e = uhash_nextElement(SHARED_DATA_HASHTABLE, &pos)) != NULL) {
+                int32_t i = e->hashcode & snapshot->mask;
+                while (snapshot->entries[i] != NULL) {
+                    i = (i + 1) & snapshot->mask;
+                }
+                snapshot->entries[i] = (UConverterSharedData *)e->value.pointer;
+            }
+        }
+    }
+    SharedDataSnapshot *oldSnapshot = gSharedDataSnapshot.exchange(snapshot);
+    if (oldSnapshot != NULL) {
+        oldSnapshot->next = gRetiredSnapshots;
+        gRetiredSnapshots = oldSnapshot;
+    }
+}
+
+/*
+ * Returns the retired snapshots and empties the list.
+ * Must be called inside umtx_lock(&cnvCacheMutex).
+ * Pass the result to ucnv_freeRetiredSnapshots() after unlocking the mutex.
+ */
+static SharedDataSnapshot *
+ucnv_takeRetiredSnapshots() {
+    SharedDataSnapshot *retired = gRetiredSnapshots;
+    gRetiredSnapshots = NULL;
+    return retired;
+}
+
+/*
+ * Frees snapshots from ucnv_takeRetiredSnapshots() once no lookup can still be using them.
+ * Must be called without cnvCacheMutex.
+ */
+static void
+ucnv_freeRetiredSnapshots(SharedDataSnapshot *retired) {
+    if (retired != NULL) {
+        ucnv_waitForSnapshotReaders();
+        ucnv_freeSnapshots(retired);
+    }
+}
+
 /* Puts the shared data in the static hashtable SHARED_DATA_HASHTABLE */
 /*   Will always be called with the cnvCacheMutex alrady being held   */
 /*     by the calling function.                                       */
@@ -470,6 +638,7 @@ ucnv_shareConverterData(UConverterSharedData * data)
             data,
             &err);
     UCNV_DEBUG_LOG("put", data->staticData->name,data);
+    ucnv_publishSharedDataSnapshot();
 
 }
 
@@ -497,6 +666,45 @@ ucnv_getSharedConverterData(const char *name)
     }
 }
 
+/*  Look up a converter name in the lookup snapshot, without cnvCacheMutex, */
+/*    and add a reference to the shared data if it is found.                */
+/* @param name The name of the shared data
+ * @return the referenced shared data, or NULL if it is not in the snapshot
+ *         or it is being deleted; then call ucnv_load() inside the mutex
+ */
+static UConverterSharedData *
+ucnv_getSharedConverterDataLockFree(const char *name)
+{
+    UConverterSharedData *rc = NULL;
+    int32_t epoch = gSnapshotEpoch.load();
+    gSnapshotReaders[epoch].fetch_add(1);
+    const SharedDataSnapshot *snapshot = gSharedDataSnapshot.load();
+    if (snapshot != NULL) {
+        UHashTok key;
+        key.pointer = (void *)name;
+        int32_t i = uhash_hashChars(key) & snapshot->mask;
+        UConverterSharedData *data;
+        while ((data = snapshot->entries[i]) != NULL) {
+            if (uprv_strcmp(data->staticData->name, name) == 0) {
+                /* One more client, unless ucnv_flushCache() is deleting it. */
+                icu::u_atomic_int32_t *counter = getReferenceCounter(data);
+                int32_t count = counter->load();
+                while (count >= 0) {
+                    if (counter->compare_exchange_weak(count, count + 1)) {
+                        rc = data;
+                        break;
+                    }
+                }
+                break;
+            }
+            i = (i + 1) & snapshot->mask;
+        }
+    }
+    gSnapshotReaders[epoch].fetch_sub(1);
+    UCNV_DEBUG_LOG("get",name,rc);
+    return rc;
+}
+
 /*frees the string of memory blocks associates with a sharedConverter
  *if and only if the referenceCounter == 0
  */
@@ -514,7 +722,7 @@ ucnv_deleteSharedConverterData(UConverterSharedData * deadSharedData)
     UTRACE_ENTRY_OC(UTRACE_UCNV_UNLOAD);
     UTRACE_DATA2(UTRACE_OPEN_CLOSE, "unload converter %s shared data %p", deadSharedData->staticData->name, deadSharedData);
 
-    if (deadSharedData->referenceCounter > 0) {
+    if (icu::umtx_loadAcquire(*getReferenceCounter(deadSharedData)) > 0) {
         UTRACE_EXIT_VALUE((int32_t)FALSE);
         return FALSE;
     }
@@ -571,7 +779,7 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
     {
         /* The data for this converter was already in the cache.            */
         /* Update the reference counter on the shared data: one more client */
-        mySharedConverterData->referenceCounter++;
+        icu::umtx_atomic_inc(getReferenceCounter(mySharedConverterData));
     }
 
     return mySharedConverterData;
@@ -579,17 +787,23 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
 
 /**
  * Unload a non-algorithmic converter.
- * It must be sharedData->isReferenceCounted
- * and this function must be called inside umtx_lock(&cnvCacheMutex).
+ * It must be sharedData->isReferenceCounted.
+ * The reference counter is updated atomically; cnvCacheMutex is not needed.
  */
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData) {
     if(sharedData != NULL) {
-        if (sharedData->referenceCounter > 0) {
-            sharedData->referenceCounter--;
-        }
+        /*
+         * Read this while we still hold a reference:
+         * ucnv_flushCache() changes it only for unreferenced shared data.
+         */
+        UBool isCached = sharedData->sharedDataCached;
+        icu::u_atomic_int32_t *counter = getReferenceCounter(sharedData);
+        int32_t count = counter->load();
+        while (count > 0 && !counter->compare_exchange_weak(count, count - 1)) {}
 
-        if((sharedData->referenceCounter <= 0)&&(sharedData->sharedDataCached == FALSE)) {
+        /* count is the value before the decrement */
+        if((count <= 1)&&(isCached == FALSE)) {
             ucnv_deleteSharedConverterData(sharedData);
         }
     }
@@ -599,9 +813,7 @@ U_CFUNC void
 ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData)
 {
     if(sharedData != NULL && sharedData->isReferenceCounted) {
-        umtx_lock(&cnvCacheMutex);
         ucnv_unload(sharedData);
-        umtx_unlock(&cnvCacheMutex);
     }
 }
 
@@ -609,9 +821,7 @@ U_CFUNC void
 ucnv_incrementRefCount(UConverterSharedData *sharedData)
 {
     if(sharedData != NULL && sharedData->isReferenceCounted) {
-        umtx_lock(&cnvCacheMutex);
-        sharedData->referenceCounter++;
-        umtx_unlock(&cnvCacheMutex);
+        icu::umtx_atomic_inc(getReferenceCounter(sharedData));
     }
 }
 
@@ -805,19 +1015,26 @@ ucnv_loadSharedData(const char *converterName,
     if (mySharedConverterData == NULL)
     {
         /* it is a data-based converter, get its shared data.               */
-        /* Hold the cnvCacheMutex through the whole process of checking the */
-        /*   converter data cache, and adding new entries to the cache      */
-        /*   to prevent other threads from modifying the cache during the   */
-        /*   process.                                                       */
+        /* Converters that are already cached are found without the mutex.  */
+        /* Otherwise hold the cnvCacheMutex through the whole process of    */
+        /*   checking the converter data cache, and adding new entries to   */
+        /*   the cache to prevent other threads from modifying the cache    */
+        /*   during the process.                                            */
         pArgs->nestedLoads=1;
         pArgs->pkg=NULL;
 
-        umtx_lock(&cnvCacheMutex);
-        mySharedConverterData = ucnv_load(pArgs, err);
-        umtx_unlock(&cnvCacheMutex);
-        if (U_FAILURE (*err) || (mySharedConverterData == NULL))
+        mySharedConverterData = ucnv_getSharedConverterDataLockFree(pArgs->name);
+        if (mySharedConverterData == NULL)
         {
-            return NULL;
+            umtx_lock(&cnvCacheMutex);
+            mySharedConverterData = ucnv_load(pArgs, err);
+            SharedDataSnapshot *retired = ucnv_takeRetiredSnapshots();
+            umtx_unlock(&cnvCacheMutex);
+            ucnv_freeRetiredSnapshots(retired);
+            if (U_FAILURE (*err) || (mySharedConverterData == NULL))
+            {
+                return NULL;
+            }
         }
     }
 
@@ -1054,43 +1271,93 @@ ucnv_flushCache ()
     * table
     *
     * Synchronization:  holding cnvCacheMutex will prevent any other thread from
-    *                   accessing or modifying the hash table during the iteration.
+    *                   modifying the hash table during the iteration.
     *                   The reference count of an entry may be decremented by
     *                   ucnv_close while the iteration is in process, but this is
-    *                   benign.  It can't be incremented (in ucnv_createConverter())
-    *                   because the sequence of looking up in the cache + incrementing
-    *                   is protected by cnvCacheMutex.
+    *                   benign.  Lookups without the mutex may increment it, so
+    *                   an unused entry is first marked as deleted with an atomic
+    *                   compare-and-swap from 0, which makes those lookups fail.
+    *                   After a new snapshot without it has been published,
+    *                   the mutex is released, and the entry is deleted
+    *                   once lookups in the old snapshot have finished.
     */
-    umtx_lock(&cnvCacheMutex);
     /*
      * double loop: A delta/extension-only converter has a pointer to its base table's
      * shared data; the first iteration of the outer loop may see the delta converter
      * before the base converter, and unloading the delta converter may get the base
      * converter's reference counter down to 0.
+     *
+     * If the array for all of the unused entries cannot be allocated,
+     * then they are deleted in batches of the stack array capacity.
      */
+    icu::MaybeStackArray<UConverterSharedData *, 16> unusedSharedData;
     i = 0;
-    do {
+    for (;;) {
+        int32_t unusedCount = 0;
+        UBool isBatchFull = FALSE;
+
+        umtx_lock(&cnvCacheMutex);
+        remaining = uhash_count(SHARED_DATA_HASHTABLE);
+        if (remaining == 0) {
+            umtx_unlock(&cnvCacheMutex);
+            break;
+        }
+        if (remaining > unusedSharedData.getCapacity()) {
+            unusedSharedData.resize(remaining);  /* keeps the old array if this fails */
+        }
+        int32_t capacity = unusedSharedData.getCapacity();
+
         remaining = 0;
         pos = UHASH_FIRST;
         while ((e = uhash_nextElement (SHARED_DATA_HASHTABLE, &pos)) != NULL)
         {
+            if (unusedCount == capacity) {
+                isBatchFull = TRUE;
+                break;
+            }
             mySharedData = (UConverterSharedData *) e->value.pointer;
             /*deletes only if reference counter == 0 */
-            if (mySharedData->referenceCounter == 0)
+            int32_t count = 0;
+            if (getReferenceCounter(mySharedData)->compare_exchange_strong(
+                    count, UCNV_DELETED_REFERENCE_COUNT))
             {
-                tableDeletedNum++;
-
                 UCNV_DEBUG_LOG("del",mySharedData->staticData->name,mySharedData);
 
                 uhash_removeElement(SHARED_DATA_HASHTABLE, e);
                 mySharedData->sharedDataCached = FALSE;
-                ucnv_deleteSharedConverterData (mySharedData);
+                unusedSharedData[unusedCount++] = mySharedData;
             } else {
                 ++remaining;
             }
         }
-    } while(++i == 1 && remaining > 0);
-    umtx_unlock(&cnvCacheMutex);
+
+        if (unusedCount > 0) {
+            ucnv_publishSharedDataSnapshot();
+        }
+        SharedDataSnapshot *retired = ucnv_takeRetiredSnapshots();
+        umtx_unlock(&cnvCacheMutex);
+
+        if (unusedCount > 0 || retired != NULL) {
+            /*
+             * Wait even without a retired snapshot: A lookup may still be using
+             * one that another thread has taken and is waiting for.
+             */
+            ucnv_waitForSnapshotReaders();
+        }
+        if (unusedCount > 0) {
+            for (int32_t j = 0; j < unusedCount; ++j) {
+                mySharedData = unusedSharedData[j];
+                icu::umtx_storeRelease(*getReferenceCounter(mySharedData), 0);
+                ucnv_deleteSharedConverterData (mySharedData);
+            }
+            tableDeletedNum += unusedCount;
+        }
+        ucnv_freeSnapshots(retired);
+
+        if (!isBatchFull && (++i == 2 || remaining == 0)) {
+            break;
+        }
+    }
 
     UTRACE_DATA1(UTRACE_INFO, "ucnv_flushCache() exits with %d converters remaining", remaining);
 
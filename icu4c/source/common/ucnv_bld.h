@@ -95,7 +95,7 @@ typedef struct UConverterStaticData {   /* +offset: size */
  */
 struct UConverterSharedData {
     uint32_t structSize;            /* Size of this structure */
-    uint32_t referenceCounter;      /* used to count number of clients, unused for static/immutable SharedData */
+    int32_t referenceCounter;       /* used to count number of clients, unused for static/immutable SharedData; see ucnv_data_unFlattenClone() */
 
     const void *dataMemory;         /* from udata_openChoice() - for cleanup */
 
@@ -127,7 +127,7 @@ struct UConverterSharedData {
 /** UConverterSharedData initializer for static, non-reference-counted converters. */
 #define UCNV_IMMUTABLE_SHARED_DATA_INITIALIZER(pStaticData, pImpl) \
     { \
-        sizeof(UConverterSharedData), ~((uint32_t)0), \
+        sizeof(UConverterSharedData), -1, \
         NULL, pStaticData, FALSE, FALSE, pImpl, \
         0, UCNV_MBCS_TABLE_INITIALIZER \
     }
@@ -273,8 +273,8 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err);
 
 /**
  * Unload a non-algorithmic converter.
- * It must be sharedData->isReferenceCounted
- * and this function must be called inside umtx_lock(&cnvCacheMutex).
+ * It must be sharedData->isReferenceCounted.
+ * The reference counter is updated atomically, without cnvCacheMutex.
  */
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData);
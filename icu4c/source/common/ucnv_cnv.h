@@ -318,6 +318,17 @@ ucnv_toUWriteCodePoint(UConverter *cnv,
                        int32_t sourceIndex,
                        UErrorCode *pErrorCode);
 
+/*
+ * Internal implementation of ucnv_convert() etc. with preflighting,
+ * also the sequential case of ucnv_convertParallel().
+ * Does not reset the converters.
+ */
+U_CFUNC int32_t
+ucnv_internalConvert(UConverter *outConverter, UConverter *inConverter,
+                     char *target, int32_t targetCapacity,
+                     const char *source, int32_t sourceLength,
+                     UErrorCode *pErrorCode);
+
 #endif
 
 #endif /* UCNV_CNV */
@@ -1140,4 +1140,75 @@ ucnv_extGetUnicodeSet(const UConverterSharedData *sharedData,
     }
 }
 
+/* match boundaries --------------------------------------------------------- */
+
+/*
+ * Both tables are partitioned into sections, each with a header unit
+ * that contains the number of following units.
+ * The toUTable starts with the section for the initial byte,
+ * while all fromUTable sections are for code units after the initial code point.
+ */
+
+U_CFUNC UBool
+ucnv_extIsToUBoundary(const int32_t *cx, uint8_t b) {
+    const uint32_t *toUTable;
+    uint32_t value;
+    int32_t i, length, tableLength;
+
+    tableLength=cx[UCNV_EXT_TO_U_LENGTH];
+    if(tableLength<=0) {
+        return TRUE;
+    }
+    toUTable=UCNV_EXT_ARRAY(cx, UCNV_EXT_TO_U_INDEX, uint32_t);
+
+    /* initial byte: a partial match continues after b */
+    length=(int32_t)UCNV_EXT_TO_U_GET_BYTE(toUTable[0]);
+    value=ucnv_extFindToU(toUTable+1, length, b);
+    if(value!=0 && UCNV_EXT_TO_U_IS_PARTIAL(value)) {
+        return FALSE;
+    }
+
+    /* non-initial bytes */
+    for(i=1+length; i<tableLength; i+=1+length) {
+        length=(int32_t)UCNV_EXT_TO_U_GET_BYTE(toUTable[i]);
+        if(ucnv_extFindToU(toUTable+i+1, length, b)!=0) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+U_CFUNC UBool
+ucnv_extIsFromUBoundary(const int32_t *cx, UChar32 c) {
+    const uint16_t *stage12, *stage3;
+    const uint32_t *stage3b;
+    const UChar *fromUTableUChars;
+    uint32_t value;
+    int32_t i, j, length, tableLength;
+
+    /* initial code point: a partial match continues after c */
+    if((c>>10)<cx[UCNV_EXT_FROM_U_STAGE_1_LENGTH]) {
+        stage12=UCNV_EXT_ARRAY(cx, UCNV_EXT_FROM_U_STAGE_12_INDEX, uint16_t);
+        stage3=UCNV_EXT_ARRAY(cx, UCNV_EXT_FROM_U_STAGE_3_INDEX, uint16_t);
+        stage3b=UCNV_EXT_ARRAY(cx, UCNV_EXT_FROM_U_STAGE_3B_INDEX, uint32_t);
+        value=stage3b[UCNV_EXT_FROM_U(stage12, stage3, c>>10, c)];
+        if(value!=0 && UCNV_EXT_FROM_U_IS_PARTIAL(value)) {
+            return FALSE;
+        }
+    }
+
+    /* code units after the initial code point */
+    fromUTableUChars=UCNV_EXT_ARRAY(cx, UCNV_EXT_FROM_U_UCHARS_INDEX, UChar);
+    tableLength=cx[UCNV_EXT_FROM_U_LENGTH];
+    for(i=0; i<tableLength; i+=1+length) {
+        length=fromUTableUChars[i];
+        for(j=1; j<=length; ++j) {
+            if(fromUTableUChars[i+j]==c) {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
 #endif /* #if !UCONFIG_NO_LEGACY_CONVERSION */
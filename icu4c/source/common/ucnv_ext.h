@@ -404,6 +404,21 @@ ucnv_extGetUnicodeSet(const UConverterSharedData *sharedData,
                       UConverterSetFilter filter,
                       UErrorCode *pErrorCode);
 
+/*
+ * Returns TRUE if byte b neither starts nor continues a multi-byte toUnicode
+ * extension mapping, so that a match never includes b and a following byte.
+ */
+U_CFUNC UBool
+ucnv_extIsToUBoundary(const int32_t *cx, uint8_t b);
+
+/*
+ * Returns TRUE if the BMP code point c neither starts nor continues
+ * a multi-character fromUnicode extension mapping,
+ * so that a match never includes c and a following code point.
+ */
+U_CFUNC UBool
+ucnv_extIsFromUBoundary(const int32_t *cx, UChar32 c);
+
 /* toUnicode helpers -------------------------------------------------------- */
 
 #define UCNV_EXT_TO_U_BYTE_SHIFT 24
@@ -0,0 +1,421 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// ucnv_parallel.cpp
+// created: 2018nov05
+//
+// ucnv_convertParallel().
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/utf16.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "ucnv_bld.h"
+#include "ucnv_cnv.h"
+#include "ucnv_ext.h"
+#include "ucnvmbcs.h"
+#include "uparallel.h"
+#include "ustr_imp.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * The text is only split across threads if each thread gets at least this many bytes.
+ * Starting a thread costs about as much as converting a few tens of kilobytes.
+ */
+constexpr int32_t MIN_BYTES_PER_THREAD = 0x10000;
+
+/** Same as the pivot buffer of ucnv_convert(). */
+constexpr int32_t PIVOT_LENGTH = 1024;
+
+/**
+ * One slice [start, limit[ of the source,
+ * with the converters that convert it, and the resulting bytes.
+ */
+struct ConvertChunk : public UMemory {
+    const char *start = nullptr;
+    const char *limit = nullptr;
+    /** Clones of the caller's converters; not used for the first chunk. */
+    LocalUConverterPointer targetClone;
+    LocalUConverterPointer sourceClone;
+    LocalMemory<char> output;
+    int32_t capacity = 0;
+    int32_t length = 0;
+    UErrorCode errorCode = U_ZERO_ERROR;
+
+    UBool grow() {
+        int32_t newCapacity;
+        if (capacity == 0) {
+            // Most conversions at most double the number of bytes.
+            int64_t sourceLength = limit - start;
+            newCapacity = sourceLength < 0x3ffffff0 ? (int32_t)(2 * sourceLength + 16) : INT32_MAX;
+        } else if (capacity < 0x40000000) {
+            newCapacity = 2 * capacity;
+        } else if (capacity < INT32_MAX) {
+            newCapacity = INT32_MAX;
+        } else {
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return FALSE;
+        }
+        if (output.allocateInsteadAndCopy(newCapacity, length) == nullptr) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        capacity = newCapacity;
+        return TRUE;
+    }
+};
+
+/**
+ * Finds the places where the source can be cut:
+ * Right after a character that returns the source converter to its initial state
+ * with nothing pending (it also ends any preceding illegal sequence),
+ * and which is converted to a BMP code point that the target converter
+ * fully handles without looking at the next one.
+ * Conversion before and after such a cut is independent.
+ */
+class SourceCutter : public UMemory {
+public:
+    SourceCutter(const UConverter *targetCnv, const UConverter *sourceCnv);
+
+    /** @return TRUE if the source can be cut at all */
+    UBool isValid() const { return unitLength > 0; }
+
+    /**
+     * @return the first cut after a character that starts in [from, limit[,
+     *         or nullptr if there is none
+     */
+    const char *findCut(const char *start, const char *from, const char *limit) const;
+
+private:
+    UBool setTarget(const UConverter *targetCnv);
+    UBool isTargetBoundary(UChar32 c) const;
+
+    /** Number of bytes per code unit: 1, 2 or 4. 0 if the source cannot be cut. */
+    int32_t unitLength = 0;
+    UBool bigEndian = FALSE;
+    /** For unitLength==1. */
+    UBool cutAfterByte[256];
+    /** Conversion extension of the target converter, if any. */
+    const int32_t *targetExt = nullptr;
+};
+
+SourceCutter::SourceCutter(const UConverter *targetCnv, const UConverter *sourceCnv) {
+    if (!setTarget(targetCnv)) {
+        return;
+    }
+    UConverterType sourceType = ucnv_getType(sourceCnv);
+    switch (sourceType) {
+    case UCNV_UTF8:
+    case UCNV_CESU8:
+    case UCNV_US_ASCII:
+    case UCNV_LATIN_1:
+        // Any ASCII byte ends a UTF-8 sequence.
+        for (int32_t b = 0; b < 0x100; ++b) {
+            cutAfterByte[b] = (b < 0x80 || sourceType == UCNV_LATIN_1) && isTargetBoundary(b);
+        }
+        unitLength = 1;
+        break;
+    case UCNV_UTF16_BigEndian:
+    case UCNV_UTF16_LittleEndian:
+        // version=1 checks for a byte order mark at the start.
+        if (UCNV_GET_VERSION(sourceCnv) == 0) {
+            unitLength = 2;
+            bigEndian = sourceType == UCNV_UTF16_BigEndian;
+        }
+        return;
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        unitLength = 4;
+        bigEndian = sourceType == UCNV_UTF32_BigEndian;
+        return;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS: {
+        UChar32 resyncChars[256];
+        if (!ucnv_MBCSGetResyncChars(sourceCnv, resyncChars)) {
+            return;
+        }
+        for (int32_t b = 0; b < 0x100; ++b) {
+            cutAfterByte[b] = resyncChars[b] >= 0 && isTargetBoundary(resyncChars[b]);
+        }
+        unitLength = 1;
+        break;
+    }
+#endif
+    default:
+        // Stateful: ISO-2022, HZ, SCSU, BOCU-1, UTF-7, IMAP, ISCII, LMBCS, EBCDIC_STATEFUL, ...
+        // Also UTF-16 and UTF-32 which detect a byte order mark.
+        return;
+    }
+    for (int32_t b = 0; b < 0x100; ++b) {
+        if (cutAfterByte[b]) {
+            return;
+        }
+    }
+    unitLength = 0;
+}
+
+UBool SourceCutter::setTarget(const UConverter *targetCnv) {
+    switch (ucnv_getType(targetCnv)) {
+    case UCNV_UTF8:
+    case UCNV_CESU8:
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+    case UCNV_US_ASCII:
+    case UCNV_LATIN_1:
+        return TRUE;
+    case UCNV_UTF16_BigEndian:
+    case UCNV_UTF16_LittleEndian:
+        // version=1 writes a byte order mark at the start.
+        return UCNV_GET_VERSION(targetCnv) == 0;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS:
+        targetExt = targetCnv->sharedData->mbcs.extIndexes;
+        return TRUE;
+#endif
+    default:
+        return FALSE;
+    }
+}
+
+UBool SourceCutter::isTargetBoundary(UChar32 c) const {
+    // After a BMP code point, only an m:n extension mapping can be pending.
+    if (U_IS_SURROGATE(c)) {
+        return FALSE;
+    }
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    if (targetExt != nullptr) {
+        return ucnv_extIsFromUBoundary(targetExt, c);
+    }
+#endif
+    return TRUE;
+}
+
+const char *SourceCutter::findCut(const char *start, const char *from, const char *limit) const {
+    if (unitLength == 1) {
+        for (const char *p = from; p < limit; ++p) {
+            if (cutAfterByte[(uint8_t)*p]) {
+                return p + 1;
+            }
+        }
+        return nullptr;
+    }
+    // Start at a code unit boundary.
+    const uint8_t *p = (const uint8_t *)start + ((from - start + unitLength - 1) & ~(unitLength - 1));
+    // Compare the code unit limit, not limit - unitLength which could precede start.
+    for (; (int32_t)((const uint8_t *)limit - p) >= unitLength; p += unitLength) {
+        UChar32 c;
+        if (unitLength == 2) {
+            c = bigEndian ? ((p[0] << 8) | p[1]) : ((p[1] << 8) | p[0]);
+        } else if (bigEndian) {
+            c = p[0] == 0 && p[1] == 0 ? ((p[2] << 8) | p[3]) : -1;
+        } else {
+            c = p[3] == 0 && p[2] == 0 ? ((p[1] << 8) | p[0]) : -1;
+        }
+        if (c >= 0 && isTargetBoundary(c)) {
+            return (const char *)p + unitLength;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * ICU's own callbacks have no side effects, so they can be called concurrently
+ * and for text after an error that stops the conversion.
+ * Any other callback must see the same calls as with sequential conversion.
+ */
+UBool hasBuiltInCallbacks(const UConverter *cnv) {
+    UConverterToUCallback toU = cnv->fromCharErrorBehaviour;
+    UConverterFromUCallback fromU = cnv->fromUCharErrorBehaviour;
+    return (toU == UCNV_TO_U_CALLBACK_SUBSTITUTE || toU == UCNV_TO_U_CALLBACK_STOP ||
+            toU == UCNV_TO_U_CALLBACK_SKIP || toU == UCNV_TO_U_CALLBACK_ESCAPE) &&
+        (fromU == UCNV_FROM_U_CALLBACK_SUBSTITUTE || fromU == UCNV_FROM_U_CALLBACK_STOP ||
+            fromU == UCNV_FROM_U_CALLBACK_SKIP || fromU == UCNV_FROM_U_CALLBACK_ESCAPE);
+}
+
+/**
+ * Converts [chunk.start, chunk.limit[ as a complete text into chunk.output.
+ * Resets the converters first.
+ */
+void convertChunk(UConverter *targetCnv, UConverter *sourceCnv, ConvertChunk &chunk) {
+    UChar pivotBuffer[PIVOT_LENGTH];
+    UChar *pivotSource = pivotBuffer, *pivotTarget = pivotBuffer;
+    const char *source = chunk.start;
+    UBool reset = TRUE;
+    chunk.length = 0;
+    chunk.errorCode = U_ZERO_ERROR;
+    if (chunk.capacity == 0 && !chunk.grow()) {
+        return;
+    }
+    for (;;) {
+        char *output = chunk.output.getAlias();
+        char *t = output + chunk.length;
+        ucnv_convertEx(targetCnv, sourceCnv,
+                       &t, output + chunk.capacity,
+                       &source, chunk.limit,
+                       pivotBuffer, &pivotSource, &pivotTarget, pivotBuffer + PIVOT_LENGTH,
+                       reset, TRUE, &chunk.errorCode);
+        chunk.length = (int32_t)(t - output);
+        if (chunk.errorCode != U_BUFFER_OVERFLOW_ERROR) {
+            break;
+        }
+        chunk.errorCode = U_ZERO_ERROR;
+        reset = FALSE;
+        if (!chunk.grow()) {
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+U_NAMESPACE_END
+
+U_NAMESPACE_USE
+
+U_CAPI int32_t U_EXPORT2
+ucnv_convertParallel(UConverter *targetCnv, UConverter *sourceCnv,
+                     char *target, int32_t targetCapacity,
+                     const char *source, int32_t sourceLength,
+                     int32_t numThreads,
+                     UErrorCode *pErrorCode) {
+    if (pErrorCode == NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if (targetCnv == NULL || sourceCnv == NULL ||
+            source == NULL || sourceLength < -1 ||
+            targetCapacity < 0 || (target == NULL && targetCapacity > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (sourceLength < 0) {
+        sourceLength = (int32_t)uprv_strlen(source);
+    }
+    ucnv_resetToUnicode(sourceCnv);
+    ucnv_resetFromUnicode(targetCnv);
+
+    int32_t numChunks = getNumParallelChunks(sourceLength, numThreads, MIN_BYTES_PER_THREAD);
+    LocalPointer<SourceCutter> cutter;
+    UBool isFallback = FALSE;
+    if (numThreads > 1) {
+        if (hasBuiltInCallbacks(targetCnv) && hasBuiltInCallbacks(sourceCnv)) {
+            cutter.adoptInsteadAndCheckErrorCode(new SourceCutter(targetCnv, sourceCnv), *pErrorCode);
+            if (U_FAILURE(*pErrorCode)) {
+                return 0;
+            }
+            isFallback = !cutter->isValid();
+        } else {
+            isFallback = TRUE;
+        }
+    }
+    LocalArray<ConvertChunk> chunks;
+    if (numChunks > 1 && !isFallback) {
+        chunks.adoptInsteadAndCheckErrorCode(new ConvertChunk[numChunks], *pErrorCode);
+        if (U_FAILURE(*pErrorCode)) {
+            return 0;
+        }
+
+        // Cut the source after the first suitable character following each equal share of it.
+        // Fewer slices if there are few such characters.
+        const char *sourceLimit = source + sourceLength;
+        int32_t n = 1;
+        chunks[0].start = source;
+        for (int32_t i = 1; i < numChunks; ++i) {
+            const char *from = source + getParallelChunkStart(sourceLength, i, numChunks);
+            const char *to = source + getParallelChunkStart(sourceLength, i + 1, numChunks);
+            if (from < chunks[n - 1].start) {
+                from = chunks[n - 1].start;
+            }
+            const char *cut = cutter->findCut(source, from, to);
+            if (cut != nullptr && cut > chunks[n - 1].start && cut < sourceLimit) {
+                chunks[n - 1].limit = cut;
+                chunks[n++].start = cut;
+            }
+        }
+        chunks[n - 1].limit = sourceLimit;
+        numChunks = n;
+    }
+
+    if (numChunks <= 1 || isFallback) {
+        int32_t length = ucnv_internalConvert(targetCnv, sourceCnv,
+                                              target, targetCapacity,
+                                              source, sourceLength, pErrorCode);
+        if (isFallback && *pErrorCode == U_ZERO_ERROR) {
+            *pErrorCode = U_SEQUENTIAL_FALLBACK_WARNING;
+        }
+        return length;
+    }
+
+    for (int32_t i = 1; i < numChunks; ++i) {
+        ConvertChunk &chunk = chunks[i];
+        chunk.targetClone.adoptInstead(ucnv_safeClone(targetCnv, NULL, NULL, &chunk.errorCode));
+        chunk.sourceClone.adoptInstead(ucnv_safeClone(sourceCnv, NULL, NULL, &chunk.errorCode));
+        if (U_FAILURE(chunk.errorCode)) {
+            *pErrorCode = chunk.errorCode;
+            return 0;
+        }
+    }
+    // Each chunk keeps its own error code because a failed one is converted again below.
+    ConvertChunk *chunksArray = chunks.getAlias();
+    runParallelChunks(numChunks, [targetCnv, sourceCnv, chunksArray](int32_t i, UErrorCode &) {
+        ConvertChunk &chunk = chunksArray[i];
+        if (i == 0) {
+            convertChunk(targetCnv, sourceCnv, chunk);
+        } else {
+            convertChunk(chunk.targetClone.getAlias(), chunk.sourceClone.getAlias(), chunk);
+        }
+    }, *pErrorCode);
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    // The output ends with the first slice that failed.
+    // Convert that one again with the caller's converters so that they have
+    // the same error state as after sequential conversion.
+    int32_t total = 0;
+    UErrorCode errorCode = U_ZERO_ERROR;
+    for (int32_t i = 0; i < numChunks; ++i) {
+        ConvertChunk &chunk = chunks[i];
+        if (U_FAILURE(chunk.errorCode) && i > 0) {
+            convertChunk(targetCnv, sourceCnv, chunk);
+        }
+        if (chunk.length > INT32_MAX - total) {
+            *pErrorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        total += chunk.length;
+        if (U_FAILURE(chunk.errorCode)) {
+            errorCode = chunk.errorCode;
+            numChunks = i + 1;
+            break;
+        }
+    }
+
+    if (total <= targetCapacity) {
+        int32_t length = 0;
+        for (int32_t i = 0; i < numChunks; ++i) {
+            ConvertChunk &chunk = chunks[i];
+            if (chunk.length > 0) {
+                uprv_memcpy(target + length, chunk.output.getAlias(), chunk.length);
+                length += chunk.length;
+            }
+        }
+    }
+    if (U_FAILURE(errorCode)) {
+        *pErrorCode = errorCode;
+        return total;
+    }
+    return u_terminateChars(target, targetCapacity, total, pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_CONVERSION
@@ -33,6 +33,7 @@
 #include "ucnv_cnv.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "utfsimd.h"
 
 /* Prototypes --------------------------------------------------------------- */
 
@@ -74,6 +75,7 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
     UBool isCESU8 = hasCESU8Data(cnv);
     uint32_t ch, ch2 = 0;
     int32_t i, inBytes;
+    int32_t untilVector = 0;    /* code points to convert before trying the vector code */
 
     /* Restore size of current sequence */
     if (cnv->toULength > 0 && myTarget < targetLimit)
@@ -90,6 +92,21 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
 
     while (mySource < sourceLimit && myTarget < targetLimit)
     {
+        if (--untilVector < 0)
+        {
+            /* Convert blocks of well-formed 1..3-byte sequences with vector code. */
+            int32_t consumed;
+            myTarget += icu::UTFSIMD::fromUTF8(mySource, (int32_t)(sourceLimit - mySource),
+                                               myTarget, (int32_t)(targetLimit - myTarget),
+                                               &consumed, NULL, 0);
+            if (consumed > 0)
+            {
+                mySource += consumed;
+                untilVector = 1;    /* convert the sequence that stopped the vector code */
+                continue;
+            }
+            untilVector = icu::UTFSIMD::SCALAR_CHUNK_LENGTH;
+        }
         ch = *(mySource++);
         if (U8_IS_SINGLE(ch))        /* Simple case */
         {
@@ -192,6 +209,7 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeAr
     UBool isCESU8 = hasCESU8Data(cnv);
     uint32_t ch, ch2 = 0;
     int32_t i, inBytes;
+    int32_t untilVector = 0;    /* code points to convert before trying the vector code */
 
     /* Restore size of current sequence */
     if (cnv->toULength > 0 && myTarget < targetLimit)
@@ -207,6 +225,24 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeAr
 
     while (mySource < sourceLimit && myTarget < targetLimit)
     {
+        if (--untilVector < 0)
+        {
+            /* Convert blocks of well-formed 1..3-byte sequences with vector code. */
+            int32_t consumed;
+            int32_t length = icu::UTFSIMD::fromUTF8(mySource, (int32_t)(sourceLimit - mySource),
+                                                    myTarget, (int32_t)(targetLimit - myTarget),
+                                                    &consumed, myOffsets, offsetNum);
+            if (consumed > 0)
+            {
+                mySource += consumed;
+                myTarget += length;
+                myOffsets += length;
+                offsetNum += consumed;
+                untilVector = 1;    /* convert the sequence that stopped the vector code */
+                continue;
+            }
+            untilVector = icu::UTFSIMD::SCALAR_CHUNK_LENGTH;
+        }
         ch = *(mySource++);
         if (U8_IS_SINGLE(ch))        /* Simple case */
         {
@@ -310,6 +346,7 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args
     uint8_t tempBuf[4];
     int32_t indexToWrite;
     UBool isNotCESU8 = !hasCESU8Data(cnv);
+    int32_t untilVector = 0;    /* code points to convert before trying the vector code */
 
     if (cnv->fromUChar32 && myTarget < targetLimit)
     {
@@ -320,6 +357,21 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args
 
     while (mySource < sourceLimit && myTarget < targetLimit)
     {
+        if (--untilVector < 0)
+        {
+            /* Convert blocks without surrogates with vector code. */
+            int32_t consumed;
+            myTarget += icu::UTFSIMD::toUTF8(mySource, (int32_t)(sourceLimit - mySource),
+                                             myTarget, (int32_t)(targetLimit - myTarget),
+                                             &consumed, NULL, 0);
+            if (consumed > 0)
+            {
+                mySource += consumed;
+                untilVector = 1;    /* convert the code point that stopped the vector code */
+                continue;
+            }
+            untilVector = icu::UTFSIMD::SCALAR_CHUNK_LENGTH;
+        }
         ch = *(mySource++);
 
         if (ch < 0x80)        /* Single byte */
@@ -426,6 +478,7 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnic
     int32_t indexToWrite;
     uint8_t tempBuf[4];
     UBool isNotCESU8 = !hasCESU8Data(cnv);
+    int32_t untilVector = 0;    /* code points to convert before trying the vector code */
 
     if (cnv->fromUChar32 && myTarget < targetLimit)
     {
@@ -440,6 +493,24 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnic
 
     while (mySource < sourceLimit && myTarget < targetLimit)
     {
+        if (--untilVector < 0)
+        {
+            /* Convert blocks without surrogates with vector code. */
+            int32_t consumed;
+            int32_t length = icu::UTFSIMD::toUTF8(mySource, (int32_t)(sourceLimit - mySource),
+                                                  myTarget, (int32_t)(targetLimit - myTarget),
+                                                  &consumed, myOffsets, offsetNum);
+            if (consumed > 0)
+            {
+                mySource += consumed;
+                myTarget += length;
+                myOffsets += length;
+                offsetNum += consumed;
+                untilVector = 1;    /* convert the code point that stopped the vector code */
+                continue;
+            }
+            untilVector = icu::UTFSIMD::SCALAR_CHUNK_LENGTH;
+        }
         ch = *(mySource++);
 
         if (ch < 0x80)        /* Single byte */
@@ -58,6 +58,7 @@
 #include "ucnv_cnv.h"
 #include "cmemory.h"
 #include "cstring.h"
+#include "simdutil.h"
 #include "umutex.h"
 #include "ustr_imp.h"
 
@@ -431,6 +432,16 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                   UConverterToUnicodeArgs *pToUArgs,
                   UErrorCode *pErrorCode);
 
+static void U_CALLCONV
+ucnv_SBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode);
+
+static void U_CALLCONV
+ucnv_DBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode);
+
 static const UConverterImpl _SBCSUTF8Impl={
     UCNV_MBCS,
 
@@ -453,7 +464,7 @@ static const UConverterImpl _SBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_SBCSToUTF8,
     ucnv_SBCSFromUTF8
 };
 
@@ -479,7 +490,7 @@ static const UConverterImpl _DBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_DBCSToUTF8,
     ucnv_DBCSFromUTF8
 };
 
@@ -1874,6 +1885,51 @@ ucnv_MBCSLoad(UConverterSharedData *sharedData,
          */
         mbcsTable->asciiRoundtrips=0;
     }
+
+    /*
+     * Runs of ASCII bytes and characters that map to each other are copied in blocks.
+     * Some tables swap a few controls and DEL (like ibm-943 for Shift-JIS),
+     * or map 5C and 7E only in their extension table (like Shift-JIS itself).
+     * The block copy looks up controls and DEL, and up to two such printable bytes.
+     */
+    mbcsTable->asciiIdentity=FALSE;
+    uprv_memset(mbcsTable->asciiIdentitySet, 0, sizeof(mbcsTable->asciiIdentitySet));
+    if(mbcsTable->asciiRoundtrips!=0) {
+        int32_t countRecheck=0;
+        int32_t i;
+
+        mbcsTable->asciiRecheck[0]=mbcsTable->asciiRecheck[1]=0x7f;
+        for(i=0; i<0x80; ++i) {
+            if(mbcsTable->stateTable[0][i]==MBCS_ENTRY_FINAL(0, MBCS_STATE_VALID_DIRECT_16, i)) {
+                mbcsTable->asciiIdentitySet[i>>5]|=(uint32_t)1<<(i&0x1f);
+            } else if(0x20<=i && i<0x7f) {
+                if(countRecheck==2) {
+                    break;
+                }
+                mbcsTable->asciiRecheck[countRecheck++]=(uint8_t)i;
+            }
+        }
+        mbcsTable->asciiIdentity=(UBool)(i==0x80);
+    }
+
+    /*
+     * For SBCS-to-UTF-8 conversion, store the UTF-8 form of each byte
+     * that maps directly to a BMP code point, so that it can be copied without branches.
+     */
+    uprv_memset(mbcsTable->sbcsToUTF8, 0, sizeof(mbcsTable->sbcsToUTF8));
+    if(mbcsTable->countStates==1) {
+        int32_t i;
+
+        for(i=0; i<256; ++i) {
+            int32_t entry=mbcsTable->stateTable[0][i];
+            if(MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry)) {
+                UChar32 c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+                int32_t length=0;
+                U8_APPEND_UNSAFE(mbcsTable->sbcsToUTF8[i], length, c);
+                mbcsTable->sbcsToUTF8[i][3]=(uint8_t)length;
+            }
+        }
+    }
 }
 
 static void U_CALLCONV
@@ -2196,6 +2252,9 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
 
     int32_t entry;
     uint8_t action;
+    UBool asciiIdentity;
+    const uint32_t *asciiSet=NULL;
+    uint8_t recheck0=0, recheck1=0;
 
     /* set up the local pointers */
     cnv=pArgs->converter;
@@ -2207,8 +2266,13 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
 
     if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
         stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+        asciiIdentity=FALSE;
     } else {
         stateTable=cnv->sharedData->mbcs.stateTable;
+        asciiIdentity=cnv->sharedData->mbcs.asciiIdentity;
+        asciiSet=cnv->sharedData->mbcs.asciiIdentitySet;
+        recheck0=cnv->sharedData->mbcs.asciiRecheck[0];
+        recheck1=cnv->sharedData->mbcs.asciiRecheck[1];
     }
 
     /* sourceIndex=-1 if the current character began in the previous buffer */
@@ -2233,6 +2297,10 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
 
         loops=count=targetCapacity>>4;
         do {
+            /* leave ASCII runs to the block copy in the conversion loop */
+            if(asciiIdentity && icu::SIMDUtil::skipBelow(source, source+16, 0x80)==source+16) {
+                break;
+            }
             oredEntries=entry=stateTable[0][*source++];
             *target++=(UChar)MBCS_ENTRY_FINAL_VALUE_16(entry);
             oredEntries|=entry=stateTable[0][*source++];
@@ -2304,6 +2372,20 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
 
     /* conversion loop */
     while(targetCapacity > 0 && source < sourceLimit) {
+        if( asciiIdentity && *source<0x80 &&
+            (length=icu::SIMDUtil::widenASCII(source, target, targetCapacity, asciiSet, recheck0, recheck1))>0
+        ) {
+            /* widened a run of ASCII bytes in blocks; the offsets are set from lastSource */
+            source+=length;
+            target+=length;
+            targetCapacity-=length;
+#if MBCS_UNROLL_SINGLE_TO_BMP
+            goto unrolled;
+#else
+            continue;
+#endif
+        }
+
         entry=stateTable[0][*source++];
         /* MBCS_ENTRY_IS_FINAL(entry) */
 
@@ -2480,9 +2562,12 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
 
     int32_t sourceIndex, nextSourceIndex;
 
-    int32_t entry;
+    int32_t entry, length;
     UChar c;
     uint8_t action;
+    UBool asciiIdentity;
+    const uint32_t *asciiSet=NULL;
+    uint8_t recheck0=0, recheck1=0;
 
     /* use optimized function if possible */
     cnv=pArgs->converter;
@@ -2517,8 +2602,13 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
 
     if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
         stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+        asciiIdentity=FALSE;
     } else {
         stateTable=cnv->sharedData->mbcs.stateTable;
+        asciiIdentity=cnv->sharedData->mbcs.asciiIdentity;
+        asciiSet=cnv->sharedData->mbcs.asciiIdentitySet;
+        recheck0=cnv->sharedData->mbcs.asciiRecheck[0];
+        recheck1=cnv->sharedData->mbcs.asciiRecheck[1];
     }
     unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
 
@@ -2560,7 +2650,21 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
             /* optimized loop for 1/2-byte input and BMP output */
             if(offsets==NULL) {
                 do {
+                    /* load the entry first so that it is set on every path out of this loop */
                     entry=stateTable[state][*source];
+                    if(asciiIdentity && state==0 && *source<0x80) {
+                        /* widen a run of ASCII bytes in blocks */
+                        length=(int32_t)(sourceLimit-source);
+                        if(length>(targetLimit-target)) {
+                            length=(int32_t)(targetLimit-target);
+                        }
+                        length=icu::SIMDUtil::widenASCII(source, target, length, asciiSet, recheck0, recheck1);
+                        if(length>0) {
+                            source+=length;
+                            target+=length;
+                            continue;
+                        }
+                    }
                     if(MBCS_ENTRY_IS_TRANSITION(entry)) {
                         state=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
                         offset=MBCS_ENTRY_TRANSITION_OFFSET(entry);
@@ -2595,7 +2699,26 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
                 } while(source<sourceLimit && target<targetLimit);
             } else /* offsets!=NULL */ {
                 do {
+                    /* load the entry first so that it is set on every path out of this loop */
                     entry=stateTable[state][*source];
+                    if(asciiIdentity && state==0 && *source<0x80) {
+                        /* widen a run of ASCII bytes in blocks */
+                        length=(int32_t)(sourceLimit-source);
+                        if(length>(targetLimit-target)) {
+                            length=(int32_t)(targetLimit-target);
+                        }
+                        length=icu::SIMDUtil::widenASCII(source, target, length, asciiSet, recheck0, recheck1);
+                        if(length>0) {
+                            source+=length;
+                            target+=length;
+                            while(length>0) {
+                                *offsets++=sourceIndex++;
+                                --length;
+                            }
+                            nextSourceIndex=sourceIndex;
+                            continue;
+                        }
+                    }
                     if(MBCS_ENTRY_IS_TRANSITION(entry)) {
                         state=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
                         offset=MBCS_ENTRY_TRANSITION_OFFSET(entry);
@@ -3422,7 +3545,11 @@ ucnv_MBCSDoubleFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
     uint32_t stage2Entry;
     uint32_t asciiRoundtrips;
     uint32_t value;
+    int32_t length;
     uint8_t unicodeMask;
+    UBool asciiIdentity;
+    const uint32_t *asciiSet=NULL;
+    uint8_t recheck0=0, recheck1=0;
 
     /* use optimized function if possible */
     cnv=pArgs->converter;
@@ -3439,8 +3566,13 @@ ucnv_MBCSDoubleFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
     mbcsIndex=cnv->sharedData->mbcs.mbcsIndex;
     if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
         bytes=cnv->sharedData->mbcs.swapLFNLFromUnicodeBytes;
+        asciiIdentity=FALSE;
     } else {
         bytes=cnv->sharedData->mbcs.fromUnicodeBytes;
+        asciiIdentity=cnv->sharedData->mbcs.asciiIdentity;
+        asciiSet=cnv->sharedData->mbcs.asciiIdentitySet;
+        recheck0=cnv->sharedData->mbcs.asciiRecheck[0];
+        recheck1=cnv->sharedData->mbcs.asciiRecheck[1];
     }
     asciiRoundtrips=cnv->sharedData->mbcs.asciiRoundtrips;
 
@@ -3466,6 +3598,27 @@ ucnv_MBCSDoubleFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
          * then break the loop, too.
          */
         if(targetCapacity>0) {
+            if(asciiIdentity && *source<0x80) {
+                /* narrow a run of ASCII characters in blocks */
+                length=(int32_t)(sourceLimit-source);
+                if(length>targetCapacity) {
+                    length=targetCapacity;
+                }
+                length=icu::SIMDUtil::narrowASCII(source, target, length, asciiSet, recheck0, recheck1);
+                if(length>0) {
+                    source+=length;
+                    target+=length;
+                    targetCapacity-=length;
+                    nextSourceIndex+=length;
+                    if(offsets!=NULL) {
+                        while(length>0) {
+                            *offsets++=sourceIndex++;
+                            --length;
+                        }
+                    }
+                    continue;
+                }
+            }
             /*
              * Get a correct Unicode code point:
              * a single UChar for a BMP code point or
@@ -3828,6 +3981,9 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
 
     uint32_t asciiRoundtrips;
     uint16_t value, minValue;
+    UBool asciiIdentity;
+    const uint32_t *asciiSet=NULL;
+    uint8_t recheck0=0, recheck1=0;
 
     /* set up the local pointers */
     cnv=pArgs->converter;
@@ -3840,8 +3996,13 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
     table=cnv->sharedData->mbcs.fromUnicodeTable;
     if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
         results=(uint16_t *)cnv->sharedData->mbcs.swapLFNLFromUnicodeBytes;
+        asciiIdentity=FALSE;
     } else {
         results=(uint16_t *)cnv->sharedData->mbcs.fromUnicodeBytes;
+        asciiIdentity=cnv->sharedData->mbcs.asciiIdentity;
+        asciiSet=cnv->sharedData->mbcs.asciiIdentitySet;
+        recheck0=cnv->sharedData->mbcs.asciiRecheck[0];
+        recheck1=cnv->sharedData->mbcs.asciiRecheck[1];
     }
     asciiRoundtrips=cnv->sharedData->mbcs.asciiRoundtrips;
 
@@ -3924,6 +4085,15 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
 #endif
 
     while(targetCapacity>0) {
+        if( asciiIdentity && *source<0x80 &&
+            (length=icu::SIMDUtil::narrowASCII(source, target, targetCapacity, asciiSet, recheck0, recheck1))>0
+        ) {
+            /* narrowed a run of ASCII characters in blocks; the offsets are set from lastSource */
+            source+=length;
+            target+=length;
+            targetCapacity-=length;
+            continue;
+        }
         /*
          * Get a correct Unicode code point:
          * a single UChar for a BMP code point or
@@ -5622,6 +5792,518 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
     pFromUArgs->target=(char *)target;
 }
 
+/* MBCS-to-UTF-8 conversion functions --------------------------------------- */
+
+/*
+ * The toUTF8 functions look up each character like the toUnicode functions
+ * and write its UTF-8 form directly, without a UTF-16 pivot buffer.
+ * Unassigned and illegal sequences are left in the MBCS converter's toUBytes
+ * with an error code, and ucnv_convertEx() calls the toUnicode callback for them.
+ */
+
+/*
+ * Writes the UTF-8 form of c to the target.
+ * If it does not fit, then the rest goes into the UTF-8 converter's overflow buffer
+ * and U_BUFFER_OVERFLOW_ERROR is set.
+ */
+static inline uint8_t *
+_writeUTF8(UConverter *utf8, UChar32 c,
+           uint8_t *target, const uint8_t *targetLimit,
+           UErrorCode *pErrorCode) {
+    int32_t length=0;
+    if((targetLimit-target)>=U8_MAX_LENGTH) {
+        U8_APPEND_UNSAFE(target, length, c);
+        return target+length;
+    } else {
+        uint8_t bytes[U8_MAX_LENGTH];
+        char *t=(char *)target;
+        U8_APPEND_UNSAFE(bytes, length, c);
+        ucnv_fromUWriteBytes(utf8, (const char *)bytes, length,
+                             &t, (const char *)targetLimit,
+                             NULL, -1, pErrorCode);
+        return (uint8_t *)t;
+    }
+}
+
+/*
+ * Input: The unassigned sequence is in cnv->toUBytes[0..length[.
+ * Writes an extension mapping via a small UTF-16 buffer if there is one.
+ * Returns -1 without consuming anything if the target might be too short
+ * for the mapping; then the caller reverts to pivoting for this character.
+ * Otherwise returns like _extToU().
+ */
+static int8_t
+_extToUTF8(UConverter *cnv, int8_t length,
+           const uint8_t **source, const uint8_t *sourceLimit,
+           uint8_t **target, const uint8_t *targetLimit,
+           UBool flush,
+           UErrorCode *pErrorCode) {
+    UChar buffer[UCNV_EXT_MAX_UCHARS];
+    UChar *t;
+    int32_t *noOffsets;
+    int32_t i, j, count;
+    UChar32 c;
+
+    if(cnv->sharedData->mbcs.extIndexes==NULL) {
+        /* no mapping */
+        *pErrorCode=U_INVALID_CHAR_FOUND;
+        return length;
+    }
+    /* each UChar takes at most 3 UTF-8 bytes */
+    if((targetLimit-*target)<3*UCNV_EXT_MAX_UCHARS) {
+        return -1;
+    }
+
+    t=buffer;
+    noOffsets=NULL;
+    length=_extToU(cnv, cnv->sharedData,
+                   length, source, sourceLimit,
+                   &t, buffer+UCNV_EXT_MAX_UCHARS,
+                   &noOffsets, -1,
+                   flush,
+                   pErrorCode);
+
+    count=(int32_t)(t-buffer);
+    for(i=j=0; i<count;) {
+        U16_NEXT(buffer, i, count, c);
+        U8_APPEND_UNSAFE(*target, j, c);
+    }
+    *target+=j;
+    return length;
+}
+
+static void U_CALLCONV
+ucnv_SBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *cnv, *utf8;
+    const uint8_t *source, *sourceLimit;
+    uint8_t *target;
+    const uint8_t *targetLimit;
+
+    const int32_t (*stateTable)[256];
+    const uint8_t (*sbcsToUTF8)[4];
+    const uint8_t *utf8Bytes;
+    UBool asciiIdentity;
+    const uint32_t *asciiSet=NULL;
+    uint8_t recheck0=0, recheck1=0;
+
+    int32_t entry, length, count;
+    UChar32 c;
+    uint8_t action, b;
+
+    /* set up the local pointers */
+    cnv=pToUArgs->converter;
+    utf8=pFromUArgs->converter;
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetLimit=(const uint8_t *)pFromUArgs->targetLimit;
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+        sbcsToUTF8=NULL;
+        asciiIdentity=FALSE;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+        sbcsToUTF8=cnv->sharedData->mbcs.sbcsToUTF8;
+        asciiIdentity=cnv->sharedData->mbcs.asciiIdentity;
+        asciiSet=cnv->sharedData->mbcs.asciiIdentitySet;
+        recheck0=cnv->sharedData->mbcs.asciiRecheck[0];
+        recheck1=cnv->sharedData->mbcs.asciiRecheck[1];
+    }
+
+    /* conversion loop */
+    while(source<sourceLimit) {
+        if(target>=targetLimit) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        /*
+         * Fast loop for bytes that map directly to BMP code points:
+         * Copy 4 bytes from the sbcsToUTF8 table and count the valid ones,
+         * while there is room for that after 3 bytes per source byte.
+         */
+        count=(int32_t)(sourceLimit-source);
+        if(sbcsToUTF8==NULL) {
+            count=0;
+        } else if(count>(int32_t)(targetLimit-target-1)/3) {
+            count=(int32_t)(targetLimit-target-1)/3;
+        }
+        while(count>0) {
+            /* copy a run of ASCII bytes in blocks, checking for one only every 16 bytes */
+            if( asciiIdentity && count>=16 &&
+                icu::SIMDUtil::skipBelow(source, source+16, 0x80)==source+16 &&
+                (length=icu::SIMDUtil::copyASCII(source, target, count, asciiSet, recheck0, recheck1))>0
+            ) {
+                source+=length;
+                target+=length;
+                count-=length;
+                continue;
+            }
+            length=count<16 ? count : 16;
+            count-=length;
+            do {
+                utf8Bytes=sbcsToUTF8[*source];
+                if(utf8Bytes[3]==0) {
+                    break;
+                }
+                uprv_memcpy(target, utf8Bytes, 4);
+                target+=utf8Bytes[3];
+                ++source;
+            } while(--length>0);
+            if(length>0) {
+                /* stopped before a byte that is not in the table */
+                break;
+            }
+        }
+        if(source>=sourceLimit) {
+            break;
+        }
+
+        /* a byte that the fast loop does not handle, or near the end of the target */
+        b=*source++;
+        entry=stateTable[0][b];
+        /* MBCS_ENTRY_IS_FINAL(entry) */
+
+        /* test the most common case first */
+        if(MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry)) {
+            c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+        } else {
+            /* same action codes and order as in ucnv_MBCSSingleToUnicodeWithOffsets() */
+            action=(uint8_t)(MBCS_ENTRY_FINAL_ACTION(entry));
+            if(action==MBCS_STATE_VALID_DIRECT_20 ||
+               (action==MBCS_STATE_FALLBACK_DIRECT_20 && UCNV_TO_U_USE_FALLBACK(cnv))
+            ) {
+                c=(UChar32)MBCS_ENTRY_FINAL_VALUE(entry)+0x10000;
+            } else if(action==MBCS_STATE_FALLBACK_DIRECT_16 && UCNV_TO_U_USE_FALLBACK(cnv)) {
+                c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            } else if(action==MBCS_STATE_FALLBACK_DIRECT_16 || action==MBCS_STATE_UNASSIGNED) {
+                /* try an extension mapping */
+                cnv->toUBytes[0]=b;
+                length=_extToUTF8(cnv, 1, &source, sourceLimit,
+                                  &target, targetLimit,
+                                  pToUArgs->flush, pErrorCode);
+                if(length<0) {
+                    /* revert to pivoting for this character */
+                    --source;
+                    *pErrorCode=U_USING_DEFAULT_WARNING;
+                    break;
+                }
+                cnv->toULength=(int8_t)length;
+                if(U_FAILURE(*pErrorCode)) {
+                    /* not mappable */
+                    break;
+                }
+                continue;
+            } else if(action==MBCS_STATE_ILLEGAL) {
+                /* callback(illegal) */
+                cnv->toUBytes[0]=b;
+                cnv->toULength=1;
+                *pErrorCode=U_ILLEGAL_CHAR_FOUND;
+                break;
+            } else {
+                /* reserved, must never occur */
+                continue;
+            }
+        }
+
+        target=_writeUTF8(utf8, c, target, targetLimit, pErrorCode);
+        if(U_FAILURE(*pErrorCode)) {
+            /* target overflow */
+            break;
+        }
+    }
+
+    /* write back the updated pointers */
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
+static void U_CALLCONV
+ucnv_DBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *cnv, *utf8;
+    const uint8_t *source, *sourceLimit;
+    uint8_t *target;
+    const uint8_t *targetLimit;
+
+    const int32_t (*stateTable)[256];
+    const uint16_t *unicodeCodeUnits;
+    UBool asciiIdentity;
+    const uint32_t *asciiSet=NULL;
+    uint8_t recheck0=0, recheck1=0;
+
+    uint32_t offset;
+    uint8_t state, startState;
+    int8_t byteIndex;
+    uint8_t *bytes;
+
+    int32_t entry, length, count;
+    UChar32 c;
+    uint8_t action;
+
+    cnv=pToUArgs->converter;
+    if(cnv->toULength>0) {
+        /* finish the character from the previous buffer with pivoting */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    /* set up the local pointers */
+    utf8=pFromUArgs->converter;
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetLimit=(const uint8_t *)pFromUArgs->targetLimit;
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+        asciiIdentity=FALSE;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+        asciiIdentity=cnv->sharedData->mbcs.asciiIdentity;
+        asciiSet=cnv->sharedData->mbcs.asciiIdentitySet;
+        recheck0=cnv->sharedData->mbcs.asciiRecheck[0];
+        recheck1=cnv->sharedData->mbcs.asciiRecheck[1];
+    }
+    unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+
+    /* get the converter state from UConverter */
+    offset=0;
+    byteIndex=0;
+    bytes=cnv->toUBytes;
+    if((state=(uint8_t)(cnv->mode))==0) {
+        state=cnv->sharedData->mbcs.dbcsOnlyState;
+    }
+
+    /* conversion loop */
+    while(source<sourceLimit) {
+        if(target>=targetLimit) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        /*
+         * Fast loop for 1- and 2-byte sequences that map to BMP code points,
+         * while there is room for 3 bytes per source byte.
+         */
+        count=(int32_t)(sourceLimit-source);
+        if(count>(int32_t)(targetLimit-target)/3) {
+            count=(int32_t)(targetLimit-target)/3;
+        }
+        while(count>0) {
+            if( asciiIdentity && state==0 && *source<0x80 && count>=16 &&
+                icu::SIMDUtil::skipBelow(source, source+16, 0x80)==source+16 &&
+                (length=icu::SIMDUtil::copyASCII(source, target, count, asciiSet, recheck0, recheck1))>0
+            ) {
+                /* copied a run of ASCII bytes in blocks */
+                source+=length;
+                target+=length;
+                count-=length;
+                continue;
+            }
+            entry=stateTable[state][*source];
+            if(MBCS_ENTRY_IS_TRANSITION(entry)) {
+                if(count<2) {
+                    break;
+                }
+                offset=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+                entry=stateTable[MBCS_ENTRY_TRANSITION_STATE(entry)][source[1]];
+                if(!(MBCS_ENTRY_IS_FINAL(entry) &&
+                     MBCS_ENTRY_FINAL_ACTION(entry)==MBCS_STATE_VALID_16 &&
+                     (c=unicodeCodeUnits[offset+MBCS_ENTRY_FINAL_VALUE_16(entry)])<0xfffe)
+                ) {
+                    break;
+                }
+                source+=2;
+                count-=2;
+            } else if(MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry)) {
+                c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+                ++source;
+                --count;
+            } else {
+                break;
+            }
+            state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+            if(c<=0x7f) {
+                *target++=(uint8_t)c;
+            } else if(c<=0x7ff) {
+                target[0]=(uint8_t)((c>>6)|0xc0);
+                target[1]=(uint8_t)((c&0x3f)|0x80);
+                target+=2;
+            } else {
+                target[0]=(uint8_t)((c>>12)|0xe0);
+                target[1]=(uint8_t)(((c>>6)&0x3f)|0x80);
+                target[2]=(uint8_t)((c&0x3f)|0x80);
+                target+=3;
+            }
+        }
+        offset=0;
+        if(source>=sourceLimit) {
+            break;
+        }
+
+        /* one character that the fast loop does not handle, or near the end of the target */
+        startState=state;
+        entry=stateTable[state][bytes[0]=*source++];
+        byteIndex=1;
+        if(MBCS_ENTRY_IS_TRANSITION(entry)) {
+            state=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
+            offset=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+
+            /* collect the rest of the byte sequence */
+            while(source<sourceLimit) {
+                entry=stateTable[state][bytes[byteIndex++]=*source++];
+                if(MBCS_ENTRY_IS_FINAL(entry)) {
+                    break;
+                }
+                state=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
+                offset+=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+            }
+            if(MBCS_ENTRY_IS_TRANSITION(entry)) {
+                /* the input ends in the middle of a character, keep it in the converter */
+                break;
+            }
+        }
+
+        /* save the previous state for proper extension mapping with SI/SO-stateful converters */
+        cnv->mode=state;
+
+        /* set the next state early so that we can reuse the entry variable */
+        state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+
+        /* same action codes and order as in ucnv_MBCSToUnicodeWithOffsets() */
+        c=U_SENTINEL;
+        action=(uint8_t)(MBCS_ENTRY_FINAL_ACTION(entry));
+        if(action==MBCS_STATE_VALID_16) {
+            offset+=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            c=unicodeCodeUnits[offset];
+            if(c<0xfffe) {
+                /* BMP code point */
+            } else if(c==0xfffe) {
+                if(UCNV_TO_U_USE_FALLBACK(cnv) && (entry=(int32_t)ucnv_MBCSGetFallback(&cnv->sharedData->mbcs, offset))!=0xfffe) {
+                    c=entry;
+                } else {
+                    c=U_SENTINEL;
+                }
+            } else {
+                /* callback(illegal) */
+                c=U_SENTINEL;
+                *pErrorCode=U_ILLEGAL_CHAR_FOUND;
+            }
+        } else if(action==MBCS_STATE_VALID_DIRECT_16) {
+            c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+        } else if(action==MBCS_STATE_VALID_16_PAIR) {
+            offset+=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            c=unicodeCodeUnits[offset++];
+            if(c<0xd800) {
+                /* BMP code point below 0xd800 */
+            } else if(UCNV_TO_U_USE_FALLBACK(cnv) ? c<=0xdfff : c<=0xdbff) {
+                /* roundtrip or fallback surrogate pair */
+                c=U16_GET_SUPPLEMENTARY(c&0xdbff, unicodeCodeUnits[offset]);
+            } else if(UCNV_TO_U_USE_FALLBACK(cnv) ? (c&0xfffe)==0xe000 : c==0xe000) {
+                /* roundtrip BMP code point above 0xd800 or fallback BMP code point */
+                c=unicodeCodeUnits[offset];
+            } else {
+                if(c==0xffff) {
+                    /* callback(illegal) */
+                    *pErrorCode=U_ILLEGAL_CHAR_FOUND;
+                }
+                c=U_SENTINEL;
+            }
+        } else if(action==MBCS_STATE_VALID_DIRECT_20 ||
+                  (action==MBCS_STATE_FALLBACK_DIRECT_20 && UCNV_TO_U_USE_FALLBACK(cnv))
+        ) {
+            c=(UChar32)MBCS_ENTRY_FINAL_VALUE(entry)+0x10000;
+        } else if(action==MBCS_STATE_CHANGE_ONLY) {
+            /* state change without any output */
+            if(cnv->sharedData->mbcs.dbcsOnlyState==0) {
+                byteIndex=0;
+            } else {
+                /* SI/SO are illegal for DBCS-only conversion */
+                state=(uint8_t)(cnv->mode); /* restore the previous state */
+
+                /* callback(illegal) */
+                *pErrorCode=U_ILLEGAL_CHAR_FOUND;
+            }
+        } else if(action==MBCS_STATE_FALLBACK_DIRECT_16) {
+            if(UCNV_TO_U_USE_FALLBACK(cnv)) {
+                c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            }
+        } else if(action==MBCS_STATE_UNASSIGNED) {
+            /* just fall through */
+        } else if(action==MBCS_STATE_ILLEGAL) {
+            /* callback(illegal) */
+            *pErrorCode=U_ILLEGAL_CHAR_FOUND;
+        } else {
+            /* reserved, must never occur */
+            byteIndex=0;
+        }
+
+        /* end of action codes: prepare for a new character */
+        offset=0;
+
+        if(c>=0) {
+            byteIndex=0;
+            target=_writeUTF8(utf8, c, target, targetLimit, pErrorCode);
+            if(U_FAILURE(*pErrorCode)) {
+                /* target overflow */
+                break;
+            }
+        } else if(byteIndex==0) {
+            /* no output */
+        } else if(U_FAILURE(*pErrorCode)) {
+            /* callback(illegal) */
+            if(byteIndex>1) {
+                /*
+                 * Ticket 5691: consistent illegal sequences, see ucnv_MBCSToUnicodeWithOffsets().
+                 * All of the bytes are from this buffer.
+                 */
+                UBool isDBCSOnly=(UBool)(cnv->sharedData->mbcs.dbcsOnlyState!=0);
+                int8_t i;
+                for(i=1;
+                    i<byteIndex && !isSingleOrLead(stateTable, state, isDBCSOnly, bytes[i]);
+                    ++i) {}
+                source-=byteIndex-i;
+                byteIndex=i;  /* length of reported illegal byte sequence */
+            }
+            break;
+        } else /* unassigned sequences indicated with byteIndex>0 */ {
+            /* try an extension mapping */
+            length=_extToUTF8(cnv, byteIndex, &source, sourceLimit,
+                              &target, targetLimit,
+                              pToUArgs->flush, pErrorCode);
+            if(length<0) {
+                /* revert to pivoting for this character */
+                source-=byteIndex;
+                state=startState;
+                byteIndex=0;
+                *pErrorCode=U_USING_DEFAULT_WARNING;
+                break;
+            }
+            byteIndex=(int8_t)length;
+            if(U_FAILURE(*pErrorCode)) {
+                /* not mappable */
+                break;
+            }
+        }
+    }
+
+    /* set the converter state back into UConverter */
+    cnv->toUnicodeStatus=offset;
+    cnv->mode=state;
+    cnv->toULength=byteIndex;
+
+    /* write back the updated pointers */
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
 /* miscellaneous ------------------------------------------------------------ */
 
 static void U_CALLCONV
@@ -5647,6 +6329,70 @@ ucnv_MBCSIsLeadByte(UConverterSharedData *sharedData, char byte) {
     return (UBool)MBCS_ENTRY_IS_TRANSITION(sharedData->mbcs.stateTable[0][(uint8_t)byte]);
 }
 
+U_CFUNC UBool
+ucnv_MBCSGetResyncChars(const UConverter *cnv, UChar32 resyncChars[256]) {
+    const UConverterMBCSTable *mbcsTable=&cnv->sharedData->mbcs;
+    const int32_t (*stateTable)[256];
+    int32_t entry;
+    int32_t b, state;
+    UBool found=FALSE;
+
+    for(b=0; b<256; ++b) {
+        resyncChars[b]=U_SENTINEL;
+    }
+    if(mbcsTable->dbcsOnlyState!=0 || (mbcsTable->outputType&0xff)==MBCS_OUTPUT_2_SISO) {
+        return FALSE;   /* not a single initial state */
+    }
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])mbcsTable->swapLFNLStateTable;
+    } else {
+        stateTable=mbcsTable->stateTable;
+    }
+
+    /* every complete character must return to state 0 */
+    for(state=0; state<(int32_t)mbcsTable->countStates; ++state) {
+        for(b=0; b<256; ++b) {
+            entry=stateTable[state][b];
+            if( MBCS_ENTRY_IS_FINAL(entry) &&
+                MBCS_ENTRY_FINAL_STATE(entry)!=0 &&
+                MBCS_ENTRY_FINAL_ACTION(entry)!=MBCS_STATE_ILLEGAL
+            ) {
+                return FALSE;
+            }
+        }
+    }
+
+    for(b=0; b<256; ++b) {
+        entry=stateTable[0][b];
+        if( !MBCS_ENTRY_IS_FINAL(entry) || MBCS_ENTRY_FINAL_STATE(entry)!=0 ||
+            !MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry) ||
+            U_IS_SURROGATE(MBCS_ENTRY_FINAL_VALUE_16(entry))
+        ) {
+            continue;
+        }
+        /*
+         * As a non-initial byte, b must be illegal and go back to state 0.
+         * Ticket 5691 then backs it out of the illegal sequence
+         * and converts it as a single byte.
+         */
+        for(state=1; state<(int32_t)mbcsTable->countStates; ++state) {
+            int32_t trail=stateTable[state][b];
+            if( !MBCS_ENTRY_IS_FINAL(trail) || MBCS_ENTRY_FINAL_STATE(trail)!=0 ||
+                MBCS_ENTRY_FINAL_ACTION(trail)!=MBCS_STATE_ILLEGAL
+            ) {
+                break;
+            }
+        }
+        if( state==(int32_t)mbcsTable->countStates &&
+            (mbcsTable->extIndexes==NULL || ucnv_extIsToUBoundary(mbcsTable->extIndexes, (uint8_t)b))
+        ) {
+            resyncChars[b]=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            found=TRUE;
+        }
+    }
+    return found;
+}
+
 static void U_CALLCONV
 ucnv_MBCSWriteSub(UConverterFromUnicodeArgs *pArgs,
               int32_t offsetIndex,
@@ -390,6 +390,10 @@ typedef struct UConverterMBCSTable {
 
     /* roundtrips */
     uint32_t asciiRoundtrips;
+    UBool asciiIdentity;                    /* copy runs of ASCII in asciiIdentitySet in blocks */
+    uint8_t asciiRecheck[2];                /* printable ASCII bytes not in asciiIdentitySet, or 0x7f */
+    uint32_t asciiIdentitySet[4];           /* bit b set if byte b round-trips with U+000b in state 0 */
+    uint8_t sbcsToUTF8[256][4];             /* SBCS: UTF-8 for VALID_DIRECT_16 bytes, with the length in [3], else 0 */
 
     /* reconstituted data that was omitted from the .cnv file */
     uint8_t *reconstitutedData;
@@ -425,6 +429,10 @@ typedef struct UConverterMBCSTable {
      \
     /* roundtrips */ \
     0, \
+    FALSE, \
+    { 0, 0 }, \
+    { 0, 0, 0, 0 }, \
+    { { 0 } }, \
      \
     /* reconstituted data that was omitted from the .cnv file */ \
     NULL, \
@@ -526,6 +534,21 @@ ucnv_MBCSIsLeadByte(UConverterSharedData *sharedData, char byte);
 #define _MBCS_IS_LEAD_BYTE(sharedData, byte) \
     (UBool)MBCS_ENTRY_IS_TRANSITION((sharedData)->mbcs.stateTable[0][(uint8_t)(byte)])
 
+/**
+ * Finds the bytes after which toUnicode conversion always resynchronizes,
+ * for ucnv_convertParallel().
+ * For each byte b, resyncChars[b] is set to the BMP code point that b maps to
+ * if b is a single-byte character in the initial state,
+ * is illegal as a non-initial byte (so that it ends any pending sequence),
+ * and does not continue a multi-byte extension mapping.
+ * After such a byte the converter is in the initial state with nothing pending.
+ * Otherwise resyncChars[b] is set to U_SENTINEL.
+ * Handles the EBCDIC swaplfnl option.
+ * @return TRUE if there is at least one such byte
+ */
+U_CFUNC UBool
+ucnv_MBCSGetResyncChars(const UConverter *cnv, UChar32 resyncChars[256]);
+
 /*
  * This is another simple conversion function for internal use by other
  * conversion implementations.
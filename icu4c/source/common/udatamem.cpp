@@ -118,8 +118,6 @@ udata_getMemory(UDataMemory *pData) {
  * For example, the length of the last item in a .dat package could be
  * computed from the size of the whole .dat package minus the offset of the
  * last item.
- * The size of a file that was directly memory-mapped could be determined
- * using some system API.
  *
  * In order to get perfect values for all data items, we may have to add a
  * length field to UDataInfo, but that complicates data generation
@@ -127,7 +125,7 @@ udata_getMemory(UDataMemory *pData) {
  *
  * @param pData The data item.
  * @return the length of the data item, or -1 if not known
- * @internal Currently used only in cintltst/udatatst.c
+ * @internal Used in cintltst/udatatst.c and for checking collation cache files
  */
 U_CAPI int32_t U_EXPORT2
 udata_getLength(const UDataMemory *pData) {
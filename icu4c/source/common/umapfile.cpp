@@ -146,6 +146,13 @@
             return FALSE;
         }
 
+        /* determine the length of the file; pData->length stays -1 if it does not fit */
+        LARGE_INTEGER fileSize;
+        int32_t length = -1;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart <= INT32_MAX) {
+            length = (int32_t)fileSize.QuadPart;
+        }
+
         /* Declare and initialize a security descriptor.
            This is required for multiuser systems on Windows 2000 SP4 and beyond */
         // TODO: UWP does not have this function and I do not think it is required?
@@ -191,6 +198,7 @@
             return FALSE;
         }
         pData->map=map;
+        pData->length=length;
         return TRUE;
     }
 
@@ -247,6 +255,7 @@
         pData->map = (char *)data + length;
         pData->pHeader=(const DataHeader *)data;
         pData->mapAddr = data;
+        pData->length = length;
 #if U_PLATFORM == U_PF_IPHONE
         posix_madvise(data, length, POSIX_MADV_RANDOM);
 #endif
@@ -325,6 +334,7 @@
         pData->map=p;
         pData->pHeader=(const DataHeader *)p;
         pData->mapAddr=p;
+        pData->length=fileLength;
         return TRUE;
     }
 
@@ -652,6 +652,98 @@ inline UBool BreakIterator::isBufferClone()
 
 #endif /* U_HIDE_DEPRECATED_API */
 
+#ifndef U_HIDE_DRAFT_API
+
+class BreakIteratorPoolImpl;
+
+/**
+ * A thread-safe pool of break iterators, keyed by break iterator type and locale.
+ *
+ * Creating a break iterator for a locale loads its rules and dictionaries,
+ * which is much slower than segmenting a short string.
+ * A pool hands out iterators that are ready to use, and takes them back
+ * for later reuse instead of deleting them.
+ * When it has no idle iterator for a (type, locale), it clones one from a
+ * prototype that is shared with other pools through ICU's internal cache,
+ * so that only the first request for each (type, locale) in the process loads data.
+ *
+ * Each iterator is used by one thread at a time, as usual;
+ * the pool itself can be shared by any number of threads.
+ *
+ * \code
+ *     BreakIterator *bi = pool.acquire(UBRK_WORD, locale, status);
+ *     bi->setText(text);
+ *     ...
+ *     pool.release(bi);
+ * \endcode
+ *
+ * Iterators from BreakIterator::registerInstance() are only picked up
+ * for a (type, locale) whose prototype was not yet cached.
+ *
+ * @see ubrk_openPool
+ * @draft ICU 64
+ */
+class U_COMMON_API BreakIteratorPool : public UMemory {
+public:
+    /**
+     * Constructs an empty pool.
+     * @param maxIdlePerKey The maximum number of idle iterators kept for each
+     *                      (type, locale). Iterators released beyond that are deleted.
+     *                      Must be >= 0.
+     * @param status        Set to U_ILLEGAL_ARGUMENT_ERROR if maxIdlePerKey < 0.
+     * @draft ICU 64
+     */
+    BreakIteratorPool(int32_t maxIdlePerKey, UErrorCode &status);
+
+    /**
+     * Destructor. Deletes the idle iterators.
+     * Iterators that have been acquired and not released remain valid,
+     * and must be deleted by the caller rather than released.
+     * @draft ICU 64
+     */
+    ~BreakIteratorPool();
+
+    /**
+     * Returns a break iterator of the given type for the locale,
+     * either an idle one from the pool or a new one.
+     * Its text is empty; call setText() before using it.
+     * Give it back with release(). Delete it instead only after the pool has been deleted.
+     * @param type   The type of break iterator.
+     * @param locale The locale.
+     * @param status Receives errors, and the warnings that creating
+     *               the iterator with BreakIterator::createWordInstance() etc. would set.
+     * @return a break iterator owned by the caller until released, or NULL on failure
+     * @draft ICU 64
+     */
+    BreakIterator *acquire(UBreakIteratorType type, const Locale &locale, UErrorCode &status);
+
+    /**
+     * Gives a break iterator back to the pool, which now owns it.
+     * Its text is reset so that the caller's text need not outlive it.
+     * It is deleted if there are already enough idle iterators for its
+     * type and locale, or if it was not obtained from this pool.
+     * @param bi The break iterator; no-op if NULL.
+     * @draft ICU 64
+     */
+    void release(BreakIterator *bi);
+
+    /**
+     * Fills in the pool's usage counters.
+     * The ratio reused/acquired is the hit rate.
+     * @param stats Receives the counters.
+     * @draft ICU 64
+     */
+    void getStatistics(UBreakIteratorPoolStatistics &stats) const;
+
+private:
+    BreakIteratorPool(const BreakIteratorPool &other) = delete;
+    BreakIteratorPool &operator=(const BreakIteratorPool &other) = delete;
+
+    BreakIteratorPoolImpl *fImpl;
+};
+
+#endif  /* U_HIDE_DRAFT_API */
+
 U_NAMESPACE_END
 
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -36,6 +36,7 @@
 U_NAMESPACE_BEGIN
 
 class ByteSink;
+class CharString;
 
 /**
  * Unicode normalization functionality for standard Unicode normalization or
@@ -223,9 +224,9 @@ class U_COMMON_API Normalizer2 : public UObject {
      * Normalizes a UTF-8 string and optionally records how source substrings
      * relate to changed and unchanged result substrings.
      *
-     * Currently implemented completely only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * Currently implemented completely only for "compose", "decompose" and FCD modes,
+     * such as for NFC, NFKC, NFKC_Casefold, NFD and NFKD
+     * (UNORM2_COMPOSE, UNORM2_COMPOSE_CONTIGUOUS, UNORM2_DECOMPOSE and UNORM2_FCD).
      * Otherwise currently converts to & from UTF-16 and does not support edits.
      *
      * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
@@ -380,9 +381,9 @@ class U_COMMON_API Normalizer2 : public UObject {
      * at the cost of doing more work in those cases.
      *
      * This works for all normalization modes,
-     * but it is currently optimized for UTF-8 only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * but it is currently optimized for UTF-8 only for "compose", "decompose" and FCD modes,
+     * such as for NFC, NFKC, NFKC_Casefold, NFD and NFKD
+     * (UNORM2_COMPOSE, UNORM2_COMPOSE_CONTIGUOUS, UNORM2_DECOMPOSE and UNORM2_FCD).
      * For other modes it currently converts to UTF-16 and calls isNormalized().
      *
      * @param s UTF-8 input string
@@ -485,6 +486,84 @@ class U_COMMON_API Normalizer2 : public UObject {
      * @stable ICU 4.4
      */
     virtual UBool isInert(UChar32 c) const = 0;
+
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Normalizes each of an array of UTF-8 strings and appends the results
+     * back to back to one ByteSink, without separators.
+     * This avoids the per-call overhead of normalizing many short strings one at a time.
+     * Each string is normalized as with normalizeUTF8().
+     *
+     * If numThreads>1 and there are enough strings, then the batch is split into
+     * contiguous ranges which are normalized concurrently by up to numThreads threads
+     * (including the calling thread). The ByteSink is only called from the calling thread,
+     * and the output is the same as with numThreads<=1.
+     *
+     * @param src array of count UTF-8 input strings
+     * @param count number of input strings
+     * @param sink output sink
+     * @param offsets if not NULL, then this array of count+1 elements receives
+     *                the start offset of each normalized string relative to the
+     *                first byte appended by this call,
+     *                and offsets[count] is set to the total output length
+     * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 64
+     */
+    void
+    normalizeUTF8Batch(const StringPiece *src, int32_t count,
+                       ByteSink &sink, int32_t *offsets,
+                       int32_t numThreads, UErrorCode &errorCode) const;
+
+    /**
+     * Performs a quick check on each of an array of strings.
+     * results[i] is set to quickCheck(src[i], errorCode).
+     *
+     * If numThreads>1 and there are enough strings, then the batch is split into
+     * contiguous ranges which are checked concurrently by up to numThreads threads
+     * (including the calling thread).
+     *
+     * @param src array of count input strings
+     * @param count number of input strings
+     * @param results array of count elements which receives the quick check results
+     * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 64
+     */
+    void
+    quickCheckBatch(const UnicodeString *src, int32_t count,
+                    UNormalizationCheckResult *results,
+                    int32_t numThreads, UErrorCode &errorCode) const;
+
+    /**
+     * Tests if each of an array of UTF-8 strings is normalized.
+     * results[i] is set to isNormalizedUTF8(src[i], errorCode).
+     *
+     * If numThreads>1 and there are enough strings, then the batch is split into
+     * contiguous ranges which are checked concurrently by up to numThreads threads
+     * (including the calling thread).
+     *
+     * @param src array of count UTF-8 input strings
+     * @param count number of input strings
+     * @param results array of count elements which receives TRUE for each normalized string
+     * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 64
+     */
+    void
+    isNormalizedUTF8Batch(const StringPiece *src, int32_t count,
+                          UBool *results,
+                          int32_t numThreads, UErrorCode &errorCode) const;
+#endif  // U_HIDE_DRAFT_API
 };
 
 /**
@@ -541,9 +620,9 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
      * Normalizes a UTF-8 string and optionally records how source substrings
      * relate to changed and unchanged result substrings.
      *
-     * Currently implemented completely only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * Currently implemented completely only for "compose", "decompose" and FCD modes,
+     * such as for NFC, NFKC, NFKC_Casefold, NFD and NFKD
+     * (UNORM2_COMPOSE, UNORM2_COMPOSE_CONTIGUOUS, UNORM2_DECOMPOSE and UNORM2_FCD).
      * Otherwise currently converts to & from UTF-16 and does not support edits.
      *
      * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
@@ -675,9 +754,9 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
      * at the cost of doing more work in those cases.
      *
      * This works for all normalization modes,
-     * but it is currently optimized for UTF-8 only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * but it is currently optimized for UTF-8 only for "compose", "decompose" and FCD modes,
+     * such as for NFC, NFKC, NFKC_Casefold, NFD and NFKD
+     * (UNORM2_COMPOSE, UNORM2_COMPOSE_CONTIGUOUS, UNORM2_DECOMPOSE and UNORM2_FCD).
      * For other modes it currently converts to UTF-16 and calls isNormalized().
      *
      * @param s UTF-8 input string
@@ -768,6 +847,153 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
     const UnicodeSet &set;
 };
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Normalizes text that arrives in chunks, for example from a file or a network stream,
+ * without requiring the whole text in memory.
+ *
+ * Each normalize() call writes the normalized form of all of the text up to
+ * the last normalization boundary seen so far to the output.
+ * Only the unfinished segment after that boundary is held internally,
+ * until more text or the end of the input arrives.
+ * The concatenation of all output is the same as the normalization of
+ * the concatenation of all input.
+ * Chunks may end in the middle of a surrogate pair or a UTF-8 multi-byte sequence.
+ *
+ * Only the unfinished segment is copied; the rest of each chunk is normalized in place.
+ * A stream must consist either only of UTF-16 chunks or only of UTF-8 chunks.
+ * Call finish() or finishUTF8() at the end of each stream;
+ * after that, the object can be used for the next stream.
+ *
+ * This class is not thread-safe.
+ * The Normalizer2 instance is aliased and must not be deleted while this object is used.
+ * @draft ICU 64
+ */
+class U_COMMON_API StreamingNormalizer2 : public UMemory {
+public:
+    /**
+     * Constructs a streaming normalizer for any Normalizer2 instance.
+     * @param n2 Normalizer2 instance, aliased
+     * @draft ICU 64
+     */
+    StreamingNormalizer2(const Normalizer2 &n2);
+
+    /**
+     * Destructor.
+     * @draft ICU 64
+     */
+    ~StreamingNormalizer2();
+
+    /**
+     * Normalizes the next chunk of UTF-16 text and appends the normalized form
+     * of the text up to the last normalization boundary to dest.
+     * dest should contain only earlier output for this stream (or nothing);
+     * see Normalizer2::normalizeSecondAndAppend().
+     * @param src source chunk
+     * @param length length of the source chunk, or -1 if NUL-terminated
+     * @param dest destination string; normalized text is appended
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  Set to U_INVALID_STATE_ERROR if UTF-8 text is pending.
+     * @return dest
+     * @draft ICU 64
+     */
+    UnicodeString &
+    normalize(const char16_t *src, int32_t length,
+              UnicodeString &dest, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the pending UTF-16 text, appends the result to dest,
+     * and resets this object for the next stream.
+     * @param dest destination string; normalized text is appended
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return dest
+     * @draft ICU 64
+     */
+    UnicodeString &
+    finish(UnicodeString &dest, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the next chunk of UTF-8 text and writes the normalized form
+     * of the text up to the last normalization boundary to the ByteSink.
+     * Ill-formed byte sequences are passed through as in Normalizer2::normalizeUTF8().
+     *
+     * Edits are accumulated across calls: U_EDITS_NO_RESET is always set.
+     * Their source indexes are relative to the start of the stream.
+     * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT.
+     * @param src       Source chunk
+     * @param sink      A ByteSink to which the normalized UTF-8 result string is written.
+     *                  sink.Flush() is called at the end of each call.
+     * @param edits     Records edits for index mapping, working with styled text,
+     *                  and getting only changes (if any).
+     *                  This function calls edits->reset() only in finishUTF8().
+     *                  Can be nullptr.
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  Set to U_INVALID_STATE_ERROR if UTF-16 text is pending.
+     * @draft ICU 64
+     */
+    void
+    normalizeUTF8(uint32_t options, StringPiece src, ByteSink &sink,
+                  Edits *edits, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the pending UTF-8 text, writes the result to the ByteSink,
+     * and resets this object for the next stream.
+     * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT.
+     * @param sink      A ByteSink to which the normalized UTF-8 result string is written.
+     *                  sink.Flush() is called at the end.
+     * @param edits     Records edits for index mapping, working with styled text,
+     *                  and getting only changes (if any).
+     *                  Edits are not reset. Can be nullptr.
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 64
+     */
+    void
+    finishUTF8(uint32_t options, ByteSink &sink, Edits *edits, UErrorCode &errorCode);
+
+    /**
+     * Discards any pending text and resets this object for the next stream.
+     * @draft ICU 64
+     */
+    void reset();
+
+    /**
+     * Returns TRUE if some text is pending,
+     * that is, it has been passed in but not yet normalized.
+     * @return TRUE if some text is pending
+     * @draft ICU 64
+     */
+    UBool hasPendingText() const;
+
+private:
+    // Restores the pending text when the C API output does not fit.
+    friend struct StreamingNormalizer2Wrapper;
+
+    StreamingNormalizer2(const StreamingNormalizer2 &other) = delete;
+    StreamingNormalizer2 &operator=(const StreamingNormalizer2 &other) = delete;
+
+    int32_t findFirstBoundary(const char16_t *s, int32_t start, int32_t limit) const;
+    int32_t findLastBoundary(const char16_t *s, int32_t start, int32_t limit) const;
+    int32_t findFirstBoundary(const uint8_t *s, int32_t start, int32_t limit) const;
+    int32_t findLastBoundary(const uint8_t *s, int32_t start, int32_t limit) const;
+
+    const Normalizer2 &norm2;
+    UnicodeString pending;
+    CharString *pending8;  // allocated on first use
+};
+#endif  // U_HIDE_DRAFT_API
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_NORMALIZATION
@@ -613,6 +613,59 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     virtual RuleBasedBreakIterator &refreshInputText(UText *input, UErrorCode &status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Finds the boundaries following a text position and writes them,
+     * with their rule status values, into caller-provided arrays.
+     * This is equivalent to following(start) followed by repeated calls to next()
+     * and getRuleStatus(), but forward-only scans run the break rules directly
+     * and do not go through the iterator's boundary cache.
+     *
+     * The starting position need not be a boundary itself.
+     * Positions outside of the text are pinned to its start or end.
+     * The iterator is left on the last boundary that was written.
+     * To continue a scan, call this function again with start set to that boundary.
+     *
+     * @param start      The text position from which to begin searching for boundaries.
+     * @param boundaries Receives the boundary positions, in ascending order.
+     * @param ruleStatus Receives the getRuleStatus() value for each boundary. Can be NULL.
+     * @param capacity   The number of elements available in each of the arrays.
+     * @param status     Receives errors detected by this function.
+     * @return           The number of boundaries written. Fewer than capacity
+     *                   means that the end of the text was reached.
+     *                   0 if start is at or beyond the end of the text.
+     * @draft ICU 64
+     */
+    int32_t getBoundaries(int32_t start, int32_t *boundaries, int32_t *ruleStatus,
+                          int32_t capacity, UErrorCode &status);
+
+    /**
+     * Finds all of the boundaries in the text, optionally using several threads.
+     * The results are the same as from getBoundaries(0, ...) called repeatedly
+     * until the end of the text.
+     *
+     * With numThreads>1 and a long enough text, the text is cut into slices
+     * after hard line breaks (CR, LF, NEL, LS, PS), and each slice is segmented
+     * on its own thread by a clone of this iterator.
+     * If the segmentation of one slice does not end exactly on the cut,
+     * then the next slice is segmented again, sequentially,
+     * from the last boundary before it.
+     *
+     * The iterator is left at the end of the text.
+     *
+     * @param boundaries Receives the boundary positions after the start of the text,
+     *                   in ascending order. Can be NULL if capacity==0 (preflighting).
+     * @param ruleStatus Receives the getRuleStatus() value for each boundary. Can be NULL.
+     * @param capacity   The number of elements available in each of the arrays.
+     * @param numThreads The maximum number of threads to use, including the calling thread.
+     * @param status     Receives errors detected by this function.
+     *                   U_BUFFER_OVERFLOW_ERROR if there are more than capacity boundaries.
+     * @return           The number of boundaries in the text, not counting its start.
+     * @draft ICU 64
+     */
+    int32_t getAllBoundaries(int32_t *boundaries, int32_t *ruleStatus, int32_t capacity,
+                             int32_t numThreads, UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
 
 private:
     //=======================================================================
@@ -642,6 +695,14 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     int32_t handleSafePrevious(int32_t fromPosition);
 
+    /**
+     * The state machine loop of handleSafePrevious(),
+     * for reading the text through the UText or, for UTF-8, directly from its bytes.
+     * @internal (private)
+     */
+    template<typename TextReader>
+    int32_t handleSafePrevious(TextReader &reader);
+
     /**
      * Find a rule-based boundary by running the state machine.
      * Input
@@ -656,6 +717,14 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     int32_t handleNext();
 
+    /**
+     * The state machine loop of handleNext(),
+     * for reading the text through the UText or, for UTF-8, directly from its bytes.
+     * @internal (private)
+     */
+    template<typename TextReader>
+    int32_t handleNext(TextReader &reader);
+
 
     /**
      * This function returns the appropriate LanguageBreakEngine for a
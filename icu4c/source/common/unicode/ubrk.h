@@ -623,6 +623,182 @@ ubrk_getBinaryRules(UBreakIterator *bi,
                     uint8_t *       binaryRules, int32_t rulesCapacity,
                     UErrorCode *    status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Find the boundaries following a text position and write them,
+ * with their rule status values, into caller-provided arrays.
+ * This is equivalent to ubrk_following() followed by repeated calls to
+ * ubrk_next() and ubrk_getRuleStatus(), but is faster for forward-only scans
+ * because the boundaries do not go through the iterator's internal cache.
+ *
+ * The starting position need not be a boundary itself.
+ * Positions outside of the text are pinned to its start or end.
+ * The iterator is left on the last boundary that was written,
+ * so that a loop can continue with start set to that boundary.
+ *
+ * @param bi         The break iterator to use.
+ * @param start      The text position from which to begin searching for boundaries.
+ * @param boundaries Receives the boundary positions, in ascending order.
+ * @param ruleStatus Receives the ubrk_getRuleStatus() value for each boundary. Can be NULL.
+ * @param capacity   The number of elements available in each of the arrays. Must be >= 0.
+ * @param status     Pointer to UErrorCode to receive any errors.
+ * @return           The number of boundaries written. Fewer than capacity
+ *                   means that the end of the text was reached.
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getBoundaries(UBreakIterator *bi, int32_t start,
+                   int32_t *boundaries, int32_t *ruleStatus, int32_t capacity,
+                   UErrorCode *status);
+
+/**
+ * Find all of the boundaries in the text, optionally using several threads.
+ * The results are the same as from ubrk_getBoundaries(bi, 0, ...) called repeatedly
+ * until the end of the text.
+ * With numThreads>1 and a long enough text, the text is cut into slices
+ * after hard line breaks, and each slice is segmented on its own thread.
+ * Supports preflighting. The iterator is left at the end of the text.
+ *
+ * @param bi         The break iterator to use.
+ * @param boundaries Receives the boundary positions after the start of the text,
+ *                   in ascending order. Can be NULL if capacity==0.
+ * @param ruleStatus Receives the ubrk_getRuleStatus() value for each boundary. Can be NULL.
+ * @param capacity   The number of elements available in each of the arrays. Must be >= 0.
+ * @param numThreads The maximum number of threads to use, including the calling thread.
+ * @param status     Pointer to UErrorCode to receive any errors, such as
+ *                   U_BUFFER_OVERFLOW_ERROR if there are more than capacity boundaries.
+ * @return           The number of boundaries in the text, not counting its start.
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getAllBoundaries(UBreakIterator *bi,
+                      int32_t *boundaries, int32_t *ruleStatus, int32_t capacity,
+                      int32_t numThreads, UErrorCode *status);
+
+struct UBreakIteratorPool;
+/**
+ * Opaque type for a thread-safe pool of break iterators, keyed by type and locale.
+ * @see ubrk_openPool
+ * @draft ICU 64
+ */
+typedef struct UBreakIteratorPool UBreakIteratorPool;
+
+/**
+ * Usage counters of a UBreakIteratorPool.
+ * The ratio reused/acquired is the hit rate.
+ * @see ubrk_getPoolStatistics
+ * @draft ICU 64
+ */
+typedef struct UBreakIteratorPoolStatistics {
+    /** Number of iterators handed out. @draft ICU 64 */
+    int64_t acquired;
+    /** Number of iterators handed out that were idle in the pool rather than new. @draft ICU 64 */
+    int64_t reused;
+    /** Number of iterators given back to the pool. @draft ICU 64 */
+    int64_t released;
+    /** Number of iterators given back that were deleted because the pool was full. @draft ICU 64 */
+    int64_t discarded;
+    /** Number of idle iterators now in the pool. @draft ICU 64 */
+    int32_t idle;
+    /** Number of iterators now handed out and not given back. @draft ICU 64 */
+    int32_t inUse;
+} UBreakIteratorPoolStatistics;
+
+/**
+ * Open an empty pool of break iterators.
+ * Opening a break iterator for a locale loads its rules and dictionaries;
+ * a pool hands out iterators that are ready to use, and takes them back
+ * for later reuse instead of closing them.
+ * The pool can be shared by any number of threads.
+ *
+ * @param maxIdlePerKey The maximum number of idle iterators kept for each
+ *                      (type, locale). Iterators returned beyond that are closed.
+ *                      Must be >= 0.
+ * @param status        Pointer to UErrorCode to receive any errors.
+ * @return the new pool; close it with ubrk_closePool()
+ * @draft ICU 64
+ */
+U_DRAFT UBreakIteratorPool * U_EXPORT2
+ubrk_openPool(int32_t maxIdlePerKey, UErrorCode *status);
+
+/**
+ * Close a pool of break iterators, and the idle iterators in it.
+ * Iterators that were taken from the pool and not returned remain valid,
+ * and must be closed with ubrk_close().
+ * @param pool The pool to close.
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+ubrk_closePool(UBreakIteratorPool *pool);
+
+/**
+ * Take a break iterator of the given type for the locale from a pool,
+ * like ubrk_open() but reusing an idle iterator when the pool has one.
+ * Give it back with ubrk_returnToPool(). Close it with ubrk_close() instead
+ * only after the pool has been closed.
+ *
+ * @param pool       The pool.
+ * @param type       The type of UBreakIterator to open.
+ * @param locale     The locale specifying the text-breaking conventions.
+ * @param text       The text to be iterated over. May be null, in which case
+ *                   ubrk_setText() is used to specify the text to be iterated.
+ * @param textLength The number of characters in text, or -1 if null-terminated.
+ * @param status     Pointer to UErrorCode to receive any errors.
+ * @return a UBreakIterator, or NULL on failure
+ * @see ubrk_open
+ * @draft ICU 64
+ */
+U_DRAFT UBreakIterator * U_EXPORT2
+ubrk_openFromPool(UBreakIteratorPool *pool,
+                  UBreakIteratorType type,
+                  const char *locale,
+                  const UChar *text,
+                  int32_t textLength,
+                  UErrorCode *status);
+
+/**
+ * Give a break iterator back to the pool that it came from.
+ * Its text is reset, so that the caller's text need not outlive it.
+ * It is closed if the pool already has enough idle iterators of its type and locale,
+ * if it did not come from this pool, or if pool is NULL.
+ *
+ * @param pool The pool.
+ * @param bi   The break iterator; no-op if NULL.
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+ubrk_returnToPool(UBreakIteratorPool *pool, UBreakIterator *bi);
+
+/**
+ * Get the usage counters of a pool of break iterators.
+ *
+ * @param pool  The pool.
+ * @param stats Receives the counters.
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+ubrk_getPoolStatistics(const UBreakIteratorPool *pool, UBreakIteratorPoolStatistics *stats);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUBreakIteratorPoolPointer
+ * "Smart pointer" class, closes a UBreakIteratorPool via ubrk_closePool().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 64
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUBreakIteratorPoolPointer, UBreakIteratorPool, ubrk_closePool);
+
+U_NAMESPACE_END
+
+#endif
+#endif  /* U_HIDE_DRAFT_API */
+
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
 
 #endif
@@ -1570,6 +1570,57 @@ ucnv_convert(const char *toConverterName,
              int32_t sourceLength,
              UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Convert a complete text from one charset to another, optionally using several threads.
+ * The output is the same as from resetting both converters and then calling
+ * ucnv_convertEx() with flush=TRUE over the whole text, including
+ * the results of callbacks, NUL termination and preflighting like ucnv_convert().
+ *
+ * With numThreads>1 and a long enough text, the source is cut into slices
+ * where the source converter always returns to its initial state
+ * (for example, after an ASCII byte in UTF-8 or in a Shift-JIS-like charset),
+ * and where the target converter has nothing pending.
+ * Each slice is converted with its own clones of the two converters,
+ * and the outputs are concatenated in order.
+ * If a slice fails, then it is converted again with the original converters,
+ * so that they report the error like a sequential conversion.
+ *
+ * Stateful charsets (for example ISO-2022, HZ, SCSU, UTF-7, EBCDIC_STATEFUL
+ * and Unicode charsets with byte order marks) cannot be cut.
+ * Custom callbacks might have side effects, and they must see the same calls
+ * as with sequential conversion. Therefore, only converters which use
+ * ICU's substitute, stop, skip or escape callbacks are cloned.
+ * In all other cases the text is converted on the calling thread, and if numThreads>1 then
+ * *pErrorCode is set to U_SEQUENTIAL_FALLBACK_WARNING unless there is another
+ * warning or error.
+ *
+ * @param targetCnv     Output converter, used to convert from the UTF-16 pivot
+ *                      to the target.
+ * @param sourceCnv     Input converter, used to convert from the source
+ *                      to the UTF-16 pivot.
+ * @param target        Pointer to the output buffer.
+ * @param targetCapacity Capacity of the target, in bytes.
+ * @param source        Pointer to the input buffer.
+ * @param sourceLength  Length of the input text, in bytes, or -1 for NUL-terminated input.
+ * @param numThreads    The maximum number of threads to use, including the calling thread.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ * @return Length of the complete output text in bytes, even if it exceeds the targetCapacity
+ *         and a U_BUFFER_OVERFLOW_ERROR is set.
+ *
+ * @see ucnv_convertEx
+ * @see ucnv_convert
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_convertParallel(UConverter *targetCnv, UConverter *sourceCnv,
+                     char *target, int32_t targetCapacity,
+                     const char *source, int32_t sourceLength,
+                     int32_t numThreads,
+                     UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Convert from one external charset to another.
  * Internally, the text is converted to and from the 16-bit Unicode "pivot"
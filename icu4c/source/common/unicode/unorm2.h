@@ -527,6 +527,193 @@ unorm2_hasBoundaryAfter(const UNormalizer2 *norm2, UChar32 c);
 U_STABLE UBool U_EXPORT2
 unorm2_isInert(const UNormalizer2 *norm2, UChar32 c);
 
+#ifndef U_HIDE_DRAFT_API
+
+struct UStreamingNormalizer2;
+/**
+ * C typedef for struct UStreamingNormalizer2.
+ * @draft ICU 64
+ */
+typedef struct UStreamingNormalizer2 UStreamingNormalizer2;
+
+/**
+ * Opens a streaming normalizer which normalizes text that arrives in chunks.
+ * Each call emits the normalized form of all of the text up to the last
+ * normalization boundary seen so far; only the unfinished segment
+ * is held internally until more text or the end of the input arrives.
+ * The concatenation of all output is the same as the normalization of
+ * the concatenation of all input.
+ *
+ * The UNormalizer2 instance is aliased and must not be closed
+ * while the streaming normalizer is in use.
+ * A streaming normalizer must be used either only with UTF-16 or only with UTF-8 text
+ * for any one stream.
+ * @param norm2 UNormalizer2 instance
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return the streaming normalizer, if successful
+ * @see StreamingNormalizer2
+ * @draft ICU 64
+ */
+U_DRAFT UStreamingNormalizer2 * U_EXPORT2
+unorm2_openStreaming(const UNormalizer2 *norm2, UErrorCode *pErrorCode);
+
+/**
+ * Closes a UStreamingNormalizer2 instance from unorm2_openStreaming().
+ * Any pending text is discarded.
+ * @param sn UStreamingNormalizer2 instance to be closed
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+unorm2_closeStreaming(UStreamingNormalizer2 *sn);
+
+/**
+ * Normalizes the next chunk of UTF-16 text and writes as much of the normalized form
+ * as is known to be final into the destination buffer.
+ * With flush=TRUE the chunk is the last one of the stream:
+ * all remaining text is normalized and written, and the streaming normalizer
+ * is reset for the next stream.
+ *
+ * The output is NUL-terminated if there is room for it.
+ * If the output does not fit into the destination buffer,
+ * then *pErrorCode is set to U_BUFFER_OVERFLOW_ERROR, the return value is
+ * the required length, and the chunk is not consumed:
+ * The streaming normalizer is left as it was before the call.
+ * In that case, call this function again with the same chunk, the same flush value,
+ * and a destination buffer with at least the required capacity.
+ * @param sn UStreamingNormalizer2 instance
+ * @param src source chunk
+ * @param length length of the source chunk, or -1 if NUL-terminated
+ * @param flush TRUE if this is the last chunk of the stream
+ * @param dest destination buffer; can be NULL if capacity=0
+ * @param capacity number of UChars that can be written to dest
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return the length of the normalized output for this chunk;
+ *         if it is greater than capacity, then nothing was written to dest
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+unorm2_normalizeStreaming(UStreamingNormalizer2 *sn,
+                          const UChar *src, int32_t length, UBool flush,
+                          UChar *dest, int32_t capacity,
+                          UErrorCode *pErrorCode);
+
+/**
+ * Normalizes the next chunk of UTF-8 text and writes as much of the normalized form
+ * as is known to be final into the destination buffer.
+ * A chunk may end in the middle of a multi-byte sequence.
+ * Otherwise the same as unorm2_normalizeStreaming().
+ * @param sn UStreamingNormalizer2 instance
+ * @param src source chunk
+ * @param length length of the source chunk, or -1 if NUL-terminated
+ * @param flush TRUE if this is the last chunk of the stream
+ * @param dest destination buffer; can be NULL if capacity=0
+ * @param capacity number of bytes that can be written to dest
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return the length of the normalized output for this chunk;
+ *         if it is greater than capacity, then nothing was written to dest
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+unorm2_normalizeStreamingUTF8(UStreamingNormalizer2 *sn,
+                              const char *src, int32_t length, UBool flush,
+                              char *dest, int32_t capacity,
+                              UErrorCode *pErrorCode);
+
+/**
+ * Normalizes each of an array of UTF-8 strings and writes the results
+ * back to back into one destination buffer, without separators or NUL terminators.
+ * This avoids the per-call setup cost of normalizing many short strings one at a time.
+ * Ill-formed byte sequences are passed through unchanged.
+ *
+ * If numThreads>1 and there are enough strings, then the batch is split into
+ * contiguous ranges which are normalized concurrently by up to numThreads threads
+ * (including the calling thread). The output is the same as with numThreads<=1.
+ *
+ * If the output does not fit, then *pErrorCode is set to U_BUFFER_OVERFLOW_ERROR,
+ * the return value is the total output length, and destOffsets is still filled in,
+ * so that the function can be used for preflighting.
+ * @param norm2 UNormalizer2 instance
+ * @param src array of count UTF-8 input strings
+ * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+ *                can be NULL if all strings are NUL-terminated
+ * @param count number of input strings
+ * @param dest destination buffer; can be NULL if capacity=0
+ * @param capacity number of bytes that can be written to dest
+ * @param destOffsets if not NULL, then this array of count+1 elements receives
+ *                    the start offset in dest of each normalized string,
+ *                    and destOffsets[count] is set to the total output length
+ * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return total length of the normalized strings
+ * @see Normalizer2::normalizeUTF8Batch
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+unorm2_normalizeUTF8Batch(const UNormalizer2 *norm2,
+                          const char *const *src, const int32_t *lengths, int32_t count,
+                          char *dest, int32_t capacity, int32_t *destOffsets,
+                          int32_t numThreads, UErrorCode *pErrorCode);
+
+/**
+ * Performs a quick check on each of an array of UTF-16 strings.
+ * results[i] is the same as unorm2_quickCheck(norm2, src[i], lengths[i], pErrorCode).
+ *
+ * If numThreads>1 and there are enough strings, then the batch is split into
+ * contiguous ranges which are checked concurrently by up to numThreads threads
+ * (including the calling thread).
+ * @param norm2 UNormalizer2 instance
+ * @param src array of count input strings
+ * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+ *                can be NULL if all strings are NUL-terminated
+ * @param count number of input strings
+ * @param results array of count elements which receives the quick check results
+ * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @see Normalizer2::quickCheckBatch
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+unorm2_quickCheckBatch(const UNormalizer2 *norm2,
+                       const UChar *const *src, const int32_t *lengths, int32_t count,
+                       UNormalizationCheckResult *results,
+                       int32_t numThreads, UErrorCode *pErrorCode);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUStreamingNormalizer2Pointer
+ * "Smart pointer" class, closes a UStreamingNormalizer2 via unorm2_closeStreaming().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 64
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUStreamingNormalizer2Pointer, UStreamingNormalizer2, unorm2_closeStreaming);
+
+U_NAMESPACE_END
+
+#endif
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Compares two strings for canonical equivalence.
  * Further options include case-insensitive comparison and
@@ -479,13 +479,17 @@
 #define ubiditransform_transform U_ICU_ENTRY_POINT_RENAME(ubiditransform_transform)
 #define ublock_getCode U_ICU_ENTRY_POINT_RENAME(ublock_getCode)
 #define ubrk_close U_ICU_ENTRY_POINT_RENAME(ubrk_close)
+#define ubrk_closePool U_ICU_ENTRY_POINT_RENAME(ubrk_closePool)
 #define ubrk_countAvailable U_ICU_ENTRY_POINT_RENAME(ubrk_countAvailable)
 #define ubrk_current U_ICU_ENTRY_POINT_RENAME(ubrk_current)
 #define ubrk_first U_ICU_ENTRY_POINT_RENAME(ubrk_first)
 #define ubrk_following U_ICU_ENTRY_POINT_RENAME(ubrk_following)
+#define ubrk_getAllBoundaries U_ICU_ENTRY_POINT_RENAME(ubrk_getAllBoundaries)
 #define ubrk_getAvailable U_ICU_ENTRY_POINT_RENAME(ubrk_getAvailable)
 #define ubrk_getBinaryRules U_ICU_ENTRY_POINT_RENAME(ubrk_getBinaryRules)
+#define ubrk_getBoundaries U_ICU_ENTRY_POINT_RENAME(ubrk_getBoundaries)
 #define ubrk_getLocaleByType U_ICU_ENTRY_POINT_RENAME(ubrk_getLocaleByType)
+#define ubrk_getPoolStatistics U_ICU_ENTRY_POINT_RENAME(ubrk_getPoolStatistics)
 #define ubrk_getRuleStatus U_ICU_ENTRY_POINT_RENAME(ubrk_getRuleStatus)
 #define ubrk_getRuleStatusVec U_ICU_ENTRY_POINT_RENAME(ubrk_getRuleStatusVec)
 #define ubrk_isBoundary U_ICU_ENTRY_POINT_RENAME(ubrk_isBoundary)
@@ -493,10 +497,13 @@
 #define ubrk_next U_ICU_ENTRY_POINT_RENAME(ubrk_next)
 #define ubrk_open U_ICU_ENTRY_POINT_RENAME(ubrk_open)
 #define ubrk_openBinaryRules U_ICU_ENTRY_POINT_RENAME(ubrk_openBinaryRules)
+#define ubrk_openFromPool U_ICU_ENTRY_POINT_RENAME(ubrk_openFromPool)
+#define ubrk_openPool U_ICU_ENTRY_POINT_RENAME(ubrk_openPool)
 #define ubrk_openRules U_ICU_ENTRY_POINT_RENAME(ubrk_openRules)
 #define ubrk_preceding U_ICU_ENTRY_POINT_RENAME(ubrk_preceding)
 #define ubrk_previous U_ICU_ENTRY_POINT_RENAME(ubrk_previous)
 #define ubrk_refreshUText U_ICU_ENTRY_POINT_RENAME(ubrk_refreshUText)
+#define ubrk_returnToPool U_ICU_ENTRY_POINT_RENAME(ubrk_returnToPool)
 #define ubrk_safeClone U_ICU_ENTRY_POINT_RENAME(ubrk_safeClone)
 #define ubrk_setText U_ICU_ENTRY_POINT_RENAME(ubrk_setText)
 #define ubrk_setUText U_ICU_ENTRY_POINT_RENAME(ubrk_setUText)
@@ -593,6 +600,7 @@
 #define ucnv_MBCSFromUChar32 U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSFromUChar32)
 #define ucnv_MBCSFromUnicodeWithOffsets U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSFromUnicodeWithOffsets)
 #define ucnv_MBCSGetFilteredUnicodeSetForUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetFilteredUnicodeSetForUnicode)
+#define ucnv_MBCSGetResyncChars U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetResyncChars)
 #define ucnv_MBCSGetType U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetType)
 #define ucnv_MBCSGetUnicodeSetForUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetUnicodeSetForUnicode)
 #define ucnv_MBCSIsLeadByte U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSIsLeadByte)
@@ -610,6 +618,7 @@
 #define ucnv_compareNames U_ICU_ENTRY_POINT_RENAME(ucnv_compareNames)
 #define ucnv_convert U_ICU_ENTRY_POINT_RENAME(ucnv_convert)
 #define ucnv_convertEx U_ICU_ENTRY_POINT_RENAME(ucnv_convertEx)
+#define ucnv_convertParallel U_ICU_ENTRY_POINT_RENAME(ucnv_convertParallel)
 #define ucnv_countAliases U_ICU_ENTRY_POINT_RENAME(ucnv_countAliases)
 #define ucnv_countAvailable U_ICU_ENTRY_POINT_RENAME(ucnv_countAvailable)
 #define ucnv_countStandards U_ICU_ENTRY_POINT_RENAME(ucnv_countStandards)
@@ -624,6 +633,8 @@
 #define ucnv_extGetUnicodeSet U_ICU_ENTRY_POINT_RENAME(ucnv_extGetUnicodeSet)
 #define ucnv_extInitialMatchFromU U_ICU_ENTRY_POINT_RENAME(ucnv_extInitialMatchFromU)
 #define ucnv_extInitialMatchToU U_ICU_ENTRY_POINT_RENAME(ucnv_extInitialMatchToU)
+#define ucnv_extIsFromUBoundary U_ICU_ENTRY_POINT_RENAME(ucnv_extIsFromUBoundary)
+#define ucnv_extIsToUBoundary U_ICU_ENTRY_POINT_RENAME(ucnv_extIsToUBoundary)
 #define ucnv_extSimpleMatchFromU U_ICU_ENTRY_POINT_RENAME(ucnv_extSimpleMatchFromU)
 #define ucnv_extSimpleMatchToU U_ICU_ENTRY_POINT_RENAME(ucnv_extSimpleMatchToU)
 #define ucnv_fixFileSeparator U_ICU_ENTRY_POINT_RENAME(ucnv_fixFileSeparator)
@@ -660,6 +671,7 @@
 #define ucnv_getType U_ICU_ENTRY_POINT_RENAME(ucnv_getType)
 #define ucnv_getUnicodeSet U_ICU_ENTRY_POINT_RENAME(ucnv_getUnicodeSet)
 #define ucnv_incrementRefCount U_ICU_ENTRY_POINT_RENAME(ucnv_incrementRefCount)
+#define ucnv_internalConvert U_ICU_ENTRY_POINT_RENAME(ucnv_internalConvert)
 #define ucnv_io_countKnownConverters U_ICU_ENTRY_POINT_RENAME(ucnv_io_countKnownConverters)
 #define ucnv_io_getConverterName U_ICU_ENTRY_POINT_RENAME(ucnv_io_getConverterName)
 #define ucnv_io_stripASCIIForCompare U_ICU_ENTRY_POINT_RENAME(ucnv_io_stripASCIIForCompare)
@@ -702,6 +714,7 @@
 #define ucnvsel_selectForUTF8 U_ICU_ENTRY_POINT_RENAME(ucnvsel_selectForUTF8)
 #define ucnvsel_serialize U_ICU_ENTRY_POINT_RENAME(ucnvsel_serialize)
 #define ucol_cloneBinary U_ICU_ENTRY_POINT_RENAME(ucol_cloneBinary)
+#define ucol_cloneWithAttributes U_ICU_ENTRY_POINT_RENAME(ucol_cloneWithAttributes)
 #define ucol_close U_ICU_ENTRY_POINT_RENAME(ucol_close)
 #define ucol_closeElements U_ICU_ENTRY_POINT_RENAME(ucol_closeElements)
 #define ucol_countAvailable U_ICU_ENTRY_POINT_RENAME(ucol_countAvailable)
@@ -728,6 +741,8 @@
 #define ucol_getRulesEx U_ICU_ENTRY_POINT_RENAME(ucol_getRulesEx)
 #define ucol_getShortDefinitionString U_ICU_ENTRY_POINT_RENAME(ucol_getShortDefinitionString)
 #define ucol_getSortKey U_ICU_ENTRY_POINT_RENAME(ucol_getSortKey)
+#define ucol_getSortKeys U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeys)
+#define ucol_getSortKeysUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeysUTF8)
 #define ucol_getStrength U_ICU_ENTRY_POINT_RENAME(ucol_getStrength)
 #define ucol_getTailoredSet U_ICU_ENTRY_POINT_RENAME(ucol_getTailoredSet)
 #define ucol_getUCAVersion U_ICU_ENTRY_POINT_RENAME(ucol_getUCAVersion)
@@ -740,14 +755,17 @@
 #define ucol_looksLikeCollationBinary U_ICU_ENTRY_POINT_RENAME(ucol_looksLikeCollationBinary)
 #define ucol_mergeSortkeys U_ICU_ENTRY_POINT_RENAME(ucol_mergeSortkeys)
 #define ucol_next U_ICU_ENTRY_POINT_RENAME(ucol_next)
+#define ucol_nextCEs U_ICU_ENTRY_POINT_RENAME(ucol_nextCEs)
 #define ucol_nextSortKeyPart U_ICU_ENTRY_POINT_RENAME(ucol_nextSortKeyPart)
 #define ucol_normalizeShortDefinitionString U_ICU_ENTRY_POINT_RENAME(ucol_normalizeShortDefinitionString)
 #define ucol_open U_ICU_ENTRY_POINT_RENAME(ucol_open)
 #define ucol_openAvailableLocales U_ICU_ENTRY_POINT_RENAME(ucol_openAvailableLocales)
 #define ucol_openBinary U_ICU_ENTRY_POINT_RENAME(ucol_openBinary)
 #define ucol_openElements U_ICU_ENTRY_POINT_RENAME(ucol_openElements)
+#define ucol_openElementsUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_openElementsUTF8)
 #define ucol_openFromShortString U_ICU_ENTRY_POINT_RENAME(ucol_openFromShortString)
 #define ucol_openRules U_ICU_ENTRY_POINT_RENAME(ucol_openRules)
+#define ucol_openRulesWithCache U_ICU_ENTRY_POINT_RENAME(ucol_openRulesWithCache)
 #define ucol_prepareShortStringOpen U_ICU_ENTRY_POINT_RENAME(ucol_prepareShortStringOpen)
 #define ucol_previous U_ICU_ENTRY_POINT_RENAME(ucol_previous)
 #define ucol_primaryOrder U_ICU_ENTRY_POINT_RENAME(ucol_primaryOrder)
@@ -761,7 +779,10 @@
 #define ucol_setReorderCodes U_ICU_ENTRY_POINT_RENAME(ucol_setReorderCodes)
 #define ucol_setStrength U_ICU_ENTRY_POINT_RENAME(ucol_setStrength)
 #define ucol_setText U_ICU_ENTRY_POINT_RENAME(ucol_setText)
+#define ucol_setTextUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_setTextUTF8)
 #define ucol_setVariableTop U_ICU_ENTRY_POINT_RENAME(ucol_setVariableTop)
+#define ucol_sortStrings U_ICU_ENTRY_POINT_RENAME(ucol_sortStrings)
+#define ucol_sortStringsUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_sortStringsUTF8)
 #define ucol_strcoll U_ICU_ENTRY_POINT_RENAME(ucol_strcoll)
 #define ucol_strcollIter U_ICU_ENTRY_POINT_RENAME(ucol_strcollIter)
 #define ucol_strcollUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_strcollUTF8)
@@ -1139,6 +1160,7 @@
 #define uniset_getUnicode32Instance U_ICU_ENTRY_POINT_RENAME(uniset_getUnicode32Instance)
 #define unorm2_append U_ICU_ENTRY_POINT_RENAME(unorm2_append)
 #define unorm2_close U_ICU_ENTRY_POINT_RENAME(unorm2_close)
+#define unorm2_closeStreaming U_ICU_ENTRY_POINT_RENAME(unorm2_closeStreaming)
 #define unorm2_composePair U_ICU_ENTRY_POINT_RENAME(unorm2_composePair)
 #define unorm2_getCombiningClass U_ICU_ENTRY_POINT_RENAME(unorm2_getCombiningClass)
 #define unorm2_getDecomposition U_ICU_ENTRY_POINT_RENAME(unorm2_getDecomposition)
@@ -1155,8 +1177,13 @@
 #define unorm2_isNormalized U_ICU_ENTRY_POINT_RENAME(unorm2_isNormalized)
 #define unorm2_normalize U_ICU_ENTRY_POINT_RENAME(unorm2_normalize)
 #define unorm2_normalizeSecondAndAppend U_ICU_ENTRY_POINT_RENAME(unorm2_normalizeSecondAndAppend)
+#define unorm2_normalizeStreaming U_ICU_ENTRY_POINT_RENAME(unorm2_normalizeStreaming)
+#define unorm2_normalizeStreamingUTF8 U_ICU_ENTRY_POINT_RENAME(unorm2_normalizeStreamingUTF8)
+#define unorm2_normalizeUTF8Batch U_ICU_ENTRY_POINT_RENAME(unorm2_normalizeUTF8Batch)
 #define unorm2_openFiltered U_ICU_ENTRY_POINT_RENAME(unorm2_openFiltered)
+#define unorm2_openStreaming U_ICU_ENTRY_POINT_RENAME(unorm2_openStreaming)
 #define unorm2_quickCheck U_ICU_ENTRY_POINT_RENAME(unorm2_quickCheck)
+#define unorm2_quickCheckBatch U_ICU_ENTRY_POINT_RENAME(unorm2_quickCheckBatch)
 #define unorm2_spanQuickCheckYes U_ICU_ENTRY_POINT_RENAME(unorm2_spanQuickCheckYes)
 #define unorm2_swap U_ICU_ENTRY_POINT_RENAME(unorm2_swap)
 #define unorm_compare U_ICU_ENTRY_POINT_RENAME(unorm_compare)
@@ -1595,6 +1622,7 @@
 #define usearch_setOffset U_ICU_ENTRY_POINT_RENAME(usearch_setOffset)
 #define usearch_setPattern U_ICU_ENTRY_POINT_RENAME(usearch_setPattern)
 #define usearch_setText U_ICU_ENTRY_POINT_RENAME(usearch_setText)
+#define usearch_setTextUTF8 U_ICU_ENTRY_POINT_RENAME(usearch_setTextUTF8)
 #define uset_add U_ICU_ENTRY_POINT_RENAME(uset_add)
 #define uset_addAll U_ICU_ENTRY_POINT_RENAME(uset_addAll)
 #define uset_addAllCodePoints U_ICU_ENTRY_POINT_RENAME(uset_addAllCodePoints)
@@ -424,12 +424,16 @@ typedef enum UErrorCode {
     
     U_PLUGIN_CHANGED_LEVEL_WARNING = -120, /**< A plugin caused a level change. May not be an error, but later plugins may not load. */
 
+#ifndef U_HIDE_DRAFT_API
+    U_SEQUENTIAL_FALLBACK_WARNING = -119, /**< A parallel operation was performed on a single thread because its input or its settings do not support splitting, for example text in a stateful charset or a custom converter callback. @draft ICU 64 */
+#endif  // U_HIDE_DRAFT_API
+
 #ifndef U_HIDE_DEPRECATED_API
     /**
      * One more than the highest normal UErrorCode warning value.
      * @deprecated ICU 58 The numeric value may change over time, see ICU ticket #12420.
      */
-    U_ERROR_WARNING_LIMIT,
+    U_ERROR_WARNING_LIMIT = -118,
 #endif  // U_HIDE_DEPRECATED_API
 
     U_ZERO_ERROR              =  0,     /**< No error, no warning. */
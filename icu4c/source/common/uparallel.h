@@ -0,0 +1,134 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// uparallel.h
+// created: 2018oct17
+//
+// Helpers for the optional multi-threaded batch functions.
+// Include this only in the translation units that implement such functions
+// (kept separate from the rest of their service),
+// so that code which does not use them does not pull in std::thread.
+
+#ifndef __UPARALLEL_H__
+#define __UPARALLEL_H__
+
+#include "unicode/utypes.h"
+
+#include <thread>
+
+#include "unicode/localpointer.h"
+#include "unicode/uobject.h"
+
+U_NAMESPACE_BEGIN
+
+/**
+ * Returns the number of chunks into which to split length units of work
+ * for up to numThreads threads, so that each chunk gets at least minPerThread units.
+ * numThreads is limited to the number of hardware threads, if that is known.
+ * Returns 1 (do all of the work on the calling thread) if numThreads<=1
+ * or if there is not enough work for two chunks.
+ */
+inline int32_t getNumParallelChunks(int64_t length, int32_t numThreads, int32_t minPerThread) {
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads != 0 && (unsigned int)numThreads > hardwareThreads) {
+        numThreads = (int32_t)hardwareThreads;
+    }
+    if (numThreads <= 1) {
+        return 1;
+    }
+    int64_t maxChunks = length / minPerThread;
+    if (maxChunks <= 1) {
+        return 1;
+    }
+    return numThreads < maxChunks ? numThreads : (int32_t)maxChunks;
+}
+
+/**
+ * Returns the start of chunk i when [0, length[ is split into numChunks
+ * ranges of about equal size. i=numChunks yields length.
+ */
+inline int32_t getParallelChunkStart(int32_t length, int32_t i, int32_t numChunks) {
+    return (int32_t)(((int64_t)length * i) / numChunks);
+}
+
+namespace parallel_impl {
+
+/** A chunk's thread and its error code; chunk 0 runs on the calling thread. */
+struct ChunkThread : public UMemory {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    std::thread thread;
+};
+
+}  // namespace parallel_impl
+
+/**
+ * Calls chunkFn(i, chunkErrorCode) for each i in [0, numChunks[,
+ * for i=0 on the calling thread and for each other one on a new thread,
+ * and waits for all of them.
+ * Then sets errorCode to the first (lowest-index) chunk failure, if any.
+ * Each call gets its own UErrorCode that starts as U_ZERO_ERROR;
+ * functions that need per-chunk error handling can keep their own error codes instead.
+ * If a thread cannot be started, then its chunk and all later ones run on the calling thread.
+ */
+template<typename ChunkFn>
+void runParallelChunks(int32_t numChunks, const ChunkFn &chunkFn, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (numChunks <= 1) {
+        if (numChunks == 1) {
+            chunkFn(0, errorCode);
+        }
+        return;
+    }
+    LocalArray<parallel_impl::ChunkThread> threads(
+        new parallel_impl::ChunkThread[numChunks], errorCode);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    int32_t numStarted = 1;
+    for (; numStarted < numChunks; ++numStarted) {
+        parallel_impl::ChunkThread &t = threads[numStarted];
+        int32_t i = numStarted;
+        try {
+            t.thread = std::thread([&chunkFn, &t, i]() { chunkFn(i, t.errorCode); });
+        } catch (...) {
+            // std::system_error or std::bad_alloc: Must not escape into C APIs.
+            break;
+        }
+    }
+    chunkFn(0, threads[0].errorCode);
+    for (int32_t i = numStarted; i < numChunks; ++i) {
+        chunkFn(i, threads[i].errorCode);
+    }
+    for (int32_t i = 1; i < numStarted; ++i) {
+        threads[i].thread.join();
+    }
+    for (int32_t i = 0; i < numChunks; ++i) {
+        if (U_FAILURE(threads[i].errorCode)) {
+            errorCode = threads[i].errorCode;
+            break;
+        }
+    }
+}
+
+/**
+ * Splits [0, length[ into getNumParallelChunks(length, numThreads, minPerThread)
+ * ranges of about equal size and calls rangeFn(i, start, limit, chunkErrorCode)
+ * for each of them as in runParallelChunks().
+ * Callers that keep per-chunk results can call getNumParallelChunks()
+ * with the same arguments to size their arrays.
+ */
+template<typename RangeFn>
+void runInChunks(int32_t length, int32_t numThreads, int32_t minPerThread,
+                 const RangeFn &rangeFn, UErrorCode &errorCode) {
+    int32_t numChunks = getNumParallelChunks(length, numThreads, minPerThread);
+    runParallelChunks(numChunks, [length, numChunks, &rangeFn](int32_t i, UErrorCode &chunkErrorCode) {
+        rangeFn(i, getParallelChunkStart(length, i, numChunks),
+                getParallelChunkStart(length, i + 1, numChunks), chunkErrorCode);
+    }, errorCode);
+}
+
+U_NAMESPACE_END
+
+#endif  // __UPARALLEL_H__
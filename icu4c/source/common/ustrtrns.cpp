@@ -35,6 +35,7 @@
 #include "cmemory.h"
 #include "ustr_imp.h"
 #include "uassert.h"
+#include "utfsimd.h"
 
 U_CAPI UChar* U_EXPORT2 
 u_strFromUTF32WithSub(UChar *dest,
@@ -379,6 +380,13 @@ u_strFromUTF8WithSub(UChar *dest,
         int32_t i = 0;
         UChar32 c;
         for(;;) {
+            /* Convert blocks of well-formed 1..3-byte sequences with vector code. */
+            int32_t consumed;
+            pDest += icu::UTFSIMD::fromUTF8((const uint8_t *)src + i, srcLength - i,
+                                            pDest, (int32_t)(pDestLimit - pDest),
+                                            &consumed, NULL, 0);
+            i += consumed;
+
             /*
              * Each iteration of the inner loop progresses by at most 3 UTF-8
              * bytes and one UChar, for most characters.
@@ -397,6 +405,9 @@ u_strFromUTF8WithSub(UChar *dest,
                  */
                 break;
             }
+            if(count > icu::UTFSIMD::SCALAR_CHUNK_LENGTH) {
+                count = icu::UTFSIMD::SCALAR_CHUNK_LENGTH; /* return to the vector code soon */
+            }
 
             do {
                 // modified copy of U8_NEXT()
@@ -899,6 +910,13 @@ u_strToUTF8WithSub(char *dest,
 
         /* Faster loop without ongoing checking for pSrcLimit and pDestLimit. */
         for(;;) {
+            /* Convert blocks without surrogates with vector code. */
+            int32_t consumed;
+            pDest += icu::UTFSIMD::toUTF8(pSrc, (int32_t)(pSrcLimit - pSrc),
+                                          pDest, (int32_t)(pDestLimit - pDest),
+                                          &consumed, NULL, 0);
+            pSrc += consumed;
+
             /*
              * Each iteration of the inner loop progresses by at most 3 UTF-8
              * bytes and one UChar, for most characters.
@@ -917,6 +935,9 @@ u_strToUTF8WithSub(char *dest,
                  */
                 break;
             }
+            if(count > icu::UTFSIMD::SCALAR_CHUNK_LENGTH) {
+                count = icu::UTFSIMD::SCALAR_CHUNK_LENGTH; /* return to the vector code soon */
+            }
             do {
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
@@ -25,6 +25,7 @@
 #include "unicode/utf8.h"
 #include "unicode/utf16.h"
 #include "ustr_imp.h"
+#include "utext_imp.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "uassert.h"
@@ -1625,6 +1626,15 @@ static const struct UTextFuncs utf8Funcs =
 
 static const char gEmptyString[] = {0};
 
+U_CFUNC const uint8_t *
+utext_getUTF8Bytes(UText *ut, int32_t *pLength) {
+    if (ut->pFuncs != &utf8Funcs) {
+        return NULL;
+    }
+    *pLength = (int32_t)utf8TextLength(ut);  // Scans for the NUL if not yet known.
+    return (const uint8_t *)ut->context;
+}
+
 U_CAPI UText * U_EXPORT2
 utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status) {
     if(U_FAILURE(*status)) {
@@ -0,0 +1,25 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// utext_imp.h
+// created: 2018oct29
+
+#ifndef __UTEXT_IMP_H__
+#define __UTEXT_IMP_H__
+
+#include "unicode/utypes.h"
+#include "unicode/utext.h"
+
+/**
+ * If ut was opened with utext_openUTF8(), or is a clone of such a UText,
+ * then this function returns the UTF-8 bytes and sets *pLength to their number.
+ * Native indexes into such a text are byte offsets into these bytes.
+ * Otherwise returns NULL.
+ *
+ * Lets performance-critical code iterate over UTF-8 text directly
+ * rather than through the UTF-16 chunks of the UText.
+ */
+U_CFUNC const uint8_t *
+utext_getUTF8Bytes(UText *ut, int32_t *pLength);
+
+#endif
@@ -0,0 +1,613 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// utfsimd.cpp
+// created: 2018nov02
+
+#include "unicode/utypes.h"
+#include "unicode/utf16.h"
+#include "simdutil.h"
+#include "umutex.h"
+#include "utfsimd.h"
+
+/*
+ * UTFSIMD_SSSE3 is 1 if the shuffle kernels are compiled.
+ * UTFSIMD_SSSE3_RUNTIME is 1 if they are compiled for the SSSE3 target
+ * and used only if the CPU reports SSSE3 support.
+ */
+#if U_SIMD_SSSE3
+#   define UTFSIMD_SSSE3 1
+#   define UTFSIMD_SSSE3_RUNTIME 0
+#   define UTFSIMD_TARGET_SSSE3
+#elif U_SIMD_SSE2 && (U_GCC_MAJOR_MINOR >= 409 || defined(__clang__))
+#   define UTFSIMD_SSSE3 1
+#   define UTFSIMD_SSSE3_RUNTIME 1
+#   define UTFSIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#   include <tmmintrin.h>
+#   include <cpuid.h>
+#elif U_SIMD_SSE2 && defined(_MSC_VER)
+#   define UTFSIMD_SSSE3 1
+#   define UTFSIMD_SSSE3_RUNTIME 1
+#   define UTFSIMD_TARGET_SSSE3
+#   include <tmmintrin.h>
+#   include <intrin.h>
+#else
+#   define UTFSIMD_SSSE3 0
+#endif
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+UInitOnce gInitOnce = U_INITONCE_INITIALIZER;
+
+/** The level that the CPU supports. */
+int32_t gMaxLevel = UTFSIMD::SCALAR;
+/** The level in use. */
+int32_t gLevel = UTFSIMD::SCALAR;
+
+/** Returns the number of trailing 0 bits in x, which must not be 0. */
+inline int32_t countTrailingZeros(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    int32_t n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/** Returns the index of the highest 1 bit in x, which must not be 0. */
+inline int32_t highestBit(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(x);
+#else
+    int32_t n = 31;
+    while ((x & 0x80000000) == 0) {
+        x <<= 1;
+        --n;
+    }
+    return n;
+#endif
+}
+
+/**
+ * Widens the leading 16-byte blocks of ASCII in src to UTF-16.
+ * Returns the number of bytes and UChars converted.
+ */
+inline int32_t fromASCII(const uint8_t *src, int32_t srcLength,
+                         UChar *dest, int32_t destCapacity,
+                         int32_t *offsets, int32_t sourceIndex) {
+    int32_t i = 0;
+#if U_SIMD_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while ((srcLength - i) >= 16 && (destCapacity - i) >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (_mm_movemask_epi8(v) != 0) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 8), _mm_unpackhi_epi8(v, zero));
+        if (offsets != NULL) {
+            for (int32_t k = 0; k < 16; ++k) {
+                offsets[i + k] = sourceIndex + i + k;
+            }
+        }
+        i += 16;
+    }
+#elif U_SIMD_NEON
+    while ((srcLength - i) >= 16 && (destCapacity - i) >= 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if (vmaxvq_u8(v) >= 0x80) {
+            break;
+        }
+        vst1q_u16(reinterpret_cast<uint16_t *>(dest + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16(reinterpret_cast<uint16_t *>(dest + i + 8), vmovl_u8(vget_high_u8(v)));
+        if (offsets != NULL) {
+            for (int32_t k = 0; k < 16; ++k) {
+                offsets[i + k] = sourceIndex + i + k;
+            }
+        }
+        i += 16;
+    }
+#else
+    (void)src;
+    (void)srcLength;
+    (void)dest;
+    (void)destCapacity;
+    (void)offsets;
+    (void)sourceIndex;
+#endif
+    return i;
+}
+
+/**
+ * Narrows the leading 16-unit blocks of ASCII in src to UTF-8.
+ * Returns the number of UChars and bytes converted.
+ */
+inline int32_t toASCII(const UChar *src, int32_t srcLength,
+                       uint8_t *dest, int32_t destCapacity,
+                       int32_t *offsets, int32_t sourceIndex) {
+    int32_t i = 0;
+#if U_SIMD_SSE2
+    const __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+    const __m128i zero = _mm_setzero_si128();
+    while ((srcLength - i) >= 16 && (destCapacity - i) >= 16) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(v0, v1), nonASCII);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_packus_epi16(v0, v1));
+        if (offsets != NULL) {
+            for (int32_t k = 0; k < 16; ++k) {
+                offsets[i + k] = sourceIndex + i + k;
+            }
+        }
+        i += 16;
+    }
+#elif U_SIMD_NEON
+    while ((srcLength - i) >= 16 && (destCapacity - i) >= 16) {
+        uint16x8_t v0 = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i));
+        uint16x8_t v1 = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i + 8));
+        if (vmaxvq_u16(vmaxq_u16(v0, v1)) >= 0x80) {
+            break;
+        }
+        vst1q_u8(dest + i, vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+        if (offsets != NULL) {
+            for (int32_t k = 0; k < 16; ++k) {
+                offsets[i + k] = sourceIndex + i + k;
+            }
+        }
+        i += 16;
+    }
+#else
+    (void)src;
+    (void)srcLength;
+    (void)dest;
+    (void)destCapacity;
+    (void)offsets;
+    (void)sourceIndex;
+#endif
+    return i;
+}
+
+#if UTFSIMD_SSSE3
+
+/**
+ * For each set of 8 16-bit lanes (bit k for lane k),
+ * a byte shuffle control that moves the lanes in the set to the front, in order.
+ */
+uint8_t gCompactLanes[256][16];
+
+/**
+ * For 4 UTF-8 sequences of 0..3 bytes each (bits 2k..2k+1 of the index for sequence k),
+ * a byte shuffle control that moves them from 32-bit elements to consecutive bytes.
+ */
+uint8_t gLaneBytes[256][16];
+
+/** Total number of bytes for each gLaneBytes index. */
+uint8_t gLaneBytesLength[256];
+
+/** Number of 1 bits in each byte value. */
+uint8_t gBitCount[256];
+
+/** Moves bit k of a 4-bit value to bit 2k. */
+const uint8_t gSpreadBits[16] = {
+    0, 1, 4, 5, 0x10, 0x11, 0x14, 0x15, 0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55
+};
+
+UBool cpuHasSSSE3() {
+#if !UTFSIMD_SSSE3_RUNTIME
+    return TRUE;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & (1 << 9)) != 0;
+#endif
+}
+
+void initShuffles() {
+    for (int32_t set = 0; set < 256; ++set) {
+        int32_t count = 0, j = 0;
+        for (int32_t lane = 0; lane < 8; ++lane) {
+            if ((set >> lane) & 1) {
+                ++count;
+                gCompactLanes[set][j++] = (uint8_t)(2 * lane);
+                gCompactLanes[set][j++] = (uint8_t)(2 * lane + 1);
+            }
+        }
+        // Indexes with the high bit set yield 0 bytes.
+        while (j < 16) {
+            gCompactLanes[set][j++] = 0x80;
+        }
+        gBitCount[set] = (uint8_t)count;
+
+        int32_t k = 0;
+        for (int32_t lane = 0; lane < 4; ++lane) {
+            int32_t length = (set >> (2 * lane)) & 3;
+            for (int32_t b = 0; b < length; ++b) {
+                gLaneBytes[set][k++] = (uint8_t)(4 * lane + b);
+            }
+        }
+        gLaneBytesLength[set] = (uint8_t)k;
+        while (k < 16) {
+            gLaneBytes[set][k++] = 0x80;
+        }
+    }
+}
+
+/** Returns (m & a) | (~m & b). */
+inline __m128i blend(__m128i m, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+
+/**
+ * Returns a mask with bit k set for byte k of the 18 bytes
+ * whose first 16 are compared in m0 and last 16 in m2.
+ */
+inline uint32_t byteMask18(__m128i m0, __m128i m2) {
+    return (uint32_t)_mm_movemask_epi8(m0) | (((uint32_t)_mm_movemask_epi8(m2) & 0xc000) << 2);
+}
+
+/** Returns a mask with bit k set for 16-bit lane k where m is all ones. */
+inline uint32_t laneMask(__m128i m) {
+    return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128()));
+}
+
+/**
+ * Writes the first lowLength bytes of low followed by the first length-lowLength bytes of high,
+ * and nothing after them, so that the output may end right before memory
+ * that the caller does not own.
+ * The other bytes of low must be 0. lowLength<=16 and length-lowLength<=16.
+ */
+UTFSIMD_TARGET_SSSE3 inline void
+storeBytes(uint8_t *p, __m128i low, __m128i high, int32_t lowLength, int32_t length) {
+    const __m128i indexes = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    // Indexes below 0 have the high bit set and yield 0 bytes.
+    __m128i v = _mm_or_si128(low, _mm_shuffle_epi8(high, _mm_sub_epi8(indexes, _mm_set1_epi8((char)lowLength))));
+    if (length >= 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+        v = _mm_shuffle_epi8(high, _mm_add_epi8(indexes, _mm_set1_epi8((char)(16 - lowLength))));
+        p += 16;
+        length -= 16;
+    }
+    if (length >= 8) {
+        // Two 8-byte stores that overlap unless length is 16.
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(p), v);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(p + length - 8),
+                         _mm_shuffle_epi8(v, _mm_add_epi8(indexes, _mm_set1_epi8((char)(length - 8)))));
+    } else if (length > 0) {
+        uint8_t buffer[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer), v);
+        for (int32_t k = 0; k < length; ++k) {
+            p[k] = buffer[k];
+        }
+    }
+}
+
+/**
+ * Decodes 8 UTF-8 sequences, or fewer, from the lead bytes in b0
+ * and the following bytes in b1 and b2, one per 16-bit lane.
+ * Lanes with trail bytes in b0 yield unused values.
+ */
+inline __m128i decodeLanes(__m128i b0, __m128i b1, __m128i b2) {
+    const __m128i trailBits = _mm_set1_epi16(0x3f);
+    __m128i t1 = _mm_and_si128(b1, trailBits);
+    __m128i t2 = _mm_and_si128(b2, trailBits);
+    __m128i two = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b0, _mm_set1_epi16(0x1f)), 6), t1);
+    // The shift by 12 drops the 0xe0 lead byte bits.
+    __m128i three = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(b0, 12), _mm_slli_epi16(t1, 6)), t2);
+    __m128i c = blend(_mm_cmpgt_epi16(b0, _mm_set1_epi16(0x7f)), two, b0);
+    return blend(_mm_cmpgt_epi16(b0, _mm_set1_epi16(0xdf)), three, c);
+}
+
+UTFSIMD_TARGET_SSSE3 int32_t
+fromUTF8Shuffle(const uint8_t *src, int32_t srcLength,
+                UChar *dest, int32_t destCapacity,
+                int32_t *pSrcConsumed,
+                int32_t *offsets, int32_t sourceIndex) {
+    const __m128i zero = _mm_setzero_si128();
+    // Signed byte comparisons: 80..BF < C0..DF < E0..EF < F0..FF < 00..7F
+    const __m128i minLead2 = _mm_set1_epi8((char)0xc0);
+    const __m128i maxCont = _mm_set1_epi8((char)0xc1);
+    const __m128i minLead3 = _mm_set1_epi8((char)0xe0);
+    const __m128i maxLead2 = _mm_set1_epi8((char)0xdf);
+    const __m128i minLead4 = _mm_set1_epi8((char)0xf0);
+    const __m128i e0 = _mm_set1_epi8((char)0xe0);
+    const __m128i ed = _mm_set1_epi8((char)0xed);
+    const __m128i a0 = _mm_set1_epi8((char)0xa0);
+    const __m128i x9f = _mm_set1_epi8((char)0x9f);
+    const __m128i lowPositions = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m128i highPositions = _mm_setr_epi16(8, 9, 10, 11, 12, 13, 14, 15);
+    // Five 3-byte sequences: lead bytes E0..EF and trail bytes 80..BF in s[0..14].
+    const __m128i lead3TrailBits = _mm_setr_epi8(
+        (char)0xf0, (char)0xc0, (char)0xc0, (char)0xf0, (char)0xc0, (char)0xc0, (char)0xf0, (char)0xc0,
+        (char)0xc0, (char)0xf0, (char)0xc0, (char)0xc0, (char)0xf0, (char)0xc0, (char)0xc0, 0);
+    const __m128i lead3Trails = _mm_setr_epi8(
+        (char)0xe0, (char)0x80, (char)0x80, (char)0xe0, (char)0x80, (char)0x80, (char)0xe0, (char)0x80,
+        (char)0x80, (char)0xe0, (char)0x80, (char)0x80, (char)0xe0, (char)0x80, (char)0x80, 0);
+    // Per 16-bit lane: the second trail byte in the low byte, the first one in the high byte.
+    const __m128i trailPairs = _mm_setr_epi8(2, 1, 5, 4, 8, 7, 11, 10, 14, 13, -1, -1, -1, -1, -1, -1);
+    // Per 16-bit lane: the lead byte in the high byte.
+    const __m128i leadBytes = _mm_setr_epi8(-1, 0, -1, 3, -1, 6, -1, 9, -1, 12, -1, -1, -1, -1, -1, -1);
+    const __m128i trailBits = _mm_set1_epi16(0x3f);
+    const __m128i trail1Bits = _mm_set1_epi16(0x3f00);
+    int32_t i = 0, j = 0;
+    while ((srcLength - i) >= 18 && (destCapacity - j) >= 16) {
+        const uint8_t *s = src + i;
+        // Leave trail bytes, C0, C1 and 4-byte sequences to the caller right away.
+        if (*s >= 0x80 && (*s < 0xc2 || *s >= 0xf0)) {
+            break;
+        }
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+        if (_mm_movemask_epi8(v0) == 0) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + j), _mm_unpacklo_epi8(v0, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + j + 8), _mm_unpackhi_epi8(v0, zero));
+            if (offsets != NULL) {
+                for (int32_t k = 0; k < 16; ++k) {
+                    offsets[j + k] = sourceIndex + i + k;
+                }
+            }
+            i += 16;
+            j += 16;
+            continue;
+        }
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 1));
+        // E0 must be followed by A0..BF, ED by 80..9F (no surrogates).
+        uint32_t badLead3 = (uint32_t)_mm_movemask_epi8(_mm_or_si128(
+            _mm_and_si128(_mm_cmpeq_epi8(v0, e0), _mm_cmplt_epi8(v1, a0)),
+            _mm_and_si128(_mm_cmpeq_epi8(v0, ed), _mm_cmpgt_epi8(v1, x9f))));
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v0, lead3TrailBits), lead3Trails)) &
+                    0x7fff) == 0x7fff &&
+                (badLead3 & 0x7fff) == 0) {
+            // Five 3-byte sequences, common in CJK text.
+            __m128i t = _mm_shuffle_epi8(v0, trailPairs);
+            __m128i c = _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(t, trailBits), _mm_srli_epi16(_mm_and_si128(t, trail1Bits), 2)),
+                _mm_slli_epi16(_mm_shuffle_epi8(v0, leadBytes), 4));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dest + j), c);
+            dest[j + 4] = (UChar)_mm_extract_epi16(c, 4);
+            if (offsets != NULL) {
+                for (int32_t k = 0; k < 5; ++k) {
+                    offsets[j + k] = sourceIndex + i + 3 * k;
+                }
+            }
+            i += 15;
+            j += 5;
+            continue;
+        }
+        __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 2));
+
+        // Classify s[0..17]: bit k of each mask is for byte s[k].
+        uint32_t ascii = ~byteMask18(v0, v2) & 0x3ffff;
+        uint32_t trail = byteMask18(_mm_cmplt_epi8(v0, minLead2), _mm_cmplt_epi8(v2, minLead2));
+        uint32_t lead2 = byteMask18(
+            _mm_and_si128(_mm_cmpgt_epi8(v0, maxCont), _mm_cmplt_epi8(v0, minLead3)),
+            _mm_and_si128(_mm_cmpgt_epi8(v2, maxCont), _mm_cmplt_epi8(v2, minLead3)));
+        uint32_t lead3 = byteMask18(
+            _mm_and_si128(_mm_cmpgt_epi8(v0, maxLead2), _mm_cmplt_epi8(v0, minLead4)),
+            _mm_and_si128(_mm_cmpgt_epi8(v2, maxLead2), _mm_cmplt_epi8(v2, minLead4)));
+        uint32_t expectedTrail = (((lead2 | lead3) << 1) | (lead3 << 2)) & 0x3ffff;
+        uint32_t other = ~(ascii | trail | lead2 | lead3) & 0x3ffff;
+        uint32_t errors = (trail ^ expectedTrail) | other | badLead3;
+
+        // Up to the first error, the bytes form a sequence of complete characters,
+        // except perhaps for the last one.
+        int32_t limit = errors == 0 ? 18 : countTrailingZeros(errors);
+        uint32_t starts = (ascii | lead2 | lead3) & ((1u << (limit < 16 ? limit : 16)) - 1);
+        if (starts == 0) {
+            break;
+        }
+        int32_t last = highestBit(starts);
+        int32_t end = last + 1 + (int32_t)((lead2 >> last) & 1) + 2 * (int32_t)((lead3 >> last) & 1);
+        if (end > limit) {
+            // Drop the incomplete character; the previous one ends where it starts.
+            starts &= ~(1u << last);
+            if (starts == 0) {
+                break;
+            }
+            end = last;
+        }
+
+        // Decode one character per byte position and keep the ones at the starts.
+        __m128i low = decodeLanes(_mm_unpacklo_epi8(v0, zero),
+                                  _mm_unpacklo_epi8(v1, zero),
+                                  _mm_unpacklo_epi8(v2, zero));
+        __m128i high = decodeLanes(_mm_unpackhi_epi8(v0, zero),
+                                   _mm_unpackhi_epi8(v1, zero),
+                                   _mm_unpackhi_epi8(v2, zero));
+        uint32_t lowStarts = starts & 0xff, highStarts = starts >> 8;
+        __m128i lowShuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(gCompactLanes[lowStarts]));
+        __m128i highShuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(gCompactLanes[highStarts]));
+        int32_t lowCount = gBitCount[lowStarts];
+        int32_t count = lowCount + gBitCount[highStarts];
+        storeBytes(reinterpret_cast<uint8_t *>(dest + j),
+                   _mm_shuffle_epi8(low, lowShuffle), _mm_shuffle_epi8(high, highShuffle),
+                   2 * lowCount, 2 * count);
+        if (offsets != NULL) {
+            uint16_t positions[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(positions),
+                             _mm_shuffle_epi8(lowPositions, lowShuffle));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(positions + lowCount),
+                             _mm_shuffle_epi8(highPositions, highShuffle));
+            for (int32_t k = 0; k < count; ++k) {
+                offsets[j + k] = sourceIndex + i + positions[k];
+            }
+        }
+        i += end;
+        j += count;
+        if (limit < 16) {
+            break;  // The caller handles the error or the supplementary code point.
+        }
+    }
+    *pSrcConsumed = i;
+    return j;
+}
+
+UTFSIMD_TARGET_SSSE3 int32_t
+toUTF8Shuffle(const UChar *src, int32_t srcLength,
+              uint8_t *dest, int32_t destCapacity,
+              int32_t *pSrcConsumed,
+              int32_t *offsets, int32_t sourceIndex) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+    const __m128i above7FF = _mm_set1_epi16((short)0xf800);
+    const __m128i surrogate = _mm_set1_epi16((short)0xd800);
+    const __m128i trailBits = _mm_set1_epi16(0x3f);
+    const __m128i trailByte = _mm_set1_epi16(0x80);
+    int32_t i = 0, j = 0;
+    while ((srcLength - i) >= 8 && (destCapacity - j) >= 28) {
+        const UChar *s = src + i;
+        if (U16_IS_SURROGATE(*s)) {
+            break;  // The caller pairs surrogates and handles unpaired ones.
+        }
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+        if ((srcLength - i) >= 16) {
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 8));
+            __m128i high = _mm_and_si128(_mm_or_si128(v, w), nonASCII);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) == 0xffff) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + j), _mm_packus_epi16(v, w));
+                if (offsets != NULL) {
+                    for (int32_t k = 0; k < 16; ++k) {
+                        offsets[j + k] = sourceIndex + i + k;
+                    }
+                }
+                i += 16;
+                j += 16;
+                continue;
+            }
+        }
+        // Convert the lanes before the first surrogate.
+        __m128i high5 = _mm_and_si128(v, above7FF);
+        __m128i isASCII = _mm_cmpeq_epi16(_mm_and_si128(v, nonASCII), zero);
+        __m128i upTo7FF = _mm_cmpeq_epi16(high5, zero);
+        uint32_t surrogates = laneMask(_mm_cmpeq_epi16(high5, surrogate));
+        int32_t n = 8;
+        uint32_t valid = 0xff;
+        if (surrogates != 0) {
+            n = countTrailingZeros(surrogates);
+            valid = (1u << n) - 1;
+        }
+        uint32_t multi = ~laneMask(isASCII) & valid;
+        uint32_t length1or3 = (laneMask(isASCII) | ~laneMask(upTo7FF)) & valid;
+
+        // Up to 3 bytes per lane: first | second << 8, and third.
+        __m128i lead2 = _mm_or_si128(_mm_srli_epi16(v, 6), _mm_set1_epi16(0xc0));
+        __m128i lead3 = _mm_or_si128(_mm_srli_epi16(v, 12), _mm_set1_epi16(0xe0));
+        __m128i last = _mm_or_si128(_mm_and_si128(v, trailBits), trailByte);
+        __m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 6), trailBits), trailByte);
+        __m128i first = blend(isASCII, v, blend(upTo7FF, lead2, lead3));
+        __m128i second = blend(upTo7FF, last, middle);
+        __m128i pairs = _mm_or_si128(first, _mm_slli_epi16(second, 8));
+        // Unpack to one 32-bit element per lane, then shuffle out the bytes that each lane needs.
+        int32_t lowIndex = gSpreadBits[length1or3 & 0xf] | (gSpreadBits[multi & 0xf] << 1);
+        int32_t highIndex = gSpreadBits[length1or3 >> 4] | (gSpreadBits[multi >> 4] << 1);
+        int32_t lowLength = gLaneBytesLength[lowIndex];
+        int32_t length = lowLength + gLaneBytesLength[highIndex];
+        storeBytes(dest + j,
+                   _mm_shuffle_epi8(_mm_unpacklo_epi16(pairs, last),
+                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(gLaneBytes[lowIndex]))),
+                   _mm_shuffle_epi8(_mm_unpackhi_epi16(pairs, last),
+                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(gLaneBytes[highIndex]))),
+                   lowLength, length);
+        if (offsets != NULL) {
+            for (int32_t k = 0; k < lowLength; ++k) {
+                offsets[j + k] = sourceIndex + i + (gLaneBytes[lowIndex][k] >> 2);
+            }
+            for (int32_t k = lowLength; k < length; ++k) {
+                offsets[j + k] = sourceIndex + i + 4 + (gLaneBytes[highIndex][k - lowLength] >> 2);
+            }
+        }
+        j += length;
+        i += n;
+    }
+    *pSrcConsumed = i;
+    return j;
+}
+
+#endif  // UTFSIMD_SSSE3
+
+void U_CALLCONV initLevel() {
+    int32_t level = UTFSIMD::SCALAR;
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    level = UTFSIMD::ASCII;
+#endif
+#if UTFSIMD_SSSE3
+    if (cpuHasSSSE3()) {
+        initShuffles();
+        level = UTFSIMD::SHUFFLE;
+    }
+#endif
+    gMaxLevel = gLevel = level;
+}
+
+}  // namespace
+
+int32_t
+UTFSIMD::fromUTF8(const uint8_t *src, int32_t srcLength,
+                  UChar *dest, int32_t destCapacity,
+                  int32_t *pSrcConsumed,
+                  int32_t *offsets, int32_t sourceIndex) {
+    *pSrcConsumed = 0;
+    // Below the smallest block of any level; see the minimums in the loops.
+    if (srcLength < 16 || destCapacity < 16) {
+        return 0;
+    }
+    umtx_initOnce(gInitOnce, &initLevel);
+    switch (gLevel) {
+#if UTFSIMD_SSSE3
+    case SHUFFLE:
+        return fromUTF8Shuffle(src, srcLength, dest, destCapacity, pSrcConsumed, offsets, sourceIndex);
+#endif
+    case ASCII:
+        return *pSrcConsumed = fromASCII(src, srcLength, dest, destCapacity, offsets, sourceIndex);
+    default:
+        return 0;
+    }
+}
+
+int32_t
+UTFSIMD::toUTF8(const UChar *src, int32_t srcLength,
+                uint8_t *dest, int32_t destCapacity,
+                int32_t *pSrcConsumed,
+                int32_t *offsets, int32_t sourceIndex) {
+    *pSrcConsumed = 0;
+    // Below the smallest block of any level; see the minimums in the loops.
+    if (srcLength < 8 || destCapacity < 16) {
+        return 0;
+    }
+    umtx_initOnce(gInitOnce, &initLevel);
+    switch (gLevel) {
+#if UTFSIMD_SSSE3
+    case SHUFFLE:
+        return toUTF8Shuffle(src, srcLength, dest, destCapacity, pSrcConsumed, offsets, sourceIndex);
+#endif
+    case ASCII:
+        return *pSrcConsumed = toASCII(src, srcLength, dest, destCapacity, offsets, sourceIndex);
+    default:
+        return 0;
+    }
+}
+
+UTFSIMD::Level
+UTFSIMD::getLevel() {
+    umtx_initOnce(gInitOnce, &initLevel);
+    return (Level)gLevel;
+}
+
+UTFSIMD::Level
+UTFSIMD::setLevel(Level level) {
+    umtx_initOnce(gInitOnce, &initLevel);
+    gLevel = level < gMaxLevel ? level : gMaxLevel;
+    return (Level)gLevel;
+}
+
+U_NAMESPACE_END
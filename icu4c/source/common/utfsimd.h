@@ -0,0 +1,103 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// utfsimd.h
+// created: 2018nov02
+
+#ifndef __UTFSIMD_H__
+#define __UTFSIMD_H__
+
+#include "unicode/utypes.h"
+
+U_NAMESPACE_BEGIN
+
+/**
+ * Validating block transcoders between UTF-8 and UTF-16 for the fast paths of
+ * u_strFromUTF8WithSub(), u_strToUTF8WithSub() and the UTF-8 and CESU-8 converters.
+ *
+ * Each function converts the longest prefix of well-formed text that its vector code handles,
+ * and stops before anything else: supplementary code points, surrogates,
+ * ill-formed sequences, and the last few units of the source or destination.
+ * The caller's code point loop continues from there and handles errors and substitutions.
+ *
+ * The implementation is selected once, at runtime, according to the CPU.
+ * @internal
+ */
+class U_COMMON_API UTFSIMD {
+public:
+    UTFSIMD() = delete;  // all static
+
+    /**
+     * Number of code points that a caller should convert one at a time
+     * before it tries the vector code again.
+     */
+    static const int32_t SCALAR_CHUNK_LENGTH = 32;
+
+    /** Implementation levels. */
+    enum Level {
+        /** No vector code: The functions return without converting anything. */
+        SCALAR,
+        /** Blocks of ASCII are widened or narrowed (SSE2, AArch64 Advanced SIMD). */
+        ASCII,
+        /** Also 2- and 3-byte UTF-8 sequences, with byte shuffles (SSSE3). */
+        SHUFFLE
+    };
+
+    /**
+     * Converts a well-formed prefix of the UTF-8 src[0..srcLength[ to UTF-16.
+     * Converts nothing unless srcLength>=16 and destCapacity>=16.
+     * The ASCII level converts blocks of 16 bytes into 16 UChars;
+     * the SHUFFLE level also reads 2 bytes beyond each block of 16.
+     * Like the code point loops, it writes only the UChars that it counts:
+     * Some callers pass a destCapacity that is larger than the actual buffer.
+     * @param src UTF-8 source
+     * @param srcLength number of source bytes
+     * @param dest UTF-16 destination
+     * @param destCapacity number of UChars at dest
+     * @param pSrcConsumed receives the number of source bytes converted
+     * @param offsets if not NULL, receives for each UChar written
+     *        sourceIndex plus the index of the byte sequence it came from
+     * @param sourceIndex added to each offset
+     * @return the number of UChars written
+     */
+    static int32_t fromUTF8(const uint8_t *src, int32_t srcLength,
+                            UChar *dest, int32_t destCapacity,
+                            int32_t *pSrcConsumed,
+                            int32_t *offsets, int32_t sourceIndex);
+
+    /**
+     * Converts a prefix without surrogates of the UTF-16 src[0..srcLength[ to UTF-8.
+     * Converts nothing unless srcLength>=8 and destCapacity>=16.
+     * The ASCII level converts blocks of 16 UChars into 16 bytes;
+     * the SHUFFLE level converts blocks of 8 UChars and needs room for 28 bytes per block.
+     * Does not write beyond the bytes that it counts.
+     * @param src UTF-16 source
+     * @param srcLength number of source UChars
+     * @param dest UTF-8 destination
+     * @param destCapacity number of bytes at dest
+     * @param pSrcConsumed receives the number of source UChars converted
+     * @param offsets if not NULL, receives for each byte written
+     *        sourceIndex plus the index of the UChar it came from
+     * @param sourceIndex added to each offset
+     * @return the number of bytes written
+     */
+    static int32_t toUTF8(const UChar *src, int32_t srcLength,
+                          uint8_t *dest, int32_t destCapacity,
+                          int32_t *pSrcConsumed,
+                          int32_t *offsets, int32_t sourceIndex);
+
+    /** @return the current implementation level */
+    static Level getLevel();
+
+    /**
+     * Sets the implementation level, for testing and performance comparisons.
+     * The level is capped at the one that the CPU supports.
+     * Must not be called while other threads are converting text.
+     * @return the new level
+     */
+    static Level setLevel(Level level);
+};
+
+U_NAMESPACE_END
+
+#endif  // __UTFSIMD_H__
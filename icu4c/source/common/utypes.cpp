@@ -30,6 +30,7 @@ _uErrorInfoName[U_ERROR_WARNING_LIMIT-U_ERROR_WARNING_START]={
     "U_AMBIGUOUS_ALIAS_WARNING",
     "U_DIFFERENT_UCA_VERSION",
     "U_PLUGIN_CHANGED_LEVEL_WARNING",
+    "U_SEQUENTIAL_FALLBACK_WARNING",
 };
 
 static const char * const
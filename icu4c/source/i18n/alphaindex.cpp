@@ -23,6 +23,7 @@
 #include "unicode/usetiter.h"
 #include "unicode/utf16.h"
 
+#include "alphaindex_impl.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "uassert.h"
@@ -157,19 +158,130 @@ class BucketList : public UObject {
                 start = i;
             }
         }
-        const AlphabeticIndex::Bucket *bucket = getBucket(*bucketList_, start);
-        if (bucket->displayBucket_ != NULL) {
-            bucket = bucket->displayBucket_;
-        }
-        return bucket->displayIndex_;
+        return getDisplayIndex(start);
     }
 
+    /**
+     * Stores the sort keys of all of the bucket lower boundaries,
+     * for getBucketIndexes().
+     */
+    void initBoundaryKeys(const RuleBasedCollator &collatorPrimaryOnly, UErrorCode &errorCode);
+
+    /**
+     * Same as getBucketIndex() for each name, but generates and compares only as many
+     * leading bytes of each name's sort key as the longest boundary sort key has.
+     * Requires initBoundaryKeys().
+     */
+    void getBucketIndexes(const UnicodeString *names, int32_t start, int32_t limit,
+                          int32_t *bucketIndexes, const RuleBasedCollator &collatorPrimaryOnly,
+                          UErrorCode &errorCode) const;
+
     /** All of the buckets, visible and invisible. */
     UVector *bucketList_;
     /** Just the visible buckets. */
     UVector *immutableVisibleList_;
+
+private:
+    int32_t getDisplayIndex(int32_t bucketIndex) const {
+        const AlphabeticIndex::Bucket *bucket = getBucket(*bucketList_, bucketIndex);
+        if (bucket->displayBucket_ != NULL) {
+            bucket = bucket->displayBucket_;
+        }
+        return bucket->displayIndex_;
+    }
+
+    /** Concatenated sort keys of the lower boundaries, each with its 00 terminator. */
+    LocalMemory<uint8_t> boundaryKeys_;
+    /** Start of each boundary sort key in boundaryKeys_, plus the total length. */
+    LocalMemory<int32_t> boundaryKeyStarts_;
+    int32_t maxBoundaryKeyLength_ = 0;
 };
 
+void BucketList::initBoundaryKeys(const RuleBasedCollator &collatorPrimaryOnly,
+                                  UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return; }
+    int32_t size = bucketList_->size();
+    if (boundaryKeyStarts_.allocateInsteadAndReset(size + 1) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    // First pass: preflight the key lengths.
+    int32_t totalLength = 0;
+    for (int32_t i = 0; i < size; ++i) {
+        const UnicodeString &boundary = getBucket(*bucketList_, i)->lowerBoundary_;
+        int32_t length = collatorPrimaryOnly.getSortKey(boundary, NULL, 0);
+        if (length <= 0) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        boundaryKeyStarts_[i] = totalLength;
+        totalLength += length;
+        if (length > maxBoundaryKeyLength_) {
+            maxBoundaryKeyLength_ = length;
+        }
+    }
+    boundaryKeyStarts_[size] = totalLength;
+    if (boundaryKeys_.allocateInsteadAndReset(totalLength) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < size; ++i) {
+        const UnicodeString &boundary = getBucket(*bucketList_, i)->lowerBoundary_;
+        int32_t start = boundaryKeyStarts_[i];
+        collatorPrimaryOnly.getSortKey(boundary, boundaryKeys_.getAlias() + start,
+                                       boundaryKeyStarts_[i + 1] - start);
+    }
+}
+
+void BucketList::getBucketIndexes(const UnicodeString *names, int32_t start, int32_t limit,
+                                  int32_t *bucketIndexes,
+                                  const RuleBasedCollator &collatorPrimaryOnly,
+                                  UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) { return; }
+    // Sort keys contain 00 bytes only as their terminators.
+    // A sort key prefix as long as the longest boundary sort key, padded with 00 bytes,
+    // therefore compares with each boundary key like the full sort key does,
+    // which in turn compares like the strings.
+    int32_t keyLength = maxBoundaryKeyLength_;
+    MaybeStackArray<uint8_t, 1024> keys;
+    int32_t window = keys.getCapacity() / keyLength;
+    if (window < 16) {
+        window = 16;
+        if (keys.resize(window * keyLength) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+    }
+    const uint8_t *boundaryKeys = boundaryKeys_.getAlias();
+    while (start < limit) {
+        int32_t count = limit - start;
+        if (count > window) {
+            count = window;
+        }
+        collatorPrimaryOnly.internalGetSortKeyPrefixes(
+            names + start, count, keys.getAlias(), keyLength, errorCode);
+        if (U_FAILURE(errorCode)) { return; }
+        const uint8_t *key = keys.getAlias();
+        for (int32_t n = start; n < start + count; ++n, key += keyLength) {
+            // binary search, as in getBucketIndex()
+            int32_t lo = 0;
+            int32_t hi = bucketList_->size();
+            while ((lo + 1) < hi) {
+                int32_t i = (lo + hi) / 2;
+                int32_t keyStart = boundaryKeyStarts_[i];
+                if (uprv_memcmp(key, boundaryKeys + keyStart,
+                                boundaryKeyStarts_[i + 1] - keyStart) < 0) {
+                    hi = i;
+                } else {
+                    lo = i;
+                }
+            }
+            bucketIndexes[n] = getDisplayIndex(lo);
+        }
+        start += count;
+    }
+}
+
 BucketList::~BucketList() {
     delete bucketList_;
     if (immutableVisibleList_ != bucketList_) {
@@ -177,6 +289,12 @@ BucketList::~BucketList() {
     }
 }
 
+void getBucketIndexesInRange(const BucketList &buckets, const RuleBasedCollator &collatorPrimaryOnly,
+                             const UnicodeString *names, int32_t start, int32_t limit,
+                             int32_t *bucketIndexes, UErrorCode &errorCode) {
+    buckets.getBucketIndexes(names, start, limit, bucketIndexes, collatorPrimaryOnly, errorCode);
+}
+
 AlphabeticIndex::ImmutableIndex::~ImmutableIndex() {
     delete buckets_;
     delete collatorPrimaryOnly_;
@@ -266,6 +384,8 @@ AlphabeticIndex::ImmutableIndex *AlphabeticIndex::buildImmutableIndex(UErrorCode
         errorCode = U_MEMORY_ALLOCATION_ERROR;
         return NULL;
     }
+    immutableBucketList->initBoundaryKeys(*coll, errorCode);
+    if (U_FAILURE(errorCode)) { return NULL; }
     ImmutableIndex *immIndex = new ImmutableIndex(immutableBucketList.getAlias(), coll.getAlias());
     if (immIndex == NULL) {
         errorCode = U_MEMORY_ALLOCATION_ERROR;
@@ -0,0 +1,33 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// alphaindex_impl.h
+// created: 2018oct22
+
+#ifndef __ALPHAINDEX_IMPL_H__
+#define __ALPHAINDEX_IMPL_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+U_NAMESPACE_BEGIN
+
+class BucketList;
+class RuleBasedCollator;
+class UnicodeString;
+
+/**
+ * Sets bucketIndexes[i] to the bucket index of names[i] for i in [start, limit[.
+ * Reads only immutable data, so it can run on several threads with the same BucketList.
+ * Implemented in alphaindex.cpp, used by the parallel
+ * ImmutableIndex::getBucketIndexes() in alphaindex_parallel.cpp.
+ */
+void getBucketIndexesInRange(const BucketList &buckets, const RuleBasedCollator &collatorPrimaryOnly,
+                             const UnicodeString *names, int32_t start, int32_t limit,
+                             int32_t *bucketIndexes, UErrorCode &errorCode);
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
+#endif  // __ALPHAINDEX_IMPL_H__
@@ -0,0 +1,50 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// alphaindex_parallel.cpp
+// created: 2018oct22
+//
+// AlphabeticIndex::ImmutableIndex::getBucketIndexes()
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/alphaindex.h"
+#include "unicode/tblcoll.h"
+#include "unicode/unistr.h"
+#include "alphaindex_impl.h"
+#include "uparallel.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/** getBucketIndexes() uses several threads only if each thread gets at least this many names. */
+constexpr int32_t MIN_NAMES_PER_THREAD = 1024;
+
+}  // namespace
+
+void
+AlphabeticIndex::ImmutableIndex::getBucketIndexes(
+        const UnicodeString *names, int32_t length, int32_t *bucketIndexes,
+        int32_t numThreads, UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) { return; }
+    if (length < 0 || (length > 0 && (names == NULL || bucketIndexes == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const RuleBasedCollator &coll = *static_cast<const RuleBasedCollator *>(collatorPrimaryOnly_);
+    const BucketList &buckets = *buckets_;
+    // Each thread handles a contiguous range of names, sharing the immutable
+    // bucket list and collator.
+    runInChunks(length, numThreads, MIN_NAMES_PER_THREAD,
+                [&buckets, &coll, names, bucketIndexes](
+                        int32_t /* chunkIndex */, int32_t start, int32_t limit, UErrorCode &ec) {
+                    getBucketIndexesInRange(buckets, coll, names, start, limit, bucketIndexes, ec);
+                }, errorCode);
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
@@ -33,6 +33,7 @@
 #include "unicode/coleitr.h"
 #include "unicode/tblcoll.h"
 #include "unicode/ustring.h"
+#include "unicode/utf8.h"
 #include "cmemory.h"
 #include "collation.h"
 #include "collationdata.h"
@@ -42,6 +43,7 @@
 #include "uassert.h"
 #include "uhash.h"
 #include "utf16collationiterator.h"
+#include "utf8collationiterator.h"
 #include "uvectr32.h"
 
 /* Constants --------------------------------------------------------------- */
@@ -54,7 +56,8 @@ UOBJECT_DEFINE_RTTI_IMPLEMENTATION(CollationElementIterator)
 
 CollationElementIterator::CollationElementIterator(
                                          const CollationElementIterator& other) 
-        : UObject(other), iter_(NULL), rbc_(NULL), otherHalf_(0), dir_(0), offsets_(NULL) {
+        : UObject(other), iter_(NULL), rbc_(NULL), otherHalf_(0), dir_(0), offsets_(NULL),
+          u8Text_(NULL), u8Length_(0) {
     *this = other;
 }
 
@@ -62,6 +65,7 @@ CollationElementIterator::~CollationElementIterator()
 {
     delete iter_;
     delete offsets_;
+    uprv_free(u8Text_);
 }
 
 /* CollationElementIterator public methods --------------------------------- */
@@ -137,6 +141,35 @@ int32_t CollationElementIterator::next(UErrorCode& status)
     return firstHalf;
 }
 
+int32_t CollationElementIterator::nextCEs(int64_t *ces, int32_t capacity, int32_t *offsets,
+                                          UErrorCode& status)
+{
+    if (U_FAILURE(status)) { return 0; }
+    if (capacity < 0 || (capacity > 0 && ces == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (dir_ < 0) {
+        // illegal change of direction
+        status = U_INVALID_STATE_ERROR;
+        return 0;
+    }
+    dir_ = 2;
+    otherHalf_ = 0;
+    int32_t length = 0;
+    while (length < capacity) {
+        iter_->clearCEsIfNoneRemaining();
+        int64_t ce = iter_->nextCE(status);
+        if (ce == Collation::NO_CE) { break; }
+        ces[length] = ce;
+        if (offsets != NULL) {
+            offsets[length] = iter_->getOffset();
+        }
+        ++length;
+    }
+    return length;
+}
+
 UBool CollationElementIterator::operator!=(
                                   const CollationElementIterator& other) const
 {
@@ -155,6 +188,9 @@ UBool CollationElementIterator::operator==(
         otherHalf_ == that.otherHalf_ &&
         normalizeDir() == that.normalizeDir() &&
         string_ == that.string_ &&
+        (u8Text_ == NULL) == (that.u8Text_ == NULL) &&
+        u8Length_ == that.u8Length_ &&
+        (u8Text_ == NULL || uprv_memcmp(u8Text_, that.u8Text_, u8Length_) == 0) &&
         *iter_ == *that.iter_;
 }
 
@@ -175,7 +211,7 @@ int32_t CollationElementIterator::previous(UErrorCode& status)
             return oh;
         }
     } else if (dir_ == 0) {
-        iter_->resetToOffset(string_.length());
+        iter_->resetToOffset(getTextLength());
         dir_ = -1;
     } else if (dir_ == 1) {
         // previous() after setOffset()
@@ -231,17 +267,32 @@ void CollationElementIterator::setOffset(int32_t newOffset,
                                          UErrorCode& status)
 {
     if (U_FAILURE(status)) { return; }
-    if (0 < newOffset && newOffset < string_.length()) {
+    if (0 < newOffset && newOffset < getTextLength()) {
         int32_t offset = newOffset;
-        do {
-            UChar c = string_.charAt(offset);
-            if (!rbc_->isUnsafe(c) ||
-                    (U16_IS_LEAD(c) && !rbc_->isUnsafe(string_.char32At(offset)))) {
-                break;
+        if (u8Text_ != NULL) {
+            const uint8_t *s = reinterpret_cast<const uint8_t *>(u8Text_);
+            U8_SET_CP_START(s, 0, offset);
+            while (offset > 0) {
+                int32_t i = offset;
+                UChar32 c;
+                U8_NEXT_OR_FFFD(s, i, u8Length_, c);
+                if (!rbc_->isUnsafe(c)) {
+                    break;
+                }
+                // Back up to before this unsafe character.
+                U8_BACK_1(s, 0, offset);
             }
-            // Back up to before this unsafe character.
-            --offset;
-        } while (offset > 0);
+        } else {
+            do {
+                UChar c = string_.charAt(offset);
+                if (!rbc_->isUnsafe(c) ||
+                        (U16_IS_LEAD(c) && !rbc_->isUnsafe(string_.char32At(offset)))) {
+                    break;
+                }
+                // Back up to before this unsafe character.
+                --offset;
+            } while (offset > 0);
+        }
         if (offset < newOffset) {
             // We might have backed up more than necessary.
             // For example, contractions "ch" and "cu" make both 'h' and 'u' unsafe,
@@ -294,6 +345,50 @@ void CollationElementIterator::setText(const UnicodeString& source,
     iter_ = newIter;
     otherHalf_ = 0;
     dir_ = 0;
+    releaseUTF8Text();
+}
+
+void CollationElementIterator::setTextUTF8(const StringPiece& source, UErrorCode& status)
+{
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t length = source.length();
+    char *text = static_cast<char *>(uprv_malloc(length + 1));
+    if (text == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uprv_memcpy(text, source.data(), length);
+    text[length] = 0;
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(text);
+    CollationIterator *newIter;
+    UBool numeric = rbc_->settings->isNumeric();
+    if (rbc_->settings->dontCheckFCD()) {
+        newIter = new UTF8CollationIterator(rbc_->data, numeric, s, 0, length);
+    } else {
+        newIter = new FCDUTF8CollationIterator(rbc_->data, numeric, s, 0, length);
+    }
+    if (newIter == NULL) {
+        uprv_free(text);
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    delete iter_;
+    iter_ = newIter;
+    otherHalf_ = 0;
+    dir_ = 0;
+    string_.remove();
+    uprv_free(u8Text_);
+    u8Text_ = text;
+    u8Length_ = length;
+}
+
+void CollationElementIterator::releaseUTF8Text()
+{
+    uprv_free(u8Text_);
+    u8Text_ = NULL;
+    u8Length_ = 0;
 }
 
 // Sets the source to the new character iterator.
@@ -331,7 +426,8 @@ CollationElementIterator::CollationElementIterator(
                                                const UnicodeString &source,
                                                const RuleBasedCollator *coll,
                                                UErrorCode &status)
-        : iter_(NULL), rbc_(coll), otherHalf_(0), dir_(0), offsets_(NULL) {
+        : iter_(NULL), rbc_(coll), otherHalf_(0), dir_(0), offsets_(NULL),
+          u8Text_(NULL), u8Length_(0) {
     setText(source, status);
 }
 
@@ -343,7 +439,8 @@ CollationElementIterator::CollationElementIterator(
                                            const CharacterIterator &source,
                                            const RuleBasedCollator *coll,
                                            UErrorCode &status)
-        : iter_(NULL), rbc_(coll), otherHalf_(0), dir_(0), offsets_(NULL) {
+        : iter_(NULL), rbc_(coll), otherHalf_(0), dir_(0), offsets_(NULL),
+          u8Text_(NULL), u8Length_(0) {
     // We only call source.getText() which should be const anyway.
     setText(const_cast<CharacterIterator &>(source), status);
 }
@@ -358,17 +455,44 @@ const CollationElementIterator& CollationElementIterator::operator=(
     }
 
     CollationIterator *newIter;
-    const FCDUTF16CollationIterator *otherFCDIter =
-            dynamic_cast<const FCDUTF16CollationIterator *>(other.iter_);
-    if(otherFCDIter != NULL) {
-        newIter = new FCDUTF16CollationIterator(*otherFCDIter, string_.getBuffer());
+    char *newU8Text = NULL;
+    if(other.u8Text_ != NULL) {
+        newU8Text = static_cast<char *>(uprv_malloc(other.u8Length_ + 1));
+        if(newU8Text == NULL) {
+            return *this;
+        }
+        uprv_memcpy(newU8Text, other.u8Text_, other.u8Length_ + 1);
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(newU8Text);
+        const FCDUTF8CollationIterator *otherFCDIter =
+                dynamic_cast<const FCDUTF8CollationIterator *>(other.iter_);
+        if(otherFCDIter != NULL) {
+            newIter = new FCDUTF8CollationIterator(*otherFCDIter, s);
+        } else {
+            const UTF8CollationIterator *otherIter =
+                    dynamic_cast<const UTF8CollationIterator *>(other.iter_);
+            if(otherIter != NULL) {
+                newIter = new UTF8CollationIterator(*otherIter, s);
+            } else {
+                newIter = NULL;
+            }
+        }
+        if(newIter == NULL) {
+            uprv_free(newU8Text);
+            newU8Text = NULL;
+        }
     } else {
-        const UTF16CollationIterator *otherIter =
-                dynamic_cast<const UTF16CollationIterator *>(other.iter_);
-        if(otherIter != NULL) {
-            newIter = new UTF16CollationIterator(*otherIter, string_.getBuffer());
+        const FCDUTF16CollationIterator *otherFCDIter =
+                dynamic_cast<const FCDUTF16CollationIterator *>(other.iter_);
+        if(otherFCDIter != NULL) {
+            newIter = new FCDUTF16CollationIterator(*otherFCDIter, string_.getBuffer());
         } else {
-            newIter = NULL;
+            const UTF16CollationIterator *otherIter =
+                    dynamic_cast<const UTF16CollationIterator *>(other.iter_);
+            if(otherIter != NULL) {
+                newIter = new UTF16CollationIterator(*otherIter, string_.getBuffer());
+            } else {
+                newIter = NULL;
+            }
         }
     }
     if(newIter != NULL) {
@@ -379,6 +503,9 @@ const CollationElementIterator& CollationElementIterator::operator=(
         dir_ = other.dir_;
 
         string_ = other.string_;
+        uprv_free(u8Text_);
+        u8Text_ = newU8Text;
+        u8Length_ = other.u8Length_;
     }
     if(other.dir_ < 0 && other.offsets_ != NULL && !other.offsets_->isEmpty()) {
         UErrorCode errorCode = U_ZERO_ERROR;
@@ -417,6 +417,7 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     uint16_t fastLatinPrimaries[CollationFastLatin::LATIN_LIMIT];
     int32_t fastLatinOptions = CollationFastLatin::getOptions(
             tailoring.data, ts, fastLatinPrimaries, UPRV_LENGTHOF(fastLatinPrimaries));
+    uint32_t fastScriptBlocks = CollationFastLatin::getScriptBlocks(tailoring.data, ts);
     if(options == ts.options && ts.variableTop != 0 &&
             reorderCodesLength == ts.reorderCodesLength &&
             (reorderCodesLength == 0 ||
@@ -424,7 +425,8 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
             fastLatinOptions == ts.fastLatinOptions &&
             (fastLatinOptions < 0 ||
                 uprv_memcmp(fastLatinPrimaries, ts.fastLatinPrimaries,
-                            sizeof(fastLatinPrimaries)) == 0)) {
+                            sizeof(fastLatinPrimaries)) == 0) &&
+            fastScriptBlocks == ts.fastScriptBlocks) {
         return;
     }
 
@@ -451,6 +453,7 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     settings->fastLatinOptions = CollationFastLatin::getOptions(
         tailoring.data, *settings,
         settings->fastLatinPrimaries, UPRV_LENGTHOF(settings->fastLatinPrimaries));
+    settings->fastScriptBlocks = CollationFastLatin::getScriptBlocks(tailoring.data, *settings);
 }
 
 UBool U_CALLCONV
@@ -0,0 +1,342 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// collationdiskcache.cpp
+// created: 2018oct22
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include <stdio.h>
+
+#include "unicode/localpointer.h"
+#include "unicode/parseerr.h"
+#include "unicode/tblcoll.h"
+#include "unicode/ucol.h"
+#include "unicode/udata.h"
+#include "unicode/unistr.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "collationdatareader.h"
+#include "collationdatawriter.h"
+#include "collationdiskcache.h"
+#include "collationroot.h"
+#include "collationtailoring.h"
+#include "putilimp.h"
+#include "ucmndata.h"
+#include "udatamem.h"
+#include "umutex.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Appended to the standard data header of a cache file.
+ * The collation data itself follows the header unchanged,
+ * and the rule string follows the collation data.
+ */
+struct CacheFileHeader {
+    uint32_t zero;  // so that this is not mistaken for a copyright string
+    uint32_t signature;
+    int32_t fileLength;
+    int32_t rulesOffset;
+    int32_t rulesLength;
+    int32_t reserved;
+};
+
+const uint32_t CACHE_FILE_SIGNATURE = 0x436f6c43;  // "ColC"
+
+// The header size grows by a multiple of 8 so that the 64-bit CEs stay 8-aligned.
+static_assert((sizeof(CacheFileHeader) & 7) == 0, "CacheFileHeader size must be a multiple of 8");
+
+const char CACHE_FILE_TYPE[] = "col";
+
+/** 64-bit FNV-1a */
+class Hash64 {
+public:
+    Hash64() : h(UINT64_C(0xcbf29ce484222325)) {}
+    void add(const void *p, int32_t length) {
+        const uint8_t *bytes = static_cast<const uint8_t *>(p);
+        for(int32_t i = 0; i < length; ++i) {
+            h = (h ^ bytes[i]) * UINT64_C(0x100000001b3);
+        }
+    }
+    uint64_t get() const { return h; }
+private:
+    uint64_t h;
+};
+
+uint64_t hashRules(const UnicodeString &rules, const CollationTailoring *root) {
+    Hash64 hash;
+    // The binary data depends on the builder and on the root data as well as on the rules.
+    static const char icuVersion[] = U_ICU_VERSION;
+    hash.add(icuVersion, (int32_t)sizeof(icuVersion));
+    hash.add(root->version, (int32_t)sizeof(UVersionInfo));
+    hash.add(rules.getBuffer(), rules.length() * U_SIZEOF_UCHAR);
+    return hash.get();
+}
+
+/** Writes "coll" plus 16 hex digits. */
+void appendFileName(uint64_t hash, CharString &name, UErrorCode &errorCode) {
+    static const char hexDigits[] = "0123456789abcdef";
+    name.append("coll", errorCode);
+    for(int32_t shift = 60; shift >= 0; shift -= 4) {
+        name.append(hexDigits[(hash >> shift) & 0xf], errorCode);
+    }
+}
+
+}  // namespace
+
+CollationTailoring *
+CollationDiskCache::load(const char *dir, const UnicodeString &rules,
+                         const CollationTailoring *root, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return NULL; }
+#if UCONFIG_NO_FILE_IO
+    (void)dir;
+    (void)rules;
+    (void)root;
+    return NULL;
+#else
+    // udata_openChoice() treats the path as a directory only if it ends with a separator
+    // and is absolute or contains another separator;
+    // otherwise it is taken as a package or tree name.
+    CharString dataPath;
+    if(!uprv_pathIsAbsolute(dir)) {
+        dataPath.append('.', errorCode).append(U_FILE_SEP_CHAR, errorCode);
+    }
+    dataPath.append(dir, errorCode).ensureEndsWithFileSeparator(errorCode);
+    CharString name;
+    appendFileName(hashRules(rules, root), name, errorCode);
+    if(U_FAILURE(errorCode)) { return NULL; }
+    UErrorCode openErrorCode = U_ZERO_ERROR;
+    UDataMemory *memory = udata_openChoice(dataPath.data(), CACHE_FILE_TYPE, name.data(),
+                                           CollationDataReader::isAcceptable, NULL,
+                                           &openErrorCode);
+    if(U_FAILURE(openErrorCode)) { return NULL; }
+    // Check every header value against the actual file length before using it:
+    // The file may be truncated or damaged.
+    const uint8_t *inBytes = static_cast<const uint8_t *>(udata_getRawMemory(memory));
+    int32_t headerSize = reinterpret_cast<const DataHeader *>(inBytes)->dataHeader.headerSize;
+    int32_t dataLength = udata_getLength(memory);  // -1 if unknown, <0 if headerSize is too large
+    if(dataLength < 0 ||
+            headerSize < (int32_t)(sizeof(DataHeader) + sizeof(CacheFileHeader))) {
+        udata_close(memory);
+        return NULL;
+    }
+    int32_t fileLength = headerSize + dataLength;
+    const CacheFileHeader *cacheHeader = reinterpret_cast<const CacheFileHeader *>(
+        inBytes + headerSize - sizeof(CacheFileHeader));
+    int32_t rulesOffset = cacheHeader->rulesOffset;
+    int32_t rulesLength = cacheHeader->rulesLength;
+    if(cacheHeader->zero != 0 || cacheHeader->signature != CACHE_FILE_SIGNATURE ||
+            cacheHeader->fileLength != fileLength ||
+            rulesOffset < headerSize || rulesOffset > fileLength || (rulesOffset & 1) != 0 ||
+            rulesLength != rules.length() ||
+            (int64_t)rulesLength * U_SIZEOF_UCHAR != fileLength - rulesOffset) {
+        udata_close(memory);
+        return NULL;
+    }
+    const UChar *cachedRules = reinterpret_cast<const UChar *>(inBytes + rulesOffset);
+    if(uprv_memcmp(cachedRules, rules.getBuffer(), rulesLength * U_SIZEOF_UCHAR) != 0) {
+        // Hash collision.
+        udata_close(memory);
+        return NULL;
+    }
+    LocalPointer<CollationTailoring> t(new CollationTailoring(root->settings));
+    if(t.isNull() || t->isBogus()) {
+        udata_close(memory);
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    t->memory = memory;
+    UErrorCode readErrorCode = U_ZERO_ERROR;
+    // The collation data must end before the rules.
+    CollationDataReader::read(root, inBytes, rulesOffset, *t, readErrorCode);
+    if(U_FAILURE(readErrorCode)) { return NULL; }
+    // Alias the mapped rule string which lives as long as the tailoring.
+    t->rules.setTo(FALSE, cachedRules, rulesLength);
+    return t.orphan();
+#endif
+}
+
+void
+CollationDiskCache::getPath(const char *dir, const UnicodeString &rules,
+                            const CollationTailoring *root,
+                            CharString &path, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    CharString name;
+    appendFileName(hashRules(rules, root), name, errorCode);
+    path.append(dir, errorCode).appendPathPart(name.toStringPiece(), errorCode).
+        append('.', errorCode).append(CACHE_FILE_TYPE, errorCode);
+}
+
+UBool
+CollationDiskCache::store(const char *dir, const UnicodeString &rules,
+                          const CollationTailoring &t) {
+#if UCONFIG_NO_FILE_IO
+    (void)dir;
+    (void)rules;
+    (void)t;
+    return FALSE;
+#else
+    // Failures only mean that there is no cache file; they do not affect the caller.
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    int32_t indexes[CollationDataReader::IX_TOTAL_SIZE + 1];
+    UErrorCode writeErrorCode = U_ZERO_ERROR;
+    int32_t binaryLength = CollationDataWriter::writeTailoring(
+        t, *t.settings, indexes, NULL, 0, writeErrorCode);
+    if(writeErrorCode != U_BUFFER_OVERFLOW_ERROR) { return FALSE; }
+    writeErrorCode = U_ZERO_ERROR;
+    MaybeStackArray<uint8_t, 1> binary;
+    if(binary.resize(binaryLength) == NULL) { return FALSE; }
+    CollationDataWriter::writeTailoring(
+        t, *t.settings, indexes, binary.getAlias(), binaryLength, writeErrorCode);
+    if(U_FAILURE(writeErrorCode)) { return FALSE; }
+
+    // Insert the cache file header at the end of the data header.
+    int32_t binaryHeaderSize =
+        reinterpret_cast<const DataHeader *>(binary.getAlias())->dataHeader.headerSize;
+    int32_t headerSize = binaryHeaderSize + (int32_t)sizeof(CacheFileHeader);
+    if(headerSize > 0xffff) { return FALSE; }
+    int32_t rulesOffset = binaryLength + (int32_t)sizeof(CacheFileHeader);
+    int32_t fileLength = rulesOffset + rules.length() * U_SIZEOF_UCHAR;
+    MaybeStackArray<uint8_t, 1> file;
+    if(file.resize(fileLength) == NULL) { return FALSE; }
+    uint8_t *p = file.getAlias();
+    uprv_memcpy(p, binary.getAlias(), binaryHeaderSize);
+    reinterpret_cast<DataHeader *>(p)->dataHeader.headerSize = (uint16_t)headerSize;
+    CacheFileHeader cacheHeader = {
+        0, CACHE_FILE_SIGNATURE, fileLength, rulesOffset, rules.length(), 0
+    };
+    uprv_memcpy(p + binaryHeaderSize, &cacheHeader, sizeof(cacheHeader));
+    uprv_memcpy(p + headerSize, binary.getAlias() + binaryHeaderSize,
+                binaryLength - binaryHeaderSize);
+    uprv_memcpy(p + rulesOffset, rules.getBuffer(), rules.length() * U_SIZEOF_UCHAR);
+
+    CharString path;
+    getPath(dir, rules, root, path, errorCode);
+    // Write a temporary file and rename it, so that readers see either no file
+    // or the complete one. The suffix need not be unique across processes:
+    // Concurrent writers of the same name write the same bytes.
+    static u_atomic_int32_t counter = ATOMIC_INT32_T_INITIALIZER(0);
+    Hash64 suffixHash;
+    UDate now = uprv_getUTCtime();
+    int32_t count = umtx_atomic_inc(&counter);
+    const void *address = &t;
+    suffixHash.add(&now, (int32_t)sizeof(now));
+    suffixHash.add(&count, (int32_t)sizeof(count));
+    suffixHash.add(&address, (int32_t)sizeof(address));
+    CharString tempPath;
+    tempPath.append(path, errorCode).append('.', errorCode);
+    appendFileName(suffixHash.get(), tempPath, errorCode);
+    tempPath.append(".tmp", errorCode);
+    if(U_FAILURE(errorCode)) { return FALSE; }
+
+    FILE *f = fopen(tempPath.data(), "wb");
+    if(f == NULL) { return FALSE; }
+    UBool ok = fwrite(p, 1, fileLength, f) == (size_t)fileLength;
+    ok = (fclose(f) == 0) && ok;
+    if(ok) {
+        if(rename(tempPath.data(), path.data()) == 0) {
+            return TRUE;
+        }
+        // On Windows, rename() does not replace an existing file.
+        // The old one is stale or damaged, or else it would have been loaded.
+        // Removing it fails while another process has it mapped.
+        if(remove(path.data()) == 0 && rename(tempPath.data(), path.data()) == 0) {
+            return TRUE;
+        }
+    }
+    remove(tempPath.data());
+    return FALSE;
+#endif
+}
+
+// RuleBasedCollator constructor with a cache directory ------------------- ***
+
+RuleBasedCollator::RuleBasedCollator(const UnicodeString &rules,
+                                     UColAttributeValue strength,
+                                     UColAttributeValue decompositionMode,
+                                     const char *cacheDir,
+                                     UErrorCode &errorCode)
+        : data(NULL),
+          settings(NULL),
+          tailoring(NULL),
+          cacheEntry(NULL),
+          validLocale(""),
+          explicitlySetAttributes(0),
+          actualLocaleIsSameAsValid(FALSE) {
+    internalBuildCachedTailoring(rules, strength, decompositionMode, cacheDir, NULL, errorCode);
+}
+
+void
+RuleBasedCollator::internalBuildCachedTailoring(const UnicodeString &rules,
+                                                int32_t strength,
+                                                UColAttributeValue decompositionMode,
+                                                const char *cacheDir,
+                                                UParseError *outParseError,
+                                                UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    if(cacheDir == NULL || *cacheDir == 0) {
+        internalBuildTailoring(rules, strength, decompositionMode, outParseError, NULL, errorCode);
+        return;
+    }
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    CollationTailoring *t = CollationDiskCache::load(cacheDir, rules, root, errorCode);
+    if(U_FAILURE(errorCode)) { return; }
+    if(t == NULL) {
+        internalBuildTailoring(rules, strength, decompositionMode, outParseError, NULL, errorCode);
+        if(U_SUCCESS(errorCode)) {
+            // Caching is an optimization: Failure to write the file is not an error.
+            CollationDiskCache::store(cacheDir, rules, *tailoring);
+        }
+        return;
+    }
+    if(outParseError != NULL) {
+        uprv_memset(outParseError, 0, sizeof(*outParseError));
+    }
+    t->actualLocale.setToBogus();
+    adoptTailoring(t, errorCode);
+    // Same as in internalBuildTailoring().
+    if(strength != UCOL_DEFAULT) {
+        setAttribute(UCOL_STRENGTH, (UColAttributeValue)strength, errorCode);
+    }
+    if(decompositionMode != UCOL_DEFAULT) {
+        setAttribute(UCOL_NORMALIZATION_MODE, decompositionMode, errorCode);
+    }
+}
+
+U_NAMESPACE_END
+
+U_NAMESPACE_USE
+
+U_CAPI UCollator * U_EXPORT2
+ucol_openRulesWithCache(const UChar *rules, int32_t rulesLength,
+                        UColAttributeValue normalizationMode, UCollationStrength strength,
+                        const char *cacheDir,
+                        UParseError *parseError, UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) { return NULL; }
+    if(rules == NULL && rulesLength != 0) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    RuleBasedCollator *coll = new RuleBasedCollator();
+    if(coll == NULL) {
+        *pErrorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    UnicodeString r((UBool)(rulesLength < 0), rules, rulesLength);
+    coll->internalBuildCachedTailoring(r, strength, normalizationMode, cacheDir,
+                                       parseError, *pErrorCode);
+    if(U_FAILURE(*pErrorCode)) {
+        delete coll;
+        return NULL;
+    }
+    return coll->toUCollator();
+}
+
+#endif  // !UCONFIG_NO_COLLATION
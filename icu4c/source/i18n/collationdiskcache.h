@@ -0,0 +1,63 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// collationdiskcache.h
+// created: 2018oct22
+
+#ifndef __COLLATIONDISKCACHE_H__
+#define __COLLATIONDISKCACHE_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+U_NAMESPACE_BEGIN
+
+struct CollationTailoring;
+
+class CharString;
+class UnicodeString;
+
+/**
+ * Stores tailorings built from rule strings as binary files in a directory,
+ * so that later processes can memory-map them instead of building them again.
+ *
+ * The file name is a hash of the rules and of the ICU and root collation versions.
+ * Each file also contains the rule string, which is compared on loading,
+ * and it is written to a temporary file which is then renamed,
+ * so that concurrent readers never see a partial file.
+ *
+ * Collator attributes that are set via API rather than in the rules
+ * are not part of the cached data.
+ */
+class U_I18N_API CollationDiskCache /* all static */ {
+public:
+    /**
+     * Memory-maps the cached tailoring for the rules.
+     * @return the tailoring with the file mapping adopted, or NULL if there is no valid file;
+     *         a missing, stale or damaged file does not set an error
+     */
+    static CollationTailoring *load(const char *dir, const UnicodeString &rules,
+                                    const CollationTailoring *root, UErrorCode &errorCode);
+
+    /**
+     * Writes the tailoring with its own (rule-derived) settings to the cache directory.
+     * Caching is an optimization, so failures are not reported as errors.
+     * @return TRUE if the file was written
+     */
+    static UBool store(const char *dir, const UnicodeString &rules,
+                       const CollationTailoring &t);
+
+    /** Appends the path of the cache file for the rules. */
+    static void getPath(const char *dir, const UnicodeString &rules,
+                        const CollationTailoring *root,
+                        CharString &path, UErrorCode &errorCode);
+
+private:
+    CollationDiskCache();  // no constructor: all static methods
+};
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
+#endif  // __COLLATIONDISKCACHE_H__
@@ -16,6 +16,7 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/ucol.h"
+#include "unicode/uscript.h"
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationsettings.h"
@@ -23,6 +24,16 @@
 
 U_NAMESPACE_BEGIN
 
+const CollationFastLatin::ScriptBlock
+CollationFastLatin::SCRIPT_BLOCKS[CollationFastLatin::NUM_SCRIPT_BLOCKS] = {
+    { USCRIPT_GREEK, 0x370, 0x400, 0, 0 },
+    // Up to the Ukrainian U+0490..U+0491 but without the historic letters and marks
+    // U+0460..U+048F, which would use up the short primaries.
+    { USCRIPT_CYRILLIC, 0x400, 0x492, 0x460, 0x490 }
+};
+
+const uint16_t CollationFastLatin::NO_PRIMARIES[CollationFastLatin::LATIN_LIMIT] = { 0 };
+
 int32_t
 CollationFastLatin::getOptions(const CollationData *data, const CollationSettings &settings,
                                uint16_t *primaries, int32_t capacity) {
@@ -105,6 +116,89 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     return ((int32_t)miniVarTop << 16) | settings.options;
 }
 
+uint32_t
+CollationFastLatin::getScriptBlocks(const CollationData *data, const CollationSettings &settings) {
+    // Only for data where the builder also supports the Latin fast path.
+    if(data->fastLatinTable == NULL) { return 0; }
+    uint32_t prevStart = 0;
+    for(int32_t group = UCOL_REORDER_CODE_FIRST; group <= UCOL_REORDER_CODE_DIGIT; ++group) {
+        uint32_t start = data->getFirstPrimaryForGroup(group);
+        if(settings.hasReordering()) {
+            start = settings.reorder(start);
+        }
+        if(start <= prevStart) {
+            return 0;  // missing group, or the permutation affects the groups up to digits
+        }
+        prevStart = start;
+    }
+    uint32_t blocks = 0;
+    for(int32_t i = 0; i < NUM_SCRIPT_BLOCKS; ++i) {
+        uint32_t start = data->getFirstPrimaryForGroup(SCRIPT_BLOCKS[i].script);
+        if(start != 0 && settings.hasReordering()) {
+            start = settings.reorder(start);
+        }
+        if(start > prevStart) {
+            blocks |= (uint32_t)1 << i;
+        }
+    }
+    return blocks;
+}
+
+int32_t
+CollationFastLatin::getScriptOptions(const uint16_t *table, const CollationSettings &settings) {
+    U_ASSERT((table[0] & 0xff) == SCRIPT_HEADER_LENGTH);
+    uint32_t miniVarTop;
+    if((settings.options & CollationSettings::ALTERNATE_MASK) == 0) {
+        miniVarTop = MIN_LONG - 1;
+    } else {
+        miniVarTop = table[1 + settings.getMaxVariable()];
+    }
+    return ((int32_t)miniVarTop << 16) | settings.options;
+}
+
+int32_t
+CollationFastLatin::findScriptBlock(uint32_t blocks, UChar32 c) {
+    for(int32_t j = 0; j < NUM_SCRIPT_BLOCKS; ++j) {
+        if((blocks & ((uint32_t)1 << j)) != 0 &&
+                SCRIPT_BLOCKS[j].start <= c && c < SCRIPT_BLOCKS[j].limit) {
+            return j;
+        }
+    }
+    return UNSUPPORTED_SCRIPT_BLOCK;
+}
+
+int32_t
+CollationFastLatin::findScriptBlock(uint32_t blocks, const UChar *s, int32_t length) {
+    for(int32_t i = 0; i != length; ++i) {
+        UChar32 c = s[i];
+        if(c <= LATIN_MAX) {
+            if(c == 0 && length < 0) { break; }
+            continue;
+        }
+        return findScriptBlock(blocks, c);
+    }
+    return NO_SCRIPT_BLOCK;
+}
+
+int32_t
+CollationFastLatin::findScriptBlockUTF8(uint32_t blocks, const uint8_t *s, int32_t length) {
+    for(int32_t i = 0; i != length; ++i) {
+        uint8_t lead = s[i];
+        if(lead <= 0x7f) {
+            if(lead == 0 && length < 0) { break; }
+            continue;
+        }
+        // The script blocks contain only two-byte characters.
+        uint8_t t;
+        if(0xc2 <= lead && lead < 0xe0 && (i + 1) != length &&
+                0x80 <= (t = s[i + 1]) && t <= 0xbf) {
+            return findScriptBlock(blocks, ((lead & 0x1f) << 6) | (t & 0x3f));
+        }
+        return UNSUPPORTED_SCRIPT_BLOCK;
+    }
+    return NO_SCRIPT_BLOCK;
+}
+
 int32_t
 CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
                                  const UChar *left, int32_t leftLength,
@@ -115,6 +209,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
+    UChar32 blockStart;
+    int32_t blockLength;
+    getBlock(table, blockStart, blockLength);
     table += (table[0] & 0xff);  // skip the header
     uint32_t variableTop = (uint32_t)options >> 16;  // see getOptions()
     options &= 0xffff;  // needed for CollationSettings::getStrength() to work
@@ -128,6 +225,24 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
      */
     uint32_t leftPair = 0, rightPair = 0;
     for(;;) {
+        if(leftPair == 0 && rightPair == 0) {
+            // Lockstep loop over Latin characters with simple primary weights:
+            // Such a character yields exactly one primary CE,
+            // so we can compare primaries without building the CE pairs.
+            while(leftIndex != leftLength && rightIndex != rightLength) {
+                UChar c = left[leftIndex];
+                UChar d = right[rightIndex];
+                if(c > LATIN_MAX || d > LATIN_MAX) { break; }
+                uint32_t leftPrimary = primaries[c];
+                uint32_t rightPrimary = primaries[d];
+                if(leftPrimary == 0 || rightPrimary == 0) { break; }
+                if(leftPrimary != rightPrimary) {
+                    return (leftPrimary < rightPrimary) ? UCOL_LESS : UCOL_GREATER;
+                }
+                ++leftIndex;
+                ++rightIndex;
+            }
+        }
         // We fetch CEs until we get a non-ignorable primary or reach the end.
         while(leftPair == 0) {
             if(leftIndex == leftLength) {
@@ -145,7 +260,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 leftPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
-                leftPair = lookup(table, c);
+                leftPair = lookup(table, c, blockStart, blockLength);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -154,7 +269,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                    left, NULL, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -176,7 +292,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 rightPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
-                rightPair = lookup(table, c);
+                rightPair = lookup(table, c, blockStart, blockLength);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -185,7 +301,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                     right, NULL, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -227,7 +344,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     leftPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
-                    leftPair = lookup(table, c);
+                    leftPair = lookup(table, c, blockStart, blockLength);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -236,7 +353,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                        left, NULL, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -252,7 +370,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     rightPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
-                    rightPair = lookup(table, c);
+                    rightPair = lookup(table, c, blockStart, blockLength);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -261,7 +379,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                         right, NULL, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -298,9 +417,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c, blockStart, blockLength);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                        left, NULL, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -311,9 +431,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c, blockStart, blockLength);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                         right, NULL, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -351,9 +472,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c, blockStart, blockLength);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                    left, NULL, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -364,9 +486,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c, blockStart, blockLength);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                     right, NULL, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -407,9 +530,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c, blockStart, blockLength);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                    left, NULL, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -420,9 +544,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c, blockStart, blockLength);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                     right, NULL, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -451,6 +576,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
+    UChar32 blockStart;
+    int32_t blockLength;
+    getBlock(table, blockStart, blockLength);
     table += (table[0] & 0xff);  // skip the header
     uint32_t variableTop = (uint32_t)options >> 16;  // see RuleBasedCollator::getFastLatinOptions()
     options &= 0xffff;  // needed for CollationSettings::getStrength() to work
@@ -467,6 +595,24 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
     // We only need to look up the table entry for the character,
     // and nextPair() looks for whether c==0.
     for(;;) {
+        if(leftPair == 0 && rightPair == 0) {
+            // Lockstep loop over ASCII characters with simple primary weights:
+            // Such a character yields exactly one primary CE,
+            // so we can compare primaries without building the CE pairs.
+            while(leftIndex != leftLength && rightIndex != rightLength) {
+                uint8_t c = left[leftIndex];
+                uint8_t d = right[rightIndex];
+                if(c > 0x7f || d > 0x7f) { break; }
+                uint32_t leftPrimary = primaries[c];
+                uint32_t rightPrimary = primaries[d];
+                if(leftPrimary == 0 || rightPrimary == 0) { break; }
+                if(leftPrimary != rightPrimary) {
+                    return (leftPrimary < rightPrimary) ? UCOL_LESS : UCOL_GREATER;
+                }
+                ++leftIndex;
+                ++rightIndex;
+            }
+        }
         // We fetch CEs until we get a non-ignorable primary or reach the end.
         while(leftPair == 0) {
             if(leftIndex == leftLength) {
@@ -490,7 +636,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 if(leftPair != 0) { break; }
                 leftPair = table[c];
             } else {
-                leftPair = lookupUTF8(table, c, left, leftIndex, leftLength);
+                leftPair = lookupUTF8(table, c, blockStart, blockLength,
+                                      left, leftIndex, leftLength);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -499,7 +646,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                    NULL, left, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -527,7 +675,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 if(rightPair != 0) { break; }
                 rightPair = table[c];
             } else {
-                rightPair = lookupUTF8(table, c, right, rightIndex, rightLength);
+                rightPair = lookupUTF8(table, c, blockStart, blockLength,
+                                       right, rightIndex, rightLength);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -536,7 +685,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                     NULL, right, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -578,7 +728,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 } else if(c <= LATIN_MAX_UTF8_LEAD) {
                     leftPair = table[((c - 0xc2) << 6) + left[leftIndex++]];
                 } else {
-                    leftPair = lookupUTF8Unsafe(table, c, left, leftIndex);
+                    leftPair = lookupUTF8Unsafe(table, c, blockStart, left, leftIndex);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -587,7 +737,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                        NULL, left, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -603,7 +754,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 } else if(c <= LATIN_MAX_UTF8_LEAD) {
                     rightPair = table[((c - 0xc2) << 6) + right[rightIndex++]];
                 } else {
-                    rightPair = lookupUTF8Unsafe(table, c, right, rightIndex);
+                    rightPair = lookupUTF8Unsafe(table, c, blockStart, right, rightIndex);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -612,7 +763,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                         NULL, right, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -649,9 +801,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+                leftPair = (c <= 0x7f) ? table[c] :
+                        lookupUTF8Unsafe(table, c, blockStart, left, leftIndex);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                        NULL, left, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -662,9 +816,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+                rightPair = (c <= 0x7f) ? table[c] :
+                        lookupUTF8Unsafe(table, c, blockStart, right, rightIndex);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                         NULL, right, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -702,9 +858,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] :
+                    lookupUTF8Unsafe(table, c, blockStart, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                    NULL, left, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -715,9 +873,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] :
+                    lookupUTF8Unsafe(table, c, blockStart, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                     NULL, right, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -758,9 +918,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] :
+                    lookupUTF8Unsafe(table, c, blockStart, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, c, leftPair, blockStart, blockLength,
+                                    NULL, left, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -771,9 +933,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] :
+                    lookupUTF8Unsafe(table, c, blockStart, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, c, rightPair, blockStart, blockLength,
+                                     NULL, right, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -796,10 +960,13 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
 }
 
 uint32_t
-CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
+CollationFastLatin::lookup(const uint16_t *table, UChar32 c,
+                           UChar32 blockStart, int32_t blockLength) {
     U_ASSERT(c > LATIN_MAX);
     if(PUNCT_START <= c && c < PUNCT_LIMIT) {
         return table[c - PUNCT_START + LATIN_LIMIT];
+    } else if((uint32_t)(c - blockStart) < (uint32_t)blockLength) {
+        return table[NUM_FAST_CHARS + (c - blockStart)];
     } else if(c == 0xfffe) {
         return MERGE_WEIGHT;
     } else if(c == 0xffff) {
@@ -811,9 +978,23 @@ CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
 
 uint32_t
 CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
+                               UChar32 blockStart, int32_t blockLength,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength) {
     // The caller handled ASCII and valid/supported Latin.
     U_ASSERT(c > 0x7f);
+    if(c < 0xe0) {
+        // Two-byte sequence: Script block characters are encoded like this.
+        uint8_t t;
+        if(blockLength != 0 && 0xc2 <= c && sIndex != sLength &&
+                0x80 <= (t = s8[sIndex]) && t <= 0xbf) {
+            int32_t i = (((c & 0x1f) << 6) | (t & 0x3f)) - blockStart;
+            if((uint32_t)i < (uint32_t)blockLength) {
+                ++sIndex;
+                return table[NUM_FAST_CHARS + i];
+            }
+        }
+        return BAIL_OUT;
+    }
     int32_t i2 = sIndex + 1;
     if(i2 < sLength || sLength < 0) {
         uint8_t t1 = s8[sIndex];
@@ -833,13 +1014,16 @@ CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
 }
 
 uint32_t
-CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c, UChar32 blockStart,
                                      const uint8_t *s8, int32_t &sIndex) {
     // The caller handled ASCII.
     // The string is well-formed and contains only supported characters.
     U_ASSERT(c > 0x7f);
     if(c <= LATIN_MAX_UTF8_LEAD) {
         return table[((c - 0xc2) << 6) + s8[sIndex++]];  // 0080..017F
+    } else if(c < 0xe0) {
+        // script block character
+        return table[NUM_FAST_CHARS + ((((c & 0x1f) << 6) | (s8[sIndex++] & 0x3f)) - blockStart)];
     }
     uint8_t t2 = s8[sIndex + 1];
     sIndex += 2;
@@ -854,6 +1038,7 @@ CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
 
 uint32_t
 CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+                             UChar32 blockStart, int32_t blockLength,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength) {
     if(ce >= MIN_LONG || ce < CONTRACTION) {
         return ce;  // simple or special mini CE
@@ -879,6 +1064,8 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                         c2 = c2 - PUNCT_START + LATIN_LIMIT;  // 2000..203F -> 0180..01BF
                     } else if(c2 == 0xfffe || c2 == 0xffff) {
                         c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
+                    } else if((uint32_t)(c2 - blockStart) < (uint32_t)blockLength) {
+                        c2 = -1;  // The table has no contraction suffixes in its block.
                     } else {
                         return BAIL_OUT;
                     }
@@ -891,6 +1078,11 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                             0x80 <= (t = s8[nextIndex]) && t <= 0xbf) {
                         c2 = ((c2 - 0xc2) << 6) + t;  // 0080..017F
                         ++nextIndex;
+                    } else if(blockLength != 0 && c2 < 0xe0 && 0xc2 <= c2 && nextIndex != sLength &&
+                            0x80 <= (t = s8[nextIndex]) && t <= 0xbf &&
+                            (uint32_t)((((c2 & 0x1f) << 6) | (t & 0x3f)) - blockStart) <
+                                (uint32_t)blockLength) {
+                        c2 = -1;  // The table has no contraction suffixes in its block.
                     } else {
                         int32_t i2 = nextIndex + 1;
                         if(i2 < sLength || sLength < 0) {
@@ -188,6 +188,36 @@ class U_I18N_API CollationFastLatin /* all static */ {
      */
     static const int32_t BAIL_OUT_RESULT = -2;
 
+    /**
+     * A run of characters of one script for which a separate fast-path table
+     * can be built at runtime.
+     * Such a table covers the fast Latin characters (where only
+     * the special-group characters and digits are supported)
+     * and additionally the characters in [start, limit[.
+     * The characters in [gapStart, gapLimit[ always bail out
+     * and do not use up any mini CEs; the gap is empty if gapStart==gapLimit.
+     */
+    struct ScriptBlock {
+        int32_t script;
+        UChar32 start;
+        UChar32 limit;
+        UChar32 gapStart;
+        UChar32 gapLimit;
+    };
+
+    static const int32_t NUM_SCRIPT_BLOCKS = 2;
+    static const ScriptBlock SCRIPT_BLOCKS[NUM_SCRIPT_BLOCKS];
+
+    /**
+     * All script blocks must be in the BMP, outside the fast Latin ranges,
+     * must have at most this many characters,
+     * and their characters must be encoded in two UTF-8 bytes.
+     */
+    static const int32_t MAX_SCRIPT_BLOCK_LENGTH = 0x92;
+
+    /** Header length of a script block table: version/length, varTops, block start & limit. */
+    static const int32_t SCRIPT_HEADER_LENGTH = 7;
+
     static inline int32_t getCharIndex(UChar c) {
         if(c <= LATIN_MAX) {
             return c;
@@ -210,6 +240,37 @@ class U_I18N_API CollationFastLatin /* all static */ {
     static int32_t getOptions(const CollationData *data, const CollationSettings &settings,
                               uint16_t *primaries, int32_t capacity);
 
+    /**
+     * Returns a bit set with bit i set if the fast path can use a table
+     * for SCRIPT_BLOCKS[i] with the data and settings.
+     * That requires the special groups, digits and the script to be in ascending order,
+     * even if the Latin fast path is not supported (for example, when Latin is reordered).
+     */
+    static uint32_t getScriptBlocks(const CollationData *data, const CollationSettings &settings);
+
+    /**
+     * Computes the options value for comparing with a script block table.
+     */
+    static int32_t getScriptOptions(const uint16_t *table, const CollationSettings &settings);
+
+    /**
+     * Finds the first character of the string above LATIN_MAX and
+     * returns the index of the script block in the blocks set which contains it.
+     * Stops at that character: Returns NO_SCRIPT_BLOCK if the string has no such character,
+     * and UNSUPPORTED_SCRIPT_BLOCK if it is not in any of the blocks.
+     */
+    static const int32_t NO_SCRIPT_BLOCK = -1;
+    static const int32_t UNSUPPORTED_SCRIPT_BLOCK = -2;
+
+    static int32_t findScriptBlock(uint32_t blocks, const UChar *s, int32_t length);
+    static int32_t findScriptBlockUTF8(uint32_t blocks, const uint8_t *s, int32_t length);
+
+    /**
+     * Primaries array for comparing with a script block table:
+     * All zero, so that all characters are looked up in the table.
+     */
+    static const uint16_t NO_PRIMARIES[LATIN_LIMIT];
+
     static int32_t compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
                                 const UChar *left, int32_t leftLength,
                                 const UChar *right, int32_t rightLength);
@@ -219,13 +280,29 @@ class U_I18N_API CollationFastLatin /* all static */ {
                                const uint8_t *right, int32_t rightLength);
 
 private:
-    static uint32_t lookup(const uint16_t *table, UChar32 c);
+    static int32_t findScriptBlock(uint32_t blocks, UChar32 c);
+
+    static inline void getBlock(const uint16_t *table, UChar32 &blockStart, int32_t &blockLength) {
+        int32_t headerLength = table[0] & 0xff;
+        if(headerLength == SCRIPT_HEADER_LENGTH) {
+            blockStart = table[headerLength - 2];
+            blockLength = table[headerLength - 1] - blockStart;
+        } else {
+            blockStart = 0;
+            blockLength = 0;
+        }
+    }
+
+    static uint32_t lookup(const uint16_t *table, UChar32 c,
+                           UChar32 blockStart, int32_t blockLength);
     static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
+                               UChar32 blockStart, int32_t blockLength,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
-    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 c, UChar32 blockStart,
                                      const uint8_t *s8, int32_t &sIndex);
 
     static uint32_t nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+                             UChar32 blockStart, int32_t blockLength,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength);
 
     static inline uint32_t getPrimaries(uint32_t variableTop, uint32_t pair) {
@@ -303,6 +380,21 @@ class U_I18N_API CollationFastLatin /* all static */ {
  *   for when there is no contraction match.
  *
  * -----------------
+ * Script block tables
+ *
+ * For each of the CollationFastLatin::SCRIPT_BLOCKS, a table of the same format
+ * is built at runtime (and never serialized), with the following differences:
+ * - The header length is SCRIPT_HEADER_LENGTH, and the header ends with
+ *   the block start and limit code points.
+ * - The miniCEs are followed by one more mini CE per character of the block.
+ *   Expansion and contraction offsets are still relative to just after
+ *   the NUM_FAST_CHARS miniCEs, that is, they start after the block miniCEs.
+ * - Only primary weights of the special groups, digits, and the block's script are supported;
+ *   Latin letters bail out.
+ * - A contraction whose suffix could start with a block character bails out,
+ *   so that a block character following a contraction start matches no suffix.
+ *
+ * -----------------
  * Changes for version 2 (ICU 55)
  *
  * Special reorder groups do not necessarily start on whole primary lead bytes any more.
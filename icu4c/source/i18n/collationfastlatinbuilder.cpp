@@ -91,6 +91,8 @@ CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
           contractionCEs(errorCode), uniqueCEs(errorCode),
           miniCEs(NULL),
           firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
+          blockStart(0), blockLimit(0), gapStart(0), gapLimit(0),
+          firstScriptPrimary(0), lastScriptPrimary(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
           headerLength(0) {
 }
@@ -101,6 +103,34 @@ CollationFastLatinBuilder::~CollationFastLatinBuilder() {
 
 UBool
 CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorCode) {
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::forScriptBlock(const CollationData &data, int32_t blockIndex,
+                                          UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(blockIndex < 0 || blockIndex >= CollationFastLatin::NUM_SCRIPT_BLOCKS) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    const CollationFastLatin::ScriptBlock &block = CollationFastLatin::SCRIPT_BLOCKS[blockIndex];
+    U_ASSERT(block.limit - block.start <= CollationFastLatin::MAX_SCRIPT_BLOCK_LENGTH);
+    firstScriptPrimary = data.getFirstPrimaryForGroup(block.script);
+    lastScriptPrimary = data.getLastPrimaryForGroup(block.script);
+    if(firstScriptPrimary == 0) {
+        // missing data
+        return FALSE;
+    }
+    blockStart = block.start;
+    blockLimit = block.limit;
+    gapStart = block.gapStart;
+    gapLimit = block.gapLimit;
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::build(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     if(!result.isEmpty()) {  // This builder is not reusable.
         errorCode = U_INVALID_STATE_ERROR;
@@ -115,7 +145,7 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     if(shortPrimaryOverflow) {
         // Give digits long mini primaries,
         // so that there are more short primaries for letters.
-        firstShortPrimary = firstLatinPrimary;
+        firstShortPrimary = blockLimit == 0 ? firstLatinPrimary : firstScriptPrimary;
         resetCEs();
         getCEs(data, errorCode);
         if(!encodeUniqueCEs(errorCode)) { return FALSE; }
@@ -139,6 +169,10 @@ UBool
 CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     headerLength = 1 + NUM_SPECIAL_GROUPS;
+    if(blockLimit != 0) {
+        headerLength += 2;
+        U_ASSERT(headerLength == CollationFastLatin::SCRIPT_HEADER_LENGTH);
+    }
     uint32_t r0 = (CollationFastLatin::VERSION << 8) | headerLength;
     result.append((UChar)r0);
     // The first few reordering groups should be special groups
@@ -151,6 +185,9 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
         }
         result.append((UChar)0);  // reserve a slot for this group
     }
+    if(blockLimit != 0) {
+        result.append((UChar)blockStart).append((UChar)blockLimit);
+    }
 
     firstDigitPrimary = data.getFirstPrimaryForGroup(UCOL_REORDER_CODE_DIGIT);
     firstLatinPrimary = data.getFirstPrimaryForGroup(USCRIPT_LATIN);
@@ -209,8 +246,17 @@ CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCo
         if(c == CollationFastLatin::LATIN_LIMIT) {
             c = CollationFastLatin::PUNCT_START;
         } else if(c == CollationFastLatin::PUNCT_LIMIT) {
+            if(blockLimit == 0) { break; }
+            c = (UChar)blockStart;
+        } else if(c == blockLimit && blockLimit != 0) {
             break;
         }
+        if(gapStart <= c && c < gapLimit) {
+            // bail out for c, without adding its CEs to the unique ones
+            charCEs[i][0] = Collation::NO_CE;
+            charCEs[i][1] = 0;
+            continue;
+        }
         const CollationData *d;
         uint32_t ce32 = data.getCE32(c);
         if(ce32 == Collation::FALLBACK_CE32) {
@@ -303,8 +349,9 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    // We only support primaries up to the Latin script,
+    // or in a script block table only those below Latin and of the block's script.
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -321,6 +368,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
         // and determine for both whether they are variable.
         uint32_t p1 = (uint32_t)(ce1 >> 32);
         if(p1 == 0 ? p0 < firstShortPrimary : !inSameGroup(p0, p1)) { return FALSE; }
+        if(blockLimit != 0 && p1 != 0 && !isSupportedPrimary(p1)) { return FALSE; }
         uint32_t lower32_1 = (uint32_t)ce1;
         // No tertiary CEs.
         if((lower32_1 >> 16) == 0) { return FALSE; }
@@ -361,7 +409,13 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
     while(suffixes.next(errorCode)) {
         const UnicodeString &suffix = suffixes.getString();
-        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0));
+        UChar s0 = suffix.charAt(0);
+        if(blockStart <= s0 && s0 < blockLimit) {
+            // The runtime does not look for block characters in contraction suffixes.
+            contractionCEs.setSize(contractionIndex);
+            return FALSE;
+        }
+        int32_t x = CollationFastLatin::getCharIndex(s0);
         if(x < 0) { continue; }  // ignore anything but fast Latin text
         if(x == prevX) {
             if(addContraction) {
@@ -565,11 +619,14 @@ UBool
 CollationFastLatinBuilder::encodeCharCEs(UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     int32_t miniCEsStart = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    int32_t numChars = getNumChars();
+    for(int32_t i = 0; i < numChars; ++i) {
         result.append((UChar)0);  // initialize to completely ignorable
     }
-    int32_t indexBase = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    // Expansion & contraction offsets are relative to just after the fast Latin miniCEs,
+    // even if the block miniCEs follow them.
+    int32_t indexBase = miniCEsStart + CollationFastLatin::NUM_FAST_CHARS;
+    for(int32_t i = 0; i < numChars; ++i) {
         int64_t ce = charCEs[i][0];
         if(isContractionCharCE(ce)) { continue; }  // defer contraction
         uint32_t miniCE = encodeTwoCEs(ce, charCEs[i][1]);
@@ -597,7 +654,8 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     int32_t indexBase = headerLength + CollationFastLatin::NUM_FAST_CHARS;
     int32_t firstContractionIndex = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    int32_t numChars = getNumChars();
+    for(int32_t i = 0; i < numChars; ++i) {
         int64_t ce = charCEs[i][0];
         if(!isContractionCharCE(ce)) { continue; }
         int32_t contractionIndex = result.length() - indexBase;
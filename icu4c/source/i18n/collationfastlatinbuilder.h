@@ -36,6 +36,12 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
 
+    /**
+     * Builds a runtime table for CollationFastLatin::SCRIPT_BLOCKS[blockIndex].
+     * @return FALSE if the data does not support such a table
+     */
+    UBool forScriptBlock(const CollationData &data, int32_t blockIndex, UErrorCode &errorCode);
+
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
     }
@@ -45,8 +51,16 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
     // space, punct, symbol, currency (not digit)
     enum { NUM_SPECIAL_GROUPS = UCOL_REORDER_CODE_CURRENCY - UCOL_REORDER_CODE_FIRST + 1 };
 
+    UBool build(const CollationData &data, UErrorCode &errorCode);
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    UBool isSupportedPrimary(uint32_t p) const {
+        if(blockLimit == 0) { return p <= lastLatinPrimary; }
+        return p < firstLatinPrimary || (firstScriptPrimary <= p && p <= lastScriptPrimary);
+    }
+    int32_t getNumChars() const {
+        return CollationFastLatin::NUM_FAST_CHARS + (blockLimit - blockStart);
+    }
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -71,7 +85,8 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
     // temporary "buffer"
     int64_t ce0, ce1;
 
-    int64_t charCEs[CollationFastLatin::NUM_FAST_CHARS][2];
+    int64_t charCEs[CollationFastLatin::NUM_FAST_CHARS +
+                    CollationFastLatin::MAX_SCRIPT_BLOCK_LENGTH][2];
 
     UVector64 contractionCEs;
     UVector64 uniqueCEs;
@@ -84,6 +99,11 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
     uint32_t firstDigitPrimary;
     uint32_t firstLatinPrimary;
     uint32_t lastLatinPrimary;
+    // Script block tables only.
+    UChar32 blockStart, blockLimit;
+    UChar32 gapStart, gapLimit;
+    uint32_t firstScriptPrimary;
+    uint32_t lastScriptPrimary;
     // This determines the first normal primary weight which is mapped to
     // a short mini primary. It must be >=firstDigitPrimary.
     uint32_t firstShortPrimary;
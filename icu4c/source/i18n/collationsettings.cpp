@@ -34,7 +34,8 @@ CollationSettings::CollationSettings(const CollationSettings &other)
           minHighNoReorder(other.minHighNoReorder),
           reorderRanges(NULL), reorderRangesLength(0),
           reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-          fastLatinOptions(other.fastLatinOptions) {
+          fastLatinOptions(other.fastLatinOptions),
+          fastScriptBlocks(other.fastScriptBlocks) {
     UErrorCode errorCode = U_ZERO_ERROR;
     copyReorderingFrom(other, errorCode);
     if(fastLatinOptions >= 0) {
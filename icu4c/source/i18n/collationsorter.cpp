@@ -0,0 +1,413 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// collationsorter.cpp
+// created: 2018oct18
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/localpointer.h"
+#include "unicode/tblcoll.h"
+#include "unicode/ucol.h"
+#include "unicode/ustring.h"
+#include "cmemory.h"
+#include "collationsorter.h"
+#include "cstring.h"
+#include "uarrsort.h"
+#include "uparallel.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Sort keys are generated on several threads only if each thread gets at least this many strings.
+ * Sorted buckets are distributed to threads only for at least twice as many records.
+ */
+constexpr int32_t MIN_STRINGS_PER_THREAD = 1024;
+/** Buckets with fewer records are sorted by comparison rather than by radix. */
+constexpr int32_t MIN_RADIX_SORT_LENGTH = 32;
+/**
+ * Each nested radix sort pass uses about 1kB of stack for its bucket array.
+ * Deeper buckets (long runs of keys that share prefixes) are sorted by comparison
+ * so that the stack use stays bounded even on small thread stacks.
+ */
+constexpr int32_t MAX_RADIX_SORT_LEVELS = 16;
+/** Maximum number of strings per getSortKeys() call. */
+constexpr int32_t KEY_WINDOW = 256;
+/** Initial capacity of each memory block for sort keys. */
+constexpr int32_t KEY_BLOCK_CAPACITY = 0x40000;
+
+/** A sort key (with a 00 terminator and no other 00 bytes) and the index of its string. */
+struct SortRecord {
+    const uint8_t *key;
+    int32_t index;
+};
+
+/** Owns the memory blocks that sort keys are written into. */
+class KeyArena : public UMemory {
+public:
+    KeyArena() : blocks(nullptr) {}
+    ~KeyArena() {
+        while (blocks != nullptr) {
+            Block *next = blocks->next;
+            uprv_free(blocks);
+            blocks = next;
+        }
+    }
+
+    uint8_t *allocate(int32_t capacity) {
+        Block *block = static_cast<Block *>(uprv_malloc(sizeof(Block) + capacity));
+        if (block == nullptr) {
+            return nullptr;
+        }
+        block->next = blocks;
+        blocks = block;
+        return reinterpret_cast<uint8_t *>(block + 1);
+    }
+
+private:
+    KeyArena(const KeyArena &other);  // not implemented
+    KeyArena &operator=(const KeyArena &other);  // not implemented
+
+    struct Block {
+        Block *next;
+        // followed by the key bytes
+    };
+    Block *blocks;
+};
+
+inline int32_t
+getSortKeys(const RuleBasedCollator &coll, const UChar *const *src, const int32_t *lengths,
+            int32_t count, uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+            UErrorCode &errorCode) {
+    return coll.getSortKeys(src, lengths, count, dest, capacity, keyOffsets, errorCode);
+}
+
+inline int32_t
+getSortKeys(const RuleBasedCollator &coll, const char *const *src, const int32_t *lengths,
+            int32_t count, uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+            UErrorCode &errorCode) {
+    return coll.getSortKeysUTF8(src, lengths, count, dest, capacity, keyOffsets, errorCode);
+}
+
+/** Writes the sort keys for src[start..limit[ into the arena and points records at them. */
+template<typename Char>
+void writeKeys(const RuleBasedCollator &coll, const Char *const *src, const int32_t *lengths,
+               int32_t start, int32_t limit, KeyArena &arena, SortRecord *records,
+               UErrorCode &errorCode) {
+    int32_t keyOffsets[KEY_WINDOW + 1];
+    uint8_t *block = nullptr;
+    int32_t blockCapacity = 0;
+    int32_t used = 0;
+    int32_t nextCapacity = KEY_BLOCK_CAPACITY;
+    for (int32_t i = start; i < limit;) {
+        int32_t n = (limit - i) < KEY_WINDOW ? (limit - i) : KEY_WINDOW;
+        int32_t numKeys = getSortKeys(coll, src + i, lengths != nullptr ? lengths + i : nullptr, n,
+                                      block + used, blockCapacity - used, keyOffsets, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        for (int32_t k = 0; k < numKeys; ++k) {
+            records[i + k].key = block + used + keyOffsets[k];
+            records[i + k].index = i + k;
+        }
+        if (numKeys > 0) {
+            used += keyOffsets[numKeys];
+            i += numKeys;
+        }
+        if (numKeys < n) {
+            // The next key does not fit into the rest of the block.
+            if (numKeys == 0 && used == 0 && block != nullptr) {
+                nextCapacity *= 2;  // It does not even fit into an empty block.
+            }
+            block = arena.allocate(nextCapacity);
+            if (block == nullptr) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            blockCapacity = nextCapacity;
+            used = 0;
+        }
+    }
+}
+
+/** Compares two strings in code point order, for records with equal sort keys. */
+typedef int32_t CompareStringsFn(const void *src, const int32_t *lengths, int32_t i, int32_t j);
+
+int32_t compareUTF16Strings(const void *src, const int32_t *lengths, int32_t i, int32_t j) {
+    const UChar *const *strings = static_cast<const UChar *const *>(src);
+    const UChar *s = strings[i] != nullptr ? strings[i] : u"";
+    const UChar *t = strings[j] != nullptr ? strings[j] : u"";
+    return u_strCompare(s, lengths != nullptr ? lengths[i] : -1,
+                        t, lengths != nullptr ? lengths[j] : -1, TRUE);
+}
+
+int32_t compareUTF8Strings(const void *src, const int32_t *lengths, int32_t i, int32_t j) {
+    // UTF-8 byte order is code point order.
+    const char *const *strings = static_cast<const char *const *>(src);
+    const char *s = strings[i] != nullptr ? strings[i] : "";
+    const char *t = strings[j] != nullptr ? strings[j] : "";
+    int32_t sLength = (lengths != nullptr && lengths[i] >= 0) ?
+        lengths[i] : static_cast<int32_t>(uprv_strlen(s));
+    int32_t tLength = (lengths != nullptr && lengths[j] >= 0) ?
+        lengths[j] : static_cast<int32_t>(uprv_strlen(t));
+    int32_t result = uprv_memcmp(s, t, sLength <= tLength ? sLength : tLength);
+    return result != 0 ? result : sLength - tLength;
+}
+
+struct CompareContext {
+    /** Number of leading key bytes known to be equal. */
+    int32_t depth;
+    const void *src;
+    const int32_t *lengths;
+    CompareStringsFn *compareStrings;
+};
+
+int32_t U_CALLCONV
+compareRecords(const void *context, const void *left, const void *right) {
+    const CompareContext &c = *static_cast<const CompareContext *>(context);
+    const SortRecord &l = *static_cast<const SortRecord *>(left);
+    const SortRecord &r = *static_cast<const SortRecord *>(right);
+    const uint8_t *p = l.key + c.depth;
+    const uint8_t *q = r.key + c.depth;
+    uint8_t b;
+    while ((b = *p) == *q) {
+        if (b == 0) {
+            // Equal sort keys.
+            int32_t result = c.compareStrings(c.src, c.lengths, l.index, r.index);
+            if (result != 0) {
+                return result;
+            }
+            return l.index < r.index ? -1 : (l.index > r.index ? 1 : 0);
+        }
+        ++p;
+        ++q;
+    }
+    return (int32_t)b - (int32_t)*q;
+}
+
+void sortByComparison(SortRecord *records, int32_t length, int32_t depth,
+                      const CompareContext &base, UErrorCode &errorCode) {
+    if (length <= 1) {
+        return;
+    }
+    CompareContext context = base;
+    context.depth = depth;
+    // The comparison is a total order, so there is no need for a stable sort.
+    uprv_sortArray(records, length, (int32_t)sizeof(SortRecord),
+                   compareRecords, &context, FALSE, &errorCode);
+}
+
+/**
+ * Distributes the records into buckets by their key byte at depth,
+ * first skipping key bytes that are the same for all records.
+ * On return, bucket b is [bucketStarts[b], bucketStarts[b + 1][.
+ * @return the depth of the distinguishing byte, or -1 if all of the keys are equal
+ */
+int32_t partition(SortRecord *records, SortRecord *temp, int32_t length, int32_t depth,
+                  int32_t bucketStarts[257]) {
+    for (;; ++depth) {
+        uprv_memset(bucketStarts, 0, 257 * sizeof(int32_t));
+        for (int32_t i = 0; i < length; ++i) {
+            ++bucketStarts[records[i].key[depth]];
+        }
+        uint8_t first = records[0].key[depth];
+        if (bucketStarts[first] != length) {
+            break;
+        }
+        if (first == 0) {
+            return -1;
+        }
+    }
+    // Turn the counts into bucket limits, then fill the buckets from the back
+    // so that the limits turn into bucket starts.
+    int32_t sum = 0;
+    for (int32_t b = 0; b < 256; ++b) {
+        sum += bucketStarts[b];
+        bucketStarts[b] = sum;
+    }
+    bucketStarts[256] = length;
+    for (int32_t i = length; i > 0;) {
+        const SortRecord &record = records[--i];
+        temp[--bucketStarts[record.key[depth]]] = record;
+    }
+    uprv_memcpy(records, temp, (size_t)length * sizeof(SortRecord));
+    return depth;
+}
+
+void radixSort(SortRecord *records, SortRecord *temp, int32_t length, int32_t depth,
+               int32_t level, const CompareContext &base, UErrorCode &errorCode);
+
+/**
+ * Sorts the records in buckets [firstBucket..limitBucket[ after partition() at depth.
+ * level is the number of radix sort passes that produced these buckets.
+ */
+void sortBuckets(SortRecord *records, SortRecord *temp, const int32_t bucketStarts[257],
+                 int32_t firstBucket, int32_t limitBucket, int32_t depth, int32_t level,
+                 const CompareContext &base, UErrorCode &errorCode) {
+    for (int32_t b = firstBucket; b < limitBucket && U_SUCCESS(errorCode); ++b) {
+        int32_t start = bucketStarts[b];
+        int32_t bucketLength = bucketStarts[b + 1] - start;
+        if (b == 0) {
+            // These keys end here: Only the tie-breaker is left.
+            sortByComparison(records + start, bucketLength, depth, base, errorCode);
+        } else if (bucketLength > 1) {
+            radixSort(records + start, temp + start, bucketLength, depth + 1, level,
+                      base, errorCode);
+        }
+    }
+}
+
+void radixSort(SortRecord *records, SortRecord *temp, int32_t length, int32_t depth,
+               int32_t level, const CompareContext &base, UErrorCode &errorCode) {
+    if (length < MIN_RADIX_SORT_LENGTH || level >= MAX_RADIX_SORT_LEVELS) {
+        sortByComparison(records, length, depth, base, errorCode);
+        return;
+    }
+    int32_t bucketStarts[257];
+    depth = partition(records, temp, length, depth, bucketStarts);
+    if (depth < 0) {
+        sortByComparison(records, length, 0, base, errorCode);
+        return;
+    }
+    sortBuckets(records, temp, bucketStarts, 0, 256, depth, level + 1, base, errorCode);
+}
+
+template<typename Char>
+void sortStrings(const RuleBasedCollator &coll, int32_t maxThreads,
+                 const Char *const *src, const int32_t *lengths, int32_t count,
+                 int32_t *permutation, CompareStringsFn *compareStrings,
+                 UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (src == nullptr || permutation == nullptr))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if (count == 0) {
+        return;
+    }
+    LocalMemory<SortRecord> records;
+    LocalMemory<SortRecord> temp;
+    if (records.allocateInsteadAndReset(count) == nullptr ||
+            temp.allocateInsteadAndReset(count) == nullptr) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+
+    // Each chunk's arena owns its sort keys until the end of this function.
+    int32_t numChunks = getNumParallelChunks(count, maxThreads, MIN_STRINGS_PER_THREAD);
+    LocalArray<KeyArena> arenas(new KeyArena[numChunks], errorCode);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    SortRecord *recordsArray = records.getAlias();
+    KeyArena *arenasArray = arenas.getAlias();
+    runInChunks(count, maxThreads, MIN_STRINGS_PER_THREAD,
+                [&coll, src, lengths, recordsArray, arenasArray](
+                        int32_t i, int32_t start, int32_t limit, UErrorCode &ec) {
+                    writeKeys(coll, src, lengths, start, limit, arenasArray[i], recordsArray, ec);
+                }, errorCode);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+
+    CompareContext base = { 0, src, lengths, compareStrings };
+    SortRecord *tempArray = temp.getAlias();
+    if (numChunks == 1 || count < 2 * MIN_STRINGS_PER_THREAD) {
+        radixSort(recordsArray, tempArray, count, 0, 0, base, errorCode);
+    } else {
+        // Partition once, then sort ranges of buckets with about equal numbers of records
+        // on the threads.
+        int32_t bucketStarts[257];
+        int32_t depth = partition(recordsArray, tempArray, count, 0, bucketStarts);
+        if (depth < 0) {
+            sortByComparison(recordsArray, count, 0, base, errorCode);
+        } else {
+            // Chunk i sorts buckets [chunkBuckets[i]..chunkBuckets[i + 1][.
+            LocalMemory<int32_t> chunkBuckets;
+            if (chunkBuckets.allocateInsteadAndReset(numChunks + 1) == nullptr) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            int32_t bucket = 0;
+            chunkBuckets[0] = 0;
+            for (int32_t i = 0; i < numChunks; ++i) {
+                int32_t recordLimit = getParallelChunkStart(count, i + 1, numChunks);
+                while (bucket < 256 && (bucketStarts[bucket + 1] <= recordLimit || i == numChunks - 1)) {
+                    ++bucket;
+                }
+                chunkBuckets[i + 1] = bucket;
+            }
+            const int32_t *chunkBucketsArray = chunkBuckets.getAlias();
+            runParallelChunks(numChunks,
+                              [recordsArray, tempArray, &bucketStarts, chunkBucketsArray, depth, &base](
+                                      int32_t i, UErrorCode &ec) {
+                                  sortBuckets(recordsArray, tempArray, bucketStarts,
+                                              chunkBucketsArray[i], chunkBucketsArray[i + 1],
+                                              depth, 1, base, ec);
+                              }, errorCode);
+        }
+    }
+    if (U_SUCCESS(errorCode)) {
+        for (int32_t i = 0; i < count; ++i) {
+            permutation[i] = recordsArray[i].index;
+        }
+    }
+}
+
+}  // namespace
+
+void
+CollationSorter::sort(const UChar *const *src, const int32_t *lengths, int32_t count,
+                      int32_t *permutation, UErrorCode &errorCode) const {
+    sortStrings(collator, maxThreads, src, lengths, count, permutation,
+                compareUTF16Strings, errorCode);
+}
+
+void
+CollationSorter::sortUTF8(const char *const *src, const int32_t *lengths, int32_t count,
+                          int32_t *permutation, UErrorCode &errorCode) const {
+    sortStrings(collator, maxThreads, src, lengths, count, permutation,
+                compareUTF8Strings, errorCode);
+}
+
+U_NAMESPACE_END
+
+U_CAPI void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar *const *src, const int32_t *lengths, int32_t count,
+                 int32_t *permutation, int32_t numThreads,
+                 UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    const icu::RuleBasedCollator *rbc = icu::RuleBasedCollator::rbcFromUCollator(coll);
+    if (rbc == nullptr) {
+        *pErrorCode = U_UNSUPPORTED_ERROR;
+        return;
+    }
+    icu::CollationSorter(*rbc, numThreads).sort(src, lengths, count, permutation, *pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char *const *src, const int32_t *lengths, int32_t count,
+                     int32_t *permutation, int32_t numThreads,
+                     UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    const icu::RuleBasedCollator *rbc = icu::RuleBasedCollator::rbcFromUCollator(coll);
+    if (rbc == nullptr) {
+        *pErrorCode = U_UNSUPPORTED_ERROR;
+        return;
+    }
+    icu::CollationSorter(*rbc, numThreads).sortUTF8(src, lengths, count, permutation, *pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_COLLATION
@@ -0,0 +1,69 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// collationsorter.h
+// created: 2018oct18
+
+#ifndef __COLLATIONSORTER_H__
+#define __COLLATIONSORTER_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/uobject.h"
+
+U_NAMESPACE_BEGIN
+
+class RuleBasedCollator;
+
+/**
+ * Sorts arrays of strings according to a collator.
+ * Instead of comparing strings O(n log n) times, it generates each sort key once
+ * and sorts the keys with an MSD radix sort on their bytes.
+ * Key generation and the sorting of the top-level radix buckets
+ * are split across threads if requested.
+ *
+ * Strings with equal sort keys are ordered by code point order,
+ * and identical strings by their input index,
+ * so that the result does not depend on the number of threads.
+ *
+ * The collator is only read, so several threads and sorters can share it.
+ */
+class U_I18N_API CollationSorter : public UMemory {
+public:
+    /**
+     * @param coll the collator; must outlive this object
+     * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+     */
+    CollationSorter(const RuleBasedCollator &coll, int32_t numThreads)
+            : collator(coll), maxThreads(numThreads) {}
+
+    /**
+     * Sorts the strings and writes their input indexes in sorted order to permutation.
+     * @param src array of count strings
+     * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+     *                can be NULL if all strings are NUL-terminated
+     * @param count number of strings
+     * @param permutation receives count indexes into src
+     * @param errorCode ICU error code
+     */
+    void sort(const UChar *const *src, const int32_t *lengths, int32_t count,
+              int32_t *permutation, UErrorCode &errorCode) const;
+
+    /** Same as sort() but for UTF-8 strings. */
+    void sortUTF8(const char *const *src, const int32_t *lengths, int32_t count,
+                  int32_t *permutation, UErrorCode &errorCode) const;
+
+private:
+    CollationSorter(const CollationSorter &other);  // not implemented
+    CollationSorter &operator=(const CollationSorter &other);  // not implemented
+
+    const RuleBasedCollator &collator;
+    int32_t maxThreads;
+};
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
+#endif  // __COLLATIONSORTER_H__
@@ -22,8 +22,11 @@
 #include "unicode/uvernum.h"
 #include "cmemory.h"
 #include "collationdata.h"
+#include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
+#include "mutex.h"
 #include "normalizer2impl.h"
 #include "uassert.h"
 #include "uhash.h"
@@ -52,6 +55,13 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
     rules.getTerminatedBuffer();  // ensure NUL-termination
     version[0] = version[1] = version[2] = version[3] = 0;
     maxExpansionsInitOnce.reset();
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        fastScriptTables[i] = NULL;
+    }
+    fastScriptTablesInitOnce.reset();
+    for(int32_t i = 0; i < SETTINGS_CACHE_CAPACITY; ++i) {
+        settingsCache[i].store(NULL, std::memory_order_relaxed);
+    }
 }
 
 CollationTailoring::~CollationTailoring() {
@@ -64,6 +74,14 @@ CollationTailoring::~CollationTailoring() {
     delete unsafeBackwardSet;
     uhash_close(maxExpansions);
     maxExpansionsInitOnce.reset();
+    for(int32_t i = 0; i < SETTINGS_CACHE_CAPACITY; ++i) {
+        const CollationSettings *s = settingsCache[i].load(std::memory_order_relaxed);
+        if(s != NULL) { s->removeRef(); }
+    }
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        uprv_free(fastScriptTables[i]);
+    }
+    fastScriptTablesInitOnce.reset();
 }
 
 UBool
@@ -99,6 +117,79 @@ CollationTailoring::setVersion(const UVersionInfo baseVersion, const UVersionInf
             (rulesVersion[3] << 4) + (rulesVersion[3] >> 4);
 }
 
+namespace {
+
+void U_CALLCONV
+buildFastScriptTables(const CollationTailoring *t, UErrorCode &errorCode) {
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        CollationFastLatinBuilder builder(errorCode);
+        if(!builder.forScriptBlock(*t->data, i, errorCode)) {
+            // Not supported for this data, or out of memory:
+            // Leave the table NULL so that the regular comparison is used.
+            errorCode = U_ZERO_ERROR;
+            continue;
+        }
+        int32_t length = builder.lengthOfTable();
+        uint16_t *table = (uint16_t *)uprv_malloc(length * 2);
+        if(table != NULL) {
+            uprv_memcpy(table, builder.getTable(), length * 2);
+            t->fastScriptTables[i] = table;
+        }
+    }
+}
+
+}  // namespace
+
+const uint16_t *
+CollationTailoring::getFastScriptTable(int32_t blockIndex) const {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    umtx_initOnce(fastScriptTablesInitOnce, buildFastScriptTables, this, errorCode);
+    return fastScriptTables[blockIndex];
+}
+
+namespace {
+
+// Serializes only the insertion of new settingsCache entries.
+UMutex settingsCacheMutex = U_MUTEX_INITIALIZER;
+
+}  // namespace
+
+const CollationSettings *
+CollationTailoring::getSettingsForOptions(int32_t options, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return NULL; }
+    if(options == settings->options) { return settings; }
+    // Entries are published with release semantics after they are fully initialized.
+    int32_t i = 0;
+    for(; i < SETTINGS_CACHE_CAPACITY; ++i) {
+        const CollationSettings *s = settingsCache[i].load(std::memory_order_acquire);
+        if(s == NULL) { break; }
+        if(s->options == options) { return s; }
+    }
+    if(i == SETTINGS_CACHE_CAPACITY) { return NULL; }
+    Mutex lock(&settingsCacheMutex);
+    // Another thread may have added entries since the lookup.
+    for(; i < SETTINGS_CACHE_CAPACITY; ++i) {
+        const CollationSettings *s = settingsCache[i].load(std::memory_order_relaxed);
+        if(s == NULL) { break; }
+        if(s->options == options) { return s; }
+    }
+    if(i == SETTINGS_CACHE_CAPACITY) { return NULL; }
+    CollationSettings *s = new CollationSettings(*settings);
+    if(s == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    s->options = options;
+    s->variableTop = data->getLastPrimaryForGroup(
+        UCOL_REORDER_CODE_FIRST + s->getMaxVariable());
+    s->fastLatinOptions = CollationFastLatin::getOptions(
+        data, *s, s->fastLatinPrimaries, UPRV_LENGTHOF(s->fastLatinPrimaries));
+    s->fastScriptBlocks = CollationFastLatin::getScriptBlocks(data, *s);
+    s->addRef();
+    settingsCache[i].store(s, std::memory_order_release);
+    return s;
+}
+
 int32_t
 CollationTailoring::getUCAVersion() const {
     return ((int32_t)version[1] << 4) | (version[2] >> 6);
@@ -18,9 +18,12 @@
 
 #if !UCONFIG_NO_COLLATION
 
+#include <atomic>
+
 #include "unicode/locid.h"
 #include "unicode/unistr.h"
 #include "unicode/uversion.h"
+#include "collationfastlatin.h"
 #include "collationsettings.h"
 #include "uhash.h"
 #include "umutex.h"
@@ -60,6 +63,24 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     void setVersion(const UVersionInfo baseVersion, const UVersionInfo rulesVersion);
     int32_t getUCAVersion() const;
 
+    /**
+     * Returns the fast-path table for CollationFastLatin::SCRIPT_BLOCKS[blockIndex],
+     * building all of them on first use;
+     * NULL if the data does not support it.
+     */
+    const uint16_t *getFastScriptTable(int32_t blockIndex) const;
+
+    /**
+     * Returns a shared settings object which is like this tailoring's settings
+     * but with the given options, and with the variableTop and fast-path options
+     * computed for them.
+     * The objects are created on first use and cached for the lifetime of the tailoring.
+     * Returns NULL if SETTINGS_CACHE_CAPACITY other options values are already cached;
+     * the caller then makes its own settings object.
+     * The caller must addRef() the result if it keeps it.
+     */
+    const CollationSettings *getSettingsForOptions(int32_t options, UErrorCode &errorCode) const;
+
     // data for sorting etc.
     const CollationData *data;  // == base data or ownedData
     const CollationSettings *settings;  // reference-counted
@@ -83,6 +104,14 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UnicodeSet *unsafeBackwardSet;
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
+    mutable uint16_t *fastScriptTables[CollationFastLatin::NUM_SCRIPT_BLOCKS];
+    mutable UInitOnce fastScriptTablesInitOnce;
+    /**
+     * Settings objects for other options values, filled from index 0 up and never replaced,
+     * so that lookups need not lock.
+     */
+    static constexpr int32_t SETTINGS_CACHE_CAPACITY = 8;
+    mutable std::atomic<const CollationSettings *> settingsCache[SETTINGS_CACHE_CAPACITY];
 
 private:
     /**
@@ -45,6 +45,7 @@
 #include "collationsets.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
+#include "simdutil.h"
 #include "cstring.h"
 #include "uassert.h"
 #include "ucol_imp.h"
@@ -137,6 +138,55 @@ CollationKeyByteSink::Resize(int32_t appendCapacity, int32_t length) {
     return TRUE;
 }
 
+namespace {
+
+/**
+ * Sets one attribute value in the settings options.
+ * Does not update the variableTop or the fast-path options.
+ */
+void
+setSettingsAttribute(CollationSettings &settings,
+                     UColAttribute attr, UColAttributeValue value,
+                     int32_t defaultOptions, UErrorCode &errorCode) {
+    switch(attr) {
+    case UCOL_FRENCH_COLLATION:
+        settings.setFlag(CollationSettings::BACKWARD_SECONDARY, value,
+                         defaultOptions, errorCode);
+        break;
+    case UCOL_ALTERNATE_HANDLING:
+        settings.setAlternateHandling(value, defaultOptions, errorCode);
+        break;
+    case UCOL_CASE_FIRST:
+        settings.setCaseFirst(value, defaultOptions, errorCode);
+        break;
+    case UCOL_CASE_LEVEL:
+        settings.setFlag(CollationSettings::CASE_LEVEL, value,
+                         defaultOptions, errorCode);
+        break;
+    case UCOL_NORMALIZATION_MODE:
+        settings.setFlag(CollationSettings::CHECK_FCD, value,
+                         defaultOptions, errorCode);
+        break;
+    case UCOL_STRENGTH:
+        settings.setStrength(value, defaultOptions, errorCode);
+        break;
+    case UCOL_HIRAGANA_QUATERNARY_MODE:
+        // Deprecated attribute. Check for valid values but do not change anything.
+        if(value != UCOL_OFF && value != UCOL_ON && value != UCOL_DEFAULT) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        }
+        break;
+    case UCOL_NUMERIC_COLLATION:
+        settings.setFlag(CollationSettings::NUMERIC, value, defaultOptions, errorCode);
+        break;
+    default:
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        break;
+    }
+}
+
+}  // namespace
+
 RuleBasedCollator::RuleBasedCollator(const RuleBasedCollator &other)
         : Collator(other),
           data(other.data),
@@ -150,6 +200,66 @@ RuleBasedCollator::RuleBasedCollator(const RuleBasedCollator &other)
     cacheEntry->addRef();
 }
 
+RuleBasedCollator::RuleBasedCollator(const RuleBasedCollator &base,
+                                     const UColAttribute *attributes,
+                                     const UColAttributeValue *values, int32_t length,
+                                     UErrorCode &errorCode)
+        : Collator(base),
+          data(base.data),
+          settings(base.settings),
+          tailoring(base.tailoring),
+          cacheEntry(base.cacheEntry),
+          validLocale(base.validLocale),
+          explicitlySetAttributes(base.explicitlySetAttributes),
+          actualLocaleIsSameAsValid(base.actualLocaleIsSameAsValid) {
+    settings->addRef();
+    cacheEntry->addRef();
+    if(U_FAILURE(errorCode)) { return; }
+    if(length < 0 || (length > 0 && (attributes == NULL || values == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // Compute the new options without touching the shared settings.
+    const CollationSettings &defaultSettings = getDefaultSettings();
+    CollationSettings scratch;
+    scratch.options = settings->options;
+    for(int32_t i = 0; i < length; ++i) {
+        setSettingsAttribute(scratch, attributes[i], values[i], defaultSettings.options, errorCode);
+    }
+    if(U_FAILURE(errorCode)) { return; }
+    if(scratch.options != settings->options) {
+        // The tailoring caches settings objects per options value
+        // if the other settings are the tailoring's own.
+        const CollationSettings *newSettings = NULL;
+        if(settings->reorderCodesLength == defaultSettings.reorderCodesLength &&
+                uprv_memcmp(settings->reorderCodes, defaultSettings.reorderCodes,
+                            settings->reorderCodesLength * 4) == 0 &&
+                settings->variableTop == data->getLastPrimaryForGroup(
+                    UCOL_REORDER_CODE_FIRST + settings->getMaxVariable())) {
+            newSettings = tailoring->getSettingsForOptions(scratch.options, errorCode);
+            if(U_FAILURE(errorCode)) { return; }
+        }
+        if(newSettings != NULL) {
+            SharedObject::copyPtr(newSettings, settings);
+        } else {
+            CollationSettings *ownedSettings = SharedObject::copyOnWrite(settings);
+            if(ownedSettings == NULL) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            ownedSettings->options = scratch.options;
+            setFastLatinOptions(*ownedSettings);
+        }
+    }
+    for(int32_t i = 0; i < length; ++i) {
+        if(values[i] == UCOL_DEFAULT) {
+            setAttributeDefault(attributes[i]);
+        } else {
+            setAttributeExplicitly(attributes[i]);
+        }
+    }
+}
+
 RuleBasedCollator::RuleBasedCollator(const uint8_t *bin, int32_t length,
                                      const RuleBasedCollator *base, UErrorCode &errorCode)
         : data(NULL),
@@ -461,42 +571,7 @@ RuleBasedCollator::setAttribute(UColAttribute attr, UColAttributeValue value,
         errorCode = U_MEMORY_ALLOCATION_ERROR;
         return;
     }
-
-    switch(attr) {
-    case UCOL_FRENCH_COLLATION:
-        ownedSettings->setFlag(CollationSettings::BACKWARD_SECONDARY, value,
-                               defaultSettings.options, errorCode);
-        break;
-    case UCOL_ALTERNATE_HANDLING:
-        ownedSettings->setAlternateHandling(value, defaultSettings.options, errorCode);
-        break;
-    case UCOL_CASE_FIRST:
-        ownedSettings->setCaseFirst(value, defaultSettings.options, errorCode);
-        break;
-    case UCOL_CASE_LEVEL:
-        ownedSettings->setFlag(CollationSettings::CASE_LEVEL, value,
-                               defaultSettings.options, errorCode);
-        break;
-    case UCOL_NORMALIZATION_MODE:
-        ownedSettings->setFlag(CollationSettings::CHECK_FCD, value,
-                               defaultSettings.options, errorCode);
-        break;
-    case UCOL_STRENGTH:
-        ownedSettings->setStrength(value, defaultSettings.options, errorCode);
-        break;
-    case UCOL_HIRAGANA_QUATERNARY_MODE:
-        // Deprecated attribute. Check for valid values but do not change anything.
-        if(value != UCOL_OFF && value != UCOL_ON && value != UCOL_DEFAULT) {
-            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
-        }
-        break;
-    case UCOL_NUMERIC_COLLATION:
-        ownedSettings->setFlag(CollationSettings::NUMERIC, value, defaultSettings.options, errorCode);
-        break;
-    default:
-        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
-        break;
-    }
+    setSettingsAttribute(*ownedSettings, attr, value, defaultSettings.options, errorCode);
     if(U_FAILURE(errorCode)) { return; }
     setFastLatinOptions(*ownedSettings);
     if(value == UCOL_DEFAULT) {
@@ -694,6 +769,7 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    ownedSettings.fastScriptBlocks = CollationFastLatin::getScriptBlocks(data, ownedSettings);
 }
 
 UCollationResult
@@ -962,6 +1038,42 @@ UCollationResult compareNFDIter(const Normalizer2Impl &nfcImpl,
     return UCOL_EQUAL;
 }
 
+/**
+ * Compares via the fast-path table for the script block
+ * of the first non-Latin character in either string.
+ * Bails out without scanning further when that character is not in one of the blocks.
+ */
+int32_t compareFastScript(const CollationTailoring &t, const CollationSettings &settings,
+                          const UChar *left, int32_t leftLength,
+                          const UChar *right, int32_t rightLength) {
+    int32_t block = CollationFastLatin::findScriptBlock(settings.fastScriptBlocks, left, leftLength);
+    if(block == CollationFastLatin::NO_SCRIPT_BLOCK) {
+        block = CollationFastLatin::findScriptBlock(settings.fastScriptBlocks, right, rightLength);
+    }
+    if(block < 0) { return CollationFastLatin::BAIL_OUT_RESULT; }
+    const uint16_t *table = t.getFastScriptTable(block);
+    if(table == NULL) { return CollationFastLatin::BAIL_OUT_RESULT; }
+    return CollationFastLatin::compareUTF16(table, CollationFastLatin::NO_PRIMARIES,
+                                            CollationFastLatin::getScriptOptions(table, settings),
+                                            left, leftLength, right, rightLength);
+}
+
+int32_t compareFastScriptUTF8(const CollationTailoring &t, const CollationSettings &settings,
+                              const uint8_t *left, int32_t leftLength,
+                              const uint8_t *right, int32_t rightLength) {
+    int32_t block =
+        CollationFastLatin::findScriptBlockUTF8(settings.fastScriptBlocks, left, leftLength);
+    if(block == CollationFastLatin::NO_SCRIPT_BLOCK) {
+        block = CollationFastLatin::findScriptBlockUTF8(settings.fastScriptBlocks, right, rightLength);
+    }
+    if(block < 0) { return CollationFastLatin::BAIL_OUT_RESULT; }
+    const uint16_t *table = t.getFastScriptTable(block);
+    if(table == NULL) { return CollationFastLatin::BAIL_OUT_RESULT; }
+    return CollationFastLatin::compareUTF8(table, CollationFastLatin::NO_PRIMARIES,
+                                           CollationFastLatin::getScriptOptions(table, settings),
+                                           left, leftLength, right, rightLength);
+}
+
 }  // namespace
 
 UCollationResult
@@ -988,15 +1100,10 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     } else {
         leftLimit = left + leftLength;
         rightLimit = right + rightLength;
-        for(;;) {
-            if(equalPrefixLength == leftLength) {
-                if(equalPrefixLength == rightLength) { return UCOL_EQUAL; }
-                break;
-            } else if(equalPrefixLength == rightLength ||
-                      left[equalPrefixLength] != right[equalPrefixLength]) {
-                break;
-            }
-            ++equalPrefixLength;
+        equalPrefixLength = SIMDUtil::equalPrefixLength(
+            left, right, leftLength <= rightLength ? leftLength : rightLength);
+        if(equalPrefixLength == leftLength && equalPrefixLength == rightLength) {
+            return UCOL_EQUAL;
         }
     }
 
@@ -1045,6 +1152,19 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
 
+    if(result == CollationFastLatin::BAIL_OUT_RESULT && settings->fastScriptBlocks != 0) {
+        // Text in one of the fast script blocks, such as Greek or Cyrillic.
+        if(leftLength >= 0) {
+            result = compareFastScript(*tailoring, *settings,
+                                       left + equalPrefixLength, leftLength - equalPrefixLength,
+                                       right + equalPrefixLength, rightLength - equalPrefixLength);
+        } else {
+            result = compareFastScript(*tailoring, *settings,
+                                       left + equalPrefixLength, -1,
+                                       right + equalPrefixLength, -1);
+        }
+    }
+
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
             UTF16CollationIterator leftIter(data, numeric,
@@ -1101,15 +1221,10 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
             ++equalPrefixLength;
         }
     } else {
-        for(;;) {
-            if(equalPrefixLength == leftLength) {
-                if(equalPrefixLength == rightLength) { return UCOL_EQUAL; }
-                break;
-            } else if(equalPrefixLength == rightLength ||
-                      left[equalPrefixLength] != right[equalPrefixLength]) {
-                break;
-            }
-            ++equalPrefixLength;
+        equalPrefixLength = SIMDUtil::equalPrefixLength(
+            left, right, leftLength <= rightLength ? leftLength : rightLength);
+        if(equalPrefixLength == leftLength && equalPrefixLength == rightLength) {
+            return UCOL_EQUAL;
         }
     }
     // Back up to the start of a partially-equal code point.
@@ -1174,6 +1289,19 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
 
+    if(result == CollationFastLatin::BAIL_OUT_RESULT && settings->fastScriptBlocks != 0) {
+        // Text in one of the fast script blocks, such as Greek or Cyrillic.
+        if(leftLength >= 0) {
+            result = compareFastScriptUTF8(*tailoring, *settings,
+                                           left + equalPrefixLength, leftLength - equalPrefixLength,
+                                           right + equalPrefixLength, rightLength - equalPrefixLength);
+        } else {
+            result = compareFastScriptUTF8(*tailoring, *settings,
+                                           left + equalPrefixLength, -1,
+                                           right + equalPrefixLength, -1);
+        }
+    }
+
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
             UTF8CollationIterator leftIter(data, numeric, left, equalPrefixLength, leftLength);
@@ -1328,6 +1456,157 @@ RuleBasedCollator::getSortKey(const UChar *s, int32_t length,
     return U_SUCCESS(errorCode) ? sink.NumberOfBytesAppended() : 0;
 }
 
+namespace {
+
+UBool
+areValidSortKeysArgs(const void *src, int32_t count,
+                     const uint8_t *dest, int32_t capacity, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(count < 0 || (src == NULL && count > 0) || capacity < 0 || (dest == NULL && capacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+const char terminatorByte = 0;  // TERMINATOR_BYTE
+
+}  // namespace
+
+int32_t
+RuleBasedCollator::getSortKeys(const UChar *const *src, const int32_t *lengths, int32_t count,
+                               uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                               UErrorCode &errorCode) const {
+    if(!areValidSortKeysArgs(src, count, dest, capacity, errorCode)) { return 0; }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) { dest = noDest; }  // A NULL buffer would mean an allocation error.
+    // One sink and one iterator for all of the strings.
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UBool numeric = settings->isNumeric();
+    UBool checkFCD = !settings->dontCheckFCD();
+    CollationKeys::LevelCallback callback;
+    UTF16CollationIterator iter(data, numeric, NULL, NULL, NULL);
+    FCDUTF16CollationIterator fcdIter(data, numeric, NULL, NULL, NULL);
+    int32_t numKeys = 0;
+    if(keyOffsets != NULL) { keyOffsets[0] = 0; }
+    for(; numKeys < count; ++numKeys) {
+        const UChar *s = src[numKeys];
+        int32_t length = lengths != NULL ? lengths[numKeys] : -1;
+        if(s == NULL && length != 0) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        const UChar *limit = (length >= 0) ? s + length : NULL;
+        if(checkFCD) {
+            fcdIter.setText(s, limit);
+            CollationKeys::writeSortKeyUpToQuaternary(fcdIter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, TRUE, errorCode);
+        } else {
+            iter.setText(s, limit);
+            CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, TRUE, errorCode);
+        }
+        if(settings->getStrength() == UCOL_IDENTICAL) {
+            writeIdenticalLevel(s, limit, sink, errorCode);
+        }
+        sink.Append(&terminatorByte, 1);
+        if(U_FAILURE(errorCode) || sink.Overflowed()) { break; }
+        if(keyOffsets != NULL) { keyOffsets[numKeys + 1] = sink.NumberOfBytesAppended(); }
+    }
+    return numKeys;
+}
+
+void
+RuleBasedCollator::internalGetSortKeyPrefixes(const UnicodeString *src, int32_t count,
+                                              uint8_t *dest, int32_t prefixLength,
+                                              UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(count < 0 || (count > 0 && (src == NULL || dest == NULL || prefixLength <= 0))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    UBool numeric = settings->isNumeric();
+    UBool checkFCD = !settings->dontCheckFCD();
+    CollationKeys::LevelCallback callback;
+    UTF16CollationIterator iter(data, numeric, NULL, NULL, NULL);
+    FCDUTF16CollationIterator fcdIter(data, numeric, NULL, NULL, NULL);
+    for(int32_t i = 0; i < count; ++i, dest += prefixLength) {
+        const UChar *s = src[i].getBuffer();
+        const UChar *limit = s + src[i].length();
+        // Without preflighting, writeSortKeyUpToQuaternary() stops
+        // when the sink overflows on the primary level.
+        FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), prefixLength);
+        if(checkFCD) {
+            fcdIter.setText(s, limit);
+            CollationKeys::writeSortKeyUpToQuaternary(fcdIter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, FALSE, errorCode);
+        } else {
+            iter.setText(s, limit);
+            CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, FALSE, errorCode);
+        }
+        if(settings->getStrength() == UCOL_IDENTICAL && !sink.Overflowed()) {
+            writeIdenticalLevel(s, limit, sink, errorCode);
+        }
+        if(U_FAILURE(errorCode)) { return; }
+        // The padding includes the terminator byte.
+        for(int32_t j = sink.NumberOfBytesAppended(); j < prefixLength; ++j) {
+            dest[j] = 0;
+        }
+    }
+}
+
+int32_t
+RuleBasedCollator::getSortKeysUTF8(const char *const *src, const int32_t *lengths, int32_t count,
+                                   uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                                   UErrorCode &errorCode) const {
+    if(!areValidSortKeysArgs(src, count, dest, capacity, errorCode)) { return 0; }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) { dest = noDest; }  // A NULL buffer would mean an allocation error.
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UBool numeric = settings->isNumeric();
+    UBool checkFCD = !settings->dontCheckFCD();
+    CollationKeys::LevelCallback callback;
+    UTF8CollationIterator iter(data, numeric, NULL, 0, 0);
+    FCDUTF8CollationIterator fcdIter(data, numeric, NULL, 0, 0);
+    UnicodeString s16;  // only for the identical level
+    int32_t numKeys = 0;
+    if(keyOffsets != NULL) { keyOffsets[0] = 0; }
+    for(; numKeys < count; ++numKeys) {
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(src[numKeys]);
+        int32_t length = lengths != NULL ? lengths[numKeys] : -1;
+        if(s == NULL && length != 0) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if(checkFCD) {
+            fcdIter.setText(s, length);
+            CollationKeys::writeSortKeyUpToQuaternary(fcdIter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, TRUE, errorCode);
+        } else {
+            iter.setText(s, length);
+            CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, TRUE, errorCode);
+        }
+        if(settings->getStrength() == UCOL_IDENTICAL) {
+            if(length < 0) { length = static_cast<int32_t>(uprv_strlen(src[numKeys])); }
+            s16 = UnicodeString::fromUTF8(StringPiece(src[numKeys], length));
+            const UChar *s16Buffer = s16.getBuffer();
+            writeIdenticalLevel(s16Buffer, s16Buffer + s16.length(), sink, errorCode);
+        }
+        sink.Append(&terminatorByte, 1);
+        if(U_FAILURE(errorCode) || sink.Overflowed()) { break; }
+        if(keyOffsets != NULL) { keyOffsets[numKeys + 1] = sink.NumberOfBytesAppended(); }
+    }
+    return numKeys;
+}
+
 void
 RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
@@ -32,6 +32,7 @@ SearchIterator::SearchIterator(const SearchIterator &other)
     m_search_->isCanonicalMatch = other.m_search_->isCanonicalMatch;
     m_search_->isOverlap        = other.m_search_->isOverlap;
     m_search_->elementComparisonType = other.m_search_->elementComparisonType;
+    m_search_->isSkipSearch     = other.m_search_->isSkipSearch;
     m_search_->matchedIndex     = other.m_search_->matchedIndex;
     m_search_->matchedLength    = other.m_search_->matchedLength;
     m_search_->text             = other.m_search_->text;
@@ -67,6 +68,9 @@ void SearchIterator::setAttribute(USearchAttribute       attribute,
                 m_search_->elementComparisonType = 0;
             }
             break;
+        case USEARCH_SKIP_SEARCH :
+            m_search_->isSkipSearch = (value == USEARCH_ON ? TRUE : FALSE);
+            break;
         default:
             status = U_ILLEGAL_ARGUMENT_ERROR;
         }
@@ -94,6 +98,8 @@ USearchAttributeValue SearchIterator::getAttribute(
                 return USEARCH_STANDARD_ELEMENT_COMPARISON;
             }
         }
+    case USEARCH_SKIP_SEARCH :
+        return (m_search_->isSkipSearch == TRUE ? USEARCH_ON : USEARCH_OFF);
     default :
         return USEARCH_DEFAULT;
     }
@@ -187,6 +193,7 @@ UBool SearchIterator::operator==(const SearchIterator &that) const
             m_search_->isCanonicalMatch == that.m_search_->isCanonicalMatch &&
             m_search_->isOverlap        == that.m_search_->isOverlap &&
             m_search_->elementComparisonType == that.m_search_->elementComparisonType &&
+            m_search_->isSkipSearch     == that.m_search_->isSkipSearch &&
             m_search_->matchedIndex     == that.m_search_->matchedIndex &&
             m_search_->matchedLength    == that.m_search_->matchedLength &&
             m_search_->textLength       == that.m_search_->textLength &&
@@ -336,6 +343,7 @@ void SearchIterator::reset()
     m_search_->isOverlap          = FALSE;
     m_search_->isCanonicalMatch   = FALSE;
     m_search_->elementComparisonType = 0;
+    m_search_->isSkipSearch       = FALSE;
     m_search_->isForwardSearching = TRUE;
     m_search_->reset              = TRUE;
 }
@@ -349,6 +357,7 @@ SearchIterator::SearchIterator()
     m_search_->isOverlap          = FALSE;
     m_search_->isCanonicalMatch   = FALSE;
     m_search_->elementComparisonType = 0;
+    m_search_->isSkipSearch       = FALSE;
     m_search_->isForwardSearching = TRUE;
     m_search_->reset              = TRUE;
     m_search_->matchedIndex       = USEARCH_DONE;
@@ -368,6 +377,7 @@ SearchIterator::SearchIterator(const UnicodeString &text,
     m_search_->isOverlap          = FALSE;
     m_search_->isCanonicalMatch   = FALSE;
     m_search_->elementComparisonType = 0;
+    m_search_->isSkipSearch       = FALSE;
     m_search_->isForwardSearching = TRUE;
     m_search_->reset              = TRUE;
     m_search_->matchedIndex       = USEARCH_DONE;
@@ -385,6 +395,7 @@ SearchIterator::SearchIterator(CharacterIterator &text,
     m_search_->isOverlap          = FALSE;
     m_search_->isCanonicalMatch   = FALSE;
     m_search_->elementComparisonType = 0;
+    m_search_->isSkipSearch       = FALSE;
     m_search_->isForwardSearching = TRUE;
     m_search_->reset              = TRUE;
     m_search_->matchedIndex       = USEARCH_DONE;
@@ -406,6 +417,7 @@ SearchIterator & SearchIterator::operator=(const SearchIterator &that)
         m_search_->isCanonicalMatch = that.m_search_->isCanonicalMatch;
         m_search_->isOverlap        = that.m_search_->isOverlap;
         m_search_->elementComparisonType = that.m_search_->elementComparisonType;
+        m_search_->isSkipSearch     = that.m_search_->isSkipSearch;
         m_search_->matchedIndex     = that.m_search_->matchedIndex;
         m_search_->matchedLength    = that.m_search_->matchedLength;
         m_search_->text             = that.m_search_->text;
@@ -102,6 +102,31 @@ ucol_safeClone(const UCollator *coll, void * /*stackBuffer*/, int32_t * pBufferS
     return newColl->toUCollator();
 }
 
+U_CAPI UCollator* U_EXPORT2
+ucol_cloneWithAttributes(const UCollator *coll,
+                         const UColAttribute *attributes,
+                         const UColAttributeValue *values,
+                         int32_t length,
+                         UErrorCode *status) {
+    if(U_FAILURE(*status)) { return NULL; }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL) {
+        *status = coll == NULL ? U_ILLEGAL_ARGUMENT_ERROR : U_UNSUPPORTED_ERROR;
+        return NULL;
+    }
+    RuleBasedCollator *newColl =
+        new RuleBasedCollator(*rbc, attributes, values, length, *status);
+    if(newColl == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    if(U_FAILURE(*status)) {
+        delete newColl;
+        return NULL;
+    }
+    return newColl->toUCollator();
+}
+
 U_CAPI void U_EXPORT2
 ucol_close(UCollator *coll)
 {
@@ -209,6 +234,67 @@ ucol_getSortKey(const    UCollator    *coll,
     return keySize;
 }
 
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *src, const int32_t *lengths, int32_t count,
+                 uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                 UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) { return 0; }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc != NULL) {
+        return rbc->getSortKeys(src, lengths, count, dest, capacity, keyOffsets, *pErrorCode);
+    }
+    // Other Collator subclasses: One key at a time.
+    if(count < 0 || (src == NULL && count > 0) || capacity < 0 || (dest == NULL && capacity > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const Collator *c = Collator::fromUCollator(coll);
+    int32_t length = 0;
+    int32_t numKeys = 0;
+    if(keyOffsets != NULL) { keyOffsets[0] = 0; }
+    for(; numKeys < count; ++numKeys) {
+        int32_t keyLength = c->getSortKey(src[numKeys], lengths != NULL ? lengths[numKeys] : -1,
+                                          dest + length, capacity - length);
+        if(keyLength == 0 || keyLength > (capacity - length)) { break; }
+        length += keyLength;
+        if(keyOffsets != NULL) { keyOffsets[numKeys + 1] = length; }
+    }
+    return numKeys;
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const *src, const int32_t *lengths, int32_t count,
+                     uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                     UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) { return 0; }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc != NULL) {
+        return rbc->getSortKeysUTF8(src, lengths, count, dest, capacity, keyOffsets, *pErrorCode);
+    }
+    // Other Collator subclasses: One key at a time.
+    if(count < 0 || (src == NULL && count > 0) || capacity < 0 || (dest == NULL && capacity > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const Collator *c = Collator::fromUCollator(coll);
+    UnicodeString s16;
+    int32_t length = 0;
+    int32_t numKeys = 0;
+    if(keyOffsets != NULL) { keyOffsets[0] = 0; }
+    for(; numKeys < count; ++numKeys) {
+        int32_t srcLength = lengths != NULL ? lengths[numKeys] : -1;
+        s16 = UnicodeString::fromUTF8(
+            srcLength >= 0 ? StringPiece(src[numKeys], srcLength) : StringPiece(src[numKeys]));
+        int32_t keyLength = c->getSortKey(s16, dest + length, capacity - length);
+        if(keyLength == 0 || keyLength > (capacity - length)) { break; }
+        length += keyLength;
+        if(keyOffsets != NULL) { keyOffsets[numKeys + 1] = length; }
+    }
+    return numKeys;
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_nextSortKeyPart(const UCollator *coll,
                      UCharIterator *iter,
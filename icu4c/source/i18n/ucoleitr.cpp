@@ -21,6 +21,7 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/coleitr.h"
+#include "unicode/localpointer.h"
 #include "unicode/tblcoll.h"
 #include "unicode/ucoleitr.h"
 #include "unicode/ustring.h"
@@ -299,6 +300,38 @@ ucol_openElements(const UCollator  *coll,
     return cei->toUCollationElements();
 }
 
+U_CAPI UCollationElements* U_EXPORT2
+ucol_openElementsUTF8(const UCollator  *coll,
+                      const char       *text,
+                            int32_t    textLength,
+                            UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (coll == NULL || (text == NULL && textLength != 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if (rbc == NULL) {
+        *status = U_UNSUPPORTED_ERROR;  // coll is a Collator but not a RuleBasedCollator
+        return NULL;
+    }
+
+    LocalPointer<CollationElementIterator> cei(
+        rbc->createCollationElementIterator(UnicodeString()), *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    cei->setTextUTF8(textLength < 0 ? StringPiece(text) : StringPiece(text, textLength), *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+
+    return cei.orphan()->toUCollationElements();
+}
+
 
 U_CAPI void U_EXPORT2
 ucol_closeElements(UCollationElements *elems)
@@ -323,6 +356,19 @@ ucol_next(UCollationElements *elems,
     return CollationElementIterator::fromUCollationElements(elems)->next(*status);
 }
 
+U_CAPI int32_t U_EXPORT2
+ucol_nextCEs(UCollationElements *elems,
+             int64_t *ces, int32_t capacity, int32_t *offsets,
+             UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+
+    return CollationElementIterator::fromUCollationElements(elems)->nextCEs(
+        ces, capacity, offsets, *status);
+}
+
 U_NAMESPACE_BEGIN
 
 int64_t
@@ -492,6 +538,23 @@ ucol_setText(      UCollationElements *elems,
     return CollationElementIterator::fromUCollationElements(elems)->setText(s, *status);
 }
 
+U_CAPI void U_EXPORT2
+ucol_setTextUTF8(UCollationElements *elems,
+                 const char *text, int32_t textLength,
+                 UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+
+    if ((text == NULL && textLength != 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    StringPiece s = textLength < 0 ? StringPiece(text) : StringPiece(text, textLength);
+    CollationElementIterator::fromUCollationElements(elems)->setTextUTF8(s, *status);
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_getOffset(const UCollationElements *elems)
 {
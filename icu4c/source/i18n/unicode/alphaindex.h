@@ -273,6 +273,30 @@ class U_I18N_API AlphabeticIndex: public UObject {
          */
         int32_t getBucketIndex(const UnicodeString &name, UErrorCode &errorCode) const;
 
+#ifndef U_HIDE_DRAFT_API
+        /**
+         * Finds the index bucket for each of the given names, with the same results
+         * as getBucketIndex() for each name.
+         * This is much faster for many names: The sort keys of the bucket boundaries are
+         * computed when the ImmutableIndex is built, and only a short prefix of
+         * each name's sort key is generated and compared with them.
+         *
+         * If numThreads>1 and there are enough names, then the names are distributed
+         * to up to numThreads threads (including the calling thread).
+         *
+         * @param names array of length strings to be sorted into index buckets
+         * @param length number of names
+         * @param bucketIndexes array of length elements which receives
+         *                      the bucket number for each name
+         * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+         * @param errorCode Error code, will be set with the reason if the
+         *                  operation fails.
+         * @draft ICU 64
+         */
+        void getBucketIndexes(const UnicodeString *names, int32_t length, int32_t *bucketIndexes,
+                              int32_t numThreads, UErrorCode &errorCode) const;
+#endif  /* U_HIDE_DRAFT_API */
+
         /**
          * Returns the index-th bucket. Returns NULL if the index is out of range.
          *
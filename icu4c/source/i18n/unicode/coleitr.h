@@ -37,6 +37,7 @@
 
 #if !UCONFIG_NO_COLLATION
 
+#include "unicode/stringpiece.h"
 #include "unicode/unistr.h"
 #include "unicode/uobject.h"
 
@@ -189,6 +190,33 @@ class U_I18N_API CollationElementIterator U_FINAL : public UObject {
     */
     int32_t previous(UErrorCode& status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+    * Gets the next collation elements of the string, up to capacity of them,
+    * as native 64-bit CEs: the primary weight in the upper 32 bits,
+    * the secondary and tertiary weights (including case bits) in the lower 32 bits.
+    * This is equivalent to calling next() in a loop and combining the CE halves,
+    * but much faster.
+    *
+    * If offsets is not NULL, then offsets[i] is set to the source text offset
+    * after ces[i], that is, what getOffset() would return after next() returned
+    * (the first half of) that CE. The text for ces[i] starts at offsets[i-1]
+    * (or at the offset before the call, for i=0);
+    * CEs from the same expansion or normalized text segment share their offsets.
+    *
+    * If next() just returned the first half of a CE, then the rest of that CE is skipped.
+    * @param ces the array to be filled with CEs
+    * @param capacity the number of elements in ces and offsets
+    * @param offsets NULL, or the array to be filled with source offsets
+    * @param status the error code status;
+    *               set to U_INVALID_STATE_ERROR after iterating backward
+    * @return the number of CEs written; less than capacity only at the end of the text
+    *         or on error
+    * @draft ICU 64
+    */
+    int32_t nextCEs(int64_t *ces, int32_t capacity, int32_t *offsets, UErrorCode& status);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
     * Gets the primary order of a collation order.
     * @param order the collation order
@@ -248,6 +276,18 @@ class U_I18N_API CollationElementIterator U_FINAL : public UObject {
     */
     void setText(CharacterIterator& str, UErrorCode& status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+    * Sets the source string in UTF-8. The string is copied.
+    * Ill-formed UTF-8 sequences are treated like U+FFFD, as in Collator::compareUTF8().
+    * All offsets are then UTF-8 byte offsets.
+    * @param str the source string.
+    * @param status the error code status.
+    * @draft ICU 64
+    */
+    void setTextUTF8(const StringPiece &str, UErrorCode& status);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
     * Checks if a comparison order is ignorable.
     * @param order the collation order.
@@ -354,6 +394,12 @@ class U_I18N_API CollationElementIterator U_FINAL : public UObject {
     /** Normalizes dir_=1 (just after setOffset()) to dir_=0 (just after reset()). */
     inline int8_t normalizeDir() const { return dir_ == 1 ? 0 : dir_; }
 
+    inline int32_t getTextLength() const {
+        return u8Text_ != NULL ? u8Length_ : string_.length();
+    }
+
+    void releaseUTF8Text();
+
     static UHashtable *computeMaxExpansions(const CollationData *data, UErrorCode &errorCode);
 
     static int32_t getMaxExpansion(const UHashtable *maxExpansions, int32_t order);
@@ -376,6 +422,9 @@ class U_I18N_API CollationElementIterator U_FINAL : public UObject {
     UVector32 *offsets_;
 
     UnicodeString string_;
+    /** Owned copy of the source string set with setTextUTF8(), otherwise NULL. */
+    char *u8Text_;
+    int32_t u8Length_;
 };
 
 // CollationElementIterator inline method definitions --------------------------
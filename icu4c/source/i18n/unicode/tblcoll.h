@@ -163,6 +163,55 @@ class U_I18N_API RuleBasedCollator : public Collator {
                     UColAttributeValue decompositionMode,
                     UErrorCode& status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * RuleBasedCollator constructor with an on-disk cache of built tailorings.
+     * If cacheDir contains the data that this version of ICU built from the same rules,
+     * then that file is memory-mapped and validated instead of building the tailoring again.
+     * Otherwise the tailoring is built from the rules and written to cacheDir.
+     * Failure to read or write the cache is not an error.
+     *
+     * The strength and decomposition mode are applied on top of the cached data
+     * like with the other constructors, so they do not need separate cache files.
+     *
+     * @param rules the collation rules to build the collation table from.
+     * @param strength strength for comparison, or UCOL_DEFAULT
+     * @param decompositionMode the normalisation mode, or UCOL_DEFAULT
+     * @param cacheDir directory for the cache files, which must exist;
+     *                 if NULL or empty, then no cache is used
+     * @param status reporting a success or an error.
+     * @see ucol_openRulesWithCache
+     * @draft ICU 64
+     */
+    RuleBasedCollator(const UnicodeString &rules,
+                      UColAttributeValue strength,
+                      UColAttributeValue decompositionMode,
+                      const char *cacheDir,
+                      UErrorCode &status);
+
+    /**
+     * Copy constructor which also sets attributes.
+     * The result is the same as from the copy constructor followed by setAttribute() calls,
+     * but when the base collator does not have custom reordering or a custom variable top,
+     * then this collator shares an immutable settings object for the resulting attribute values
+     * with all other collators for the same tailoring.
+     * Creating such a collator, for example on the stack, does not allocate memory
+     * once the settings for the attribute values have been created and cached.
+     *
+     * @param base the collator to copy
+     * @param attributes array of length attributes to set
+     * @param values array of length values, one per attribute; UCOL_DEFAULT is allowed
+     * @param length number of attributes
+     * @param errorCode ICU error code
+     * @see ucol_cloneWithAttributes
+     * @draft ICU 64
+     */
+    RuleBasedCollator(const RuleBasedCollator &base,
+                      const UColAttribute *attributes,
+                      const UColAttributeValue *values, int32_t length,
+                      UErrorCode &errorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_INTERNAL_API
     /**
      * TODO: document & propose as public API
@@ -649,6 +698,66 @@ class U_I18N_API RuleBasedCollator : public Collator {
     virtual int32_t getSortKey(const char16_t *source, int32_t sourceLength,
                                uint8_t *result, int32_t resultLength) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Writes the sort keys for an array of strings back to back into one buffer.
+     * Each sort key is the same as from getSortKey(), including its terminating zero byte.
+     * This avoids the per-string setup of getSortKey() and
+     * the per-key allocation of getCollationKey().
+     *
+     * Sort keys are written in input order until one does not fit.
+     * The number of complete sort keys is returned; the buffer contents
+     * after the last complete key are undefined.
+     * The caller can continue with the remaining strings in another buffer.
+     *
+     * @param src array of count input strings
+     * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+     *                can be NULL if all strings are NUL-terminated
+     * @param count number of input strings
+     * @param dest destination buffer; can be NULL if capacity=0
+     * @param capacity number of bytes that can be written to dest
+     * @param keyOffsets if not NULL, then this array of count+1 elements receives
+     *                   the start offset in dest of each complete sort key,
+     *                   followed by the end offset of the last one
+     *                   (keyOffsets[0..n] for n returned keys)
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return number n of sort keys written completely, 0<=n<=count
+     * @draft ICU 64
+     */
+    int32_t getSortKeys(const char16_t *const *src, const int32_t *lengths, int32_t count,
+                        uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                        UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys for an array of UTF-8 strings back to back into one buffer.
+     * Same as getSortKeys() for UTF-16 strings, and each sort key is the same as
+     * for the equivalent UTF-16 string.
+     * Ill-formed UTF-8 sequences are treated like U+FFFD, as in compareUTF8().
+     *
+     * @param src array of count UTF-8 input strings
+     * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+     *                can be NULL if all strings are NUL-terminated
+     * @param count number of input strings
+     * @param dest destination buffer; can be NULL if capacity=0
+     * @param capacity number of bytes that can be written to dest
+     * @param keyOffsets if not NULL, then this array of count+1 elements receives
+     *                   the start offset in dest of each complete sort key,
+     *                   followed by the end offset of the last one
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return number n of sort keys written completely, 0<=n<=count
+     * @draft ICU 64
+     */
+    int32_t getSortKeysUTF8(const char *const *src, const int32_t *lengths, int32_t count,
+                            uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                            UErrorCode &errorCode) const;
+#endif  // U_HIDE_DRAFT_API
+
     /**
      * Retrieves the reordering codes for this collator.
      * @param dest The array to fill with the script ordering.
@@ -776,6 +885,19 @@ class U_I18N_API RuleBasedCollator : public Collator {
             UParseError *outParseError, UnicodeString *outReason,
             UErrorCode &errorCode);
 
+    /**
+     * Implements the from-rules constructor with a cache directory,
+     * and ucol_openRulesWithCache().
+     * @internal
+     */
+    void internalBuildCachedTailoring(
+            const UnicodeString &rules,
+            int32_t strength,
+            UColAttributeValue decompositionMode,
+            const char *cacheDir,
+            UParseError *outParseError,
+            UErrorCode &errorCode);
+
     /** @internal */
     static inline RuleBasedCollator *rbcFromUCollator(UCollator *uc) {
         return dynamic_cast<RuleBasedCollator *>(fromUCollator(uc));
@@ -790,6 +912,18 @@ class U_I18N_API RuleBasedCollator : public Collator {
      * @internal for tests & tools
      */
     void internalGetCEs(const UnicodeString &str, UVector64 &ces, UErrorCode &errorCode) const;
+
+    /**
+     * Writes the first prefixLength bytes of the sort key of each of the count strings
+     * to dest+i*prefixLength, padding shorter sort keys with 00 bytes.
+     * Below the identical strength, each string is processed only as far as needed
+     * for its sort key prefix.
+     * Used for comparing many strings with a few short ones, such as index bucket boundaries.
+     * @internal
+     */
+    void internalGetSortKeyPrefixes(const UnicodeString *src, int32_t count,
+                                    uint8_t *dest, int32_t prefixLength,
+                                    UErrorCode &errorCode) const;
 #endif  // U_HIDE_INTERNAL_API
 
 protected:
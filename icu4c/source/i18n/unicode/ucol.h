@@ -432,6 +432,38 @@ ucol_openRules( const UChar        *rules,
                 UParseError        *parseError,
                 UErrorCode         *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Same as ucol_openRules() but with an on-disk cache of built tailorings.
+ * If cacheDir contains the data that this version of ICU built from the same rules,
+ * then that file is memory-mapped and validated instead of building the tailoring again.
+ * Otherwise the tailoring is built from the rules and written to cacheDir
+ * via a temporary file which is then renamed.
+ * Failure to read or write the cache is not an error.
+ * When the tailoring is loaded from the cache, parseError is cleared.
+ * @param rules A string describing the collation rules.
+ * @param rulesLength The length of rules, or -1 if null-terminated.
+ * @param normalizationMode UCOL_OFF, UCOL_ON, or UCOL_DEFAULT
+ * @param strength The default collation strength, or UCOL_DEFAULT
+ * @param cacheDir directory for the cache files, which must exist;
+ *                 if NULL or empty, then this is the same as ucol_openRules()
+ * @param parseError  A pointer to UParseError to recieve information about errors
+ *                    occurred during parsing.
+ * @param status A pointer to a UErrorCode to receive any errors
+ * @return A pointer to a UCollator.
+ * @see ucol_openRules
+ * @draft ICU 64
+ */
+U_DRAFT UCollator* U_EXPORT2
+ucol_openRulesWithCache(const UChar        *rules,
+                        int32_t            rulesLength,
+                        UColAttributeValue normalizationMode,
+                        UCollationStrength strength,
+                        const char         *cacheDir,
+                        UParseError        *parseError,
+                        UErrorCode         *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_DEPRECATED_API
 /** 
  * Open a collator defined by a short form string.
@@ -1019,6 +1051,129 @@ ucol_getSortKey(const    UCollator    *coll,
         uint8_t        *result,
         int32_t        resultLength);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Writes the sort keys for an array of strings back to back into one buffer.
+ * Each sort key is the same as from ucol_getSortKey(), including its terminating zero byte.
+ * This avoids the per-call setup cost of ucol_getSortKey() when building
+ * sort keys for many strings, for example for a sorted index.
+ *
+ * Sort keys are written in input order until one does not fit.
+ * The number of complete sort keys is returned; the buffer contents
+ * after the last complete key are undefined.
+ * The caller can continue with the remaining strings in another buffer.
+ * @param coll The UCollator containing the collation rules.
+ * @param src array of count input strings
+ * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+ *                can be NULL if all strings are NUL-terminated
+ * @param count number of input strings
+ * @param dest destination buffer; can be NULL if capacity=0
+ * @param capacity number of bytes that can be written to dest
+ * @param keyOffsets if not NULL, then this array of count+1 elements receives
+ *                   the start offset in dest of each complete sort key,
+ *                   followed by the end offset of the last one
+ *                   (keyOffsets[0..n] for n returned keys)
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return number n of sort keys written completely, 0<=n<=count
+ * @see ucol_getSortKey
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *src, const int32_t *lengths, int32_t count,
+                 uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                 UErrorCode *pErrorCode);
+
+/**
+ * Writes the sort keys for an array of UTF-8 strings back to back into one buffer.
+ * Same as ucol_getSortKeys(), and each sort key is the same as
+ * for the equivalent UTF-16 string.
+ * Ill-formed UTF-8 sequences are treated like U+FFFD, as in ucol_strcollUTF8().
+ * @param coll The UCollator containing the collation rules.
+ * @param src array of count UTF-8 input strings
+ * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+ *                can be NULL if all strings are NUL-terminated
+ * @param count number of input strings
+ * @param dest destination buffer; can be NULL if capacity=0
+ * @param capacity number of bytes that can be written to dest
+ * @param keyOffsets if not NULL, then this array of count+1 elements receives
+ *                   the start offset in dest of each complete sort key,
+ *                   followed by the end offset of the last one
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return number n of sort keys written completely, 0<=n<=count
+ * @see ucol_getSortKeys
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const *src, const int32_t *lengths, int32_t count,
+                     uint8_t *dest, int32_t capacity, int32_t *keyOffsets,
+                     UErrorCode *pErrorCode);
+
+/**
+ * Sorts an array of strings according to the collator.
+ * Generates each sort key once and sorts the keys with a radix sort,
+ * which is much faster for large arrays than sorting with ucol_strcoll() as the comparator.
+ * Strings that compare equal are ordered by code point order,
+ * and identical strings by their input index.
+ *
+ * If numThreads>1 and there are enough strings, then the sort keys are generated
+ * and the sort is performed by up to numThreads threads (including the calling thread),
+ * sharing the collator. The result is the same as with numThreads<=1.
+ * @param coll The UCollator containing the collation rules.
+ * @param src array of count input strings
+ * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+ *                can be NULL if all strings are NUL-terminated
+ * @param count number of input strings
+ * @param permutation array of count elements which receives the indexes of
+ *                    the input strings in sorted order
+ * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ *                   Set to U_UNSUPPORTED_ERROR if coll is not a RuleBasedCollator.
+ * @see ucol_getSortKeys
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar *const *src, const int32_t *lengths, int32_t count,
+                 int32_t *permutation, int32_t numThreads,
+                 UErrorCode *pErrorCode);
+
+/**
+ * Sorts an array of UTF-8 strings according to the collator.
+ * Same as ucol_sortStrings().
+ * Ill-formed UTF-8 sequences are treated like U+FFFD, as in ucol_strcollUTF8().
+ * @param coll The UCollator containing the collation rules.
+ * @param src array of count UTF-8 input strings
+ * @param lengths array of count string lengths, each -1 if that string is NUL-terminated;
+ *                can be NULL if all strings are NUL-terminated
+ * @param count number of input strings
+ * @param permutation array of count elements which receives the indexes of
+ *                    the input strings in sorted order
+ * @param numThreads maximum number of threads to use; 0 or 1 uses only the calling thread
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @see ucol_sortStrings
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char *const *src, const int32_t *lengths, int32_t count,
+                     int32_t *permutation, int32_t numThreads,
+                     UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /** Gets the next count bytes of a sort key. Caller needs
  *  to preserve state array between calls and to provide
@@ -1334,6 +1489,34 @@ ucol_safeClone(const UCollator *coll,
                int32_t         *pBufferSize,
                UErrorCode      *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Clones a collator and sets attributes on the clone.
+ * The result is the same as from ucol_safeClone() followed by ucol_setAttribute() calls,
+ * but when the collator does not have custom reordering or a custom variable top,
+ * then the clone shares an immutable settings object for the resulting attribute values
+ * with all other clones of the same tailoring.
+ * This makes it cheap to create many collators with different attributes,
+ * for example one per thread and per comparison strength.
+ *
+ * @param coll collator to be cloned
+ * @param attributes array of length attributes to set
+ * @param values array of length values, one per attribute; UCOL_DEFAULT is allowed
+ * @param length number of attributes
+ * @param status to indicate whether the operation went on smoothly or there were errors
+ * @return pointer to the new clone, to be closed with ucol_close()
+ * @see ucol_safeClone
+ * @see ucol_setAttribute
+ * @draft ICU 64
+ */
+U_DRAFT UCollator* U_EXPORT2
+ucol_cloneWithAttributes(const UCollator *coll,
+                         const UColAttribute *attributes,
+                         const UColAttributeValue *values,
+                         int32_t length,
+                         UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_DEPRECATED_API
 
 /** default memory size for the new clone.
@@ -115,6 +115,29 @@ ucol_openElements(const UCollator  *coll,
                         int32_t    textLength,
                         UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Open the collation elements for a UTF-8 string.
+ * The text is copied. Ill-formed UTF-8 sequences are treated like U+FFFD,
+ * as in ucol_strcollUTF8().
+ * All offsets (ucol_getOffset(), ucol_setOffset(), ucol_nextCEs())
+ * are UTF-8 byte offsets.
+ *
+ * @param coll The collator containing the desired collation rules.
+ * @param text The UTF-8 text to iterate over.
+ * @param textLength The number of bytes in text, or -1 if null-terminated
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return a struct containing collation element information
+ * @see ucol_openElements
+ * @draft ICU 64
+ */
+U_DRAFT UCollationElements* U_EXPORT2
+ucol_openElementsUTF8(const UCollator  *coll,
+                      const char       *text,
+                            int32_t    textLength,
+                            UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /**
  * get a hash code for a key... Not very useful!
@@ -159,6 +182,38 @@ ucol_reset(UCollationElements *elems);
 U_STABLE int32_t U_EXPORT2 
 ucol_next(UCollationElements *elems, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Get the next collation elements in the text, up to capacity of them,
+ * as native 64-bit CEs: the primary weight in the upper 32 bits,
+ * the secondary and tertiary weights (including case bits) in the lower 32 bits.
+ * This is equivalent to calling ucol_next() in a loop and combining
+ * the 32-bit collation element halves, but much faster.
+ *
+ * If offsets is not NULL, then offsets[i] is set to the source text offset
+ * after ces[i], that is, what ucol_getOffset() would return after ucol_next()
+ * returned (the first half of) that CE. The text for ces[i] starts at offsets[i-1]
+ * (or at the offset before the call, for i=0);
+ * CEs from the same expansion or normalized text segment share their offsets.
+ *
+ * @param elems The UCollationElements containing the text.
+ * @param ces The array to be filled with CEs.
+ * @param capacity The number of elements in ces and offsets.
+ * @param offsets NULL, or the array to be filled with source offsets.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ *               U_INVALID_STATE_ERROR is set after ucol_previous()
+ *               without ucol_reset() or ucol_setOffset().
+ * @return The number of CEs written; less than capacity only at the end of the text
+ *         or on error.
+ * @see ucol_next
+ * @draft ICU 64
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_nextCEs(UCollationElements *elems,
+             int64_t *ces, int32_t capacity, int32_t *offsets,
+             UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Get the ordering priority of the previous collation element in the text.
  * A single character may contain more than one collation element.
@@ -207,6 +262,23 @@ ucol_setText(      UCollationElements *elems,
                    int32_t            textLength,
                    UErrorCode         *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Set the UTF-8 text containing the collation elements.
+ * Same as ucol_setText() otherwise; see ucol_openElementsUTF8().
+ * @param elems The UCollationElements to set.
+ * @param text The UTF-8 source text containing the collation elements.
+ * @param textLength The length of text in bytes, or -1 if null-terminated.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_openElementsUTF8
+ * @draft ICU 64
+ */
+U_DRAFT void U_EXPORT2
+ucol_setTextUTF8(UCollationElements *elems,
+                 const char *text, int32_t textLength,
+                 UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Get the offset of the current source character.
  * This is an offset into the text of the character containing the current
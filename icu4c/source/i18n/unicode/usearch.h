@@ -189,13 +189,29 @@ typedef enum {
      * @stable ICU 4.4
      */
     USEARCH_ELEMENT_COMPARISON = 2,
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Option to use the skip-search engine for forward searching.
+     * Before the regular matcher is run, the text is scanned for characters
+     * whose collation elements have primary weights that do not occur in the pattern;
+     * no match can contain such a character, so the matcher only runs
+     * on the stretches of text between them that are long enough for a match.
+     * This is much faster when matches are rare,
+     * and the results are the same as with the regular engine.
+     * It has no effect on backward searching, and it is only used with
+     * USEARCH_STANDARD_ELEMENT_COMPARISON.
+     * The default value is USEARCH_OFF; the other value is USEARCH_ON.
+     * @draft ICU 64
+     */
+    USEARCH_SKIP_SEARCH = 3,
+#endif  /* U_HIDE_DRAFT_API */
 
 #ifndef U_HIDE_DEPRECATED_API
     /**
      * One more than the highest normal USearchAttribute value.
      * @deprecated ICU 58 The numeric value may change over time, see ICU ticket #12420.
      */
-    USEARCH_ATTRIBUTE_COUNT = 3
+    USEARCH_ATTRIBUTE_COUNT = 4
 #endif  /* U_HIDE_DEPRECATED_API */
 } USearchAttribute;
 
@@ -552,6 +568,34 @@ U_STABLE void U_EXPORT2 usearch_setText(      UStringSearch *strsrch,
                                             int32_t        textlength,
                                             UErrorCode    *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+* Set UTF-8 text to be searched. Text iteration will hence begin at the
+* start of the text. The text is converted to UTF-16 for searching,
+* and ill-formed sequences are treated like U+FFFD.
+* <p>
+* While this text is set, all offsets that are passed into and returned by the
+* other usearch functions, including match starts and lengths, are
+* byte offsets into the UTF-8 text.
+* usearch_getText() returns the converted UTF-16 text.
+* The text is not copied, and it must remain valid until
+* other text is set or the search is closed.
+* @param strsrch search iterator data struct
+* @param text new UTF-8 string to look for match
+* @param textLength length of the new string in bytes, -1 for NUL-termination
+* @param status for errors if it occurs. If text is NULL, or textLength is 0
+*               or too large for a UTF-16 copy of the text,
+*               then an U_ILLEGAL_ARGUMENT_ERROR is returned with no change
+*               done to strsrch.
+* @see #usearch_setText
+* @draft ICU 64
+*/
+U_DRAFT void U_EXPORT2 usearch_setTextUTF8(UStringSearch *strsrch,
+                                           const char    *text,
+                                           int32_t        textLength,
+                                           UErrorCode    *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
 * Return the string text to be searched.
 * @param strsrch search iterator data struct
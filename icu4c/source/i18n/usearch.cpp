@@ -17,12 +17,18 @@
 #include "unicode/ustring.h"
 #include "unicode/uchar.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
+#include "unicode/tblcoll.h"
+#include "unicode/uniset.h"
+#include "unicode/usetiter.h"
 #include "normalizer2impl.h"
 #include "usrchimp.h"
 #include "cmemory.h"
+#include "cstring.h"
 #include "ucln_in.h"
 #include "uassert.h"
 #include "ustr_imp.h"
+#include "uvectr64.h"
 
 U_NAMESPACE_USE
 
@@ -38,6 +44,55 @@ U_NAMESPACE_USE
 
 static const Normalizer2Impl *g_nfcImpl = NULL;
 
+/*
+ * Character classes for the skip search, indexed by BMP code unit.
+ * A "blocker" has a collation element with a primary weight that does not occur
+ * in the pattern, so no match can contain it.
+ * Characters whose CEs may depend on their neighbors (contractions, prefixes, non-FCD text)
+ * are never blockers.
+ * For non-blockers, the class is SKIP_CLASS_COUNT_BASE plus an upper bound for
+ * the number of processed CEs that the character contributes,
+ * or SKIP_CLASS_COMPLEX if there is no such bound
+ * (supplementary code points, numeric collation, very long expansions).
+ */
+enum {
+    SKIP_CLASS_UNKNOWN = 0,
+    SKIP_CLASS_COMPLEX = 1,
+    SKIP_CLASS_BLOCKER = 2,
+    SKIP_CLASS_COUNT_BASE = 3
+};
+
+struct USearchSkipTable : public UMemory {
+    USearchSkipTable() : collator(NULL), numeric(FALSE) {
+        uprv_memset(contextCounts, 0, sizeof(contextCounts));
+        resetPattern();
+    }
+
+    /** Forgets the data that depends on the pattern. */
+    void resetPattern() {
+        hasPattern = FALSE;
+        uprv_memset(primaries, 0, sizeof(primaries));
+        uprv_memset(classes, 0, sizeof(classes));
+    }
+
+    UBool hasPrimary(uint32_t p) const {
+        return (primaries[p >> 5] & ((uint32_t)1 << (p & 0x1f))) != 0;
+    }
+
+    const RuleBasedCollator *collator;
+    UBool numeric;
+    // all code points of contraction and prefix strings
+    UnicodeSet contextChars;
+    // for each code unit in contextChars, the largest number of CEs
+    // of a contraction or prefix string that contains it
+    uint8_t contextCounts[0x10000];
+    UBool hasPattern;
+    // bit set of the 16-bit primary weights in the pattern's processed CEs
+    uint32_t primaries[0x10000 / 32];
+    // SKIP_CLASS_... values, computed on demand
+    uint8_t classes[0x10000];
+};
+
 // internal methods -------------------------------------------------
 
 /**
@@ -463,6 +518,9 @@ inline int16_t initializePattern(UStringSearch *strsrch, UErrorCode *status)
 
         strsrch->pattern.pces = NULL;
     }
+    if (strsrch->skipTable != NULL && strsrch->skipTable->hasPattern) {
+        strsrch->skipTable->resetPattern();
+    }
 
     // since intializePattern is an internal method status is a success.
     return initializePatternCETable(strsrch, status);
@@ -2712,6 +2770,11 @@ U_CAPI UStringSearch * U_EXPORT2 usearch_openFromCollator(
         result->pattern.textLength = patternlength;
         result->pattern.ces         = NULL;
         result->pattern.pces        = NULL;
+        result->skipTable           = NULL;
+        result->utf8Text            = NULL;
+        result->utf8Length          = 0;
+        result->utf16Text           = NULL;
+        result->utf8Checkpoints     = NULL;
 
         result->search->breakIter  = breakiter;
 #if !UCONFIG_NO_BREAK_ITERATION
@@ -2736,6 +2799,7 @@ U_CAPI UStringSearch * U_EXPORT2 usearch_openFromCollator(
         result->search->isOverlap          = FALSE;
         result->search->isCanonicalMatch   = FALSE;
         result->search->elementComparisonType = 0;
+        result->search->isSkipSearch       = FALSE;
         result->search->isForwardSearching = TRUE;
         result->search->reset              = TRUE;
 
@@ -2764,6 +2828,9 @@ U_CAPI void U_EXPORT2 usearch_close(UStringSearch *strsrch)
             uprv_free(strsrch->pattern.pces);
         }
 
+        delete strsrch->skipTable;
+        uprv_free(strsrch->utf16Text);
+        uprv_free(strsrch->utf8Checkpoints);
         delete strsrch->textProcessedIter;
         ucol_closeElements(strsrch->textIter);
         ucol_closeElements(strsrch->utilIter);
@@ -2801,11 +2868,90 @@ UBool initTextProcessedIter(UStringSearch *strsrch, UErrorCode *status) {
 
 }
 
+// UTF-8 text -------------------------------------------------------------
+
+/*
+ * Returns the UTF-16 index of the code point that contains
+ * UTF-16 index k*USEARCH_UTF8_CHECKPOINT_INTERVAL.
+ * Its UTF-8 index is utf8Checkpoints[k].
+ */
+static inline int32_t getCheckpointUTF16Index(const UStringSearch *strsrch, int32_t k)
+{
+    int32_t index = k * USEARCH_UTF8_CHECKPOINT_INTERVAL;
+    // The converted text has no unpaired surrogates.
+    if (index < strsrch->search->textLength && U16_IS_TRAIL(strsrch->utf16Text[index])) {
+        --index;
+    }
+    return index;
+}
+
+/*
+ * Maps a UTF-16 index into the search text to the caller's text.
+ * Passes through USEARCH_DONE.
+ */
+static int32_t toExternalIndex(const UStringSearch *strsrch, int32_t index)
+{
+    if (strsrch->utf8Text == NULL || index < 0) {
+        return index;
+    }
+    int32_t k = index / USEARCH_UTF8_CHECKPOINT_INTERVAL;
+    int32_t i16 = getCheckpointUTF16Index(strsrch, k);
+    int32_t i8 = strsrch->utf8Checkpoints[k];
+    const uint8_t *s = (const uint8_t *)strsrch->utf8Text;
+    int32_t length = strsrch->utf8Length;
+    while (i16 < index && i8 < length) {
+        UChar32 c;
+        U8_NEXT_OR_FFFD(s, i8, length, c);
+        i16 += U16_LENGTH(c);
+    }
+    return i8;
+}
+
+/*
+ * Maps an index into the caller's text to a UTF-16 index into the search text.
+ * A UTF-8 index inside of a character maps to the start of that character.
+ * @return the UTF-16 index, or -1 if the index is out of bounds
+ */
+static int32_t toInternalIndex(const UStringSearch *strsrch, int32_t index)
+{
+    if (strsrch->utf8Text == NULL) {
+        return index;
+    }
+    int32_t length = strsrch->utf8Length;
+    if (index < 0 || index > length) {
+        return -1;
+    }
+    // Binary search for the last checkpoint at or before the index.
+    const int32_t *checkpoints = strsrch->utf8Checkpoints;
+    int32_t start = 0;
+    int32_t limit = strsrch->search->textLength / USEARCH_UTF8_CHECKPOINT_INTERVAL + 1;
+    while ((limit - start) > 1) {
+        int32_t mid = (start + limit) / 2;
+        if (checkpoints[mid] <= index) {
+            start = mid;
+        } else {
+            limit = mid;
+        }
+    }
+    int32_t i16 = getCheckpointUTF16Index(strsrch, start);
+    int32_t i8 = checkpoints[start];
+    const uint8_t *s = (const uint8_t *)strsrch->utf8Text;
+    while (i8 < index) {
+        UChar32 c;
+        U8_NEXT_OR_FFFD(s, i8, length, c);
+        if (i8 > index) {
+            break;
+        }
+        i16 += U16_LENGTH(c);
+    }
+    return i16;
+}
+
 // set and get methods --------------------------------------------------
 
-U_CAPI void U_EXPORT2 usearch_setOffset(UStringSearch *strsrch,
-                                        int32_t    position,
-                                        UErrorCode    *status)
+static void setOffset16(UStringSearch *strsrch,
+                        int32_t    position,
+                        UErrorCode    *status)
 {
     if (U_SUCCESS(*status) && strsrch) {
         if (isOutOfBounds(strsrch->search->textLength, position)) {
@@ -2820,7 +2966,7 @@ U_CAPI void U_EXPORT2 usearch_setOffset(UStringSearch *strsrch,
     }
 }
 
-U_CAPI int32_t U_EXPORT2 usearch_getOffset(const UStringSearch *strsrch)
+static int32_t getOffset16(const UStringSearch *strsrch)
 {
     if (strsrch) {
         int32_t result = ucol_getOffset(strsrch->textIter);
@@ -2832,6 +2978,23 @@ U_CAPI int32_t U_EXPORT2 usearch_getOffset(const UStringSearch *strsrch)
     return USEARCH_DONE;
 }
 
+U_CAPI void U_EXPORT2 usearch_setOffset(UStringSearch *strsrch,
+                                        int32_t    position,
+                                        UErrorCode    *status)
+{
+    if (U_SUCCESS(*status) && strsrch) {
+        setOffset16(strsrch, toInternalIndex(strsrch, position), status);
+    }
+}
+
+U_CAPI int32_t U_EXPORT2 usearch_getOffset(const UStringSearch *strsrch)
+{
+    if (strsrch) {
+        return toExternalIndex(strsrch, getOffset16(strsrch));
+    }
+    return USEARCH_DONE;
+}
+
 U_CAPI void U_EXPORT2 usearch_setAttribute(UStringSearch *strsrch,
                                  USearchAttribute attribute,
                                  USearchAttributeValue value,
@@ -2854,6 +3017,9 @@ U_CAPI void U_EXPORT2 usearch_setAttribute(UStringSearch *strsrch,
                 strsrch->search->elementComparisonType = 0;
             }
             break;
+        case USEARCH_SKIP_SEARCH :
+            strsrch->search->isSkipSearch = (value == USEARCH_ON ? TRUE : FALSE);
+            break;
         case USEARCH_ATTRIBUTE_COUNT :
         default:
             *status = U_ILLEGAL_ARGUMENT_ERROR;
@@ -2885,6 +3051,9 @@ U_CAPI USearchAttributeValue U_EXPORT2 usearch_getAttribute(
                     return USEARCH_STANDARD_ELEMENT_COMPARISON;
                 }
             }
+        case USEARCH_SKIP_SEARCH :
+            return (strsrch->search->isSkipSearch == TRUE ? USEARCH_ON :
+                                                           USEARCH_OFF);
         case USEARCH_ATTRIBUTE_COUNT :
             return USEARCH_DEFAULT;
         }
@@ -2898,7 +3067,7 @@ U_CAPI int32_t U_EXPORT2 usearch_getMatchedStart(
     if (strsrch == NULL) {
         return USEARCH_DONE;
     }
-    return strsrch->search->matchedIndex;
+    return toExternalIndex(strsrch, strsrch->search->matchedIndex);
 }
 
 
@@ -2938,6 +3107,11 @@ U_CAPI int32_t U_EXPORT2 usearch_getMatchedLength(
                                               const UStringSearch *strsrch)
 {
     if (strsrch) {
+        int32_t start = strsrch->search->matchedIndex;
+        if (strsrch->utf8Text != NULL && start != USEARCH_DONE) {
+            return toExternalIndex(strsrch, start + strsrch->search->matchedLength) -
+                toExternalIndex(strsrch, start);
+        }
         return strsrch->search->matchedLength;
     }
     return USEARCH_DONE;
@@ -2969,6 +3143,36 @@ usearch_getBreakIterator(const UStringSearch *strsrch)
 
 #endif
 
+static void setUTF16Text(      UStringSearch *strsrch,
+                         const UChar         *text,
+                               int32_t        textlength,
+                               UErrorCode    *status)
+{
+    strsrch->search->text       = text;
+    strsrch->search->textLength = textlength;
+    ucol_setText(strsrch->textIter, text, textlength, status);
+    strsrch->search->matchedIndex  = USEARCH_DONE;
+    strsrch->search->matchedLength = 0;
+    strsrch->search->reset         = TRUE;
+#if !UCONFIG_NO_BREAK_ITERATION
+    if (strsrch->search->breakIter != NULL) {
+        ubrk_setText(strsrch->search->breakIter, text,
+                     textlength, status);
+    }
+    ubrk_setText(strsrch->search->internalBreakIter, text, textlength, status);
+#endif
+}
+
+static void releaseUTF8Text(UStringSearch *strsrch)
+{
+    uprv_free(strsrch->utf16Text);
+    uprv_free(strsrch->utf8Checkpoints);
+    strsrch->utf8Text        = NULL;
+    strsrch->utf8Length      = 0;
+    strsrch->utf16Text       = NULL;
+    strsrch->utf8Checkpoints = NULL;
+}
+
 U_CAPI void U_EXPORT2 usearch_setText(      UStringSearch *strsrch,
                                       const UChar         *text,
                                             int32_t        textlength,
@@ -2983,21 +3187,84 @@ U_CAPI void U_EXPORT2 usearch_setText(      UStringSearch *strsrch,
             if (textlength == -1) {
                 textlength = u_strlen(text);
             }
-            strsrch->search->text       = text;
-            strsrch->search->textLength = textlength;
-            ucol_setText(strsrch->textIter, text, textlength, status);
-            strsrch->search->matchedIndex  = USEARCH_DONE;
-            strsrch->search->matchedLength = 0;
-            strsrch->search->reset         = TRUE;
-#if !UCONFIG_NO_BREAK_ITERATION
-            if (strsrch->search->breakIter != NULL) {
-                ubrk_setText(strsrch->search->breakIter, text,
-                             textlength, status);
+            setUTF16Text(strsrch, text, textlength, status);
+            releaseUTF8Text(strsrch);
+        }
+    }
+}
+
+U_CAPI void U_EXPORT2 usearch_setTextUTF8(UStringSearch *strsrch,
+                                          const char    *text,
+                                          int32_t        textLength,
+                                          UErrorCode    *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    if (strsrch == NULL || text == NULL || textLength < -1 || textLength == 0) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if (textLength == -1) {
+        textLength = (int32_t)uprv_strlen(text);
+    }
+    // The UTF-16 buffer size in bytes must fit into an int32_t.
+    if (textLength >= INT32_MAX / U_SIZEOF_UCHAR - 1) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // The UTF-16 text has at most as many code units as the UTF-8 text has bytes.
+    UChar *dest = (UChar *)uprv_malloc((textLength + 1) * U_SIZEOF_UCHAR);
+    int32_t *checkpoints = (int32_t *)uprv_malloc(
+        (textLength / USEARCH_UTF8_CHECKPOINT_INTERVAL + 1) * sizeof(int32_t));
+    if (dest == NULL || checkpoints == NULL) {
+        uprv_free(dest);
+        uprv_free(checkpoints);
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    const uint8_t *s = (const uint8_t *)text;
+    int32_t i = 0;
+    int32_t j = 0;
+    while (i < textLength) {
+        if ((j % USEARCH_UTF8_CHECKPOINT_INTERVAL) == 0) {
+            checkpoints[j / USEARCH_UTF8_CHECKPOINT_INTERVAL] = i;
+        }
+        // Copy ASCII up to the next checkpoint.
+        int32_t asciiLimit = i + (USEARCH_UTF8_CHECKPOINT_INTERVAL - j % USEARCH_UTF8_CHECKPOINT_INTERVAL);
+        if (asciiLimit > textLength) {
+            asciiLimit = textLength;
+        }
+        while (i < asciiLimit && U8_IS_SINGLE(s[i])) {
+            dest[j++] = s[i++];
+        }
+        if (i == asciiLimit) {
+            continue;
+        }
+        int32_t start = i;
+        UChar32 c;
+        U8_NEXT_OR_FFFD(s, i, textLength, c);
+        if (c <= 0xffff) {
+            dest[j++] = (UChar)c;
+        } else {
+            dest[j++] = U16_LEAD(c);
+            if ((j % USEARCH_UTF8_CHECKPOINT_INTERVAL) == 0) {
+                checkpoints[j / USEARCH_UTF8_CHECKPOINT_INTERVAL] = start;
             }
-            ubrk_setText(strsrch->search->internalBreakIter, text, textlength, status);
-#endif
+            dest[j++] = U16_TRAIL(c);
         }
     }
+    if ((j % USEARCH_UTF8_CHECKPOINT_INTERVAL) == 0) {
+        checkpoints[j / USEARCH_UTF8_CHECKPOINT_INTERVAL] = textLength;
+    }
+    dest[j] = 0;
+
+    setUTF16Text(strsrch, dest, j, status);
+    releaseUTF8Text(strsrch);
+    strsrch->utf8Text        = text;
+    strsrch->utf8Length      = textLength;
+    strsrch->utf16Text       = dest;
+    strsrch->utf8Checkpoints = checkpoints;
 }
 
 U_CAPI const UChar * U_EXPORT2 usearch_getText(const UStringSearch *strsrch,
@@ -3026,6 +3293,8 @@ U_CAPI void U_EXPORT2 usearch_setCollator(      UStringSearch *strsrch,
             ucol_closeElements(strsrch->textIter);
             ucol_closeElements(strsrch->utilIter);
             strsrch->textIter = strsrch->utilIter = NULL;
+            delete strsrch->skipTable;
+            strsrch->skipTable = NULL;
             if (strsrch->ownCollator && (strsrch->collator != collator)) {
                 ucol_close((UCollator *)strsrch->collator);
                 strsrch->ownCollator = FALSE;
@@ -3109,14 +3378,17 @@ usearch_getPattern(const UStringSearch *strsrch,
 
 // miscellanous methods --------------------------------------------------
 
+static int32_t next16(UStringSearch *strsrch, UErrorCode *status);
+static int32_t previous16(UStringSearch *strsrch, UErrorCode *status);
+
 U_CAPI int32_t U_EXPORT2 usearch_first(UStringSearch *strsrch,
                                            UErrorCode    *status)
 {
     if (strsrch && U_SUCCESS(*status)) {
         strsrch->search->isForwardSearching = TRUE;
-        usearch_setOffset(strsrch, 0, status);
+        setOffset16(strsrch, 0, status);
         if (U_SUCCESS(*status)) {
-            return usearch_next(strsrch, status);
+            return toExternalIndex(strsrch, next16(strsrch, status));
         }
     }
     return USEARCH_DONE;
@@ -3128,10 +3400,10 @@ U_CAPI int32_t U_EXPORT2 usearch_following(UStringSearch *strsrch,
 {
     if (strsrch && U_SUCCESS(*status)) {
         strsrch->search->isForwardSearching = TRUE;
-        // position checked in usearch_setOffset
-        usearch_setOffset(strsrch, position, status);
+        // position checked in setOffset16
+        setOffset16(strsrch, toInternalIndex(strsrch, position), status);
         if (U_SUCCESS(*status)) {
-            return usearch_next(strsrch, status);
+            return toExternalIndex(strsrch, next16(strsrch, status));
         }
     }
     return USEARCH_DONE;
@@ -3142,9 +3414,9 @@ U_CAPI int32_t U_EXPORT2 usearch_last(UStringSearch *strsrch,
 {
     if (strsrch && U_SUCCESS(*status)) {
         strsrch->search->isForwardSearching = FALSE;
-        usearch_setOffset(strsrch, strsrch->search->textLength, status);
+        setOffset16(strsrch, strsrch->search->textLength, status);
         if (U_SUCCESS(*status)) {
-            return usearch_previous(strsrch, status);
+            return toExternalIndex(strsrch, previous16(strsrch, status));
         }
     }
     return USEARCH_DONE;
@@ -3156,10 +3428,10 @@ U_CAPI int32_t U_EXPORT2 usearch_preceding(UStringSearch *strsrch,
 {
     if (strsrch && U_SUCCESS(*status)) {
         strsrch->search->isForwardSearching = FALSE;
-        // position checked in usearch_setOffset
-        usearch_setOffset(strsrch, position, status);
+        // position checked in setOffset16
+        setOffset16(strsrch, toInternalIndex(strsrch, position), status);
         if (U_SUCCESS(*status)) {
-            return usearch_previous(strsrch, status);
+            return toExternalIndex(strsrch, previous16(strsrch, status));
         }
     }
     return USEARCH_DONE;
@@ -3187,13 +3459,13 @@ U_CAPI int32_t U_EXPORT2 usearch_preceding(UStringSearch *strsrch,
 * iterator. Callers of this API would have to set the offset in the collation
 * element iterator before using this method.
 */
-U_CAPI int32_t U_EXPORT2 usearch_next(UStringSearch *strsrch,
-                                          UErrorCode    *status)
+static int32_t next16(UStringSearch *strsrch,
+                      UErrorCode    *status)
 {
     if (U_SUCCESS(*status) && strsrch) {
         // note offset is either equivalent to the start of the previous match
         // or is set by the user
-        int32_t      offset       = usearch_getOffset(strsrch);
+        int32_t      offset       = getOffset16(strsrch);
         USearch     *search       = strsrch->search;
         search->reset             = FALSE;
         int32_t      textlength   = search->textLength;
@@ -3295,8 +3567,8 @@ U_CAPI int32_t U_EXPORT2 usearch_next(UStringSearch *strsrch,
     return USEARCH_DONE;
 }
 
-U_CAPI int32_t U_EXPORT2 usearch_previous(UStringSearch *strsrch,
-                                              UErrorCode *status)
+static int32_t previous16(UStringSearch *strsrch,
+                          UErrorCode *status)
 {
     if (U_SUCCESS(*status) && strsrch) {
         int32_t offset;
@@ -3308,7 +3580,7 @@ U_CAPI int32_t U_EXPORT2 usearch_previous(UStringSearch *strsrch,
             setColEIterOffset(strsrch->textIter, offset);
         }
         else {
-            offset = usearch_getOffset(strsrch);
+            offset = getOffset16(strsrch);
         }
 
         int32_t matchedindex = search->matchedIndex;
@@ -3383,6 +3655,24 @@ U_CAPI int32_t U_EXPORT2 usearch_previous(UStringSearch *strsrch,
 
 
 
+U_CAPI int32_t U_EXPORT2 usearch_next(UStringSearch *strsrch,
+                                          UErrorCode    *status)
+{
+    if (strsrch) {
+        return toExternalIndex(strsrch, next16(strsrch, status));
+    }
+    return USEARCH_DONE;
+}
+
+U_CAPI int32_t U_EXPORT2 usearch_previous(UStringSearch *strsrch,
+                                              UErrorCode *status)
+{
+    if (strsrch) {
+        return toExternalIndex(strsrch, previous16(strsrch, status));
+    }
+    return USEARCH_DONE;
+}
+
 U_CAPI void U_EXPORT2 usearch_reset(UStringSearch *strsrch)
 {
     /*
@@ -3428,6 +3718,9 @@ U_CAPI void U_EXPORT2 usearch_reset(UStringSearch *strsrch)
         if (!sameCollAttribute) {
             initialize(strsrch, &status);
         }
+        // the skip table also depends on collator attributes that are not checked above
+        delete strsrch->skipTable;
+        strsrch->skipTable = NULL;
         ucol_setText(strsrch->textIter, strsrch->search->text,
                               strsrch->search->textLength,
                               &status);
@@ -3436,6 +3729,7 @@ U_CAPI void U_EXPORT2 usearch_reset(UStringSearch *strsrch)
         strsrch->search->isOverlap          = FALSE;
         strsrch->search->isCanonicalMatch   = FALSE;
         strsrch->search->elementComparisonType = 0;
+        strsrch->search->isSkipSearch       = FALSE;
         strsrch->search->isForwardSearching = TRUE;
         strsrch->search->reset              = TRUE;
     }
@@ -3833,43 +4127,18 @@ UChar32 codePointBefore(const USearch &search, int32_t index) {
 
 }  // namespace
 
-U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
-                                       int32_t        startIdx,
-                                       int32_t        *matchStart,
-                                       int32_t        *matchLimit,
-                                       UErrorCode     *status)
+/*
+ * Forward search for the first match that starts at or after startIdx
+ * and before limitIdx. Text after limitIdx is still examined for the end of a match.
+ * The input parameters must have been checked.
+ */
+static UBool searchForward(UStringSearch  *strsrch,
+                           int32_t        startIdx,
+                           int32_t        limitIdx,
+                           int32_t        *matchStart,
+                           int32_t        *matchLimit,
+                           UErrorCode     *status)
 {
-    if (U_FAILURE(*status)) {
-        return FALSE;
-    }
-
-    // TODO:  reject search patterns beginning with a combining char.
-
-#ifdef USEARCH_DEBUG
-    if (getenv("USEARCH_DEBUG") != NULL) {
-        printf("Pattern CEs\n");
-        for (int ii=0; ii<strsrch->pattern.cesLength; ii++) {
-            printf(" %8x", strsrch->pattern.ces[ii]);
-        }
-        printf("\n");
-    }
-
-#endif
-    // Input parameter sanity check.
-    //  TODO:  should input indicies clip to the text length
-    //         in the same way that UText does.
-    if(strsrch->pattern.cesLength == 0         ||
-       startIdx < 0                           ||
-       startIdx > strsrch->search->textLength ||
-       strsrch->pattern.ces == NULL) {
-           *status = U_ILLEGAL_ARGUMENT_ERROR;
-           return FALSE;
-    }
-
-    if (strsrch->pattern.pces == NULL) {
-        initializePatternPCETable(strsrch, status);
-    }
-
     ucol_setOffset(strsrch->textIter, startIdx, status);
     CEIBuffer ceb(strsrch, status);
 
@@ -3916,6 +4185,11 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
             found = FALSE;
             break;
         }
+        if (firstCEI->lowIndex >= limitIdx) {
+            // Matches that start at or after the limit are not wanted.
+            found = FALSE;
+            break;
+        }
         
         for (patIx=0; patIx<strsrch->pattern.pcesLength; patIx++) {
             patCE = strsrch->pattern.pces[patIx];
@@ -4133,6 +4407,307 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
     return found;
 }
 
+U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
+                                       int32_t        startIdx,
+                                       int32_t        *matchStart,
+                                       int32_t        *matchLimit,
+                                       UErrorCode     *status)
+{
+    if (U_FAILURE(*status)) {
+        return FALSE;
+    }
+
+    // TODO:  reject search patterns beginning with a combining char.
+
+#ifdef USEARCH_DEBUG
+    if (getenv("USEARCH_DEBUG") != NULL) {
+        printf("Pattern CEs\n");
+        for (int ii=0; ii<strsrch->pattern.cesLength; ii++) {
+            printf(" %8x", strsrch->pattern.ces[ii]);
+        }
+        printf("\n");
+    }
+
+#endif
+    // Input parameter sanity check.
+    //  TODO:  should input indicies clip to the text length
+    //         in the same way that UText does.
+    if(strsrch->pattern.cesLength == 0         ||
+       startIdx < 0                           ||
+       startIdx > strsrch->search->textLength ||
+       strsrch->pattern.ces == NULL) {
+           *status = U_ILLEGAL_ARGUMENT_ERROR;
+           return FALSE;
+    }
+
+    if (strsrch->pattern.pces == NULL) {
+        initializePatternPCETable(strsrch, status);
+    }
+
+    return searchForward(strsrch, startIdx, INT32_MAX, matchStart, matchLimit, status);
+}
+
+// skip search ------------------------------------------------------------
+
+// Same as in coleitr.cpp: how a 64-bit CE is split into 32-bit CEs.
+static inline uint32_t getFirstHalf(uint32_t p, uint32_t lower32) {
+    return (p & 0xffff0000) | ((lower32 >> 16) & 0xff00) | ((lower32 >> 8) & 0xff);
+}
+
+static inline uint32_t getSecondHalf(uint32_t p, uint32_t lower32) {
+    return (p << 16) | ((lower32 >> 8) & 0xff00) | (lower32 & 0x3f);
+}
+
+/*
+ * Returns the number of 32-bit CEs that a CollationElementIterator returns for the string.
+ * If isBlocker is not NULL, then it is set to TRUE if one of the CEs
+ * has a primary weight that does not occur in the pattern.
+ */
+static int32_t getSkipCount(const UStringSearch *strsrch, const USearchSkipTable &table,
+                            const UnicodeString &s, UBool *isBlocker, UErrorCode *status)
+{
+    UVector64 ces(*status);
+    table.collator->internalGetCEs(s, ces, *status);
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    // Mirror CollationElementIterator and UCollationPCE::processCE():
+    // a half with a non-zero primary weight is either shifted (primary becomes 0)
+    // or keeps the top 16 bits of its primary.
+    int32_t count = 0;
+    UBool isForeign = FALSE;
+    UBool endsShifted = FALSE;
+    for (int32_t i = 0; i < ces.size(); ++i) {
+        int64_t ce = ces.elementAti(i);
+        uint32_t p = (uint32_t)(ce >> 32);
+        uint32_t lower32 = (uint32_t)ce;
+        uint32_t halves[2] = { getFirstHalf(p, lower32), getSecondHalf(p, lower32) };
+        if (halves[1] != 0) {
+            halves[1] |= 0xc0;  // continuation CE
+        }
+        for (int32_t j = 0; j < 2; ++j) {
+            uint32_t half = halves[j];
+            if (half == 0) {
+                continue;
+            }
+            ++count;
+            uint32_t primary = half >> 16;
+            if (primary != 0) {
+                if (strsrch->toShift && strsrch->variableTop > half) {
+                    endsShifted = TRUE;
+                } else {
+                    endsShifted = FALSE;
+                    if (!table.hasPrimary(primary)) {
+                        isForeign = TRUE;
+                    }
+                }
+            }
+        }
+    }
+    if (isBlocker != NULL) {
+        // After a shifted CE, the following primary-ignorable CEs are ignored,
+        // so the search could not restart right after such a character
+        // with the same CEs as when iterating over it.
+        *isBlocker = isForeign && !endsShifted;
+    }
+    return count;
+}
+
+/*
+ * Returns the skip table for the current pattern and collator,
+ * or NULL if the collator is not a RuleBasedCollator.
+ * The pattern PCEs must have been initialized.
+ */
+static USearchSkipTable *getSkipTable(UStringSearch *strsrch, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    USearchSkipTable *table = strsrch->skipTable;
+    if (table == NULL) {
+        const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(strsrch->collator);
+        if (rbc == NULL) {
+            return NULL;
+        }
+        LocalPointer<USearchSkipTable> newTable(new USearchSkipTable(), *status);
+        if (U_FAILURE(*status)) {
+            return NULL;
+        }
+        newTable->collator = rbc;
+        newTable->numeric = rbc->getAttribute(UCOL_NUMERIC_COLLATION, *status) == UCOL_ON;
+        UnicodeSet contractions;
+        rbc->internalGetContractionsAndExpansions(&contractions, NULL, TRUE, *status);
+        UnicodeSetIterator iter(contractions);
+        while (iter.next()) {
+            const UnicodeString &str = iter.getString();  // also for a single code point
+            int32_t count = getSkipCount(strsrch, *newTable, str, NULL, status);
+            if (count > 0xff) {
+                count = 0xff;
+            }
+            newTable->contextChars.addAll(str);
+            for (int32_t i = 0; i < str.length(); ++i) {
+                UChar c = str.charAt(i);
+                if (count > newTable->contextCounts[c]) {
+                    newTable->contextCounts[c] = (uint8_t)count;
+                }
+            }
+        }
+        newTable->contextChars.freeze();
+        if (U_FAILURE(*status)) {
+            return NULL;
+        }
+        strsrch->skipTable = table = newTable.orphan();
+    }
+    if (!table->hasPattern) {
+        for (int32_t i = 0; i < strsrch->pattern.pcesLength; ++i) {
+            uint32_t p = (uint32_t)((uint64_t)strsrch->pattern.pces[i] >> 48);
+            table->primaries[p >> 5] |= (uint32_t)1 << (p & 0x1f);
+        }
+        table->hasPattern = TRUE;
+    }
+    return table;
+}
+
+static uint8_t computeSkipClass(const UStringSearch *strsrch, const USearchSkipTable &table,
+                                UChar c, UErrorCode *status)
+{
+    if (U16_IS_SURROGATE(c) ||
+            (table.numeric && u_charType(c) == U_DECIMAL_DIGIT_NUMBER)) {
+        return SKIP_CLASS_COMPLEX;
+    }
+    UBool isBlocker;
+    int32_t count = getSkipCount(strsrch, table, UnicodeString(c), &isBlocker, status);
+    if (U_FAILURE(*status)) {
+        return SKIP_CLASS_COMPLEX;
+    }
+    // A character that can be part of a contraction may yield
+    // all of the contraction's CEs in addition to its own.
+    UnicodeString decomp;
+    if (table.contextChars.contains(c)) {
+        count += table.contextCounts[c];
+        isBlocker = FALSE;
+    } else if (strsrch->nfd->getDecomposition(c, decomp) && table.contextChars.containsSome(decomp)) {
+        for (int32_t i = 0; i < decomp.length(); ++i) {
+            count += table.contextCounts[decomp.charAt(i)];
+        }
+        isBlocker = FALSE;
+    }
+    if (isBlocker && g_nfcImpl->getFCD16(c) == 0) {
+        return SKIP_CLASS_BLOCKER;
+    }
+    if (count > 0xff - SKIP_CLASS_COUNT_BASE) {
+        return SKIP_CLASS_COMPLEX;
+    }
+    return (uint8_t)(SKIP_CLASS_COUNT_BASE + count);
+}
+
+static inline uint8_t getSkipClass(const UStringSearch *strsrch, USearchSkipTable &table,
+                                   UChar c, UErrorCode *status)
+{
+    uint8_t cls = table.classes[c];
+    if (cls == SKIP_CLASS_UNKNOWN) {
+        cls = table.classes[c] = computeSkipClass(strsrch, table, c, status);
+    }
+    return cls;
+}
+
+/*
+ * Same result as usearch_search(), but the matcher is only run on the stretches
+ * of text between blockers that can yield as many CEs as the pattern has.
+ *
+ * A match never contains a blocker, because each of its CEs that has a non-zero
+ * primary weight must equal a pattern CE, and a match that contains only some of
+ * a character's CEs is rejected.
+ * A blocker is not part of any contraction or normalization segment,
+ * so the CEs from the text after it are the same as when the search starts there.
+ */
+static UBool skipSearch(UStringSearch  *strsrch,
+                        int32_t        startIdx,
+                        int32_t        *matchStart,
+                        int32_t        *matchLimit,
+                        UErrorCode     *status)
+{
+    if (U_FAILURE(*status)) {
+        return FALSE;
+    }
+    if(strsrch->pattern.cesLength == 0         ||
+       startIdx < 0                           ||
+       startIdx > strsrch->search->textLength ||
+       strsrch->pattern.ces == NULL) {
+           *status = U_ILLEGAL_ARGUMENT_ERROR;
+           return FALSE;
+    }
+
+    if (strsrch->pattern.pces == NULL) {
+        initializePatternPCETable(strsrch, status);
+    }
+    USearchSkipTable *table = getSkipTable(strsrch, status);
+    if (U_FAILURE(*status)) {
+        return FALSE;
+    }
+    int32_t minCount = strsrch->pattern.pcesLength;
+    if (table == NULL || minCount == 0) {
+        return searchForward(strsrch, startIdx, INT32_MAX, matchStart, matchLimit, status);
+    }
+
+    const UChar *text   = strsrch->search->text;
+    int32_t      length = strsrch->search->textLength;
+    int32_t      i      = startIdx;
+    while (i < length) {
+        uint8_t cls = getSkipClass(strsrch, *table, text[i], status);
+        if (cls == SKIP_CLASS_BLOCKER) {
+            ++i;
+            continue;
+        }
+        // Find the end of this stretch and whether it can hold a match.
+        int32_t regionStart = i;
+        int32_t count = 0;
+        do {
+            if (count < minCount) {
+                if (cls == SKIP_CLASS_COMPLEX) {
+                    count = minCount;
+                } else {
+                    count += cls - SKIP_CLASS_COUNT_BASE;
+                }
+            }
+        } while (++i < length &&
+                 (cls = getSkipClass(strsrch, *table, text[i], status)) != SKIP_CLASS_BLOCKER);
+        if (U_FAILURE(*status)) {
+            return FALSE;
+        }
+        if (count >= minCount &&
+                searchForward(strsrch, regionStart, i, matchStart, matchLimit, status)) {
+            return TRUE;
+        }
+        if (U_FAILURE(*status)) {
+            return FALSE;
+        }
+    }
+
+    if (matchStart != NULL) {
+        *matchStart = -1;
+    }
+    if (matchLimit != NULL) {
+        *matchLimit = -1;
+    }
+    return FALSE;
+}
+
+/*
+ * Forward search with the engine that is selected by the search attributes.
+ */
+static inline UBool searchNext(UStringSearch  *strsrch,
+                               int32_t        startIdx,
+                               int32_t        *matchStart,
+                               int32_t        *matchLimit,
+                               UErrorCode     *status)
+{
+    if (strsrch->search->isSkipSearch && strsrch->search->elementComparisonType == 0) {
+        return skipSearch(strsrch, startIdx, matchStart, matchLimit, status);
+    }
+    return usearch_search(strsrch, startIdx, matchStart, matchLimit, status);
+}
+
 U_CAPI UBool U_EXPORT2 usearch_searchBackwards(UStringSearch  *strsrch,
                                                 int32_t        startIdx,
                                                 int32_t        *matchStart,
@@ -4521,7 +5096,7 @@ UBool usearch_handleNextExact(UStringSearch *strsrch, UErrorCode *status)
     int32_t start = -1;
     int32_t end = -1;
 
-    if (usearch_search(strsrch, textOffset, &start, &end, status)) {
+    if (searchNext(strsrch, textOffset, &start, &end, status)) {
         strsrch->search->matchedIndex  = start;
         strsrch->search->matchedLength = end - start;
         return TRUE;
@@ -4636,7 +5211,7 @@ UBool usearch_handleNextCanonical(UStringSearch *strsrch, UErrorCode *status)
     int32_t start = -1;
     int32_t end = -1;
 
-    if (usearch_search(strsrch, textOffset, &start, &end, status)) {
+    if (searchNext(strsrch, textOffset, &start, &end, status)) {
         strsrch->search->matchedIndex  = start;
         strsrch->search->matchedLength = end - start;
         return TRUE;
@@ -128,6 +128,7 @@ U_NAMESPACE_END
 
 #define INITIAL_ARRAY_SIZE_       256
 #define MAX_TABLE_SIZE_           257
+#define USEARCH_UTF8_CHECKPOINT_INTERVAL 64
 
 struct USearch {
     // required since collation element iterator does not have a getText API
@@ -146,6 +147,7 @@ struct USearch {
           int32_t             matchedLength;
           UBool               isForwardSearching;
           UBool               reset;
+          UBool               isSkipSearch;
 };
 
 struct UPattern {
@@ -165,6 +167,8 @@ struct UPattern {
           int16_t             backShift[MAX_TABLE_SIZE_];
 };
 
+struct USearchSkipTable;
+
 struct UStringSearch {
     struct USearch            *search;
     struct UPattern            pattern;
@@ -184,6 +188,16 @@ struct UStringSearch {
            UBool               toShift;
            UChar               canonicalPrefixAccents[INITIAL_ARRAY_SIZE_];
            UChar               canonicalSuffixAccents[INITIAL_ARRAY_SIZE_];
+    // character classes for the skip search (about 136kB),
+    // allocated only by the first search with USEARCH_SKIP_SEARCH on
+    struct USearchSkipTable   *skipTable;
+    // UTF-8 text set via usearch_setTextUTF8(), converted into utf16Text;
+    // utf8Checkpoints[i] is the UTF-8 index of the code point that contains
+    // UTF-16 index i*USEARCH_UTF8_CHECKPOINT_INTERVAL
+    const  char               *utf8Text;
+           int32_t             utf8Length;
+           UChar              *utf16Text;
+           int32_t            *utf8Checkpoints;
 };
 
 /**
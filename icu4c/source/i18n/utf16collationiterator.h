@@ -95,6 +95,13 @@ class U_I18N_API FCDUTF16CollationIterator : public UTF16CollationIterator {
 
     virtual ~FCDUTF16CollationIterator();
 
+    void setText(const UChar *s, const UChar *lim) {
+        reset();
+        rawStart = start = segmentStart = pos = s;
+        rawLimit = limit = lim;
+        checkDir = 1;
+    }
+
     virtual UBool operator==(const CollationIterator &other) const;
 
     virtual void resetToOffset(int32_t newOffset);
@@ -30,6 +30,14 @@ U_NAMESPACE_BEGIN
 
 UTF8CollationIterator::~UTF8CollationIterator() {}
 
+UBool
+UTF8CollationIterator::operator==(const CollationIterator &other) const {
+    if(!CollationIterator::operator==(other)) { return FALSE; }
+    const UTF8CollationIterator &o = static_cast<const UTF8CollationIterator &>(other);
+    // Compare the iterator state but not the text: Assume that the caller does that.
+    return pos == o.pos;
+}
+
 void
 UTF8CollationIterator::resetToOffset(int32_t newOffset) {
     reset();
@@ -129,6 +137,20 @@ UTF8CollationIterator::backwardNumCodePoints(int32_t num, UErrorCode & /*errorCo
 
 FCDUTF8CollationIterator::~FCDUTF8CollationIterator() {}
 
+UBool
+FCDUTF8CollationIterator::operator==(const CollationIterator &other) const {
+    // Skip the UTF8CollationIterator and call its parent.
+    if(!CollationIterator::operator==(other)) { return FALSE; }
+    const FCDUTF8CollationIterator &o = static_cast<const FCDUTF8CollationIterator &>(other);
+    // Compare the iterator state but not the text: Assume that the caller does that.
+    if(state != o.state) { return FALSE; }
+    if(state == IN_NORMALIZED) {
+        return start == o.start && pos == o.pos;
+    } else {
+        return pos == o.pos;
+    }
+}
+
 void
 FCDUTF8CollationIterator::resetToOffset(int32_t newOffset) {
     reset();
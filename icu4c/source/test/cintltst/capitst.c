@@ -89,6 +89,10 @@ void addCollAPITest(TestNode** root)
     addTest(root, &TestBengaliSortKey, "tscoll/capitst/TestBengaliSortKey");
     addTest(root, &TestGetKeywordValuesForLocale, "tscoll/capitst/TestGetKeywordValuesForLocale");
     addTest(root, &TestStrcollNull, "tscoll/capitst/TestStrcollNull");
+    addTest(root, &TestSortKeys, "tscoll/capitst/TestSortKeys");
+    addTest(root, &TestSortStrings, "tscoll/capitst/TestSortStrings");
+    addTest(root, &TestSortNestedPrefixes, "tscoll/capitst/TestSortNestedPrefixes");
+    addTest(root, &TestCloneWithAttributes, "tscoll/capitst/TestCloneWithAttributes");
 }
 
 void TestGetSetAttr(void) {
@@ -2560,4 +2564,302 @@ static void TestStrcollNull(void) {
     ucol_close(coll);
 }
 
+static void TestSortKeys(void) {
+    static const char *const strings8[] = {
+        "abc", "", "ABC", "a\xCC\x88" "b", "\xC3\xA4" "b", "\xE5\xB1\xB1\xE5\xB7\x9D",
+        "x\xF0\x9F\x98\x80y", "a\x80z", "co-op", "12 monkeys"
+    };
+    enum { COUNT = UPRV_LENGTHOF(strings8) };
+    static const UColAttributeValue strengths[] = { UCOL_TERTIARY, UCOL_IDENTICAL };
+    UChar buffers16[COUNT][20];
+    const UChar *strings16[COUNT];
+    int32_t lengths16[COUNT];
+    int32_t lengths8[COUNT];
+    uint8_t keys[1000], keys8[1000], key[100];
+    int32_t keyOffsets[COUNT + 1], keyOffsets8[COUNT + 1];
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t i, s, numKeys;
+    UCollator *coll = ucol_open("en", &status);
+    if (U_FAILURE(status)) {
+        log_err_status(status, "ucol_open(en) failed: %s\n", u_errorName(status));
+        return;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        lengths8[i] = (int32_t)strlen(strings8[i]);
+        u_strFromUTF8WithSub(buffers16[i], UPRV_LENGTHOF(buffers16[i]), &lengths16[i],
+                             strings8[i], lengths8[i], 0xfffd, NULL, &status);
+        strings16[i] = buffers16[i];
+    }
+    if (U_FAILURE(status)) {
+        log_err("u_strFromUTF8WithSub() failed: %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    for (s = 0; s < UPRV_LENGTHOF(strengths); ++s) {
+        ucol_setStrength(coll, strengths[s]);
+        numKeys = ucol_getSortKeys(coll, strings16, lengths16, COUNT,
+                                   keys, UPRV_LENGTHOF(keys), keyOffsets, &status);
+        if (U_FAILURE(status) || numKeys != COUNT) {
+            log_err("ucol_getSortKeys(strength %d) = %d keys, %s\n",
+                    (int)strengths[s], (int)numKeys, u_errorName(status));
+            break;
+        }
+        /* NUL-terminated UTF-8 strings, lengths=NULL */
+        numKeys = ucol_getSortKeysUTF8(coll, strings8, NULL, COUNT,
+                                       keys8, UPRV_LENGTHOF(keys8), keyOffsets8, &status);
+        if (U_FAILURE(status) || numKeys != COUNT) {
+            log_err("ucol_getSortKeysUTF8(strength %d) = %d keys, %s\n",
+                    (int)strengths[s], (int)numKeys, u_errorName(status));
+            break;
+        }
+        for (i = 0; i < COUNT; ++i) {
+            int32_t keyLength = ucol_getSortKey(coll, strings16[i], lengths16[i],
+                                                key, UPRV_LENGTHOF(key));
+            if (keyOffsets[i + 1] - keyOffsets[i] != keyLength ||
+                    memcmp(keys + keyOffsets[i], key, keyLength) != 0) {
+                log_err("ucol_getSortKeys(strength %d)[%d] != ucol_getSortKey()\n",
+                        (int)strengths[s], (int)i);
+            }
+            if (keyOffsets8[i + 1] - keyOffsets8[i] != keyLength ||
+                    memcmp(keys8 + keyOffsets8[i], key, keyLength) != 0) {
+                log_err("ucol_getSortKeysUTF8(strength %d)[%d] != ucol_getSortKey()\n",
+                        (int)strengths[s], (int)i);
+            }
+        }
+    }
+
+    /* Only the first three keys fit; the fourth would need at least two more bytes. */
+    ucol_setStrength(coll, UCOL_TERTIARY);
+    ucol_getSortKeys(coll, strings16, lengths16, COUNT,
+                     keys, UPRV_LENGTHOF(keys), keyOffsets, &status);
+    numKeys = ucol_getSortKeysUTF8(coll, strings8, lengths8, COUNT,
+                                   keys8, keyOffsets[3] + 1, keyOffsets8, &status);
+    if (U_FAILURE(status) || numKeys != 3 || keyOffsets8[3] != keyOffsets[3] ||
+            memcmp(keys8, keys, keyOffsets[3]) != 0) {
+        log_err("ucol_getSortKeysUTF8(capacity %d) = %d keys, %s\n",
+                (int)(keyOffsets[3] + 1), (int)numKeys, u_errorName(status));
+    }
+    numKeys = ucol_getSortKeys(coll, strings16, lengths16, COUNT, NULL, 0, NULL, &status);
+    if (U_FAILURE(status) || numKeys != 0) {
+        log_err("ucol_getSortKeys(NULL, 0) = %d keys, %s\n", (int)numKeys, u_errorName(status));
+    }
+    numKeys = ucol_getSortKeys(coll, strings16, lengths16, -1, keys, UPRV_LENGTHOF(keys), NULL, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_getSortKeys(count=-1) should fail with U_ILLEGAL_ARGUMENT_ERROR but got %s\n",
+                u_errorName(status));
+    }
+    ucol_close(coll);
+}
+
+static void TestSortStrings(void) {
+    /* Pieces include case and accent variants, ignorables and canonically equivalent sequences. */
+    static const char *const pieces[] = {
+        "a", "A", "b", "ch", "\xC3\xA4", "a\xCC\x88", "-", "\x01", "1", "10",
+        "\xE5\xB1\xB1", "z", "Z", "\xF0\x9F\x98\x80"
+    };
+    enum { COUNT = 5000, MAX_PIECES = 6 };
+    static const int32_t threads[] = { 1, 4 };
+    char (*strings8)[4 * 6 + 1] = (char (*)[4 * 6 + 1])malloc(COUNT * sizeof(*strings8));
+    UChar (*strings16)[2 * 6 + 1] = (UChar (*)[2 * 6 + 1])malloc(COUNT * sizeof(*strings16));
+    const char **src8 = (const char **)malloc(COUNT * sizeof(const char *));
+    const UChar **src16 = (const UChar **)malloc(COUNT * sizeof(const UChar *));
+    int32_t *lengths16 = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    int32_t *permutation = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    int32_t *expected = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    UBool *seen = (UBool *)malloc(COUNT);
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    uint32_t seed = 1;
+    int32_t i, j, t;
+    if (U_FAILURE(status)) {
+        log_err_status(status, "ucol_open(en) failed: %s\n", u_errorName(status));
+        goto cleanup;
+    }
+    if (strings8 == NULL || strings16 == NULL || src8 == NULL || src16 == NULL ||
+            lengths16 == NULL || permutation == NULL || expected == NULL || seen == NULL) {
+        log_err("out of memory\n");
+        goto cleanup;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        int32_t numPieces;
+        seed = seed * 1103515245 + 12345;
+        numPieces = (int32_t)((seed >> 16) % (MAX_PIECES + 1));
+        strings8[i][0] = 0;
+        for (j = 0; j < numPieces; ++j) {
+            seed = seed * 1103515245 + 12345;
+            strcat(strings8[i], pieces[(seed >> 16) % UPRV_LENGTHOF(pieces)]);
+        }
+        src8[i] = strings8[i];
+        u_strFromUTF8(strings16[i], UPRV_LENGTHOF(strings16[i]), &lengths16[i],
+                      strings8[i], -1, &status);
+        src16[i] = strings16[i];
+    }
+    if (U_FAILURE(status)) {
+        log_err("u_strFromUTF8() failed: %s\n", u_errorName(status));
+        goto cleanup;
+    }
+
+    ucol_sortStrings(coll, src16, lengths16, COUNT, expected, 1, &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_sortStrings() failed: %s\n", u_errorName(status));
+        goto cleanup;
+    }
+    memset(seen, 0, COUNT);
+    for (i = 0; i < COUNT; ++i) {
+        int32_t k = expected[i];
+        if (k < 0 || k >= COUNT || seen[k]) {
+            log_err("ucol_sortStrings() did not return a permutation: [%d]=%d\n", (int)i, (int)k);
+            goto cleanup;
+        }
+        seen[k] = TRUE;
+        if (i > 0) {
+            int32_t prev = expected[i - 1];
+            UCollationResult order = ucol_strcoll(coll, src16[prev], lengths16[prev],
+                                                  src16[k], lengths16[k]);
+            int32_t cpOrder = u_strCompare(src16[prev], lengths16[prev],
+                                           src16[k], lengths16[k], TRUE);
+            if (order == UCOL_GREATER ||
+                    (order == UCOL_EQUAL && (cpOrder > 0 || (cpOrder == 0 && prev > k)))) {
+                log_err("ucol_sortStrings(): [%d]=%d sorts before [%d]=%d\n",
+                        (int)(i - 1), (int)prev, (int)i, (int)k);
+            }
+        }
+    }
+    for (t = 0; t < UPRV_LENGTHOF(threads); ++t) {
+        ucol_sortStrings(coll, src16, lengths16, COUNT, permutation, threads[t], &status);
+        if (U_FAILURE(status) || memcmp(permutation, expected, COUNT * sizeof(int32_t)) != 0) {
+            log_err("ucol_sortStrings(%d threads) differs: %s\n", (int)threads[t], u_errorName(status));
+            status = U_ZERO_ERROR;
+        }
+        ucol_sortStringsUTF8(coll, src8, NULL, COUNT, permutation, threads[t], &status);
+        if (U_FAILURE(status) || memcmp(permutation, expected, COUNT * sizeof(int32_t)) != 0) {
+            log_err("ucol_sortStringsUTF8(%d threads) differs: %s\n", (int)threads[t], u_errorName(status));
+            status = U_ZERO_ERROR;
+        }
+    }
+    ucol_sortStrings(coll, src16, lengths16, -1, permutation, 1, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_sortStrings(count=-1) should fail with U_ILLEGAL_ARGUMENT_ERROR but got %s\n",
+                u_errorName(status));
+    }
+
+cleanup:
+    ucol_close(coll);
+    free(strings8);
+    free(strings16);
+    free(src8);
+    free(src16);
+    free(lengths16);
+    free(permutation);
+    free(expected);
+    free(seen);
+}
+
+static void TestSortNestedPrefixes(void) {
+    /*
+     * "x", "xx", "xxx", ... in reverse order: Each string's sort key is a prefix of the next one's
+     * up to the level separator, which used to nest the radix sort once per string.
+     */
+    enum { COUNT = 3000 };
+    static const int32_t threads[] = { 1, 4 };
+    UChar *text = (UChar *)malloc(COUNT * sizeof(UChar));
+    const UChar **src = (const UChar **)malloc(COUNT * sizeof(const UChar *));
+    int32_t *lengths = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    int32_t *permutation = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    int32_t i, t;
+    if (U_FAILURE(status)) {
+        log_err_status(status, "ucol_open(en) failed: %s\n", u_errorName(status));
+        goto cleanup;
+    }
+    if (text == NULL || src == NULL || lengths == NULL || permutation == NULL) {
+        log_err("out of memory\n");
+        goto cleanup;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        text[i] = 0x78;
+        src[i] = text;
+        lengths[i] = COUNT - i;
+    }
+    for (t = 0; t < UPRV_LENGTHOF(threads); ++t) {
+        ucol_sortStrings(coll, src, lengths, COUNT, permutation, threads[t], &status);
+        if (U_FAILURE(status)) {
+            log_err("ucol_sortStrings(%d threads) failed: %s\n", (int)threads[t], u_errorName(status));
+            goto cleanup;
+        }
+        for (i = 0; i < COUNT; ++i) {
+            if (permutation[i] != COUNT - 1 - i) {
+                log_err("ucol_sortStrings(%d threads): [%d]=%d but expected %d\n",
+                        (int)threads[t], (int)i, (int)permutation[i], (int)(COUNT - 1 - i));
+                break;
+            }
+        }
+    }
+
+cleanup:
+    ucol_close(coll);
+    free(text);
+    free(src);
+    free(lengths);
+    free(permutation);
+}
+
+static void TestCloneWithAttributes(void) {
+    static const UColAttribute attributes[] = {
+        UCOL_STRENGTH, UCOL_NUMERIC_COLLATION, UCOL_ALTERNATE_HANDLING
+    };
+    static const UColAttributeValue values[] = { UCOL_SECONDARY, UCOL_ON, UCOL_SHIFTED };
+    static const char *const strings[] = { "a", "A", "a-b", "ab", "x2", "x10", "\xC3\xA4" };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    UCollator *expected, *clone;
+    int32_t i, j;
+    if (U_FAILURE(status)) {
+        log_err_status(status, "ucol_open(en) failed: %s\n", u_errorName(status));
+        return;
+    }
+    expected = ucol_safeClone(coll, NULL, NULL, &status);
+    status = U_ZERO_ERROR;  /* U_SAFECLONE_ALLOCATED_WARNING */
+    for (i = 0; i < UPRV_LENGTHOF(attributes); ++i) {
+        ucol_setAttribute(expected, attributes[i], values[i], &status);
+    }
+    clone = ucol_cloneWithAttributes(coll, attributes, values, UPRV_LENGTHOF(attributes), &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_cloneWithAttributes() failed: %s\n", u_errorName(status));
+    } else {
+        if (!ucol_equals(clone, expected)) {
+            log_err("ucol_cloneWithAttributes() != ucol_safeClone() + ucol_setAttribute()\n");
+        }
+        for (i = 0; i < UPRV_LENGTHOF(attributes); ++i) {
+            if (ucol_getAttribute(clone, attributes[i], &status) != values[i]) {
+                log_err("ucol_cloneWithAttributes() did not set attribute %d\n", (int)attributes[i]);
+            }
+        }
+        for (i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+            for (j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                UCollationResult order = ucol_strcollUTF8(clone, strings[i], -1, strings[j], -1, &status);
+                UCollationResult order2 = ucol_strcollUTF8(expected, strings[i], -1, strings[j], -1, &status);
+                if (order != order2) {
+                    log_err("ucol_cloneWithAttributes(): compare(%d, %d)=%d != %d\n",
+                            (int)i, (int)j, (int)order, (int)order2);
+                }
+            }
+        }
+        /* The original collator is not modified. */
+        if (ucol_getAttribute(coll, UCOL_STRENGTH, &status) != UCOL_TERTIARY) {
+            log_err("ucol_cloneWithAttributes() modified the original collator\n");
+        }
+    }
+    ucol_close(clone);
+    clone = ucol_cloneWithAttributes(coll, attributes, NULL, 1, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR || clone != NULL) {
+        log_err("ucol_cloneWithAttributes(values=NULL) should fail with U_ILLEGAL_ARGUMENT_ERROR but got %s\n",
+                u_errorName(status));
+    }
+    ucol_close(clone);
+    ucol_close(expected);
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -137,6 +137,26 @@
      */
     static void TestStrcollNull(void);
 
+    /**
+     * Test ucol_getSortKeys() and ucol_getSortKeysUTF8()
+     */
+    static void TestSortKeys(void);
+
+    /**
+     * Test ucol_sortStrings() and ucol_sortStringsUTF8()
+     */
+    static void TestSortStrings(void);
+
+    /**
+     * Test ucol_sortStrings() with many strings that share long prefixes
+     */
+    static void TestSortNestedPrefixes(void);
+
+    /**
+     * Test ucol_cloneWithAttributes()
+     */
+    static void TestCloneWithAttributes(void);
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 #endif
@@ -52,6 +52,10 @@ static void TestBreakIteratorTailoring(void);
 static void TestBreakIteratorRefresh(void);
 static void TestBug11665(void);
 static void TestBreakIteratorSuppressions(void);
+#if !UCONFIG_NO_FILE_IO
+static void TestBreakIteratorGetBoundaries(void);
+static void TestBreakIteratorPool(void);
+#endif
 
 void addBrkIterAPITest(TestNode** root);
 
@@ -71,6 +75,10 @@ void addBrkIterAPITest(TestNode** root)
 #if !UCONFIG_NO_FILTERED_BREAK_ITERATION
     addTest(root, &TestBreakIteratorSuppressions, "tstxtbd/cbiapts/TestBreakIteratorSuppressions");
 #endif
+#if !UCONFIG_NO_FILE_IO
+    addTest(root, &TestBreakIteratorGetBoundaries, "tstxtbd/cbiapts/TestBreakIteratorGetBoundaries");
+    addTest(root, &TestBreakIteratorPool, "tstxtbd/cbiapts/TestBreakIteratorPool");
+#endif
 }
 
 #define CLONETEST_ITERATOR_COUNT 2
@@ -1110,4 +1118,131 @@ static void TestBreakIteratorSuppressions(void) {
 }
 
 
+#if !UCONFIG_NO_FILE_IO
+/*
+ *  TestBreakIteratorGetBoundaries()   Test ubrk_getBoundaries(), with plain and
+ *                                     with filtered break iterators.
+ */
+static void TestBreakIteratorGetBoundaries(void) {
+    static const int32_t expBounds[] = { 5, 6, 7, 12, 13, 16, 17 };
+    static const int32_t expStatus[] = { UBRK_WORD_LETTER, UBRK_WORD_NONE, UBRK_WORD_NONE,
+                                         UBRK_WORD_LETTER, UBRK_WORD_NONE, UBRK_WORD_NUMBER, UBRK_WORD_NONE };
+    UChar           text[64];
+    int32_t         bounds[10];
+    int32_t         status[10];
+    int32_t         length;
+    UErrorCode      errorCode = U_ZERO_ERROR;
+    UBreakIterator *bi;
+
+    u_uastrcpy(text, "Hello, world 123.");
+    bi = ubrk_open(UBRK_WORD, "en", text, -1, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_data_err("FAIL: ubrk_open(UBRK_WORD) failed: %s (Are you missing data?)\n", u_errorName(errorCode));
+        return;
+    }
+    length = ubrk_getBoundaries(bi, 0, bounds, status, UPRV_LENGTHOF(bounds), &errorCode);
+    TEST_ASSERT_SUCCESS(errorCode);
+    TEST_ASSERT(length == UPRV_LENGTHOF(expBounds));
+    TEST_ASSERT(memcmp(bounds, expBounds, sizeof(expBounds)) == 0);
+    TEST_ASSERT(memcmp(status, expStatus, sizeof(expStatus)) == 0);
+    TEST_ASSERT(ubrk_current(bi) == 17);
+
+    /* Start in the middle of a word, in chunks of two, without status values. */
+    length = ubrk_getBoundaries(bi, 9, bounds, NULL, 2, &errorCode);
+    TEST_ASSERT(length == 2 && bounds[0] == 12 && bounds[1] == 13);
+    TEST_ASSERT(ubrk_current(bi) == 13);
+    TEST_ASSERT(ubrk_getRuleStatus(bi) == UBRK_WORD_NONE);
+    length = ubrk_getBoundaries(bi, 13, bounds, NULL, 2, &errorCode);
+    TEST_ASSERT(length == 2 && bounds[0] == 16 && bounds[1] == 17);
+    length = ubrk_getBoundaries(bi, 17, bounds, NULL, 2, &errorCode);
+    TEST_ASSERT(length == 0);
+    TEST_ASSERT_SUCCESS(errorCode);
+
+    ubrk_getBoundaries(bi, 0, NULL, NULL, 2, &errorCode);
+    TEST_ASSERT(errorCode == U_ILLEGAL_ARGUMENT_ERROR);
+    ubrk_close(bi);
+
+#if !UCONFIG_NO_FILTERED_BREAK_ITERATION
+    /* Sentence breaks with suppressions come from a BreakIterator that is not rule-based. */
+    errorCode = U_ZERO_ERROR;
+    u_uastrcpy(text, "Mr. Smith is here. Okay?");
+    bi = ubrk_open(UBRK_SENTENCE, "en@ss=standard", text, -1, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_data_err("FAIL: ubrk_open(UBRK_SENTENCE) failed: %s (Are you missing data?)\n", u_errorName(errorCode));
+        return;
+    }
+    length = ubrk_getBoundaries(bi, 0, bounds, NULL, UPRV_LENGTHOF(bounds), &errorCode);
+    TEST_ASSERT_SUCCESS(errorCode);
+    TEST_ASSERT(length == 2 && bounds[0] == 19 && bounds[1] == 24);
+    TEST_ASSERT(ubrk_current(bi) == 24);
+    length = ubrk_getBoundaries(bi, 0, bounds, NULL, 1, &errorCode);
+    TEST_ASSERT(length == 1 && bounds[0] == 19);
+    TEST_ASSERT(ubrk_current(bi) == 19);
+    ubrk_close(bi);
+#endif
+}
+
+/*
+ *  TestBreakIteratorPool()   Test ubrk_openFromPool() and ubrk_returnToPool().
+ */
+static void TestBreakIteratorPool(void) {
+    UChar           text[64];
+    UErrorCode      errorCode = U_ZERO_ERROR;
+    UBreakIteratorPool *pool;
+    UBreakIterator *bi, *bi2, *sbi;
+    UBreakIteratorPoolStatistics stats;
+
+    pool = ubrk_openPool(1, &errorCode);
+    TEST_ASSERT_SUCCESS(errorCode);
+    u_uastrcpy(text, "Hello, world 123.");
+    bi = ubrk_openFromPool(pool, UBRK_WORD, "en", text, -1, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_data_err("FAIL: ubrk_openFromPool(UBRK_WORD) failed: %s (Are you missing data?)\n", u_errorName(errorCode));
+        ubrk_closePool(pool);
+        return;
+    }
+    TEST_ASSERT(ubrk_following(bi, 0) == 5);
+    ubrk_returnToPool(pool, bi);
+
+    bi2 = ubrk_openFromPool(pool, UBRK_WORD, "en", NULL, 0, &errorCode);
+    TEST_ASSERT_SUCCESS(errorCode);
+    TEST_ASSERT(bi2 == bi);
+    TEST_ASSERT(ubrk_first(bi2) == 0 && ubrk_next(bi2) == UBRK_DONE);
+
+    /* Sentence breaks with suppressions come from a BreakIterator that is not rule-based. */
+    u_uastrcpy(text, "Mr. Smith is here. Okay?");
+    sbi = ubrk_openFromPool(pool, UBRK_SENTENCE, "en@ss=standard", text, -1, &errorCode);
+    TEST_ASSERT_SUCCESS(errorCode);
+    TEST_ASSERT(ubrk_following(sbi, 0) == 19);
+    bi = ubrk_openFromPool(pool, UBRK_WORD, "en", text, -1, &errorCode);
+    TEST_ASSERT(bi != bi2 && ubrk_following(bi, 0) == 2);
+
+    ubrk_returnToPool(pool, sbi);
+    ubrk_returnToPool(pool, bi2);
+    ubrk_returnToPool(pool, bi);    /* The pool keeps only one per key. */
+    ubrk_returnToPool(pool, NULL);
+    ubrk_getPoolStatistics(pool, &stats);
+    TEST_ASSERT(stats.acquired == 4 && stats.reused == 1 && stats.released == 4 && stats.discarded == 1);
+    TEST_ASSERT(stats.idle == 2 && stats.inUse == 0);
+
+    /* If the text cannot be set, then the iterator goes back into the pool. */
+    bi = ubrk_openFromPool(pool, UBRK_WORD, "en", text, -2, &errorCode);
+    TEST_ASSERT(bi == NULL && errorCode == U_ILLEGAL_ARGUMENT_ERROR);
+    errorCode = U_ZERO_ERROR;
+    ubrk_getPoolStatistics(pool, &stats);
+    TEST_ASSERT(stats.acquired == 5 && stats.released == 5 && stats.idle == 2 && stats.inUse == 0);
+
+    sbi = ubrk_openFromPool(pool, UBRK_SENTENCE, "en@ss=standard", text, -1, &errorCode);
+    TEST_ASSERT_SUCCESS(errorCode);
+    TEST_ASSERT(ubrk_following(sbi, 0) == 19);
+    ubrk_closePool(pool);
+    /* Still usable after the pool is gone. */
+    TEST_ASSERT(ubrk_next(sbi) == 24);
+    ubrk_close(sbi);
+
+    ubrk_openPool(-1, &errorCode);
+    TEST_ASSERT(errorCode == U_ILLEGAL_ARGUMENT_ERROR);
+}
+#endif
+
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -69,6 +69,8 @@ static void TestEBCDICSwapLFNL(void);
 static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
+static void TestConvertExToUTF8(void);
+static void TestConvertParallel(void);
 static void TestConvertAlgorithmic(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
@@ -104,6 +106,8 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertEx,               "tsconv/ccapitst/TestConvertEx");
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
+    addTest(root, &TestConvertExToUTF8,         "tsconv/ccapitst/TestConvertExToUTF8");
+    addTest(root, &TestConvertParallel,         "tsconv/ccapitst/TestConvertParallel");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
@@ -2759,6 +2763,292 @@ static void TestConvertExFromUTF8_C5F0() {
     ucnv_close(utf8Cnv);
 }
 
+/*
+ * Test conversion from SBCS/DBCS charsets to UTF-8,
+ * which can bypass the pivot buffer.
+ * Compare with the two-step conversion via UTF-16.
+ */
+static void TestConvertExToUTF8() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const char *const converterNames[]={
+        "windows-1252",
+        "ibm-37",
+        "shift-jis",
+        "windows-936",
+        "Big5"
+    };
+
+    UConverter *utf8Cnv, *cnv;
+    UErrorCode errorCode;
+    int32_t i;
+
+    errorCode=U_ZERO_ERROR;
+    utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open UTF-8 converter - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(converterNames); ++i) {
+        char src[400], expect[1200], testName[64];
+        UChar utf16[400];
+        int32_t srcLength, expectLength, utf16Length;
+        USet *set;
+        UChar32 c;
+        int32_t j, step;
+
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(converterNames[i], &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", converterNames[i], u_errorName(errorCode));
+            continue;
+        }
+
+        /* ASCII, then a sample of roundtrip characters */
+        utf16Length=u_unescape("Some ASCII text, then other characters:\\n", utf16, UPRV_LENGTHOF(utf16));
+        set=uset_open(1, 0);
+        ucnv_getUnicodeSet(cnv, set, UCNV_ROUNDTRIP_SET, &errorCode);
+        step=uset_size(set)/80+1;
+        for(j=0; j<uset_size(set) && utf16Length<200; j+=step) {
+            c=uset_charAt(set, j);
+            U16_APPEND_UNSAFE(utf16, utf16Length, c);
+        }
+        uset_close(set);
+        srcLength=ucnv_fromUChars(cnv, src, 300, utf16, utf16Length, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("unable to convert test text to %s - %s\n", converterNames[i], u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+
+        /* append unassigned and illegal bytes, each followed by an ASCII character */
+        for(j=0x80; j<0x100 && srcLength<UPRV_LENGTHOF(src)-2; j+=3) {
+            src[srcLength++]=(char)j;
+            src[srcLength++]='a';
+        }
+
+        /* expect the same result as with substitution and pivoting */
+        utf16Length=ucnv_toUChars(cnv, utf16, UPRV_LENGTHOF(utf16), src, srcLength, &errorCode);
+        expectLength=0;
+        for(j=0; j<utf16Length;) {
+            U16_NEXT(utf16, j, utf16Length, c);
+            U8_APPEND_UNSAFE(expect, expectLength, c);
+        }
+        if(U_FAILURE(errorCode)) {
+            log_err("unable to convert test text from %s - %s\n", converterNames[i], u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+
+        strcpy(testName, converterNames[i]);
+        strcat(testName, " to UTF-8");
+        convertExMultiStreaming(cnv, utf8Cnv,
+                                src, srcLength,
+                                expect, expectLength,
+                                testName,
+                                U_ZERO_ERROR);
+        /* large buffers for the block copy of ASCII and extension mappings */
+        convertExStreaming(cnv, utf8Cnv,
+                           src, srcLength,
+                           expect, expectLength,
+                           CHUNK_SIZE, testName,
+                           U_ZERO_ERROR);
+        ucnv_close(cnv);
+    }
+    ucnv_close(utf8Cnv);
+#endif
+}
+
+static void U_CALLCONV
+countingToUCallback(const void *context, UConverterToUnicodeArgs *toUArgs,
+                    const char *codeUnits, int32_t length,
+                    UConverterCallbackReason reason, UErrorCode *pErrorCode) {
+    if(reason<=UCNV_IRREGULAR) {
+        ++*(int32_t *)context;
+    }
+    UCNV_TO_U_CALLBACK_SUBSTITUTE(NULL, toUArgs, codeUnits, length, reason, pErrorCode);
+}
+
+/*
+ * Test ucnv_convertParallel() on texts long enough to be cut into slices.
+ * Compare with sequential conversion, including errors from the STOP callbacks.
+ */
+static void TestConvertParallel() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const struct {
+        const char *sourceName, *targetName;
+        UBool isStateful;
+    } pairs[]={
+        { "shift-jis", "UTF-8", FALSE },
+        { "UTF-8", "windows-936", FALSE },
+        { "UTF-16LE", "ibm-37", FALSE },
+        { "windows-1252", "UTF-16BE", FALSE },
+        { "Big5", "shift-jis", FALSE },
+        { "ISO-2022-JP", "UTF-8", TRUE },
+        { "UTF-8", "HZ", TRUE }
+    };
+    static const int32_t numThreads[]={ 1, 2, 3, 8 };
+    enum { SRC_LENGTH=300000 };
+
+    char *src, *expect, *result;
+    int32_t i, j;
+
+    src=(char *)malloc(SRC_LENGTH);
+    expect=(char *)malloc(4*SRC_LENGTH);
+    result=(char *)malloc(4*SRC_LENGTH);
+    if(src==NULL || expect==NULL || result==NULL) {
+        log_err("out of memory\n");
+        free(src);
+        free(expect);
+        free(result);
+        return;
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(pairs); ++i) {
+        UConverter *sourceCnv, *targetCnv;
+        UChar utf16[400];
+        char sample[1200];
+        int32_t utf16Length, sampleLength, srcLength, expectLength, resultLength;
+        UErrorCode errorCode, expectErrorCode;
+        USet *set;
+        UChar32 c;
+        int32_t step;
+        UBool stop;
+
+        errorCode=U_ZERO_ERROR;
+        sourceCnv=ucnv_open(pairs[i].sourceName, &errorCode);
+        targetCnv=ucnv_open(pairs[i].targetName, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s or %s converter - %s\n",
+                         pairs[i].sourceName, pairs[i].targetName, u_errorName(errorCode));
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+            continue;
+        }
+
+        /* lines with ASCII and a sample of roundtrip characters, repeated */
+        utf16Length=u_unescape("Some ASCII text, then other characters:\\n", utf16, UPRV_LENGTHOF(utf16));
+        set=uset_open(1, 0);
+        ucnv_getUnicodeSet(sourceCnv, set, UCNV_ROUNDTRIP_SET, &errorCode);
+        step=uset_size(set)/150+1;
+        for(j=0; j<uset_size(set) && utf16Length<UPRV_LENGTHOF(utf16)-3; j+=step) {
+            c=uset_charAt(set, j);
+            U16_APPEND_UNSAFE(utf16, utf16Length, c);
+            if((j%8)==7) {
+                utf16[utf16Length++]=0xa;
+            }
+        }
+        uset_close(set);
+        ucnv_setFromUCallBack(sourceCnv, UCNV_FROM_U_CALLBACK_SKIP, NULL, NULL, NULL, &errorCode);
+        sampleLength=ucnv_fromUChars(sourceCnv, sample, UPRV_LENGTHOF(sample), utf16, utf16Length, &errorCode);
+        ucnv_setFromUCallBack(sourceCnv, UCNV_FROM_U_CALLBACK_SUBSTITUTE, NULL, NULL, NULL, &errorCode);
+        if(U_FAILURE(errorCode) || sampleLength==0) {
+            log_err("unable to convert test text to %s - %s\n", pairs[i].sourceName, u_errorName(errorCode));
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+            continue;
+        }
+        for(srcLength=0; srcLength+sampleLength<=SRC_LENGTH; srcLength+=sampleLength) {
+            uprv_memcpy(src+srcLength, sample, sampleLength);
+        }
+
+        for(stop=FALSE; stop<=TRUE; ++stop) {
+            if(stop) {
+                /* an illegal byte late in the text */
+                src[srcLength*3/4]=(char)0xff;
+                ucnv_setToUCallBack(sourceCnv, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+                ucnv_setFromUCallBack(targetCnv, UCNV_FROM_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+            }
+            expectErrorCode=U_ZERO_ERROR;
+            expectLength=ucnv_convertParallel(targetCnv, sourceCnv, expect, 4*SRC_LENGTH,
+                                              src, srcLength, 1, &expectErrorCode);
+            if(!stop && U_FAILURE(expectErrorCode)) {
+                log_err("ucnv_convertParallel(%s to %s, 1 thread) failed - %s\n",
+                        pairs[i].sourceName, pairs[i].targetName, u_errorName(expectErrorCode));
+                break;
+            }
+            for(j=1; j<UPRV_LENGTHOF(numThreads); ++j) {
+                UErrorCode expectThreadsErrorCode=expectErrorCode;
+                if(pairs[i].isStateful && expectErrorCode==U_ZERO_ERROR) {
+                    expectThreadsErrorCode=U_SEQUENTIAL_FALLBACK_WARNING;
+                }
+
+                errorCode=U_ZERO_ERROR;
+                resultLength=ucnv_convertParallel(targetCnv, sourceCnv, result, 4*SRC_LENGTH,
+                                                  src, srcLength, numThreads[j], &errorCode);
+                if( errorCode!=expectThreadsErrorCode || resultLength!=expectLength ||
+                    (U_SUCCESS(errorCode) && uprv_memcmp(result, expect, expectLength)!=0)
+                ) {
+                    log_err("ucnv_convertParallel(%s to %s, %d threads, stop=%d) differs from sequential: "
+                            "length %d vs. %d, %s vs. %s\n",
+                            pairs[i].sourceName, pairs[i].targetName, (int)numThreads[j], stop,
+                            (int)resultLength, (int)expectLength,
+                            u_errorName(errorCode), u_errorName(expectThreadsErrorCode));
+                }
+
+                if(!stop) {
+                    /* preflighting, and exactly filling the buffer */
+                    errorCode=U_ZERO_ERROR;
+                    resultLength=ucnv_convertParallel(targetCnv, sourceCnv, NULL, 0,
+                                                      src, srcLength, numThreads[j], &errorCode);
+                    if(errorCode!=U_BUFFER_OVERFLOW_ERROR || resultLength!=expectLength) {
+                        log_err("ucnv_convertParallel(%s to %s, %d threads) preflighting: length %d, %s\n",
+                                pairs[i].sourceName, pairs[i].targetName, (int)numThreads[j],
+                                (int)resultLength, u_errorName(errorCode));
+                    }
+                    errorCode=U_ZERO_ERROR;
+                    resultLength=ucnv_convertParallel(targetCnv, sourceCnv, result, expectLength,
+                                                      src, srcLength, numThreads[j], &errorCode);
+                    if(errorCode!=U_STRING_NOT_TERMINATED_WARNING || resultLength!=expectLength) {
+                        log_err("ucnv_convertParallel(%s to %s, %d threads) into exact capacity: length %d, %s\n",
+                                pairs[i].sourceName, pairs[i].targetName, (int)numThreads[j],
+                                (int)resultLength, u_errorName(errorCode));
+                    }
+                }
+            }
+        }
+        ucnv_close(sourceCnv);
+        ucnv_close(targetCnv);
+    }
+
+    /* A custom callback is called exactly as often as with sequential conversion. */
+    {
+        UConverter *sourceCnv, *targetCnv;
+        int32_t srcLength, expectLength, resultLength, expectCount=0, count=0;
+        UErrorCode errorCode=U_ZERO_ERROR;
+        sourceCnv=ucnv_open("UTF-8", &errorCode);
+        targetCnv=ucnv_open("UTF-16BE", &errorCode);
+        for(srcLength=0; srcLength+5<=SRC_LENGTH; srcLength+=5) {
+            uprv_memcpy(src+srcLength, "abc\xff\n", 5);
+        }
+        ucnv_setToUCallBack(sourceCnv, countingToUCallback, &expectCount, NULL, NULL, &errorCode);
+        expectLength=ucnv_convertParallel(targetCnv, sourceCnv, expect, 4*SRC_LENGTH,
+                                          src, srcLength, 1, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("ucnv_convertParallel(custom callback, 1 thread) failed - %s\n", u_errorName(errorCode));
+        } else {
+            ucnv_setToUCallBack(sourceCnv, countingToUCallback, &count, NULL, NULL, &errorCode);
+            resultLength=ucnv_convertParallel(targetCnv, sourceCnv, result, 4*SRC_LENGTH,
+                                              src, srcLength, 8, &errorCode);
+            if( errorCode!=U_SEQUENTIAL_FALLBACK_WARNING || resultLength!=expectLength ||
+                uprv_memcmp(result, expect, expectLength)!=0 ||
+                count!=expectCount || count!=srcLength/5
+            ) {
+                log_err("ucnv_convertParallel(custom callback, 8 threads) differs from sequential: "
+                        "length %d vs. %d, %d vs. %d callbacks, %s\n",
+                        (int)resultLength, (int)expectLength, (int)count, (int)expectCount,
+                        u_errorName(errorCode));
+            }
+        }
+        ucnv_close(sourceCnv);
+        ucnv_close(targetCnv);
+    }
+    free(src);
+    free(expect);
+    free(result);
+#endif
+}
+
 static void
 TestConvertAlgorithmic() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
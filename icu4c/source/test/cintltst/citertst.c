@@ -58,6 +58,8 @@ void addCollIterTest(TestNode** root)
     addTest(root, &TestSmallBuffer, "tscoll/citertst/TestSmallBuffer");
     addTest(root, &TestDiscontiguos, "tscoll/citertst/TestDiscontiguos");
     addTest(root, &TestSearchCollatorElements, "tscoll/citertst/TestSearchCollatorElements");
+    addTest(root, &TestNextCEs, "tscoll/citertst/TestNextCEs");
+    addTest(root, &TestUTF8Elements, "tscoll/citertst/TestUTF8Elements");
 }
 
 /* The locales we support */
@@ -1258,4 +1260,252 @@ static void TestSearchCollatorElements(void)
     }
 }
 
+/* Texts with expansions, contractions, unnormalized and supplementary characters. */
+static const char *const nextCEsTexts[] = {
+    "",
+    "abc",
+    "\\u00e6\\u00c4ffi\\uFB03\\u01c4 sch\\u00df",
+    "chLLama caballo",
+    "a\\u0301\\u0327c\\u0327\\u0301\\u1e09\\u0f73\\u0f81",
+    "\\u0e40\\u0e01\\u0e44\\u0e02 \\u0e01\\u0e33",
+    "\\uac00\\u1100\\u1161\\u11a8\\u3131 \\u30ab\\u30fc\\u30ad",
+    "\\U0001D15F\\U0001D165\\U00020000x\\U0001F600 123",
+    "\\u0410\\u0439\\u0418\\u0306\\u0451"
+};
+
+static const char *const nextCEsLocales[] = {
+    "root", "es@collation=traditional", "th", "ja", "ko", "da"
+};
+
+/* Same as CollationElementIterator's conversion of a 64-bit CE into two old-style 32-bit CEs. */
+static int32_t getCEHalves(int64_t ce, uint32_t halves[2]) {
+    uint32_t p = (uint32_t)(ce >> 32);
+    uint32_t lower32 = (uint32_t)ce;
+    uint32_t secondHalf = (p << 16) | ((lower32 >> 8) & 0xff00) | (lower32 & 0x3f);
+    halves[0] = (p & 0xffff0000) | ((lower32 >> 16) & 0xff00) | ((lower32 >> 8) & 0xff);
+    if (secondHalf != 0) {
+        halves[1] = secondHalf | 0xc0;
+        return 2;
+    }
+    return 1;
+}
+
+/*
+ * Checks that ucol_nextCEs() with the given capacity returns the same elements
+ * as ucol_next(), with offsets as from ucol_getOffset() after ucol_next().
+ * Returns the number of CEs.
+ */
+static int32_t checkNextCEs(UCollationElements *elems, const char *name, int32_t capacity,
+                            const int32_t *expectedOrders, const int32_t *expectedOffsets,
+                            int32_t expectedLength) {
+    int64_t ces[100];
+    int32_t offsets[100];
+    int32_t numCEs = 0, numOrders = 0, length;
+    UErrorCode status = U_ZERO_ERROR;
+    ucol_reset(elems);
+    do {
+        int32_t i;
+        length = ucol_nextCEs(elems, ces + numCEs, capacity, offsets + numCEs, &status);
+        if (U_FAILURE(status)) {
+            log_err("%s: ucol_nextCEs() failed: %s\n", name, u_errorName(status));
+            return numCEs;
+        }
+        for (i = numCEs; i < numCEs + length; ++i) {
+            uint32_t halves[2];
+            int32_t numHalves = getCEHalves(ces[i], halves), j;
+            for (j = 0; j < numHalves; ++j) {
+                if (numOrders >= expectedLength || (uint32_t)expectedOrders[numOrders] != halves[j]) {
+                    log_err("%s capacity %d: CE[%d] half %d = %08lx does not match ucol_next()\n",
+                            name, capacity, i, j, (long)halves[j]);
+                    return numCEs;
+                }
+                if (j == 0 && offsets[i] != expectedOffsets[numOrders]) {
+                    log_err("%s capacity %d: offsets[%d] = %d but ucol_getOffset() = %d\n",
+                            name, capacity, i, offsets[i], expectedOffsets[numOrders]);
+                }
+                ++numOrders;
+            }
+        }
+        numCEs += length;
+    } while (length == capacity && numCEs + capacity <= UPRV_LENGTHOF(ces));
+    if (numOrders != expectedLength) {
+        log_err("%s capacity %d: %d CE halves but ucol_next() returned %d\n",
+                name, capacity, numOrders, expectedLength);
+    }
+    return numCEs;
+}
+
+static void TestNextCEs(void) {
+    int32_t l, t;
+    for (l = 0; l < UPRV_LENGTHOF(nextCEsLocales); ++l) {
+        UErrorCode status = U_ZERO_ERROR;
+        UCollator *coll = ucol_open(nextCEsLocales[l], &status);
+        int32_t norm;
+        if (U_FAILURE(status)) {
+            log_data_err("ucol_open(%s) failed: %s\n", nextCEsLocales[l], u_errorName(status));
+            continue;
+        }
+        for (norm = 0; norm < 2; ++norm) {
+            ucol_setAttribute(coll, UCOL_NORMALIZATION_MODE, norm ? UCOL_ON : UCOL_OFF, &status);
+            for (t = 0; t < UPRV_LENGTHOF(nextCEsTexts); ++t) {
+                UChar text[100];
+                char text8[300];
+                int32_t orders[200], offsets[200], offsets8[200];
+                int32_t length = u_unescape(nextCEsTexts[t], text, UPRV_LENGTHOF(text));
+                int32_t length8, numOrders = 0, numCEs, i;
+                int64_t ces[100], ces8[100];
+                int32_t ceOffsets[100], ceOffsets8[100];
+                char name[100];
+                UCollationElements *elems = ucol_openElements(coll, text, length, &status);
+                UCollationElements *elems8;
+                u_strToUTF8(text8, UPRV_LENGTHOF(text8), &length8, text, length, &status);
+                elems8 = ucol_openElementsUTF8(coll, text8, length8, &status);
+                if (U_FAILURE(status)) {
+                    log_err("ucol_openElements(%s) failed: %s\n", nextCEsLocales[l], u_errorName(status));
+                    ucol_closeElements(elems);
+                    ucol_closeElements(elems8);
+                    break;
+                }
+                sprintf(name, "%s norm=%d text %d", nextCEsLocales[l], (int)norm, (int)t);
+                for (;;) {
+                    int32_t order = ucol_next(elems, &status);
+                    if (order == UCOL_NULLORDER || U_FAILURE(status)) { break; }
+                    orders[numOrders] = order;
+                    offsets[numOrders] = ucol_getOffset(elems);
+                    /* Expected UTF-8 offset: the length of the UTF-8 prefix. */
+                    u_strToUTF8(NULL, 0, &offsets8[numOrders], text, offsets[numOrders], &status);
+                    status = U_ZERO_ERROR;
+                    ++numOrders;
+                }
+                numCEs = checkNextCEs(elems, name, 1, orders, offsets, numOrders);
+                checkNextCEs(elems, name, 3, orders, offsets, numOrders);
+                checkNextCEs(elems, name, 100, orders, offsets, numOrders);
+                checkNextCEs(elems8, name, 2, orders, offsets8, numOrders);
+
+                /* UTF-8 text yields the same CEs as UTF-16 text. */
+                ucol_reset(elems);
+                ucol_reset(elems8);
+                if (ucol_nextCEs(elems, ces, UPRV_LENGTHOF(ces), ceOffsets, &status) != numCEs ||
+                        ucol_nextCEs(elems8, ces8, UPRV_LENGTHOF(ces8), ceOffsets8, &status) != numCEs) {
+                    log_err("%s: wrong number of CEs\n", name);
+                }
+                for (i = 0; i < numCEs; ++i) {
+                    if (ces[i] != ces8[i]) {
+                        log_err("%s: UTF-8 CE[%d] differs from UTF-16\n", name, (int)i);
+                        break;
+                    }
+                }
+                /* At the end of the text. */
+                if (ucol_nextCEs(elems, ces, UPRV_LENGTHOF(ces), NULL, &status) != 0 ||
+                        U_FAILURE(status)) {
+                    log_err("%s: ucol_nextCEs() at the end returned CEs or failed: %s\n",
+                            name, u_errorName(status));
+                }
+                ucol_closeElements(elems);
+                ucol_closeElements(elems8);
+            }
+        }
+        ucol_close(coll);
+    }
+}
+
+static void TestUTF8Elements(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("es@collation=traditional", &status);
+    UChar text[100];
+    char text8[300];
+    int32_t length, length8, i;
+    int64_t ces[100];
+    UCollationElements *elems, *elems8;
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open() failed: %s\n", u_errorName(status));
+        return;
+    }
+    ucol_setAttribute(coll, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+    length = u_unescape("x\\u00e6chLa\\u0301\\u0327c\\U0001D15F\\U0001D165\\u0e40\\u0e01y", text, UPRV_LENGTHOF(text));
+    u_strToUTF8(text8, UPRV_LENGTHOF(text8), &length8, text, length, &status);
+    elems = ucol_openElements(coll, text, length, &status);
+    elems8 = ucol_openElementsUTF8(coll, text8, -1, &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_openElementsUTF8() failed: %s\n", u_errorName(status));
+        ucol_closeElements(elems);
+        ucol_closeElements(elems8);
+        ucol_close(coll);
+        return;
+    }
+
+    /* Backward iteration yields the same elements and mapped offsets. */
+    for (;;) {
+        int32_t order = ucol_previous(elems, &status);
+        int32_t order8 = ucol_previous(elems8, &status);
+        int32_t offset8;
+        u_strToUTF8(NULL, 0, &offset8, text, ucol_getOffset(elems), &status);
+        status = U_ZERO_ERROR;
+        if (order != order8 || offset8 != ucol_getOffset(elems8)) {
+            log_err("UTF-8 ucol_previous() %08lx offset %d != UTF-16 %08lx offset %d\n",
+                    (long)order8, ucol_getOffset(elems8), (long)order, offset8);
+            break;
+        }
+        if (order == UCOL_NULLORDER) { break; }
+    }
+    /* ucol_nextCEs() after ucol_previous() is a direction change. */
+    ucol_nextCEs(elems8, ces, UPRV_LENGTHOF(ces), NULL, &status);
+    if (status != U_INVALID_STATE_ERROR) {
+        log_err("ucol_nextCEs() after ucol_previous(): %s\n", u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+
+    /* ucol_setOffset() at every code point boundary. */
+    for (i = 0; i <= length; ++i) {
+        int32_t offset8;
+        int32_t order, order8;
+        if (i < length && U16_IS_TRAIL(text[i])) { continue; }
+        u_strToUTF8(NULL, 0, &offset8, text, i, &status);
+        status = U_ZERO_ERROR;
+        ucol_setOffset(elems, i, &status);
+        ucol_setOffset(elems8, offset8, &status);
+        u_strToUTF8(NULL, 0, &offset8, text, ucol_getOffset(elems), &status);
+        status = U_ZERO_ERROR;
+        if (offset8 != ucol_getOffset(elems8)) {
+            log_err("ucol_setOffset(%d): UTF-8 offset %d != %d\n",
+                    (int)i, ucol_getOffset(elems8), offset8);
+        }
+        order = ucol_next(elems, &status);
+        order8 = ucol_next(elems8, &status);
+        if (order != order8 || U_FAILURE(status)) {
+            log_err("ucol_next() after ucol_setOffset(%d): UTF-8 %08lx != %08lx %s\n",
+                    (int)i, (long)order8, (long)order, u_errorName(status));
+        }
+    }
+
+    /* Ill-formed UTF-8 is treated like U+FFFD. */
+    {
+        static const UChar fffd[] = { 0x61, 0xfffd, 0x62 };
+        int64_t ces16[10];
+        int32_t numCEs, numCEs16;
+        ucol_setTextUTF8(elems8, "a\xff" "b", 3, &status);
+        ucol_setText(elems, fffd, 3, &status);
+        numCEs = ucol_nextCEs(elems8, ces, UPRV_LENGTHOF(ces), NULL, &status);
+        numCEs16 = ucol_nextCEs(elems, ces16, UPRV_LENGTHOF(ces16), NULL, &status);
+        if (U_FAILURE(status) || numCEs != numCEs16 ||
+                uprv_memcmp(ces, ces16, numCEs * 8) != 0) {
+            log_err("ill-formed UTF-8 not like U+FFFD: %s\n", u_errorName(status));
+        }
+    }
+
+    /* Back to UTF-16 text, with UTF-16 offsets. */
+    ucol_setText(elems8, text, length, &status);
+    ucol_setText(elems, text, length, &status);
+    ucol_setOffset(elems8, length - 1, &status);
+    ucol_setOffset(elems, length - 1, &status);
+    if (ucol_next(elems8, &status) != ucol_next(elems, &status) ||
+            ucol_getOffset(elems8) != length || U_FAILURE(status)) {
+        log_err("ucol_setText() after ucol_setTextUTF8() failed: %s\n", u_errorName(status));
+    }
+
+    ucol_closeElements(elems);
+    ucol_closeElements(elems8);
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -90,6 +90,15 @@ static void TestDiscontiguos(void);
 * normalization on AND jamo tailoring, among other things.
 */
 static void TestSearchCollatorElements(void);
+/**
+* Tests ucol_nextCEs() vs. ucol_next(), and UTF-8 text vs. UTF-16 text.
+*/
+static void TestNextCEs(void);
+/**
+* Tests ucol_openElementsUTF8() and ucol_setTextUTF8() with
+* ucol_previous(), ucol_setOffset() and ill-formed text.
+*/
+static void TestUTF8Elements(void);
 
 /*------------------------------------------------------------------------
  Internal utilities
@@ -21,6 +21,7 @@
 #include "unicode/utf16.h"
 #include "cintltst.h"
 #include "cmemory.h"
+#include "cstring.h"
 
 #if !UCONFIG_NO_NORMALIZATION
 
@@ -65,6 +66,9 @@ TestGetRawDecomposition(void);
 
 static void TestAppendRestoreMiddle(void);
 static void TestGetEasyToUseInstance(void);
+static void TestStreaming(void);
+
+static void TestBatch(void);
 
 static const char* const canonTests[][3] = {
     /* Input*/                    /*Decomposed*/                /*Composed*/
@@ -156,6 +160,8 @@ void addNormTest(TestNode** root)
     addTest(root, &TestGetRawDecomposition, "tsnorm/cnormtst/TestGetRawDecomposition");
     addTest(root, &TestAppendRestoreMiddle, "tsnorm/cnormtst/TestAppendRestoreMiddle");
     addTest(root, &TestGetEasyToUseInstance, "tsnorm/cnormtst/TestGetEasyToUseInstance");
+    addTest(root, &TestStreaming, "tsnorm/cnormtst/TestStreaming");
+    addTest(root, &TestBatch, "tsnorm/cnormtst/TestBatch");
 }
 
 static const char* const modeStrings[]={
@@ -1693,4 +1699,171 @@ TestGetEasyToUseInstance() {
     }
 }
 
+static void
+TestStreaming() {
+    /* a+U+0308 split across chunks, and a surrogate pair split across chunks */
+    static const UChar in1[]={ 0x61 };
+    static const UChar in2[]={ 0x308, 0x62, 0xd83d };
+    static const UChar in3[]={ 0xde00, 0x20 };
+    static const UChar expected[]={ 0xe4, 0x62, 0xd83d, 0xde00, 0x20 };
+    static const char *const in8[]={ "a", "\xcc", "\x88" "b\xf0\x9f", "\x98\x80 " };
+    static const char expected8[]="\xc3\xa4" "b\xf0\x9f\x98\x80 ";
+    const UChar *const chunks[]={ in1, in2, in3 };
+    const int32_t lengths[]={ UPRV_LENGTHOF(in1), UPRV_LENGTHOF(in2), UPRV_LENGTHOF(in3) };
+    UChar out[16];
+    char out8[16];
+    int32_t length=0, i;
+
+    UErrorCode errorCode=U_ZERO_ERROR;
+    const UNormalizer2 *n2=unorm2_getNFCInstance(&errorCode);
+    UStreamingNormalizer2 *sn;
+    if(U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "unorm2_getNFCInstance() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    sn=unorm2_openStreaming(n2, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("unorm2_openStreaming() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    /*
+     * Preflight each chunk: On overflow, the chunk is not consumed,
+     * and passing it again with the required capacity continues the stream.
+     */
+    for(i=0; i<UPRV_LENGTHOF(chunks); ++i) {
+        UBool flush=(UBool)(i==UPRV_LENGTHOF(chunks)-1);
+        int32_t outLength;
+        errorCode=U_ZERO_ERROR;
+        outLength=unorm2_normalizeStreaming(sn, chunks[i], lengths[i], flush, NULL, 0, &errorCode);
+        if(outLength>0 ? errorCode!=U_BUFFER_OVERFLOW_ERROR : U_FAILURE(errorCode)) {
+            log_err("unorm2_normalizeStreaming(chunk %d, preflighting) failed: %s\n",
+                    (int)i, u_errorName(errorCode));
+            unorm2_closeStreaming(sn);
+            return;
+        }
+        if(outLength>0) {
+            /* Without overflow, the chunk has been consumed. */
+            errorCode=U_ZERO_ERROR;
+            if(outLength!=unorm2_normalizeStreaming(sn, chunks[i], lengths[i], flush,
+                                                    out+length, outLength, &errorCode) ||
+                    U_FAILURE(errorCode)) {
+                log_err("unorm2_normalizeStreaming(chunk %d) failed: %s\n", (int)i, u_errorName(errorCode));
+                unorm2_closeStreaming(sn);
+                return;
+            }
+            length+=outLength;
+        }
+    }
+    if(length!=UPRV_LENGTHOF(expected) || 0!=u_memcmp(out, expected, length)) {
+        log_err("unorm2_normalizeStreaming() wrong result (length=%d)\n", (int)length);
+    }
+
+    length=0;
+    for(i=0; i<UPRV_LENGTHOF(in8); ++i) {
+        errorCode=U_ZERO_ERROR;
+        length+=unorm2_normalizeStreamingUTF8(sn, in8[i], -1, (UBool)(i==UPRV_LENGTHOF(in8)-1),
+                                              out8+length, UPRV_LENGTHOF(out8)-length, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("unorm2_normalizeStreamingUTF8(chunk %d) failed: %s\n", (int)i, u_errorName(errorCode));
+            unorm2_closeStreaming(sn);
+            return;
+        }
+    }
+    if(length!=(int32_t)uprv_strlen(expected8) || 0!=uprv_memcmp(out8, expected8, length)) {
+        log_err("unorm2_normalizeStreamingUTF8() wrong result (length=%d)\n", (int)length);
+    }
+
+    /* UTF-8 overflow on the last chunk: The pending text must be kept. */
+    errorCode=U_ZERO_ERROR;
+    length=unorm2_normalizeStreamingUTF8(sn, "a", -1, FALSE, out8, UPRV_LENGTHOF(out8), &errorCode);
+    if(U_FAILURE(errorCode) || length!=0) {
+        log_err("unorm2_normalizeStreamingUTF8(a) failed: %s length=%d\n",
+                u_errorName(errorCode), (int)length);
+    }
+    errorCode=U_ZERO_ERROR;
+    length=unorm2_normalizeStreamingUTF8(sn, "\xcc\x88", -1, TRUE, out8, 1, &errorCode);
+    if(errorCode!=U_BUFFER_OVERFLOW_ERROR || length!=2) {
+        log_err("unorm2_normalizeStreamingUTF8(U+0308, capacity 1) did not report overflow: %s length=%d\n",
+                u_errorName(errorCode), (int)length);
+    }
+    errorCode=U_ZERO_ERROR;
+    length=unorm2_normalizeStreamingUTF8(sn, "\xcc\x88", -1, TRUE, out8, UPRV_LENGTHOF(out8), &errorCode);
+    if(U_FAILURE(errorCode) || length!=2 || 0!=uprv_strcmp(out8, "\xc3\xa4")) {
+        log_err("unorm2_normalizeStreamingUTF8(U+0308) after overflow failed: %s length=%d\n",
+                u_errorName(errorCode), (int)length);
+    }
+
+    errorCode=U_ZERO_ERROR;
+    unorm2_normalizeStreaming(sn, NULL, 1, FALSE, out, UPRV_LENGTHOF(out), &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("unorm2_normalizeStreaming(src=NULL, length=1) did not fail: %s\n", u_errorName(errorCode));
+    }
+    errorCode=U_ZERO_ERROR;
+    unorm2_normalizeStreaming(sn, in1, -2, FALSE, out, UPRV_LENGTHOF(out), &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("unorm2_normalizeStreaming(length=-2) did not fail: %s\n", u_errorName(errorCode));
+    }
+    unorm2_closeStreaming(sn);
+}
+
+
+static void
+TestBatch() {
+    static const UChar s1[]={ 0x61, 0x308, 0 };
+    static const UChar s2[]={ 0xe4, 0 };
+    static const UChar s3[]={ 0x62, 0x301, 0x327 };
+    const UChar *const src[]={ s1, s2, s3 };
+    const int32_t lengths[]={ -1, -1, UPRV_LENGTHOF(s3) };
+    static const char *const src8[]={ "a\xcc\x88", "", "x\xcc\x81\xcc\xa7" };
+    static const char expected8[]="\xc3\xa4" "x\xcc\xa7\xcc\x81";
+    static const int32_t expectedOffsets[]={ 0, 2, 2, 7 };
+    UNormalizationCheckResult results[3];
+    char out8[16];
+    int32_t offsets[4];
+    int32_t length, i;
+
+    UErrorCode errorCode=U_ZERO_ERROR;
+    const UNormalizer2 *n2=unorm2_getNFCInstance(&errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "unorm2_getNFCInstance() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    unorm2_quickCheckBatch(n2, src, lengths, UPRV_LENGTHOF(src), results, 2, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("unorm2_quickCheckBatch() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    if(results[0]!=UNORM_MAYBE || results[1]!=UNORM_YES || results[2]!=UNORM_NO) {
+        log_err("unorm2_quickCheckBatch() wrong results\n");
+    }
+
+    /* preflighting */
+    length=unorm2_normalizeUTF8Batch(n2, src8, NULL, UPRV_LENGTHOF(src8), NULL, 0, offsets, 1, &errorCode);
+    if(errorCode!=U_BUFFER_OVERFLOW_ERROR || length!=(int32_t)uprv_strlen(expected8)) {
+        log_err("unorm2_normalizeUTF8Batch(preflighting) failed: %s length=%d\n",
+                u_errorName(errorCode), (int)length);
+    }
+    errorCode=U_ZERO_ERROR;
+    length=unorm2_normalizeUTF8Batch(n2, src8, NULL, UPRV_LENGTHOF(src8),
+                                     out8, UPRV_LENGTHOF(out8), offsets, 1, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("unorm2_normalizeUTF8Batch() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    if(length!=(int32_t)uprv_strlen(expected8) || 0!=uprv_memcmp(out8, expected8, length)) {
+        log_err("unorm2_normalizeUTF8Batch() wrong result (length=%d)\n", (int)length);
+    }
+    for(i=0; i<UPRV_LENGTHOF(offsets); ++i) {
+        if(offsets[i]!=expectedOffsets[i]) {
+            log_err("unorm2_normalizeUTF8Batch() offsets[%d]=%d instead of %d\n",
+                    (int)i, (int)offsets[i], (int)expectedOffsets[i]);
+        }
+    }
+
+    unorm2_quickCheckBatch(n2, src, NULL, UPRV_LENGTHOF(src), NULL, 1, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("unorm2_quickCheckBatch(results=NULL) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
@@ -23,6 +23,8 @@
 #include "unicode/utypes.h"
 #include "unicode/ustring.h"
 #include "unicode/ures.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "ustr_imp.h"
 #include "cintltst.h"
 #include "cmemory.h"
@@ -44,6 +46,7 @@ static void Test_WCHART_LongString(void);
 static void Test_strToJavaModifiedUTF8(void);
 static void Test_strFromJavaModifiedUTF8(void);
 static void TestNullEmptySource(void);
+static void Test_UTF8Blocks(void);
 
 void 
 addUCharTransformTest(TestNode** root)
@@ -63,6 +66,7 @@ addUCharTransformTest(TestNode** root)
    addTest(root, &Test_strToJavaModifiedUTF8,  "custrtrn/Test_strToJavaModifiedUTF8");
    addTest(root, &Test_strFromJavaModifiedUTF8,  "custrtrn/Test_strFromJavaModifiedUTF8");
    addTest(root, &TestNullEmptySource,  "custrtrn/TestNullEmptySource");
+   addTest(root, &Test_UTF8Blocks,  "custrtrn/Test_UTF8Blocks");
 }
 
 static const UChar32 src32[]={
@@ -2114,3 +2118,120 @@ static void TestNullEmptySource() {
 
 #endif
 }
+
+/*
+ * u_strFromUTF8WithSub() and u_strToUTF8WithSub() convert blocks of text with vector code.
+ * Runs of ASCII, Latin, Cyrillic, CJK and supplementary characters and ill-formed sequences
+ * make the blocks start and stop at all positions.
+ * The results must match simple U8_NEXT() and U16_NEXT() loops.
+ */
+static void Test_UTF8Blocks() {
+    static const char *const pieces[]={
+        "The quick brown fox jumps over the lazy dog. ",
+        "d\xC3\xA9j\xC3\xA0 vu, na\xC3\xAFve ",
+        "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 ",
+        "\xE4\xB8\xAD\xE6\x96\x87\xE6\x96\x87\xE6\x9C\xAC\xE3\x80\x82",
+        "\xF0\x9F\x98\x80",
+        "\xEF\xBF\xBD\xE0\xA0\x80\xED\x9F\xBF\xDF\xBF",
+        /* ill-formed */
+        "\x80", "\xC0\xAF", "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE4\xB8", "\xFE"
+    };
+    static const int32_t numValidPieces=6;
+    char utf8[3000];
+    UChar expected[3000], utf16[3000], dest16[3000];
+    char expected8[9000], dest8[9000];
+    int32_t utf8Length=0, utf16Length=0;
+    int32_t i, j, start;
+
+    for(j=0; utf8Length<2900; ++j) {
+        int32_t piece= (j%11)==10 ? numValidPieces+(j/11)%(UPRV_LENGTHOF(pieces)-numValidPieces) :
+                                    (j*5+j/7)%numValidPieces;
+        int32_t length=(int32_t)uprv_strlen(pieces[piece]);
+        if(piece==0) {
+            length=j%length+1;  /* vary the ASCII run lengths */
+        }
+        if(utf8Length+length>(int32_t)sizeof(utf8)) {
+            break;
+        }
+        uprv_memcpy(utf8+utf8Length, pieces[piece], length);
+        utf8Length+=length;
+    }
+    /* UTF-16 text with some unpaired surrogates */
+    for(i=0; i<utf8Length;) {
+        UChar32 c;
+        U8_NEXT(utf8, i, utf8Length, c);
+        if(c<0) {
+            c= (i%3)==0 ? 0xdc00 : 0xfffd;
+        }
+        U16_APPEND_UNSAFE(utf16, utf16Length, c);
+    }
+
+    for(start=0; start<40; ++start) {
+        const char *src=utf8+start;
+        int32_t srcLength=utf8Length-start-(start%5), expectedLength=0, expectedSubs=0;
+        int32_t destLength, numSubs, capacity;
+        UErrorCode errorCode;
+
+        for(i=0; i<srcLength;) {
+            UChar32 c;
+            U8_NEXT(src, i, srcLength, c);
+            if(c<0) {
+                c=0xfffd;
+                ++expectedSubs;
+            }
+            U16_APPEND_UNSAFE(expected, expectedLength, c);
+        }
+        for(j=3; j>=1; --j) {
+            capacity=expectedLength*j/3;
+            errorCode=U_ZERO_ERROR;
+            u_strFromUTF8WithSub(dest16, capacity, &destLength, src, srcLength,
+                                 0xfffd, &numSubs, &errorCode);
+            if(capacity==expectedLength ? U_FAILURE(errorCode) : errorCode!=U_BUFFER_OVERFLOW_ERROR) {
+                log_err("u_strFromUTF8WithSub(start %d, capacity %d) failed: %s\n",
+                        (int)start, (int)capacity, u_errorName(errorCode));
+            } else if(destLength!=expectedLength || numSubs!=expectedSubs) {
+                log_err("u_strFromUTF8WithSub(start %d, capacity %d) length %d numSubs %d != expected %d %d\n",
+                        (int)start, (int)capacity, (int)destLength, (int)numSubs,
+                        (int)expectedLength, (int)expectedSubs);
+            } else if(u_memcmp(dest16, expected, capacity)!=0) {
+                log_err("u_strFromUTF8WithSub(start %d, capacity %d) wrong output\n",
+                        (int)start, (int)capacity);
+            }
+        }
+    }
+
+    for(start=0; start<40; ++start) {
+        const UChar *src=utf16+start;
+        int32_t srcLength=utf16Length-start-(start%5), expectedLength=0, expectedSubs=0;
+        int32_t destLength, numSubs, capacity;
+        UErrorCode errorCode;
+
+        for(i=0; i<srcLength;) {
+            UChar32 c;
+            U16_NEXT(src, i, srcLength, c);
+            if(U_IS_SURROGATE(c)) {
+                c=0xfffd;
+                ++expectedSubs;
+            }
+            U8_APPEND_UNSAFE(expected8, expectedLength, c);
+        }
+        for(j=3; j>=1; --j) {
+            capacity=expectedLength*j/3;
+            errorCode=U_ZERO_ERROR;
+            u_strToUTF8WithSub(dest8, capacity, &destLength, src, srcLength,
+                               0xfffd, &numSubs, &errorCode);
+            if(capacity==expectedLength ? U_FAILURE(errorCode) : errorCode!=U_BUFFER_OVERFLOW_ERROR) {
+                log_err("u_strToUTF8WithSub(start %d, capacity %d) failed: %s\n",
+                        (int)start, (int)capacity, u_errorName(errorCode));
+            } else if(destLength!=expectedLength || numSubs!=expectedSubs) {
+                log_err("u_strToUTF8WithSub(start %d, capacity %d) length %d numSubs %d != expected %d %d\n",
+                        (int)start, (int)capacity, (int)destLength, (int)numSubs,
+                        (int)expectedLength, (int)expectedSubs);
+            } else if(uprv_memcmp(dest8, expected8, capacity-3)!=0) {
+                /* The last character may not have fit. */
+                log_err("u_strToUTF8WithSub(start %d, capacity %d) wrong output\n",
+                        (int)start, (int)capacity);
+            }
+        }
+    }
+}
@@ -25,6 +25,7 @@
 #include "unicode/ustring.h"
 #include "unicode/ucol.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "cmemory.h"
 #include "nucnvtst.h"
 
@@ -43,6 +44,7 @@ static void TestSignatureDetection(void);
 static void TestUTF7(void);
 static void TestIMAP(void);
 static void TestUTF8(void);
+static void TestUTF8Blocks(void);
 static void TestCESU8(void);
 static void TestUTF16(void);
 static void TestUTF16BE(void);
@@ -55,6 +57,7 @@ static void TestLATIN1(void);
 #if !UCONFIG_NO_LEGACY_CONVERSION
 static void TestSBCS(void);
 static void TestDBCS(void);
+static void TestASCIIRuns(void);
 static void TestMBCS(void);
 #if !UCONFIG_NO_LEGACY_CONVERSION && !UCONFIG_NO_FILE_IO
 static void TestICCRunout(void);
@@ -259,6 +262,7 @@ void addTestNewConvert(TestNode** root)
    addTest(root, &TestUTF7, "tsconv/nucnvtst/TestUTF7");
    addTest(root, &TestIMAP, "tsconv/nucnvtst/TestIMAP");
    addTest(root, &TestUTF8, "tsconv/nucnvtst/TestUTF8");
+   addTest(root, &TestUTF8Blocks, "tsconv/nucnvtst/TestUTF8Blocks");
 
    /* test ucnv_getNextUChar() for charsets that encode single surrogates with complete byte sequences */
    addTest(root, &TestCESU8, "tsconv/nucnvtst/TestCESU8");
@@ -279,6 +283,7 @@ void addTestNewConvert(TestNode** root)
    addTest(root, &TestSBCS, "tsconv/nucnvtst/TestSBCS");
 #if !UCONFIG_NO_FILE_IO
    addTest(root, &TestDBCS, "tsconv/nucnvtst/TestDBCS");
+   addTest(root, &TestASCIIRuns, "tsconv/nucnvtst/TestASCIIRuns");
    addTest(root, &TestICCRunout, "tsconv/nucnvtst/TestICCRunout");
 #endif
    addTest(root, &TestMBCS, "tsconv/nucnvtst/TestMBCS");
@@ -1961,6 +1966,59 @@ static void TestUTF8() {
     ucnv_close(cnv);
 }
 
+/*
+ * The UTF-8 and CESU-8 converters convert blocks of 1..3-byte sequences with vector code.
+ * Runs of ASCII, Latin, Cyrillic, CJK and supplementary characters of varying lengths
+ * make the blocks start and stop at all positions, for several buffer sizes.
+ */
+static void TestUTF8Blocks() {
+    static const UChar32 samples[]={
+        0x61, 0xe9, 0x41f, 0x4e2d, 0x20, 0x7ff, 0x800, 0x1f600, 0xfffd, 0x10ffff, 0xd7ff, 0xe000
+    };
+    static const int32_t bufferSizes[][2]={
+        { NEW_MAX_BUFFER, NEW_MAX_BUFFER }, { NEW_MAX_BUFFER, 1 }, { NEW_MAX_BUFFER, 19 },
+        { 1, NEW_MAX_BUFFER }, { 17, NEW_MAX_BUFFER }, { 25, 7 }
+    };
+    UChar text[900];
+    uint8_t utf8[900], cesu8[900];
+    int32_t fromUOffsets8[900], fromUOffsetsCESU[900], toUOffsets8[900], toUOffsetsCESU[900];
+    int32_t i, j, k, textLength=0, utf8Length=0, cesu8Length=0;
+
+    for(j=0; utf8Length<800 && cesu8Length<800; ++j) {
+        int32_t runLength=(j*7)%13+1;
+        UChar32 c=samples[j%UPRV_LENGTHOF(samples)];
+        for(k=0; k<runLength; ++k) {
+            UChar32 d= c==0x61 ? c+(j+k)%26 : c;
+            int32_t start=textLength, start8=utf8Length;
+            U16_APPEND_UNSAFE(text, textLength, d);
+            U8_APPEND_UNSAFE(utf8, utf8Length, d);
+            for(i=start8; i<utf8Length; ++i) {
+                fromUOffsets8[i]=start;
+            }
+            for(i=start; i<textLength; ++i) {
+                /* CESU-8 encodes each surrogate separately. */
+                int32_t startCESU=cesu8Length;
+                toUOffsets8[i]=start8;
+                toUOffsetsCESU[i]=startCESU;
+                U8_APPEND_UNSAFE(cesu8, cesu8Length, text[i]);
+                while(startCESU<cesu8Length) {
+                    fromUOffsetsCESU[startCESU++]=i;
+                }
+            }
+        }
+    }
+
+    for(j=0; j<UPRV_LENGTHOF(bufferSizes); ++j) {
+        gOutBufferSize=bufferSizes[j][0];
+        gInBufferSize=bufferSizes[j][1];
+        testConvertFromU(text, textLength, utf8, utf8Length, "UTF-8", fromUOffsets8, FALSE);
+        testConvertToU(utf8, utf8Length, text, textLength, "UTF-8", toUOffsets8, FALSE);
+        testConvertFromU(text, textLength, cesu8, cesu8Length, "CESU-8", fromUOffsetsCESU, FALSE);
+        testConvertToU(cesu8, cesu8Length, text, textLength, "CESU-8", toUOffsetsCESU, FALSE);
+    }
+    gInBufferSize=gOutBufferSize=NEW_MAX_BUFFER;
+}
+
 static void TestCESU8() {
     /* test input */
     static const uint8_t in[]={
@@ -2563,6 +2621,80 @@ TestSBCS() {
     ucnv_close(cnv);
 }
 
+/*
+ * Long ASCII runs are copied in blocks by SBCS and MBCS converters whose
+ * printable ASCII maps to itself. The runs must stop at C0 controls and DEL
+ * that the table maps elsewhere (ibm-943 swaps 1A, 1C and 7F)
+ * and at non-ASCII characters, with and without offsets, for all buffer sizes.
+ */
+static void
+TestASCIIRuns() {
+    static const struct {
+        const char *name;
+        UChar nonASCII[2];
+        uint8_t nonASCIIBytes[2][2];
+        int32_t nonASCIILengths[2];
+        UChar control;
+        uint8_t controlByte;
+    } cases[]={
+        { "windows-1252", { 0xe9, 0x20ac }, { { 0xe9 }, { 0x80 } }, { 1, 1 }, 0x7f, 0x7f },
+        { "ibm-943_P15A-2003", { 0x4e00, 0xff71 }, { { 0x88, 0xea }, { 0xb1 } }, { 2, 1 }, 0x1c, 0x1a },
+        { "ibm-970_P110_P110-2006_U2", { 0x4e00, 0xac00 }, { { 0xec, 0xe9 }, { 0xb0, 0xa1 } }, { 2, 2 }, 0x1a, 0x1a }
+    };
+    static const int32_t bufferSizes[][2]={
+        { NEW_MAX_BUFFER, NEW_MAX_BUFFER }, { NEW_MAX_BUFFER, 1 }, { NEW_MAX_BUFFER, 17 },
+        { 1, NEW_MAX_BUFFER }, { 3, NEW_MAX_BUFFER }, { 33, 5 }
+    };
+    UChar text[500];
+    uint8_t bytes[600];
+    int32_t fromUOffsets[600], toUOffsets[500];
+    int32_t i, j, k, textLength, bytesLength;
+
+    for(i=0; i<UPRV_LENGTHOF(cases); ++i) {
+        /* build runs of 0..69 printable ASCII characters, CR LF and TAB, separated by other characters */
+        textLength=bytesLength=0;
+        for(j=0; j<12; ++j) {
+            int32_t runLength=(j*29)%70;
+            for(k=0; k<runLength; ++k) {
+                UChar c=(k%23)==22 ? 9 : (UChar)(0x20+(j+k)%0x5f);
+                fromUOffsets[bytesLength]=textLength;
+                toUOffsets[textLength]=bytesLength;
+                text[textLength++]=c;
+                bytes[bytesLength++]=(uint8_t)c;
+            }
+            if(j%3==2) {
+                fromUOffsets[bytesLength]=textLength;
+                toUOffsets[textLength]=bytesLength;
+                text[textLength++]=cases[i].control;
+                bytes[bytesLength++]=cases[i].controlByte;
+            } else {
+                for(k=0; k<cases[i].nonASCIILengths[j&1]; ++k) {
+                    fromUOffsets[bytesLength]=textLength;
+                    bytes[bytesLength++]=cases[i].nonASCIIBytes[j&1][k];
+                }
+                toUOffsets[textLength]=bytesLength-cases[i].nonASCIILengths[j&1];
+                text[textLength++]=cases[i].nonASCII[j&1];
+            }
+            fromUOffsets[bytesLength]=textLength;
+            toUOffsets[textLength]=bytesLength;
+            text[textLength++]=0xd;
+            bytes[bytesLength++]=0xd;
+            fromUOffsets[bytesLength]=textLength;
+            toUOffsets[textLength]=bytesLength;
+            text[textLength++]=0xa;
+            bytes[bytesLength++]=0xa;
+        }
+
+        for(j=0; j<UPRV_LENGTHOF(bufferSizes); ++j) {
+            gOutBufferSize=bufferSizes[j][0];
+            gInBufferSize=bufferSizes[j][1];
+            testConvertFromU(text, textLength, bytes, bytesLength, cases[i].name, fromUOffsets, FALSE);
+            testConvertToU(bytes, bytesLength, text, textLength, cases[i].name, toUOffsets, FALSE);
+        }
+    }
+    gInBufferSize=gOutBufferSize=NEW_MAX_BUFFER;
+}
+
 static void
 TestDBCS() {
     /* test input */
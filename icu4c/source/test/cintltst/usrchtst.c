@@ -3005,6 +3005,292 @@ static void TestIndicPrefixMatch(void)
     close();
 }
 
+static UBool assertEqualWithSkipSearch(const SearchData search)
+{
+    UErrorCode      status      = U_ZERO_ERROR;
+    UChar           pattern[32];
+    UChar           text[128];
+    UCollator      *collator = getCollator(search.collator);
+    UBreakIterator *breaker  = getBreakIterator(search.breaker);
+    UStringSearch  *strsrch;
+    UBool           result;
+
+    CHECK_BREAK_BOOL(search.breaker);
+    u_unescape(search.text, text, 128);
+    u_unescape(search.pattern, pattern, 32);
+    ucol_setStrength(collator, search.strength);
+    strsrch = usearch_openFromCollator(pattern, -1, text, -1, collator,
+                                       breaker, &status);
+    usearch_setAttribute(strsrch, USEARCH_SKIP_SEARCH, USEARCH_ON, &status);
+    if (U_FAILURE(status)) {
+        log_err("Error opening string search %s\n", u_errorName(status));
+        ucol_setStrength(collator, UCOL_TERTIARY);
+        usearch_close(strsrch);
+        return FALSE;
+    }
+
+    result = assertEqualWithUStringSearch(strsrch, search);
+    ucol_setStrength(collator, UCOL_TERTIARY);
+    usearch_close(strsrch);
+    return result;
+}
+
+/* Collects the forward matches as start/length pairs. */
+static int32_t getForwardMatches(UStringSearch *strsrch, int32_t *matches, int32_t capacity,
+                                 UErrorCode *status)
+{
+    int32_t count = 0;
+    int32_t start = usearch_first(strsrch, status);
+    while (U_SUCCESS(*status) && start != USEARCH_DONE && count + 2 <= capacity) {
+        matches[count++] = start;
+        matches[count++] = usearch_getMatchedLength(strsrch);
+        start = usearch_next(strsrch, status);
+    }
+    return count;
+}
+
+/*
+ * Compares the skip search with the regular search on pseudo-random text
+ * made of characters that exercise contractions, prefixes, expansions,
+ * combining marks, variable characters and supplementary code points.
+ */
+static void TestSkipSearchRandom(void)
+{
+    static const char *const locales[] = { "en", "es@collation=traditional", "th", "ja", "ru", "da" };
+    static const char *const alphabet[] = {
+        "a", "b", "c", "h", "l", "e", "\\u00e9", "\\u0301", "\\u0323", " ", "-", "!",
+        "\\u0e40", "\\u0e01", "\\u30a2", "\\u30fc", "\\u0438", "\\u0306", "\\u00df", "s",
+        "\\u00e6", "\\u00c5", "\\u1e09", "\\u0f73", "A", "\\U0001D400", "\\u1100", "\\u1161", "\\uac00", "1"
+    };
+    const int32_t alphabetSize = UPRV_LENGTHOF(alphabet);
+    uint32_t random = 1;
+    int32_t l;
+
+    for (l = 0; l < UPRV_LENGTHOF(locales); ++l) {
+        UErrorCode status = U_ZERO_ERROR;
+        UCollator *coll = ucol_open(locales[l], &status);
+        int32_t settings;
+        if (U_FAILURE(status)) {
+            log_data_err("ucol_open(%s) failed - %s\n", locales[l], u_errorName(status));
+            continue;
+        }
+        /* alternate shifted or not, primary or tertiary strength, normalization on or off */
+        for (settings = 0; settings < 8; ++settings) {
+            UChar text[400], pattern[40];
+            UStringSearch *strsrch;
+            int32_t iteration;
+
+            ucol_setAttribute(coll, UCOL_ALTERNATE_HANDLING,
+                              (settings & 1) ? UCOL_SHIFTED : UCOL_NON_IGNORABLE, &status);
+            ucol_setStrength(coll, (settings & 2) ? UCOL_PRIMARY : UCOL_TERTIARY);
+            ucol_setAttribute(coll, UCOL_NORMALIZATION_MODE,
+                              (settings & 4) ? UCOL_ON : UCOL_OFF, &status);
+            text[0] = pattern[0] = 0x61;
+            strsrch = usearch_openFromCollator(pattern, 1, text, 1, coll, NULL, &status);
+            if (U_FAILURE(status)) {
+                log_err("%s: error opening string search %s\n", locales[l], u_errorName(status));
+                break;
+            }
+            for (iteration = 0; iteration < 100; ++iteration) {
+                int32_t textLength = 0, patternLength = 0, i;
+                int32_t expected[200], actual[200];
+                int32_t expectedCount, actualCount;
+
+                for (i = 0; i < 60; ++i) {
+                    random = random * 1103515245 + 12345;
+                    textLength += u_unescape(alphabet[(random >> 16) % alphabetSize],
+                                             text + textLength, 4);
+                }
+                /* The pattern is either a piece of the text or random. */
+                random = random * 1103515245 + 12345;
+                if (random & 0x10000) {
+                    int32_t start = (random >> 17) % (textLength - 4);
+                    patternLength = 1 + ((random >> 24) % 4);
+                    u_memcpy(pattern, text + start, patternLength);
+                } else {
+                    int32_t n = 1 + ((random >> 24) % 3);
+                    for (i = 0; i < n; ++i) {
+                        random = random * 1103515245 + 12345;
+                        patternLength += u_unescape(alphabet[(random >> 16) % alphabetSize],
+                                                    pattern + patternLength, 4);
+                    }
+                }
+                usearch_setText(strsrch, text, textLength, &status);
+                usearch_setPattern(strsrch, pattern, patternLength, &status);
+                usearch_setAttribute(strsrch, USEARCH_OVERLAP,
+                                     (iteration & 1) ? USEARCH_ON : USEARCH_OFF, &status);
+                usearch_setAttribute(strsrch, USEARCH_SKIP_SEARCH, USEARCH_OFF, &status);
+                expectedCount = getForwardMatches(strsrch, expected, UPRV_LENGTHOF(expected), &status);
+                usearch_setAttribute(strsrch, USEARCH_SKIP_SEARCH, USEARCH_ON, &status);
+                actualCount = getForwardMatches(strsrch, actual, UPRV_LENGTHOF(actual), &status);
+                if (U_FAILURE(status)) {
+                    log_err("%s settings %d iteration %d: search failed - %s\n",
+                            locales[l], settings, iteration, u_errorName(status));
+                    status = U_ZERO_ERROR;
+                } else if (expectedCount != actualCount ||
+                        uprv_memcmp(expected, actual, expectedCount * 4) != 0) {
+                    log_err("%s settings %d iteration %d: skip search found %d matches, "
+                            "regular search %d (first at %d vs. %d) for pattern %s in text %s\n",
+                            locales[l], settings, iteration, actualCount / 2, expectedCount / 2,
+                            actualCount > 0 ? actual[0] : -1, expectedCount > 0 ? expected[0] : -1,
+                            aescstrdup(pattern, patternLength), aescstrdup(text, textLength));
+                }
+            }
+            usearch_close(strsrch);
+        }
+        ucol_close(coll);
+    }
+}
+
+static void TestSkipSearch(void)
+{
+    static const SearchData *const data[] = {
+        BASIC, STRENGTH, BREAKITERATOREXACT, COMPOSITEBOUNDARIES, SUPPLEMENTARY,
+        NORMEXACT, INDICPREFIXMATCH
+    };
+    UErrorCode     status = U_ZERO_ERROR;
+    UChar          pattern[] = { 0x61, 0 };
+    UChar          text[] = { 0x61, 0x62, 0x61, 0 };
+    UStringSearch *strsrch;
+    int32_t        i, count;
+
+    open(&status);
+    if (U_FAILURE(status)) {
+        log_err_status(status, "Unable to open static collators %s\n", u_errorName(status));
+        return;
+    }
+    strsrch = usearch_openFromCollator(pattern, -1, text, -1, EN_US_, NULL, &status);
+    if (U_FAILURE(status)) {
+        log_err("Error opening string search %s\n", u_errorName(status));
+        close();
+        return;
+    }
+    if (usearch_getAttribute(strsrch, USEARCH_SKIP_SEARCH) != USEARCH_OFF) {
+        log_err("Error: skip search should be off by default\n");
+    }
+    usearch_setAttribute(strsrch, USEARCH_SKIP_SEARCH, USEARCH_ON, &status);
+    if (U_FAILURE(status) ||
+            usearch_getAttribute(strsrch, USEARCH_SKIP_SEARCH) != USEARCH_ON) {
+        log_err("Error setting USEARCH_SKIP_SEARCH: %s\n", u_errorName(status));
+    }
+    if (usearch_first(strsrch, &status) != 0 || usearch_next(strsrch, &status) != 2 ||
+            usearch_next(strsrch, &status) != USEARCH_DONE) {
+        log_err("Error: skip search did not find the expected matches\n");
+    }
+    usearch_reset(strsrch);
+    if (usearch_getAttribute(strsrch, USEARCH_SKIP_SEARCH) != USEARCH_OFF) {
+        log_err("Error: usearch_reset() should turn skip search off\n");
+    }
+    usearch_close(strsrch);
+
+    for (i = 0; i < UPRV_LENGTHOF(data); ++i) {
+        if (data[i] == NORMEXACT) {
+            ucol_setAttribute(EN_US_, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+        }
+        for (count = 0; data[i][count].text != NULL; ++count) {
+            if (!assertEqualWithSkipSearch(data[i][count])) {
+                log_err("Error at test set %d number %d\n", i, count);
+            }
+        }
+        ucol_setAttribute(EN_US_, UCOL_NORMALIZATION_MODE, UCOL_OFF, &status);
+    }
+    ucol_setAttribute(EN_US_, UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, &status);
+    for (count = 0; VARIABLE[count].text != NULL; ++count) {
+        if (!assertEqualWithSkipSearch(VARIABLE[count])) {
+            log_err("Error at variable test number %d\n", count);
+        }
+    }
+    ucol_setAttribute(EN_US_, UCOL_ALTERNATE_HANDLING, UCOL_NON_IGNORABLE, &status);
+    close();
+}
+
+static void TestSetTextUTF8(void)
+{
+    /* a é t é sp U+1F600 sp <ill-formed> sp é t é ! */
+    static const char text[] =
+        "a\xC3\xA9t\xC3\xA9 \xF0\x9F\x98\x80 \xFF \xC3\xA9t\xC3\xA9!";
+    UErrorCode     status = U_ZERO_ERROR;
+    UChar          pattern[8];
+    UChar          utf16[8];
+    UStringSearch *strsrch;
+    const UChar   *text16;
+    int32_t        length16;
+
+    u_unescape("\\u00e9t\\u00e9", pattern, UPRV_LENGTHOF(pattern));
+    strsrch = usearch_open(pattern, -1, pattern, -1, "en", NULL, &status);
+    usearch_setTextUTF8(strsrch, text, -1, &status);
+    if (U_FAILURE(status)) {
+        log_err_status(status, "Error opening string search %s\n", u_errorName(status));
+        usearch_close(strsrch);
+        return;
+    }
+    text16 = usearch_getText(strsrch, &length16);
+    if (length16 != 14 || text16[1] != 0xe9 || text16[5] != 0xd83d || text16[8] != 0xfffd) {
+        log_err("Error: usearch_getText() returns unexpected UTF-16 text %s\n",
+                aescstrdup(text16, length16));
+    }
+    if (usearch_first(strsrch, &status) != 1 || usearch_getMatchedStart(strsrch) != 1 ||
+            usearch_getMatchedLength(strsrch) != 5 || usearch_getOffset(strsrch) != 1) {
+        log_err("Error: usearch_first() on UTF-8 text returns wrong offsets\n");
+    }
+    if (usearch_next(strsrch, &status) != 14 || usearch_getMatchedLength(strsrch) != 5 ||
+            usearch_next(strsrch, &status) != USEARCH_DONE) {
+        log_err("Error: usearch_next() on UTF-8 text returns wrong offsets\n");
+    }
+    if (usearch_last(strsrch, &status) != 14 || usearch_previous(strsrch, &status) != 1) {
+        log_err("Error: usearch_last()/usearch_previous() on UTF-8 text return wrong offsets\n");
+    }
+    if (usearch_following(strsrch, 6, &status) != 14 ||
+            usearch_preceding(strsrch, 14, &status) != 1) {
+        log_err("Error: usearch_following()/usearch_preceding() on UTF-8 text return wrong offsets\n");
+    }
+    usearch_setOffset(strsrch, 12, &status);
+    if (U_FAILURE(status) || usearch_getOffset(strsrch) != 12) {
+        log_err("Error: usearch_setOffset(12) on UTF-8 text - %s\n", u_errorName(status));
+    }
+    usearch_setOffset(strsrch, 21, &status);
+    if (status != U_INDEX_OUTOFBOUNDS_ERROR) {
+        log_err("Error: usearch_setOffset(21) past the UTF-8 text should fail\n");
+    }
+    status = U_ZERO_ERROR;
+
+    /* the supplementary and the ill-formed characters */
+    u_unescape("\\U0001F600", pattern, UPRV_LENGTHOF(pattern));
+    usearch_setPattern(strsrch, pattern, -1, &status);
+    if (usearch_first(strsrch, &status) != 7 || usearch_getMatchedLength(strsrch) != 4) {
+        log_err("Error: U+1F600 not found at UTF-8 offset 7 length 4\n");
+    }
+    pattern[0] = 0xfffd;
+    usearch_setPattern(strsrch, pattern, 1, &status);
+    if (usearch_first(strsrch, &status) != 12 || usearch_getMatchedLength(strsrch) != 1) {
+        log_err("Error: ill-formed byte not found as U+FFFD at UTF-8 offset 12 length 1\n");
+    }
+
+    /* with UTF-16 text, the offsets are UTF-16 again */
+    u_unescape("\\u00e9t\\u00e9", pattern, UPRV_LENGTHOF(pattern));
+    usearch_setPattern(strsrch, pattern, -1, &status);
+    u_unescape("x\\u00e9t\\u00e9", utf16, UPRV_LENGTHOF(utf16));
+    usearch_setText(strsrch, utf16, -1, &status);
+    if (usearch_first(strsrch, &status) != 1 || usearch_getMatchedLength(strsrch) != 3) {
+        log_err("Error: offsets after usearch_setText() should be UTF-16\n");
+    }
+    if (U_FAILURE(status)) {
+        log_err("Error: %s\n", u_errorName(status));
+    }
+
+    /* A length whose UTF-16 buffer size would overflow is rejected before the text is read. */
+    status = U_ZERO_ERROR;
+    usearch_setTextUTF8(strsrch, text, INT32_MAX, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("Error: usearch_setTextUTF8(length=INT32_MAX) should fail - %s\n", u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    if (usearch_getText(strsrch, &length16) != utf16 || length16 != 4) {
+        log_err("Error: a failed usearch_setTextUTF8() changed the text\n");
+    }
+    usearch_close(strsrch);
+}
+
 /**
 * addSearchTest
 */
@@ -3057,6 +3343,9 @@ void addSearchTest(TestNode** root)
                                "tscoll/usrchtst/TestSupplementaryCanonical");
     addTest(root, &TestContractionCanonical, 
                                  "tscoll/usrchtst/TestContractionCanonical");
+    addTest(root, &TestSkipSearch, "tscoll/usrchtst/TestSkipSearch");
+    addTest(root, &TestSkipSearchRandom, "tscoll/usrchtst/TestSkipSearchRandom");
+    addTest(root, &TestSetTextUTF8, "tscoll/usrchtst/TestSetTextUTF8");
     addTest(root, &TestEnd, "tscoll/usrchtst/TestEnd");
     addTest(root, &TestNumeric, "tscoll/usrchtst/TestNumeric");
     addTest(root, &TestDiacriticMatch, "tscoll/usrchtst/TestDiacriticMatch");
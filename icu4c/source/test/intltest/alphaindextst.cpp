@@ -68,6 +68,7 @@ void AlphabeticIndexTest::runIndexedTest( int32_t index, UBool exec, const char*
     TESTCASE_AUTO(TestJapaneseKanji);
     TESTCASE_AUTO(TestChineseUnihan);
     TESTCASE_AUTO(testHasBuckets);
+    TESTCASE_AUTO(TestGetBucketIndexes);
     TESTCASE_AUTO_END;
 }
 
@@ -749,4 +750,74 @@ void AlphabeticIndexTest::checkHasBuckets(const Locale &locale, UScriptCode scri
             uscript_getScript(bucket->getLabel().char32At(0), errorCode));
 }
 
+void AlphabeticIndexTest::TestGetBucketIndexes() {
+    static const char *const localeIDs[] = {
+        "en", "de-u-co-phonebk", "sv", "ru", "ja", "zh-u-co-pinyin", "zh-u-co-unihan"
+    };
+    // Characters near the bucket boundaries of the locales, and some others.
+    static const UChar extraChars[] = u"aAbcdhkuvwyz\u00e4\u00f6\u00fc\u00df\u0308\u0301"
+        u" -.09\u0430\u0435\u0451\u044f\u30a2\u30ab\u3042\u4e00\u4e5d\u5416\u7527"
+        u"\u03b1\U00020000";
+    UnicodeString extras = UnicodeString(extraChars).unescape();
+    for (int32_t l = 0; l < UPRV_LENGTHOF(localeIDs); ++l) {
+        IcuTestErrorCode errorCode(*this, "TestGetBucketIndexes");
+        AlphabeticIndex aindex(localeIDs[l], errorCode);
+        LocalPointer<AlphabeticIndex::ImmutableIndex> index(
+            aindex.buildImmutableIndex(errorCode), errorCode);
+        if (errorCode.errDataIfFailureAndReset("buildImmutableIndex(%s)", localeIDs[l])) {
+            continue;
+        }
+        // Build names from the bucket labels, with and without suffixes,
+        // plus pseudo-random combinations of label characters and the extra characters.
+        UnicodeString chars(extras);
+        UnicodeString names[3000];
+        int32_t length = 0;
+        names[length++].remove();
+        for (int32_t i = 0; i < index->getBucketCount() && length < 500; ++i) {
+            const UnicodeString &label = index->getBucket(i)->getLabel();
+            chars.append(label);
+            names[length++] = label;
+            names[length++] = UnicodeString(label).append(u'z');
+        }
+        uint32_t seed = 12345;
+        while (length < UPRV_LENGTHOF(names)) {
+            UnicodeString &name = names[length++];
+            seed = seed * 1103515245 + 12345;
+            int32_t nameLength = (seed >> 16) % 6;
+            for (int32_t j = 0; j < nameLength; ++j) {
+                seed = seed * 1103515245 + 12345;
+                name.append(chars.charAt((seed >> 8) % chars.length()));
+            }
+        }
+        int32_t bucketIndexes[UPRV_LENGTHOF(names)];
+        index->getBucketIndexes(names, length, bucketIndexes, 1, errorCode);
+        int32_t threadedBucketIndexes[UPRV_LENGTHOF(names)];
+        index->getBucketIndexes(names, length, threadedBucketIndexes, 3, errorCode);
+        if (errorCode.errIfFailureAndReset("getBucketIndexes(%s)", localeIDs[l])) {
+            continue;
+        }
+        int32_t numErrors = 0;
+        for (int32_t i = 0; i < length && numErrors < 10; ++i) {
+            int32_t expected = index->getBucketIndex(names[i], errorCode);
+            if (bucketIndexes[i] != expected || threadedBucketIndexes[i] != expected) {
+                errln(UnicodeString(u"getBucketIndexes(") +
+                      UnicodeString(localeIDs[l], -1, US_INV) + u") for " + prettify(names[i]) + u" = " + bucketIndexes[i] + u"/" +
+                      threadedBucketIndexes[i] + u" != getBucketIndex() = " + expected);
+                ++numErrors;
+            }
+        }
+    }
+    IcuTestErrorCode errorCode(*this, "TestGetBucketIndexes");
+    AlphabeticIndex aindex("en", errorCode);
+    LocalPointer<AlphabeticIndex::ImmutableIndex> index(
+        aindex.buildImmutableIndex(errorCode), errorCode);
+    if (errorCode.errDataIfFailureAndReset("buildImmutableIndex(en)")) {
+        return;
+    }
+    index->getBucketIndexes(NULL, 0, NULL, 1, errorCode);
+    errorCode.errIfFailureAndReset("getBucketIndexes(no names)");
+    index->getBucketIndexes(NULL, 1, NULL, 1, errorCode);
+    assertEquals("getBucketIndexes(NULL)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+}
+
 #endif
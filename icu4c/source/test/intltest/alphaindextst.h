@@ -53,6 +53,10 @@ class AlphabeticIndexTest: public IntlTest {
 
     void testHasBuckets();
     void checkHasBuckets(const Locale &locale, UScriptCode script);
+    /**
+     * ImmutableIndex::getBucketIndexes() vs. getBucketIndex().
+     */
+    void TestGetBucketIndexes();
 };
 
 #endif
@@ -13,6 +13,8 @@
 
 #include "unicode/utypes.h"
 
+#include <stdio.h>
+
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/coll.h"
@@ -32,11 +34,14 @@
 #include "cmemory.h"
 #include "collation.h"
 #include "collationdata.h"
+#include "collationdiskcache.h"
+#include "collationfastlatin.h"
 #include "collationfcd.h"
 #include "collationiterator.h"
 #include "collationroot.h"
 #include "collationrootelements.h"
 #include "collationruleparser.h"
+#include "collationtailoring.h"
 #include "collationweights.h"
 #include "cstring.h"
 #include "intltest.h"
@@ -71,6 +76,11 @@ class CollationTest : public IntlTest {
     void TestImplicits();
     void TestNulTerminated();
     void TestIllegalUTF8();
+    void TestLongEqualPrefix();
+    void TestSortKeys();
+    void TestFastScriptBlocks();
+    void TestAttributeViews();
+    void TestDiskCache();
     void TestShortFCDData();
     void TestFCD();
     void TestCollationWeights();
@@ -141,6 +151,11 @@ void CollationTest::runIndexedTest(int32_t index, UBool exec, const char *&name,
     TESTCASE_AUTO(TestImplicits);
     TESTCASE_AUTO(TestNulTerminated);
     TESTCASE_AUTO(TestIllegalUTF8);
+    TESTCASE_AUTO(TestLongEqualPrefix);
+    TESTCASE_AUTO(TestSortKeys);
+    TESTCASE_AUTO(TestFastScriptBlocks);
+    TESTCASE_AUTO(TestAttributeViews);
+    TESTCASE_AUTO(TestDiskCache);
     TESTCASE_AUTO(TestShortFCDData);
     TESTCASE_AUTO(TestFCD);
     TESTCASE_AUTO(TestCollationWeights);
@@ -315,6 +330,335 @@ void CollationTest::TestIllegalUTF8() {
     }
 }
 
+void CollationTest::TestLongEqualPrefix() {
+    IcuTestErrorCode errorCode(*this, "TestLongEqualPrefix");
+    // Long identical prefixes are skipped in blocks of code units;
+    // vary the position of the first difference across block boundaries,
+    // including differences inside contractions, UTF-8 sequences
+    // and before combining marks which require backing up.
+    LocalPointer<Collator> tailored(
+        new RuleBasedCollator(UNICODE_STRING_SIMPLE("&h<ch<<<cH"), errorCode), errorCode);
+    setRootCollator(errorCode);
+    if(errorCode.errDataIfFailureAndReset("unable to create the collators")) {
+        return;
+    }
+    static const char *const variants[] = {
+        "a", "b", "c", "ch", "cH", "A", "B",
+        "e", u8"\u00E9", u8"\u00E8", u8"e\u0301", u8"e\u0300", u8"e\u0301\u0323"
+    };
+    UnicodeString base("the quick brown fox jumps over the lazy dog, twice");
+    Collator *colls[] = { coll, tailored.getAlias() };
+    for(int32_t k = 0; k < UPRV_LENGTHOF(colls); ++k) {
+        Collator *c = colls[k];
+        for(int32_t pos = 0; pos <= 40; ++pos) {
+            UnicodeString prefix = base.tempSubString(0, pos);
+            UnicodeString suffix = base.tempSubString(pos);
+            for(int32_t i = 0; i < UPRV_LENGTHOF(variants); ++i) {
+                for(int32_t j = 0; j < UPRV_LENGTHOF(variants); ++j) {
+                    UnicodeString left = prefix + UnicodeString::fromUTF8(variants[i]) + suffix;
+                    UnicodeString right = prefix + UnicodeString::fromUTF8(variants[j]) + suffix;
+                    UCollationResult order = c->compare(left, right, errorCode);
+                    std::string left8, right8;
+                    left.toUTF8String(left8);
+                    right.toUTF8String(right8);
+                    UCollationResult order8 = c->compareUTF8(left8, right8, errorCode);
+                    CollationKey leftKey, rightKey;
+                    c->getCollationKey(left, leftKey, errorCode);
+                    c->getCollationKey(right, rightKey, errorCode);
+                    UCollationResult keyOrder = leftKey.compareTo(rightKey, errorCode);
+                    if(errorCode.errIfFailureAndReset("compare()")) {
+                        return;
+                    }
+                    if(order != keyOrder || order8 != keyOrder) {
+                        errln("collator %d pos %d: compare(%s, %s)=%d compareUTF8()=%d "
+                              "but the sort keys compare %d",
+                              (int)k, (int)pos, variants[i], variants[j],
+                              order, order8, keyOrder);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CollationTest::TestSortKeys() {
+    IcuTestErrorCode errorCode(*this, "TestSortKeys");
+    setRootCollator(errorCode);
+    if(errorCode.errDataIfFailureAndReset("unable to create the root collator")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll);
+    if(rbc == NULL) {
+        errln("the root collator is not a RuleBasedCollator");
+        return;
+    }
+    // Pieces include text that fails the FCD check,
+    // so that the reused iterator must reset its normalization state.
+    static const char *const pieces[] = {
+        "a", "B", "\\u00E4", "a\\u0301\\u0323", "\\u0FB3\\u0F71\\u0F80", "\\u5C71",
+        "\\U0001F600", "1", "-", "\\uAC00\\u11A8", "e\\u0300"
+    };
+    UnicodeString strings[60];
+    std::string strings8[UPRV_LENGTHOF(strings)];
+    const UChar *src[UPRV_LENGTHOF(strings)];
+    const char *src8[UPRV_LENGTHOF(strings)];
+    int32_t lengths[UPRV_LENGTHOF(strings)];
+    int32_t lengths8[UPRV_LENGTHOF(strings)];
+    for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+        for(int32_t j = 0; j < i % 5; ++j) {
+            strings[i].append(UnicodeString(pieces[(i * 7 + j * 3) % UPRV_LENGTHOF(pieces)], -1, US_INV).unescape());
+        }
+        strings[i].toUTF8String(strings8[i]);
+        src[i] = strings[i].getBuffer();
+        lengths[i] = strings[i].length();
+        src8[i] = strings8[i].data();
+        lengths8[i] = static_cast<int32_t>(strings8[i].length());
+    }
+    static const UColAttributeValue normalization[] = { UCOL_OFF, UCOL_ON };
+    static const UColAttributeValue strengths[] = { UCOL_PRIMARY, UCOL_TERTIARY, UCOL_IDENTICAL };
+    uint8_t keys[4000], keys8[4000], key[100];
+    int32_t keyOffsets[UPRV_LENGTHOF(strings) + 1], keyOffsets8[UPRV_LENGTHOF(strings) + 1];
+    for(int32_t n = 0; n < UPRV_LENGTHOF(normalization); ++n) {
+        rbc->setAttribute(UCOL_NORMALIZATION_MODE, normalization[n], errorCode);
+        for(int32_t s = 0; s < UPRV_LENGTHOF(strengths); ++s) {
+            rbc->setAttribute(UCOL_STRENGTH, strengths[s], errorCode);
+            int32_t numKeys = rbc->getSortKeys(src, lengths, UPRV_LENGTHOF(strings),
+                                               keys, UPRV_LENGTHOF(keys), keyOffsets, errorCode);
+            int32_t numKeys8 = rbc->getSortKeysUTF8(src8, lengths8, UPRV_LENGTHOF(strings),
+                                                    keys8, UPRV_LENGTHOF(keys8), keyOffsets8,
+                                                    errorCode);
+            if(errorCode.errIfFailureAndReset("getSortKeys()")) {
+                return;
+            }
+            if(numKeys != UPRV_LENGTHOF(strings) || numKeys8 != UPRV_LENGTHOF(strings)) {
+                errln("normalization %d strength %d: getSortKeys()=%d getSortKeysUTF8()=%d keys",
+                      (int)normalization[n], (int)strengths[s], (int)numKeys, (int)numKeys8);
+                continue;
+            }
+            for(int32_t i = 0; i < numKeys; ++i) {
+                int32_t keyLength = rbc->getSortKey(strings[i], key, UPRV_LENGTHOF(key));
+                if((keyOffsets[i + 1] - keyOffsets[i]) != keyLength ||
+                        uprv_memcmp(keys + keyOffsets[i], key, keyLength) != 0) {
+                    errln("normalization %d strength %d: getSortKeys()[%d] != getSortKey()",
+                          (int)normalization[n], (int)strengths[s], (int)i);
+                }
+                if((keyOffsets8[i + 1] - keyOffsets8[i]) != keyLength ||
+                        uprv_memcmp(keys8 + keyOffsets8[i], key, keyLength) != 0) {
+                    errln("normalization %d strength %d: getSortKeysUTF8()[%d] != getSortKey()",
+                          (int)normalization[n], (int)strengths[s], (int)i);
+                }
+            }
+            // Every prefix of complete keys fits exactly.
+            for(int32_t i = 0; i < numKeys; i += 7) {
+                int32_t numFit = rbc->getSortKeys(src, lengths, UPRV_LENGTHOF(strings),
+                                                  keys, keyOffsets[i + 1] - 1, NULL, errorCode);
+                if(numFit != i) {
+                    errln("getSortKeys(capacity=end of key %d minus 1)=%d keys", (int)i, (int)numFit);
+                }
+            }
+        }
+    }
+}
+
+void CollationTest::TestFastScriptBlocks() {
+    IcuTestErrorCode errorCode(*this, "TestFastScriptBlocks");
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    if(errorCode.errDataIfFailureAndReset("CollationRoot::getRoot()")) {
+        return;
+    }
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        if(root->getFastScriptTable(i) == NULL) {
+            errln("no fast-path table for script block %d", (int)i);
+        }
+    }
+    // The Cyrillic block includes the Ukrainian U+0490..U+0491.
+    static const UChar ghe[] = { 0x491 };
+    if(CollationFastLatin::findScriptBlock(~0u, ghe, 1) < 0) {
+        errln("U+0491 is not in a script block");
+    }
+    // Compare results with and without the fast path (sort keys never use it).
+    // Pieces include characters that the script tables do not support.
+    static const char *const pieces[] = {
+        "\\u0430", "\\u0411", "\\u0451", "\\u0435", "\\u0439", "\\u0438\\u0306", "\\u0457",
+        "\\u0491", "\\u0490", "\\u0463", "\\u0483", "\\u044F", "\\u042C", "\\u03B1", "\\u03A9",
+        "\\u03AC", "\\u0390", "\\u03C2", "\\u03C3", "\\u037E", "\\u0387", " ", "-", "\\u2010",
+        "1", "9", "a", ""
+    };
+    UnicodeString strings[80];
+    for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+        for(int32_t j = 0; j <= i % 4; ++j) {
+            strings[i].append(UnicodeString(pieces[(i * 7 + j * 5) % UPRV_LENGTHOF(pieces)], -1, US_INV).unescape());
+        }
+    }
+    static const char *const locales[] = { "", "ru", "uk", "el", "sr", "ja" };
+    for(int32_t l = 0; l < UPRV_LENGTHOF(locales); ++l) {
+        LocalPointer<Collator> coll(Collator::createInstance(locales[l], errorCode));
+        if(errorCode.errDataIfFailureAndReset("Collator::createInstance(%s)", locales[l])) {
+            continue;
+        }
+        for(int32_t variant = 0; variant < 5; ++variant) {
+            coll->setAttribute(UCOL_ALTERNATE_HANDLING,
+                               variant == 1 ? UCOL_SHIFTED : UCOL_NON_IGNORABLE, errorCode);
+            coll->setAttribute(UCOL_STRENGTH, variant == 1 ? UCOL_QUATERNARY :
+                               variant == 2 ? UCOL_PRIMARY : UCOL_TERTIARY, errorCode);
+            coll->setAttribute(UCOL_CASE_FIRST,
+                               variant == 3 ? UCOL_UPPER_FIRST : UCOL_OFF, errorCode);
+            coll->setAttribute(UCOL_NUMERIC_COLLATION, variant == 4 ? UCOL_ON : UCOL_OFF, errorCode);
+            if(variant == 4) {
+                coll->setMaxVariable(UCOL_REORDER_CODE_SYMBOL, errorCode);
+            }
+            if(errorCode.errIfFailureAndReset("setAttribute()")) {
+                continue;
+            }
+            CollationKey keys[UPRV_LENGTHOF(strings)];
+            std::string strings8[UPRV_LENGTHOF(strings)];
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                coll->getCollationKey(strings[i], keys[i], errorCode);
+                strings[i].toUTF8String(strings8[i]);
+            }
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                    UCollationResult expected = keys[i].compareTo(keys[j], errorCode);
+                    UCollationResult order = coll->compare(strings[i], strings[j], errorCode);
+                    UCollationResult order8 = coll->compareUTF8(strings8[i], strings8[j], errorCode);
+                    UCollationResult orderNul = coll->compare(strings[i].getTerminatedBuffer(), -1,
+                                                              strings[j].getTerminatedBuffer(), -1,
+                                                              errorCode);
+                    if(order != expected || order8 != expected || orderNul != expected) {
+                        errln(UnicodeString(locales[l], -1, US_INV) + " variant " + variant +
+                              ": compare(" + prettify(strings[i]) + ", " + prettify(strings[j]) +
+                              ")=" + order + " UTF-8 " + order8 + " NUL-terminated " + orderNul +
+                              " but sort keys " + expected);
+                    }
+                }
+            }
+            errorCode.errIfFailureAndReset("%s variant %d", locales[l], (int)variant);
+        }
+    }
+}
+
+void CollationTest::TestAttributeViews() {
+    IcuTestErrorCode errorCode(*this, "TestAttributeViews");
+    LocalPointer<RuleBasedCollator> base(
+        dynamic_cast<RuleBasedCollator *>(Collator::createInstance("de", errorCode)));
+    if(errorCode.errDataIfFailureAndReset("Collator::createInstance(de)")) {
+        return;
+    }
+    static const UColAttribute attributes[] = {
+        UCOL_STRENGTH, UCOL_NUMERIC_COLLATION, UCOL_ALTERNATE_HANDLING, UCOL_CASE_FIRST
+    };
+    static const UColAttributeValue values[][UPRV_LENGTHOF(attributes)] = {
+        { UCOL_SECONDARY, UCOL_ON, UCOL_SHIFTED, UCOL_OFF },
+        { UCOL_PRIMARY, UCOL_OFF, UCOL_NON_IGNORABLE, UCOL_UPPER_FIRST },
+        { UCOL_QUATERNARY, UCOL_ON, UCOL_SHIFTED, UCOL_LOWER_FIRST },
+        { UCOL_DEFAULT, UCOL_DEFAULT, UCOL_DEFAULT, UCOL_DEFAULT }
+    };
+    static const char *const strings[] = {
+        "a", "A", "\\u00E4", "b", "a b", "ab", "a-b", "x2", "x10", "X10", "\\u00C4b", ""
+    };
+    // Pass 0 uses the tailoring's own reordering & variable top which allow shared settings,
+    // pass 1 a custom reordering, and pass 2 a custom variable top.
+    for(int32_t pass = 0; pass < 3; ++pass) {
+        if(pass == 1) {
+            static const int32_t codes[] = { USCRIPT_GREEK, USCRIPT_LATIN };
+            base->setReorderCodes(codes, UPRV_LENGTHOF(codes), errorCode);
+        } else if(pass == 2) {
+            base->setReorderCodes(NULL, 0, errorCode);
+            base->setVariableTop(UnicodeString((UChar)0x2D), errorCode);
+        }
+        if(errorCode.errIfFailureAndReset("pass %d setup", (int)pass)) {
+            continue;
+        }
+        for(int32_t v = 0; v < UPRV_LENGTHOF(values); ++v) {
+            RuleBasedCollator view(*base, attributes, values[v], UPRV_LENGTHOF(attributes),
+                                   errorCode);
+            LocalPointer<Collator> expectedColl(base->clone());
+            for(int32_t a = 0; a < UPRV_LENGTHOF(attributes); ++a) {
+                expectedColl->setAttribute(attributes[a], values[v][a], errorCode);
+            }
+            if(errorCode.errIfFailureAndReset("pass %d values %d", (int)pass, (int)v)) {
+                continue;
+            }
+            if(view != *expectedColl) {
+                errln("pass %d values %d: view != clone with setAttribute()", (int)pass, (int)v);
+            }
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                UnicodeString s = UnicodeString(strings[i], -1, US_INV).unescape();
+                for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                    UnicodeString s2 = UnicodeString(strings[j], -1, US_INV).unescape();
+                    UCollationResult expected = expectedColl->compare(s, s2, errorCode);
+                    UCollationResult actual = view.compare(s, s2, errorCode);
+                    if(actual != expected) {
+                        errln("pass %d values %d: view compare(%s, %s)=%d != %d",
+                              (int)pass, (int)v, strings[i], strings[j],
+                              (int)actual, (int)expected);
+                    }
+                }
+            }
+        }
+    }
+    // Illegal arguments.
+    RuleBasedCollator bad(*base, attributes, NULL, 1, errorCode);
+    errorCode.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR, "view with NULL values");
+    static const UColAttributeValue badValue[] = { UCOL_SHIFTED };
+    RuleBasedCollator bad2(*base, attributes, badValue, 1, errorCode);
+    errorCode.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR, "view with strength=shifted");
+
+    // The tailoring caches one settings object per options value.
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    if(errorCode.errDataIfFailureAndReset("CollationRoot::getRoot()")) {
+        return;
+    }
+    int32_t options = (root->settings->options & ~CollationSettings::STRENGTH_MASK) |
+            (UCOL_SECONDARY << CollationSettings::STRENGTH_SHIFT) | CollationSettings::NUMERIC;
+    const CollationSettings *s1 = root->getSettingsForOptions(options, errorCode);
+    const CollationSettings *s2 = root->getSettingsForOptions(options, errorCode);
+    if(errorCode.errIfFailureAndReset("getSettingsForOptions()")) {
+        return;
+    }
+    if(s1 != s2 || s1->options != options) {
+        errln("getSettingsForOptions() does not return one cached object per options value");
+    }
+    if(root->getSettingsForOptions(root->settings->options, errorCode) != root->settings) {
+        errln("getSettingsForOptions(default options) != the tailoring's settings");
+    }
+
+    // More options values than the tailoring caches: The others get their own settings.
+    RuleBasedCollator fromRules(u"&a<b<<<B", errorCode);
+    if(errorCode.errIfFailureAndReset("RuleBasedCollator(rules)")) {
+        return;
+    }
+    static const UColAttribute attributes2[] = {
+        UCOL_STRENGTH, UCOL_NUMERIC_COLLATION, UCOL_CASE_LEVEL, UCOL_FRENCH_COLLATION
+    };
+    static const UColAttributeValue strengths[] = {
+        UCOL_PRIMARY, UCOL_SECONDARY, UCOL_TERTIARY, UCOL_QUATERNARY, UCOL_IDENTICAL
+    };
+    for(int32_t i = 0; i < 4 * UPRV_LENGTHOF(strengths); ++i) {
+        const UColAttributeValue values2[] = {
+            strengths[i % UPRV_LENGTHOF(strengths)],
+            (i & 1) != 0 ? UCOL_ON : UCOL_OFF,
+            (i / UPRV_LENGTHOF(strengths)) & 1 ? UCOL_ON : UCOL_OFF,
+            (i / UPRV_LENGTHOF(strengths)) & 2 ? UCOL_ON : UCOL_OFF
+        };
+        RuleBasedCollator view(fromRules, attributes2, values2, UPRV_LENGTHOF(attributes2),
+                               errorCode);
+        LocalPointer<Collator> expectedColl(fromRules.clone());
+        for(int32_t a = 0; a < UPRV_LENGTHOF(attributes2); ++a) {
+            expectedColl->setAttribute(attributes2[a], values2[a], errorCode);
+        }
+        if(errorCode.errIfFailureAndReset("options values %d", (int)i)) {
+            continue;
+        }
+        if(view != *expectedColl) {
+            errln("options values %d: view != clone with setAttribute()", (int)i);
+        }
+        if(view.compare(u"b2", u"B10", errorCode) != expectedColl->compare(u"b2", u"B10", errorCode)) {
+            errln("options values %d: view compare(b2, B10) differs", (int)i);
+        }
+    }
+}
+
 namespace {
 
 void addLeadSurrogatesForSupplementary(const UnicodeSet &src, UnicodeSet &dest) {
@@ -329,6 +673,115 @@ void addLeadSurrogatesForSupplementary(const UnicodeSet &src, UnicodeSet &dest)
 
 }  // namespace
 
+void CollationTest::TestDiskCache() {
+#if !UCONFIG_NO_FILE_IO
+    IcuTestErrorCode errorCode(*this, "TestDiskCache");
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    if(errorCode.errDataIfFailureAndReset("CollationRoot::getRoot()")) {
+        return;
+    }
+    UnicodeString rules(u"[caseFirst upper]&b<ch<<<cH<<<Ch<<<CH &[before 1]a<\\u00E6");
+    // Write the cache file into the test data output directory.
+    const char *testDataPath = loadTestData(errorCode);
+    if(errorCode.errDataIfFailureAndReset("loadTestData()")) {
+        return;
+    }
+    CharString dirString;
+    const char *sep = uprv_strrchr(testDataPath, U_FILE_SEP_CHAR);
+    if(sep != NULL) {
+        dirString.append(testDataPath, (int32_t)(sep - testDataPath), errorCode);
+    } else {
+        dirString.append(".", errorCode);
+    }
+    const char *dir = dirString.data();
+    CharString path;
+    CollationDiskCache::getPath(dir, rules, root, path, errorCode);
+    remove(path.data());
+    RuleBasedCollator uncached(rules, Collator::SECONDARY, UCOL_ON, errorCode);
+    if(errorCode.errDataIfFailureAndReset("RuleBasedCollator(rules)")) {
+        return;
+    }
+    static const char *const strings[] = {
+        "a", "\\u00E6", "b", "ch", "cH", "CH", "c", "d", "a\\u0308", "Ch"
+    };
+    // Pass 0 builds the tailoring and writes the file, pass 1 maps the file,
+    // pass 2 replaces a damaged file, and pass 3 replaces a truncated file.
+    for(int32_t pass = 0; pass < 4; ++pass) {
+        LocalPointer<CollationTailoring> t(CollationDiskCache::load(dir, rules, root, errorCode));
+        if(pass == 0 && t.isValid()) {
+            errln("the cache file should have been removed");
+        } else if(pass == 1 && t.isNull()) {
+            errln("the first collator did not write a valid cache file");
+        }
+        t.adoptInstead(NULL);
+        if(pass == 2) {
+            FILE *f = fopen(path.data(), "wb");
+            if(f != NULL) {
+                static const char garbage[] = "not a collation data file";
+                fwrite(garbage, 1, sizeof(garbage), f);
+                fclose(f);
+            }
+        } else if(pass == 3) {
+            // Cut off the end of the rule string but keep the header intact.
+            MaybeStackArray<char, 1> contents;
+            int32_t length = 0;
+            FILE *f = fopen(path.data(), "rb");
+            if(f != NULL) {
+                fseek(f, 0, SEEK_END);
+                length = (int32_t)ftell(f);
+                fseek(f, 0, SEEK_SET);
+                if(length > 0 && contents.resize(length) != NULL) {
+                    length = (int32_t)fread(contents.getAlias(), 1, length, f);
+                } else {
+                    length = 0;
+                }
+                fclose(f);
+            }
+            if(length <= 2 || (f = fopen(path.data(), "wb")) == NULL) {
+                errln("unable to read and rewrite the cache file");
+                continue;
+            }
+            fwrite(contents.getAlias(), 1, length - 2, f);
+            fclose(f);
+            t.adoptInstead(CollationDiskCache::load(dir, rules, root, errorCode));
+            if(t.isValid()) {
+                errln("a truncated cache file must not be loaded");
+            }
+            t.adoptInstead(NULL);
+        }
+        RuleBasedCollator cached(rules, UCOL_SECONDARY, UCOL_ON, dir, errorCode);
+        if(errorCode.errIfFailureAndReset("RuleBasedCollator(rules, cacheDir) pass %d", (int)pass)) {
+            continue;
+        }
+        if(cached.getRules() != rules) {
+            errln("pass %d: getRules() differs from the input rules", (int)pass);
+        }
+        assertEquals("strength", UCOL_SECONDARY, cached.getAttribute(UCOL_STRENGTH, errorCode));
+        assertEquals("caseFirst", UCOL_UPPER_FIRST, cached.getAttribute(UCOL_CASE_FIRST, errorCode));
+        if(cached != uncached) {
+            errln("pass %d: cached collator != uncached collator", (int)pass);
+        }
+        for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+            UnicodeString s = UnicodeString(strings[i], -1, US_INV).unescape();
+            for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                UnicodeString s2 = UnicodeString(strings[j], -1, US_INV).unescape();
+                UCollationResult expected = uncached.compare(s, s2, errorCode);
+                UCollationResult actual = cached.compare(s, s2, errorCode);
+                if(actual != expected) {
+                    errln("pass %d: cached compare(%s, %s)=%d != %d",
+                          (int)pass, strings[i], strings[j], (int)actual, (int)expected);
+                }
+            }
+        }
+        t.adoptInstead(CollationDiskCache::load(dir, rules, root, errorCode));
+        if(t.isNull()) {
+            errln("pass %d: no valid cache file after constructing the collator", (int)pass);
+        }
+    }
+    remove(path.data());
+#endif
+}
+
 void CollationTest::TestShortFCDData() {
     // See CollationFCD class comments.
     IcuTestErrorCode errorCode(*this, "TestShortFCDData");
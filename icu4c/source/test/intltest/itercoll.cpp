@@ -651,6 +651,69 @@ UnicodeString &CollationIteratorTest::orderString(CollationElementIterator &iter
     return target;
 }
 
+void CollationIteratorTest::TestUTF8AssignmentAndNextCEs()
+{
+    IcuTestErrorCode errorCode(*this, "TestUTF8AssignmentAndNextCEs");
+    LocalPointer<RuleBasedCollator> coll(
+        static_cast<RuleBasedCollator *>(Collator::createInstance(Locale::getRoot(), errorCode)));
+    if (errorCode.errDataIfFailureAndReset("Collator::createInstance(root)")) {
+        return;
+    }
+    coll->setAttribute(UCOL_NORMALIZATION_MODE, UCOL_ON, errorCode);
+    // a + two combining marks in non-canonical order, which are normalized
+    LocalPointer<CollationElementIterator> iter1(
+        coll->createCollationElementIterator(UnicodeString()));
+    iter1->setTextUTF8("xa\xcc\x80\xcc\xa5\xc3\xa6", errorCode);
+    CollationElementIterator iter2(*iter1);
+    if (*iter1 != iter2) {
+        errln("UTF-8 collation iterator copy constructor does not produce the same elements");
+    }
+    // Step into the normalized segment and the middle of the expansion.
+    for (int32_t i = 0; i < 3; ++i) {
+        iter1->next(errorCode);
+        if (*iter1 == iter2) {
+            errln("UTF-8 collation iterators equal after %d next() calls on one", (int)i);
+        }
+        iter2.next(errorCode);
+        if (*iter1 != iter2) {
+            errln("UTF-8 collation iterators not equal after %d next() calls", (int)i);
+        }
+    }
+    CollationElementIterator iter3(iter2);
+    if (*iter1 != iter3) {
+        errln("UTF-8 collation iterator copy in a normalized segment is not equal");
+    }
+    assertEqual(*iter1, iter3);
+
+    // A UTF-16 iterator over the same text is not equal.
+    LocalPointer<CollationElementIterator> iter16(coll->createCollationElementIterator(
+        UnicodeString(u"xa\u0300\u0325\u00e6")));
+    iter1->reset();
+    if (*iter1 == *iter16) {
+        errln("UTF-8 and UTF-16 collation iterators are equal");
+    }
+    // nextCEs() yields the same CEs, with UTF-8 vs. UTF-16 offsets.
+    int64_t ces[10], ces16[10];
+    int32_t offsets[10], offsets16[10];
+    int32_t length = iter1->nextCEs(ces, 10, offsets, errorCode);
+    int32_t length16 = iter16->nextCEs(ces16, 10, offsets16, errorCode);
+    if (errorCode.errIfFailureAndReset("nextCEs()")) {
+        return;
+    }
+    assertEquals("nextCEs() UTF-8 vs. UTF-16 length", length16, length);
+    assertTrue("at least 4 CEs", length >= 4);
+    for (int32_t i = 0; i < length && i < length16; ++i) {
+        assertEquals("nextCEs() UTF-8 vs. UTF-16 CE", ces16[i], ces[i]);
+    }
+    assertEquals("offset after x", 1, offsets[0]);
+    assertEquals("offset after a", 2, offsets[1]);
+    // The reordered combining marks share the offset after their normalized segment.
+    assertEquals("UTF-8 offset after marks", 6, offsets[2]);
+    assertEquals("UTF-8 offset after marks", 6, offsets[3]);
+    assertEquals("UTF-16 offset after marks", 4, offsets16[2]);
+    assertEquals("UTF-8 offset at the end", 8, offsets[length - 1]);
+}
+
 void CollationIteratorTest::assertEqual(CollationElementIterator &i1, CollationElementIterator &i2)
 {
     int32_t c1, c2, count = 0;
@@ -691,6 +754,7 @@ void CollationIteratorTest::runIndexedTest(int32_t index, UBool exec, const char
           case  6: name = "TestAssignment";    if (exec) TestAssignment(/* par */);    break;
           case  7: name = "TestConstructors";  if (exec) TestConstructors(/* par */); break;
           case  8: name = "TestStrengthOrder"; if (exec) TestStrengthOrder(/* par */); break;
+          case  9: name = "TestUTF8AssignmentAndNextCEs"; if (exec) TestUTF8AssignmentAndNextCEs(); break;
           default: name = ""; break;
       }
     } else {
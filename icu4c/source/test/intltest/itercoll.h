@@ -84,6 +84,11 @@ class CollationIteratorTest: public IntlTestCollator
     * Testing the strength order functionality
     */
     void TestStrengthOrder();
+
+    /**
+     * Testing assignment, equality and nextCEs() with UTF-8 text
+     */
+    void TestUTF8AssignmentAndNextCEs();
     
     //------------------------------------------------------------------------
     // Internal utilities
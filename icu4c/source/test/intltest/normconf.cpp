@@ -385,8 +385,52 @@ UBool NormalizerConformanceTest::checkConformance(const UnicodeString* field,
         }
     }
 
+    if(options==0) {
+        if(!isNormalizedUTF8(*nfd, field[2], status)) {
+            dataerrln("Normalizer error: nfd.isNormalizedUTF8(NFD(s)) is FALSE");
+            pass = FALSE;
+        }
+        if(field[0]!=field[2] && isNormalizedUTF8(*nfd, field[0], status)) {
+            errln("Normalizer error: nfd.isNormalizedUTF8(s) is TRUE");
+            pass = FALSE;
+        }
+        if(!isNormalizedUTF8(*nfkd, field[4], status)) {
+            dataerrln("Normalizer error: nfkd.isNormalizedUTF8(NFKD(s)) is FALSE");
+            pass = FALSE;
+        }
+        if(field[0]!=field[4] && isNormalizedUTF8(*nfkd, field[0], status)) {
+            errln("Normalizer error: nfkd.isNormalizedUTF8(s) is TRUE");
+            pass = FALSE;
+        }
+    }
+
     // test FCD quick check and "makeFCD"
     Normalizer::normalize(field[0], UNORM_FCD, options, fcd, status);
+    if(options==0) {
+        const Normalizer2 *fcd2 = Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, status);
+        std::string s8, fcd8, out8;
+        field[0].toUTF8String(s8);
+        fcd.toUTF8String(fcd8);
+        Edits edits;
+        StringByteSink<std::string> sink(&out8);
+        fcd2->normalizeUTF8(0, s8, sink, &edits, status);
+        if(out8 != fcd8) {
+            errln("Normalizer error: fcd.normalizeUTF8(s) != FCD(s)");
+            pass = FALSE;
+        }
+        if(edits.lengthDelta() != (int32_t)(out8.length() - s8.length())) {
+            errln("Normalizer error: fcd.normalizeUTF8(s) edits.lengthDelta() is wrong");
+            pass = FALSE;
+        }
+        if(!fcd2->isNormalizedUTF8(fcd8, status)) {
+            errln("Normalizer error: fcd.isNormalizedUTF8(FCD(s)) is FALSE");
+            pass = FALSE;
+        }
+        if(field[0]!=fcd && fcd2->isNormalizedUTF8(s8, status)) {
+            errln("Normalizer error: fcd.isNormalizedUTF8(s) is TRUE");
+            pass = FALSE;
+        }
+    }
     if(UNORM_NO == Normalizer::quickCheck(fcd, UNORM_FCD, options, status)) {
         errln("Normalizer error: quickCheck(FCD(s), UNORM_FCD) is UNORM_NO");
         pass = FALSE;
@@ -481,9 +525,8 @@ UBool NormalizerConformanceTest::checkNorm(UNormalizationMode mode, int32_t opti
     exp.toUTF8String(exp8);
     std::string out8;
     Edits edits;
-    Edits *editsPtr = (mode == UNORM_NFC || mode == UNORM_NFKC) ? &edits : nullptr;
     StringByteSink<std::string> sink(&out8, exp8.length());
-    norm2->normalizeUTF8(0, s8, sink, editsPtr, errorCode);
+    norm2->normalizeUTF8(0, s8, sink, &edits, errorCode);
     if (U_FAILURE(errorCode)) {
         errln("Normalizer2.%s.normalizeUTF8(%s) failed: %s",
               modeString, s8.c_str(), u_errorName(errorCode));
@@ -494,10 +537,6 @@ UBool NormalizerConformanceTest::checkNorm(UNormalizationMode mode, int32_t opti
               modeString, s8.c_str(), out8.c_str(), exp8.c_str());
         return FALSE;
     }
-    if (editsPtr == nullptr) {
-        return TRUE;
-    }
-
     // Do the Edits cover the entire input & output?
     UBool pass = TRUE;
     pass &= assertEquals("edits.hasChanges()", (UBool)(s8 != out8), edits.hasChanges());
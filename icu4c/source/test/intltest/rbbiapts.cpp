@@ -28,6 +28,7 @@
 #if !UCONFIG_NO_BREAK_ITERATION
 #include "unicode/filteredbrk.h"
 #include <stdio.h> // for sprintf
+#include <thread>
 #endif
 /**
  * API Test the RuleBasedBreakIterator class
@@ -1160,6 +1161,289 @@ void RBBIAPITest::TestRefreshInputText() {
 
 }
 
+// Check getBoundaries() against following(), next() and getRuleStatus(),
+// in chunks of various sizes, on text with dictionary-based segments.
+
+void RBBIAPITest::TestGetBoundaries() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text = UnicodeString(
+        "Hello, World! The price is $12.50 (tax incl.) \\u0E01\\u0E32\\u0E23\\u0E17\\u0E14\\u0E2A\\u0E2D\\u0E1A"
+        "\\u0E20\\u0E32\\u0E29\\u0E32\\u0E44\\u0E17\\u0E22 -- \\u65E5\\u672C\\u8A9E\\u306E\\u6587\\u7AE0\\u3067\\u3059\\u3002 "
+        "\\uD83D\\uDE00 don't stop. e\\u0301t\\u00E9\\r\\nend", -1, US_INV).unescape();
+    LocalPointer<BreakIterator> instances[] = {
+        LocalPointer<BreakIterator>(BreakIterator::createCharacterInstance(Locale::getEnglish(), status)),
+        LocalPointer<BreakIterator>(BreakIterator::createWordInstance(Locale::getEnglish(), status)),
+        LocalPointer<BreakIterator>(BreakIterator::createLineInstance(Locale::getEnglish(), status)),
+        LocalPointer<BreakIterator>(BreakIterator::createSentenceInstance(Locale::getEnglish(), status))
+    };
+    if (U_FAILURE(status)) {
+        dataerrln("FAIL: creating break iterators: %s", u_errorName(status));
+        return;
+    }
+    static const int32_t capacities[] = { 1, 2, 5, 1000 };
+    for (int32_t type = 0; type < UPRV_LENGTHOF(instances); ++type) {
+        RuleBasedBreakIterator *bi = dynamic_cast<RuleBasedBreakIterator *>(instances[type].getAlias());
+        if (bi == NULL) {
+            errln("FAIL: break iterator type %d is not a RuleBasedBreakIterator", (int)type);
+            continue;
+        }
+        LocalPointer<BreakIterator> ref(bi->clone());
+        ref->setText(text);
+        bi->setText(text);
+        for (int32_t start = 0; start < text.length(); start += 7) {
+            for (int32_t c = 0; c < UPRV_LENGTHOF(capacities); ++c) {
+                int32_t boundaries[1000];
+                int32_t ruleStatus[1000];
+                int32_t capacity = capacities[c];
+                int32_t expected = ref->following(start);
+                int32_t pos = start;
+                int32_t count = 0;
+                UBool atEnd = FALSE;
+                while (!atEnd) {
+                    int32_t length = bi->getBoundaries(pos, boundaries, ruleStatus, capacity, status);
+                    if (U_FAILURE(status)) {
+                        errln("FAIL: getBoundaries(%d): %s", (int)pos, u_errorName(status));
+                        return;
+                    }
+                    atEnd = length < capacity;
+                    for (int32_t i = 0; i < length; ++i, ++count) {
+                        if (boundaries[i] != expected || ruleStatus[i] != ref->getRuleStatus()) {
+                            errln("FAIL: type %d start %d capacity %d: boundary #%d is %d status %d, expected %d status %d",
+                                  (int)type, (int)start, (int)capacity, (int)count,
+                                  (int)boundaries[i], (int)ruleStatus[i], (int)expected, (int)ref->getRuleStatus());
+                            return;
+                        }
+                        expected = ref->next();
+                    }
+                    if (length > 0) {
+                        pos = boundaries[length - 1];
+                        // The iterator is left on the last boundary that was returned.
+                        TEST_ASSERT(bi->current() == pos);
+                        TEST_ASSERT(bi->getRuleStatus() == ruleStatus[length - 1]);
+                    }
+                }
+                TEST_ASSERT(expected == UBRK_DONE);
+            }
+        }
+
+        // Normal iteration continues from where getBoundaries() stopped, in both directions.
+        int32_t boundaries[3];
+        int32_t length = bi->getBoundaries(20, boundaries, NULL, 3, status);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT(length == 3);
+        TEST_ASSERT(bi->next() == ref->following(boundaries[2]));
+        TEST_ASSERT(bi->previous() == boundaries[2]);
+        TEST_ASSERT(bi->previous() == boundaries[1]);
+
+        // Out of range start positions and argument errors.
+        TEST_ASSERT(bi->getBoundaries(text.length(), boundaries, NULL, 3, status) == 0);
+        TEST_ASSERT(bi->getBoundaries(text.length() + 5, boundaries, NULL, 3, status) == 0);
+        TEST_ASSERT(bi->getBoundaries(-5, boundaries, NULL, 1, status) == 1 &&
+                    boundaries[0] == ref->following(0));
+        TEST_ASSERT(bi->getBoundaries(0, boundaries, NULL, 0, status) == 0);
+        TEST_ASSERT_SUCCESS(status);
+        bi->getBoundaries(0, NULL, NULL, 3, status);
+        TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+        status = U_ZERO_ERROR;
+        bi->getBoundaries(0, boundaries, NULL, -1, status);
+        TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+        status = U_ZERO_ERROR;
+    }
+}
+
+// Check getAllBoundaries() with several threads against sequential iteration,
+// with standard rules and with rules that do not break after line breaks.
+
+void RBBIAPITest::TestGetAllBoundaries() {
+    static const char *const lines[] = {
+        "Hello, World! The price is $12.50 (tax incl.) and that's that.",
+        "\\u0E01\\u0E32\\u0E23\\u0E17\\u0E14\\u0E2A\\u0E2D\\u0E1A\\u0E20\\u0E32\\u0E29\\u0E32\\u0E44\\u0E17\\u0E22 abc",
+        "\\u65E5\\u672C\\u8A9E\\u306E\\u6587\\u7AE0\\u3067\\u3059\\u3002\\u3053\\u308C\\u306F\\u30C6\\u30B9\\u30C8",
+        "  \\uD83D\\uDE00 e\\u0301t\\u00E9 12,345.67 -- \"Quoted.\" Mr. Smith went home",
+        "no line break here, only spaces and words and more words "
+    };
+    static const char *const separators[] = { "\\n", "\\r\\n", "\\u2029", " ", "\\r" };
+    UnicodeString text;
+    for (int32_t i = 0; text.length() < 60000; ++i) {
+        text.append(UnicodeString(lines[i % UPRV_LENGTHOF(lines)], -1, US_INV).unescape());
+        text.append(UnicodeString(separators[(i / 3) % UPRV_LENGTHOF(separators)], -1, US_INV).unescape());
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError parseError;
+    LocalPointer<BreakIterator> instances[] = {
+        LocalPointer<BreakIterator>(BreakIterator::createCharacterInstance(Locale::getEnglish(), status)),
+        LocalPointer<BreakIterator>(BreakIterator::createWordInstance(Locale::getEnglish(), status)),
+        LocalPointer<BreakIterator>(BreakIterator::createLineInstance(Locale::getJapanese(), status)),
+        LocalPointer<BreakIterator>(BreakIterator::createSentenceInstance(Locale::getEnglish(), status)),
+        // Boundaries only after periods, so that most of the cuts are not boundaries.
+        LocalPointer<BreakIterator>(new RuleBasedBreakIterator(
+            UnicodeString(u"$s = [^.]; $s* \\.; $s+;"), parseError, status))
+    };
+    if (U_FAILURE(status)) {
+        dataerrln("FAIL: creating break iterators: %s", u_errorName(status));
+        return;
+    }
+    int32_t capacity = text.length();
+    LocalArray<int32_t> expected(new int32_t[capacity]);
+    LocalArray<int32_t> expectedStatus(new int32_t[capacity]);
+    LocalArray<int32_t> actual(new int32_t[capacity]);
+    LocalArray<int32_t> actualStatus(new int32_t[capacity]);
+    static const int32_t numThreads[] = { 1, 2, 3, 8 };
+    for (int32_t type = 0; type < UPRV_LENGTHOF(instances); ++type) {
+        RuleBasedBreakIterator *bi = dynamic_cast<RuleBasedBreakIterator *>(instances[type].getAlias());
+        if (bi == NULL) {
+            errln("FAIL: break iterator type %d is not a RuleBasedBreakIterator", (int)type);
+            continue;
+        }
+        bi->setText(text);
+        int32_t expectedLength = 0;
+        bi->first();
+        for (int32_t pos; (pos = bi->next()) != UBRK_DONE; ++expectedLength) {
+            expected[expectedLength] = pos;
+            expectedStatus[expectedLength] = bi->getRuleStatus();
+        }
+        for (int32_t t = 0; t < UPRV_LENGTHOF(numThreads); ++t) {
+            // Start from somewhere in the middle, with stale cache contents.
+            bi->following(capacity / 2);
+            int32_t length = bi->getAllBoundaries(actual.getAlias(), actualStatus.getAlias(),
+                                                  capacity, numThreads[t], status);
+            if (U_FAILURE(status) || length != expectedLength) {
+                errln("FAIL: type %d threads %d: getAllBoundaries() = %d (%s), expected %d",
+                      (int)type, (int)numThreads[t], (int)length, u_errorName(status), (int)expectedLength);
+                return;
+            }
+            for (int32_t i = 0; i < length; ++i) {
+                if (actual[i] != expected[i] || actualStatus[i] != expectedStatus[i]) {
+                    errln("FAIL: type %d threads %d: boundary #%d is %d status %d, expected %d status %d",
+                          (int)type, (int)numThreads[t], (int)i, (int)actual[i], (int)actualStatus[i],
+                          (int)expected[i], (int)expectedStatus[i]);
+                    return;
+                }
+            }
+            TEST_ASSERT(bi->current() == text.length());
+        }
+
+        // Preflighting, and too small a buffer.
+        TEST_ASSERT(bi->getAllBoundaries(NULL, NULL, 0, 3, status) == expectedLength);
+        TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+        status = U_ZERO_ERROR;
+        TEST_ASSERT(bi->getAllBoundaries(actual.getAlias(), NULL, expectedLength - 1, 3, status) == expectedLength);
+        TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+        status = U_ZERO_ERROR;
+    }
+}
+
+void RBBIAPITest::TestBreakIteratorPool() {
+    UErrorCode status = U_ZERO_ERROR;
+    BreakIteratorPool pool(2, status);
+    TEST_ASSERT_SUCCESS(status);
+    UnicodeString text(u"Hello, World! How are you?");
+    LocalPointer<BreakIterator> reference(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    BreakIterator *bi = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    if (U_FAILURE(status)) {
+        dataerrln("FAIL: BreakIteratorPool::acquire() - %s", u_errorName(status));
+        return;
+    }
+    reference->setText(text);
+    bi->setText(text);
+    TEST_ASSERT(bi->first() == 0);
+    for (int32_t pos; (pos = reference->next()) != UBRK_DONE;) {
+        TEST_ASSERT(bi->next() == pos);
+        TEST_ASSERT(bi->getRuleStatus() == reference->getRuleStatus());
+    }
+    TEST_ASSERT(bi->next() == UBRK_DONE);
+    pool.release(bi);
+
+    // The same object comes back, with its text reset.
+    BreakIterator *bi2 = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi2 == bi);
+    TEST_ASSERT(bi2->first() == 0);
+    TEST_ASSERT(bi2->next() == UBRK_DONE);
+    // Different keys do not share iterators.
+    BreakIterator *line = pool.acquire(UBRK_LINE, Locale::getEnglish(), status);
+    BreakIterator *ja = pool.acquire(UBRK_WORD, Locale::getJapanese(), status);
+    BreakIterator *bi3 = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    BreakIterator *bi4 = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(line != bi2 && ja != bi2 && bi3 != bi2 && bi4 != bi2 && bi4 != bi3);
+    TEST_ASSERT(dynamic_cast<RuleBasedBreakIterator *>(line) != NULL && *line != *bi2);
+
+    UBreakIteratorPoolStatistics stats;
+    pool.getStatistics(stats);
+    TEST_ASSERT(stats.acquired == 6 && stats.reused == 1 && stats.released == 1);
+    TEST_ASSERT(stats.discarded == 0 && stats.idle == 0 && stats.inUse == 5);
+
+    // At most 2 idle iterators per key: The third English word iterator is deleted.
+    pool.release(bi2);
+    pool.release(bi3);
+    pool.release(bi4);
+    pool.release(line);
+    pool.release(NULL);
+    // Not from this pool: Deleted, not counted.
+    pool.release(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    pool.getStatistics(stats);
+    TEST_ASSERT(stats.acquired == 6 && stats.reused == 1 && stats.released == 5);
+    TEST_ASSERT(stats.discarded == 1 && stats.idle == 3 && stats.inUse == 1);
+
+    TEST_ASSERT(pool.acquire((UBreakIteratorType)(UBRK_TITLE + 1), Locale::getEnglish(), status) == NULL);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+    status = U_ZERO_ERROR;
+    BreakIteratorPool badPool(-1, status);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+    status = U_ZERO_ERROR;
+
+    // Several threads taking iterators from the same pool and returning them.
+    static constexpr int32_t NUM_THREADS = 4;
+    static constexpr int32_t NUM_ROUNDS = 200;
+    UErrorCode threadStatus[NUM_THREADS];
+    int32_t threadFailures[NUM_THREADS] = { 0 };
+    std::thread threads[NUM_THREADS];
+    reference->first();
+    for (int32_t t = 0; t < NUM_THREADS; ++t) {
+        threadStatus[t] = U_ZERO_ERROR;
+        threads[t] = std::thread([&pool, &text, &threadStatus, &threadFailures, t]() {
+            const Locale &locale = (t & 1) == 0 ? Locale::getEnglish() : Locale::getGerman();
+            for (int32_t i = 0; i < NUM_ROUNDS; ++i) {
+                BreakIterator *wbi = pool.acquire(UBRK_WORD, locale, threadStatus[t]);
+                if (U_FAILURE(threadStatus[t])) {
+                    return;
+                }
+                wbi->setText(text);
+                int32_t count = 0;
+                for (wbi->first(); wbi->next() != UBRK_DONE;) {
+                    ++count;
+                }
+                if (count != 12) {
+                    ++threadFailures[t];
+                }
+                pool.release(wbi);
+            }
+        });
+    }
+    for (int32_t t = 0; t < NUM_THREADS; ++t) {
+        threads[t].join();
+        TEST_ASSERT_SUCCESS(threadStatus[t]);
+        TEST_ASSERT(threadFailures[t] == 0);
+    }
+    pool.getStatistics(stats);
+    TEST_ASSERT(stats.acquired == 6 + NUM_THREADS * NUM_ROUNDS);
+    TEST_ASSERT(stats.released == 5 + NUM_THREADS * NUM_ROUNDS);
+    TEST_ASSERT(stats.inUse == 1);
+    TEST_ASSERT(stats.idle <= 2 * 4);
+    TEST_ASSERT(stats.reused >= 1 + NUM_THREADS * NUM_ROUNDS - 4);
+
+    pool.release(ja);
+
+    // An iterator that was not returned outlives its pool.
+    LocalPointer<BreakIteratorPool> pool2(new BreakIteratorPool(1, status), status);
+    LocalPointer<BreakIterator> kept(pool2->acquire(UBRK_WORD, Locale::getEnglish(), status));
+    TEST_ASSERT_SUCCESS(status);
+    pool2.adoptInstead(NULL);
+    kept->setText(text);
+    TEST_ASSERT(kept->following(0) == 5);
+}
+
 #if !UCONFIG_NO_BREAK_ITERATION && !UCONFIG_NO_FILTERED_BREAK_ITERATION
 static void prtbrks(BreakIterator* brk, const UnicodeString &ustr, IntlTest &it) {
   static const UChar PILCROW=0x00B6, CHSTR=0x3010, CHEND=0x3011; // lenticular brackets
@@ -1429,6 +1713,11 @@ void RBBIAPITest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestGetBinaryRules);
 #endif
     TESTCASE_AUTO(TestRefreshInputText);
+#if !UCONFIG_NO_FILE_IO
+    TESTCASE_AUTO(TestGetBoundaries);
+    TESTCASE_AUTO(TestGetAllBoundaries);
+    TESTCASE_AUTO(TestBreakIteratorPool);
+#endif
 #if !UCONFIG_NO_BREAK_ITERATION
     TESTCASE_AUTO(TestFilteredBreakIteratorBuilder);
 #endif
@@ -90,6 +90,10 @@ class RBBIAPITest: public IntlTest {
 
     void TestRefreshInputText();
 
+    void TestGetBoundaries();
+    void TestGetAllBoundaries();
+    void TestBreakIteratorPool();
+
     /**
      *Internal subroutines
      **/
@@ -684,6 +684,7 @@ void RBBIMonkeyImpl::runTest() {
         testPreceding(status);
         testIsBoundary(status);
         testIsBoundaryRandom(status);
+        testAllBoundaries(status);
 
         if (fLoopCount < 0 && loopCount % 100 == 0) {
             fprintf(stderr, ".");
@@ -842,6 +843,54 @@ void RBBIMonkeyImpl::testIsBoundaryRandom(UErrorCode &status) {
         
 
 
+// testAllBoundaries    Run several test data strings together, until the text is long enough
+//                      for getAllBoundaries() to split it into slices for several threads,
+//                      and check that the results are the same as from sequential iteration.
+
+void RBBIMonkeyImpl::testAllBoundaries(UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    fLongText.append(fTestData->fString);
+    if (fLongText.length() < 33000) {
+        return;
+    }
+    int32_t capacity = fLongText.length();
+    LocalArray<int32_t> expected(new int32_t[capacity]);
+    LocalArray<int32_t> expectedStatus(new int32_t[capacity]);
+    LocalArray<int32_t> actual(new int32_t[capacity]);
+    LocalArray<int32_t> actualStatus(new int32_t[capacity]);
+    fBI->setText(fLongText);
+    int32_t expectedLength = 0;
+    fBI->first();
+    for (int32_t bk; (bk = fBI->next()) != BreakIterator::DONE; ++expectedLength) {
+        expected[expectedLength] = bk;
+        expectedStatus[expectedLength] = fBI->getRuleStatus();
+    }
+    int32_t actualLength = fBI->getAllBoundaries(actual.getAlias(), actualStatus.getAlias(),
+                                                 capacity, 4, status);
+    if (U_FAILURE(status)) {
+        IntlTest::gTest->errln("%s:%d getAllBoundaries() failed with %s. @rules=%s",
+                               __FILE__, __LINE__, u_errorName(status), fRuleFileName);
+    } else if (actualLength != expectedLength) {
+        IntlTest::gTest->errln("%s:%d getAllBoundaries() found %d boundaries, expected %d. @rules=%s",
+                               __FILE__, __LINE__, actualLength, expectedLength, fRuleFileName);
+        status = U_INVALID_STATE_ERROR;
+    } else {
+        for (int32_t i = 0; i < actualLength; ++i) {
+            if (actual[i] != expected[i] || actualStatus[i] != expectedStatus[i]) {
+                IntlTest::gTest->errln("%s:%d getAllBoundaries() boundary %d at %d status %d, expected %d status %d. @rules=%s",
+                                       __FILE__, __LINE__, i, actual[i], actualStatus[i],
+                                       expected[i], expectedStatus[i], fRuleFileName);
+                status = U_INVALID_STATE_ERROR;
+                break;
+            }
+        }
+    }
+    fLongText.remove();
+}
+
+
 void RBBIMonkeyImpl::checkResults(const char *msg, CheckDirection direction, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return;
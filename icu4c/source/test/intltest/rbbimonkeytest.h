@@ -196,6 +196,7 @@ class RBBIMonkeyImpl: public UObject {
     const char                          *fRuleFileName;
     UBool                                fVerbose;                 // True to do long dump of failing data.
     int32_t                              fLoopCount;
+    UnicodeString                        fLongText;               // Several test data strings, for testAllBoundaries().
 
     UBool                                fDumpExpansions;          // Debug flag to output epananded form of rules and sets.
 
@@ -210,6 +211,7 @@ class RBBIMonkeyImpl: public UObject {
     void testPreceding(UErrorCode &status);
     void testIsBoundary(UErrorCode &status);
     void testIsBoundaryRandom(UErrorCode &status);
+    void testAllBoundaries(UErrorCode &status);
     void checkResults(const char *msg, CheckDirection dir, UErrorCode &status);
 
     class RBBIMonkeyThread: public SimpleThread {
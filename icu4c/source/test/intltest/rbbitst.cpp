@@ -17,6 +17,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -114,6 +116,7 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
     TESTCASE_AUTO(TestBug13447);
     TESTCASE_AUTO(TestReverse);
     TESTCASE_AUTO(TestBug13692);
+    TESTCASE_AUTO(TestUTF8Text);
     TESTCASE_AUTO_END;
 }
 
@@ -4583,6 +4586,144 @@ void RBBITest::TestBug13692() {
     assertSuccess(WHERE, status);
 }
 
+//  TestUTF8Text checks that breaking UTF-8 text, which reads the bytes directly
+//  rather than through the UText, finds the same boundaries as breaking the
+//  equivalent UTF-16 text, including for ill-formed UTF-8 which reads as U+FFFD.
+//  Random text with code points from all of the character categories, like TestReverse.
+
+void RBBITest::TestUTF8Text() {
+    UErrorCode status = U_ZERO_ERROR;
+    TestUTF8Text(std::unique_ptr<RuleBasedBreakIterator>((RuleBasedBreakIterator *)
+            BreakIterator::createCharacterInstance(Locale::getEnglish(), status)));
+    assertSuccess(WHERE, status, true);
+    status = U_ZERO_ERROR;
+    TestUTF8Text(std::unique_ptr<RuleBasedBreakIterator>((RuleBasedBreakIterator *)
+            BreakIterator::createWordInstance(Locale::getEnglish(), status)));
+    assertSuccess(WHERE, status, true);
+    status = U_ZERO_ERROR;
+    TestUTF8Text(std::unique_ptr<RuleBasedBreakIterator>((RuleBasedBreakIterator *)
+            BreakIterator::createLineInstance(Locale::getJapanese(), status)));
+    assertSuccess(WHERE, status, true);
+    status = U_ZERO_ERROR;
+    TestUTF8Text(std::unique_ptr<RuleBasedBreakIterator>((RuleBasedBreakIterator *)
+            BreakIterator::createSentenceInstance(Locale::getEnglish(), status)));
+    assertSuccess(WHERE, status, true);
+}
+
+void RBBITest::TestUTF8Text(std::unique_ptr<RuleBasedBreakIterator>bi) {
+    if (!bi) {
+        return;
+    }
+    RBBIDataWrapper *data = bi->fData;
+    int32_t categoryCount = data->fHeader->fCatCount;
+    UTrie2  *trie = data->fTrie;
+
+    std::vector<UnicodeString> strings(categoryCount, UnicodeString());
+    for (int cp=0; cp<0x1fff0; ++cp) {
+        if (U_IS_SURROGATE(cp)) {
+            continue;   // Not encodable in UTF-8.
+        }
+        int cat = utrie2_get32(trie, cp) & ~0x4000;
+        strings[cat].append(cp);
+    }
+
+    // Ill-formed sequences: a lone trail byte, non-shortest forms, a surrogate,
+    // a truncated sequence and a byte that never occurs in UTF-8.
+    static const char *illFormed[] = {
+        "\x80", "\xc0\xaf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf0\x9f\x98", "\xff"
+    };
+    icu_rand randomGen;
+    const int testStringLength = 3000;
+    std::string utf8;
+    for (int i=0; i<testStringLength; ++i) {
+        if (randomGen() % 20 == 0) {
+            utf8.append(illFormed[randomGen() % UPRV_LENGTHOF(illFormed)]);
+            continue;
+        }
+        int charClass = randomGen() % categoryCount;
+        if (strings[charClass].length() > 0) {
+            UChar32 cp = strings[charClass].char32At(randomGen() % strings[charClass].length());
+            char buffer[U8_MAX_LENGTH];
+            int32_t length = 0;
+            U8_APPEND_UNSAFE(buffer, length, cp);
+            utf8.append(buffer, length);
+        }
+    }
+
+    // The UTF-16 equivalent, with the UTF-8 offset of each UTF-16 code point start.
+    UnicodeString utf16;
+    std::vector<int32_t> utf16ToUTF8;
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(utf8.data());
+    int32_t utf8Length = static_cast<int32_t>(utf8.length());
+    for (int32_t i = 0; i < utf8Length;) {
+        int32_t start = i;
+        UChar32 c;
+        U8_NEXT_OR_FFFD(s, i, utf8Length, c);
+        utf16.append(c);
+        while (static_cast<int32_t>(utf16ToUTF8.size()) < utf16.length()) {
+            utf16ToUTF8.push_back(start);
+        }
+    }
+    utf16ToUTF8.push_back(utf8Length);
+
+    std::vector<int32_t> expectedBoundaries;
+    std::vector<int32_t> expectedStatus;
+    bi->setText(utf16);
+    for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next()) {
+        expectedBoundaries.push_back(utf16ToUTF8[b]);
+        expectedStatus.push_back(bi->getRuleStatus());
+    }
+
+    UErrorCode status = U_ZERO_ERROR;
+    LocalUTextPointer ut(utext_openUTF8(nullptr, utf8.data(), utf8Length, &status));
+    bi->setText(ut.getAlias(), status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    size_t n = 0;
+    for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next(), ++n) {
+        if (n >= expectedBoundaries.size()) {
+            errln("%s:%d extra boundary %d", __FILE__, __LINE__, b);
+            return;
+        }
+        if (expectedBoundaries[n] != b || expectedStatus[n] != bi->getRuleStatus()) {
+            errln("%s:%d boundary %d status %d, expected %d status %d", __FILE__, __LINE__,
+                  b, bi->getRuleStatus(), expectedBoundaries[n], expectedStatus[n]);
+            return;
+        }
+    }
+    assertEquals(WHERE, (int32_t)expectedBoundaries.size(), (int32_t)n);
+    for (int32_t b = bi->last(); b != BreakIterator::DONE; b = bi->previous()) {
+        if (n == 0 || expectedBoundaries[--n] != b) {
+            errln("%s:%d backwards boundary %d, expected %d", __FILE__, __LINE__,
+                  b, n < expectedBoundaries.size() ? expectedBoundaries[n] : -1);
+            return;
+        }
+    }
+
+    // Random access at each code point start, from an empty cache, to use the safe reverse rules.
+    for (int32_t i = static_cast<int32_t>(utf16ToUTF8.size()) - 1; i >= 0; i -= 3) {
+        int32_t offset = utf16ToUTF8[i];
+        auto it = std::upper_bound(expectedBoundaries.begin(), expectedBoundaries.end(), offset);
+        int32_t expectedFollowing = it == expectedBoundaries.end() ? BreakIterator::DONE : *it;
+        bi->setText(ut.getAlias(), status);
+        if (expectedFollowing != bi->following(offset)) {
+            errln("%s:%d following(%d) = %d, expected %d", __FILE__, __LINE__,
+                  offset, bi->current(), expectedFollowing);
+            return;
+        }
+        it = std::lower_bound(expectedBoundaries.begin(), expectedBoundaries.end(), offset);
+        int32_t expectedPreceding = it == expectedBoundaries.begin() ? BreakIterator::DONE : *(it - 1);
+        bi->setText(ut.getAlias(), status);
+        if (expectedPreceding != bi->preceding(offset)) {
+            errln("%s:%d preceding(%d) = %d, expected %d", __FILE__, __LINE__,
+                  offset, bi->current(), expectedPreceding);
+            return;
+        }
+    }
+    assertSuccess(WHERE, status);
+}
+
 //
 //  TestDebug    -  A place-holder test for debugging purposes.
 //                  For putting in fragments of other tests that can be invoked
@@ -82,6 +82,8 @@ class RBBITest: public IntlTest {
     void TestReverse();
     void TestReverse(std::unique_ptr<RuleBasedBreakIterator>bi);
     void TestBug13692();
+    void TestUTF8Text();
+    void TestUTF8Text(std::unique_ptr<RuleBasedBreakIterator>bi);
 
     void TestDebug();
     void TestProperties();
@@ -18,6 +18,7 @@
 #include "unicode/ustring.h"
 #include "unicode/schriter.h"
 #include "cmemory.h"
+#include "uvectr32.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -170,6 +171,7 @@ void StringSearchTest::runIndexedTest(int32_t index, UBool exec,
         CASE(34, TestSubclass)
         CASE(35, TestCoverage)
         CASE(36, TestDiacriticMatch)
+        CASE(37, TestSkipSearch)
         default: name = ""; break;
     }
 #else
@@ -1709,6 +1711,65 @@ void StringSearchTest::TestDiacriticMatch()
     
 }
  
+namespace {
+
+/** Collects the forward matches as start/length pairs. */
+void getForwardMatches(StringSearch &strsrch, UVector32 &matches, UErrorCode &status) {
+    matches.removeAllElements();
+    for (int32_t start = strsrch.first(status);
+            start != USEARCH_DONE && U_SUCCESS(status);
+            start = strsrch.next(status)) {
+        matches.addElement(start, status);
+        matches.addElement(strsrch.getMatchedLength(), status);
+    }
+}
+
+}  // namespace
+
+void StringSearchTest::TestSkipSearch()
+{
+    static const SearchData *const dataSets[] = {
+        BASIC, NORMEXACT, STRENGTH, MATCH, SUPPLEMENTARY, COMPOSITEBOUNDARIES, DIACRITICMATCH
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    UVector32 expected(status), actual(status);
+    UChar temp[128];
+    for (int32_t set = 0; set < UPRV_LENGTHOF(dataSets); ++set) {
+        for (const SearchData *search = dataSets[set]; search->text != NULL; ++search) {
+            u_unescape(search->text, temp, 128);
+            UnicodeString text(temp);
+            // Repeat the text so that the skip search has room to skip.
+            for (int32_t i = 0; i < 4; ++i) {
+                text.append(text);
+            }
+            u_unescape(search->pattern, temp, 128);
+            UnicodeString pattern(temp);
+            RuleBasedCollator *collator = getCollator(search->collator);
+            collator->setStrength(getECollationStrength(search->strength));
+            StringSearch strsrch(pattern, text, collator, NULL, status);
+            strsrch.setAttribute(USEARCH_ELEMENT_COMPARISON, search->elemCompare, status);
+            getForwardMatches(strsrch, expected, status);
+            strsrch.setAttribute(USEARCH_SKIP_SEARCH, USEARCH_ON, status);
+            if (U_SUCCESS(status) && strsrch.getAttribute(USEARCH_SKIP_SEARCH) != USEARCH_ON) {
+                errln("set %d test %d: setAttribute(USEARCH_SKIP_SEARCH, USEARCH_ON) had no effect",
+                      (int)set, (int)(search - dataSets[set]));
+            }
+            getForwardMatches(strsrch, actual, status);
+            collator->setStrength(getECollationStrength(UCOL_TERTIARY));
+            if (U_FAILURE(status)) {
+                errln("set %d test %d: search failed - %s",
+                      (int)set, (int)(search - dataSets[set]), u_errorName(status));
+                status = U_ZERO_ERROR;
+            } else if (actual != expected) {
+                errln("set %d test %d: skip search found %d matches, the default search %d "
+                      "for pattern %s",
+                      (int)set, (int)(search - dataSets[set]),
+                      (int)actual.size() / 2, (int)expected.size() / 2, search->pattern);
+            }
+        }
+    }
+}
+
 void StringSearchTest::TestCanonical()
 {
     int count = 0;
@@ -91,6 +91,7 @@ class StringSearchTest: public IntlTest
     void TestSubclass();
     void TestCoverage();
     void TestDiacriticMatch();
+    void TestSkipSearch();
 #endif
 };
 
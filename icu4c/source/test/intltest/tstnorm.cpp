@@ -6,6 +6,8 @@
  * others. All Rights Reserved.
  ********************************************************************/
 
+#include <vector>
+
 #include "unicode/utypes.h"
 
 #if !UCONFIG_NO_NORMALIZATION
@@ -13,6 +15,7 @@
 #include "unicode/uchar.h"
 #include "unicode/errorcode.h"
 #include "unicode/normlzr.h"
+#include "unicode/normalizer2.h"
 #include "unicode/stringoptions.h"
 #include "unicode/uniset.h"
 #include "unicode/usetiter.h"
@@ -55,11 +58,16 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
 #endif
     TESTCASE_AUTO(TestFilteredNormalizer2Coverage);
     TESTCASE_AUTO(TestNormalizeUTF8WithEdits);
+    TESTCASE_AUTO(TestDecomposeUTF8WithEdits);
+    TESTCASE_AUTO(TestMakeFCDUTF8WithEdits);
     TESTCASE_AUTO(TestLowMappingToEmpty_D);
     TESTCASE_AUTO(TestLowMappingToEmpty_FCD);
     TESTCASE_AUTO(TestNormalizeIllFormedText);
     TESTCASE_AUTO(TestComposeJamoTBase);
     TESTCASE_AUTO(TestComposeBoundaryAfter);
+    TESTCASE_AUTO(TestStreamingNormalizer2);
+    TESTCASE_AUTO(TestBatch);
+    TESTCASE_AUTO(TestComposeUTF8ASCIIMap);
     TESTCASE_AUTO_END;
 }
 
@@ -1669,6 +1677,91 @@ BasicNormalizerTest::TestNormalizeUTF8WithEdits() {
             TRUE, errorCode);
 }
 
+void
+BasicNormalizerTest::TestDecomposeUTF8WithEdits() {
+    IcuTestErrorCode errorCode(*this, "TestDecomposeUTF8WithEdits");
+    const Normalizer2 *nfd=Normalizer2::getNFDInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFDInstance() call failed")) {
+        return;
+    }
+    std::string src(u8"  AÄA\u0308\u0323Ä\u0323,가");
+    src.append("\xC0\x80  ");
+    std::string expected(u8"  AA\u0308A\u0323\u0308A\u0323\u0308,\u1100\u1161");
+    expected.append("\xC0\x80  ");
+    std::string result;
+    StringByteSink<std::string> sink(&result, expected.length());
+    Edits edits;
+    nfd->normalizeUTF8(0, src, sink, &edits, errorCode);
+    assertSuccess("NFD normalizeUTF8 with Edits", errorCode.get());
+    assertEquals("NFD normalizeUTF8 with Edits", expected.c_str(), result.c_str());
+    static const EditChange expectedChanges[] = {
+        { FALSE, 3, 3 },  // 2 spaces + A
+        { TRUE, 2, 3 },  // Ä→A\u0308
+        { FALSE, 1, 1 },  // A
+        { TRUE, 4, 4 },  // \u0308\u0323→\u0323\u0308
+        { TRUE, 4, 5 },  // Ä\u0323→A\u0323\u0308
+        { FALSE, 1, 1 },  // comma
+        { TRUE, 3, 6 },  // 가→\u1100\u1161
+        { FALSE, 4, 4 }  // ill-formed sequence + 2 spaces
+    };
+    assertTrue("NFD normalizeUTF8 with Edits hasChanges", edits.hasChanges());
+    assertEquals("NFD normalizeUTF8 with Edits numberOfChanges", 4, edits.numberOfChanges());
+    TestUtility::checkEditsIter(*this, u"NFD normalizeUTF8 with Edits",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+
+    assertFalse("NFD isNormalizedUTF8(source)", nfd->isNormalizedUTF8(src, errorCode));
+    assertTrue("NFD isNormalizedUTF8(normalized)", nfd->isNormalizedUTF8(result, errorCode));
+
+    // Omit unchanged text.
+    expected = u8"A\u0308\u0323\u0308A\u0323\u0308\u1100\u1161";
+    result.clear();
+    edits.reset();
+    nfd->normalizeUTF8(U_OMIT_UNCHANGED_TEXT, src, sink, &edits, errorCode);
+    assertSuccess("NFD normalizeUTF8 omit unchanged", errorCode.get());
+    assertEquals("NFD normalizeUTF8 omit unchanged", expected.c_str(), result.c_str());
+    TestUtility::checkEditsIter(*this, u"NFD normalizeUTF8 omit unchanged",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+}
+
+void
+BasicNormalizerTest::TestMakeFCDUTF8WithEdits() {
+    IcuTestErrorCode errorCode(*this, "TestMakeFCDUTF8WithEdits");
+    const Normalizer2 *fcd=Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance(FCD) call failed")) {
+        return;
+    }
+    std::string src(u8"  A\u0308\u0323Ä\u0323\u0300,Ä");
+    src.append("\xC0\x80  ");
+    std::string expected(u8"  A\u0323\u0308A\u0323\u0308\u0300,Ä");
+    expected.append("\xC0\x80  ");
+    std::string result;
+    StringByteSink<std::string> sink(&result, expected.length());
+    Edits edits;
+    fcd->normalizeUTF8(0, src, sink, &edits, errorCode);
+    assertSuccess("FCD normalizeUTF8 with Edits", errorCode.get());
+    assertEquals("FCD normalizeUTF8 with Edits", expected.c_str(), result.c_str());
+    static const EditChange expectedChanges[] = {
+        { FALSE, 3, 3 },  // 2 spaces + A
+        { TRUE, 4, 4 },  // \u0308\u0323→\u0323\u0308
+        { TRUE, 6, 7 },  // Ä\u0323\u0300→A\u0323\u0308\u0300
+        { FALSE, 7, 7 }  // comma + Ä + ill-formed sequence + 2 spaces
+    };
+    assertEquals("FCD normalizeUTF8 with Edits numberOfChanges", 2, edits.numberOfChanges());
+    TestUtility::checkEditsIter(*this, u"FCD normalizeUTF8 with Edits",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+
+    assertFalse("FCD isNormalizedUTF8(source)", fcd->isNormalizedUTF8(src, errorCode));
+    assertTrue("FCD isNormalizedUTF8(normalized)", fcd->isNormalizedUTF8(result, errorCode));
+    // Not NFD but FCD.
+    assertTrue("FCD isNormalizedUTF8(Ä\u0323)", fcd->isNormalizedUTF8(u8"Ä\u0300\u0301", errorCode));
+}
+
 void
 BasicNormalizerTest::TestLowMappingToEmpty_D() {
     IcuTestErrorCode errorCode(*this, "TestLowMappingToEmpty_D");
@@ -1805,4 +1898,255 @@ BasicNormalizerTest::TestComposeBoundaryAfter() {
     assertFalse("U+FB2C boundary-after", nfkc->hasBoundaryAfter(0xFB2C));
 }
 
+namespace {
+
+class FlushCountingByteSink : public ByteSink {
+public:
+    FlushCountingByteSink() : flushCount(0) {}
+    virtual void Append(const char *bytes, int32_t n) { result.append(bytes, n); }
+    virtual void Flush() { ++flushCount; }
+    std::string result;
+    int32_t flushCount;
+};
+
+}  // namespace
+
+void
+BasicNormalizerTest::TestStreamingNormalizer2() {
+    IcuTestErrorCode errorCode(*this, "TestStreamingNormalizer2");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *nfkc_cf = Normalizer2::getNFKCCasefoldInstance(errorCode);
+    const Normalizer2 *fcd = Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    const Normalizer2 *normalizers[] = { nfc, nfd, nfkc_cf, fcd };
+    const char *const names[] = { "nfc", "nfd", "nfkc_cf", "fcd" };
+    // Combining sequences, Hangul, supplementary code points, and compatibility mappings,
+    // so that chunk boundaries fall into the middle of segments and multi-unit characters.
+    UnicodeString s(u"ABc\u0308\u0301d\u1EA1\u0308 \uAC00\u11A8\u1100\u1161\u11A8 "
+                    u"\U0001D15E\u0327\U0001D165\u0301 \uFB2C\u05B6x\u02DA\u0339 \u00C5\u0323\uFF21");
+    std::string s8;
+    s.toUTF8String(s8);
+    for(int32_t n=0; n<UPRV_LENGTHOF(normalizers); ++n) {
+        const Normalizer2 &n2=*normalizers[n];
+        UnicodeString expected=n2.normalize(s, errorCode);
+        std::string expected8;
+        expected.toUTF8String(expected8);
+        StreamingNormalizer2 sn(n2);
+        // UTF-16, split into three chunks at every pair of indexes.
+        int32_t length=s.length();
+        for(int32_t i=0; i<=length; ++i) {
+            for(int32_t j=i; j<=length; ++j) {
+                UnicodeString result;
+                sn.normalize(s.getBuffer(), i, result, errorCode);
+                sn.normalize(s.getBuffer()+i, j-i, result, errorCode);
+                sn.normalize(s.getBuffer()+j, length-j, result, errorCode);
+                sn.finish(result, errorCode);
+                if(errorCode.errIfFailureAndReset("%s split at %d and %d", names[n], (int)i, (int)j)) {
+                    return;
+                }
+                if(result!=expected) {
+                    errln("%s: streaming normalization of UTF-16 split at %d and %d differs",
+                          names[n], (int)i, (int)j);
+                    return;
+                }
+                assertFalse("no pending text after finish()", sn.hasPendingText());
+            }
+        }
+        // UTF-8, split into three chunks at every pair of byte indexes.
+        int32_t length8=(int32_t)s8.length();
+        for(int32_t i=0; i<=length8; ++i) {
+            for(int32_t j=i; j<=length8; ++j) {
+                std::string result8;
+                StringByteSink<std::string> sink(&result8);
+                Edits edits;
+                StringPiece sp(s8);
+                sn.normalizeUTF8(0, StringPiece(sp.data(), i), sink, &edits, errorCode);
+                sn.normalizeUTF8(0, StringPiece(sp.data()+i, j-i), sink, &edits, errorCode);
+                sn.normalizeUTF8(0, StringPiece(sp.data()+j, length8-j), sink, &edits, errorCode);
+                sn.finishUTF8(0, sink, &edits, errorCode);
+                if(errorCode.errIfFailureAndReset("%s UTF-8 split at %d and %d", names[n], (int)i, (int)j)) {
+                    return;
+                }
+                if(result8!=expected8) {
+                    errln("%s: streaming normalization of UTF-8 split at %d and %d differs",
+                          names[n], (int)i, (int)j);
+                    return;
+                }
+                if(edits.lengthDelta()!=(int32_t)(expected8.length()-s8.length())) {
+                    errln("%s: streaming normalization of UTF-8 split at %d and %d: wrong Edits",
+                          names[n], (int)i, (int)j);
+                    return;
+                }
+            }
+        }
+    }
+
+    // A stream must not mix UTF-16 and UTF-8 text.
+    StreamingNormalizer2 sn(*nfc);
+    UnicodeString result;
+    sn.normalize(u"a", -1, result, errorCode);
+    assertTrue("'a' pending", sn.hasPendingText());
+    std::string result8;
+    StringByteSink<std::string> sink(&result8);
+    sn.normalizeUTF8(0, "b", sink, nullptr, errorCode);
+    errorCode.expectErrorAndReset(U_INVALID_STATE_ERROR);
+    sn.reset();
+    assertFalse("nothing pending after reset()", sn.hasPendingText());
+    sn.normalizeUTF8(0, "b\xCC", sink, nullptr, errorCode);
+    sn.normalizeUTF8(0, "\x81", sink, nullptr, errorCode);  // U+0301 split across chunks
+    sn.finishUTF8(0, sink, nullptr, errorCode);
+    assertSuccess("UTF-8 after reset()", errorCode.get());
+    assertEquals("b+U+0301 split across chunks", "b\xCC\x81", result8.c_str());
+
+    // Every call flushes the sink, even when the whole chunk is kept pending.
+    FlushCountingByteSink countingSink;
+    sn.normalizeUTF8(0, "c", countingSink, nullptr, errorCode);
+    assertEquals("flushed while 'c' is pending", 1, countingSink.flushCount);
+    sn.normalizeUTF8(0, "\xCC\x81", countingSink, nullptr, errorCode);
+    assertEquals("flushed while c+U+0301 is pending", 2, countingSink.flushCount);
+    sn.finishUTF8(0, countingSink, nullptr, errorCode);
+    assertTrue("flushed at the end", countingSink.flushCount >= 3);
+    sn.finishUTF8(0, countingSink, nullptr, errorCode);
+    assertTrue("flushed with nothing pending", countingSink.flushCount >= 4);
+    assertSuccess("FlushCountingByteSink", errorCode.get());
+    assertEquals("c+U+0301", "\xC4\x87", countingSink.result.c_str());
+}
+
+
+void
+BasicNormalizerTest::TestBatch() {
+    IcuTestErrorCode errorCode(*this, "TestBatch");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfkc_cf = Normalizer2::getNFKCCasefoldInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    static const char16_t *const samples[] = {
+        u"", u"abc", u"\u00E4", u"a\u0308", u"\u1100\u1161\u11A8", u"\u1EA0\u0302",
+        u"\uFB2C\u05B6", u"\U0001D15E", u"\u0301x", u"\u00C5\uFF21"
+    };
+    // Enough strings to be split across several threads.
+    const int32_t count = 5000;
+    std::vector<UnicodeString> strings(count);
+    std::vector<std::string> strings8(count);
+    std::vector<StringPiece> pieces(count);
+    for(int32_t i=0; i<count; ++i) {
+        strings[i] = samples[i % UPRV_LENGTHOF(samples)];
+        if((i % 7) == 0) {
+            strings[i].append(u'a' + (i % 26));
+        }
+        strings[i].toUTF8String(strings8[i]);
+        pieces[i] = strings8[i];
+    }
+    const Normalizer2 *normalizers[] = { nfc, nfkc_cf };
+    const char *const names[] = { "nfc", "nfkc_cf" };
+    for(int32_t n=0; n<UPRV_LENGTHOF(normalizers); ++n) {
+        const Normalizer2 &n2=*normalizers[n];
+        std::string expected;
+        for(int32_t i=0; i<count; ++i) {
+            n2.normalize(strings[i], errorCode).toUTF8String(expected);
+        }
+        for(int32_t numThreads : { 1, 4 }) {
+            std::string result;
+            StringByteSink<std::string> sink(&result);
+            std::vector<int32_t> offsets(count+1);
+            n2.normalizeUTF8Batch(pieces.data(), count, sink, offsets.data(), numThreads, errorCode);
+            if(errorCode.errIfFailureAndReset("%s normalizeUTF8Batch(%d threads)", names[n], (int)numThreads)) {
+                return;
+            }
+            assertTrue(UnicodeString(names[n]) + " normalizeUTF8Batch result", result==expected);
+            assertEquals("total length", (int32_t)expected.length(), offsets[count]);
+            for(int32_t i=0; i<count; ++i) {
+                std::string single;
+                n2.normalize(strings[i], errorCode).toUTF8String(single);
+                if(result.compare(offsets[i], offsets[i+1]-offsets[i], single)!=0) {
+                    errln("%s normalizeUTF8Batch(%d threads): wrong offsets for string %d",
+                          names[n], (int)numThreads, (int)i);
+                    break;
+                }
+            }
+
+            std::vector<UNormalizationCheckResult> qc(count);
+            std::vector<UBool> isNorm(count);
+            n2.quickCheckBatch(strings.data(), count, qc.data(), numThreads, errorCode);
+            n2.isNormalizedUTF8Batch(pieces.data(), count, isNorm.data(), numThreads, errorCode);
+            if(errorCode.errIfFailureAndReset("%s check batches (%d threads)", names[n], (int)numThreads)) {
+                return;
+            }
+            for(int32_t i=0; i<count; ++i) {
+                if(qc[i]!=n2.quickCheck(strings[i], errorCode) ||
+                        isNorm[i]!=n2.isNormalized(strings[i], errorCode)) {
+                    errln("%s check batches (%d threads): wrong result for string %d",
+                          names[n], (int)numThreads, (int)i);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Empty batches and illegal arguments.
+    std::string result;
+    StringByteSink<std::string> sink(&result);
+    int32_t offset = -1;
+    nfc->normalizeUTF8Batch(nullptr, 0, sink, &offset, 4, errorCode);
+    assertSuccess("empty batch", errorCode.get());
+    assertEquals("empty batch offsets[0]", 0, offset);
+    nfc->normalizeUTF8Batch(pieces.data(), -1, sink, nullptr, 1, errorCode);
+    errorCode.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR);
+    nfc->quickCheckBatch(strings.data(), 1, nullptr, 1, errorCode);
+    errorCode.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR);
+}
+
+
+void
+BasicNormalizerTest::TestComposeUTF8ASCIIMap() {
+    // NFKC_Casefold lowercases ASCII A..Z via a table when normalizing UTF-8.
+    // The last ASCII character before non-ASCII text must still compose with what follows.
+    IcuTestErrorCode errorCode(*this, "TestComposeUTF8ASCIIMap");
+    const Normalizer2 *nfkc_cf = Normalizer2::getNFKCCasefoldInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFKCCasefoldInstance() call failed")) {
+        return;
+    }
+    static const char16_t *const pieces[] = {
+        u"A", u"z", u"Ab.", u"\u00C4", u"\u0308", u"\u0301\u0323", u"\u00AD",
+        u"\u00DF", u"\u01C4", u"\u1100", u"\u1161", u"\uFF21", u"\U0001D15E"
+    };
+    int32_t numPieces = UPRV_LENGTHOF(pieces);
+    for(int32_t i=0; i<numPieces; ++i) {
+        for(int32_t j=0; j<numPieces; ++j) {
+            for(int32_t k=0; k<numPieces; ++k) {
+                UnicodeString s = UnicodeString(pieces[i]).append(pieces[j]).append(pieces[k]);
+                std::string s8, expected8, result8, omitted8;
+                s.toUTF8String(s8);
+                nfkc_cf->normalize(s, errorCode).toUTF8String(expected8);
+                StringByteSink<std::string> sink(&result8);
+                Edits edits;
+                nfkc_cf->normalizeUTF8(0, s8, sink, &edits, errorCode);
+                StringByteSink<std::string> omittedSink(&omitted8);
+                nfkc_cf->normalizeUTF8(U_OMIT_UNCHANGED_TEXT, s8, omittedSink, nullptr, errorCode);
+                if(errorCode.errIfFailureAndReset("normalizeUTF8(pieces %d %d %d)", (int)i, (int)j, (int)k)) {
+                    return;
+                }
+                if(result8!=expected8 || omitted8.length()>result8.length()) {
+                    errln("NFKC_Casefold UTF-8 != UTF-16 for pieces %d %d %d", (int)i, (int)j, (int)k);
+                    return;
+                }
+                if(edits.lengthDelta()!=(int32_t)(expected8.length()-s8.length())) {
+                    errln("NFKC_Casefold UTF-8 wrong Edits for pieces %d %d %d", (int)i, (int)j, (int)k);
+                    return;
+                }
+            }
+        }
+    }
+    // Ill-formed sequences are copied and split ASCII runs.
+    std::string result8;
+    StringByteSink<std::string> sink(&result8);
+    nfkc_cf->normalizeUTF8(0, "AB" "\xFF" "CD" "\xCC" "E", sink, nullptr, errorCode);
+    assertSuccess("ill-formed", errorCode.get());
+    assertEquals("ill-formed", "ab" "\xFF" "cd" "\xCC" "e", result8.c_str());
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
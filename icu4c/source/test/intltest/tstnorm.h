@@ -48,11 +48,16 @@ class BasicNormalizerTest : public IntlTest {
     void TestCustomFCC();
     void TestFilteredNormalizer2Coverage();
     void TestNormalizeUTF8WithEdits();
+    void TestDecomposeUTF8WithEdits();
+    void TestMakeFCDUTF8WithEdits();
     void TestLowMappingToEmpty_D();
     void TestLowMappingToEmpty_FCD();
     void TestNormalizeIllFormedText();
     void TestComposeJamoTBase();
     void TestComposeBoundaryAfter();
+    void TestStreamingNormalizer2();
+    void TestBatch();
+    void TestComposeUTF8ASCIIMap();
 
 private:
     UnicodeString canonTests[24][3];
@@ -9,10 +9,12 @@
 ***********************************************************************
 */
 
+#include <algorithm>
 #include <string.h>
 #include "unicode/localpointer.h"
 #include "unicode/uperf.h"
 #include "unicode/ucol.h"
+#include "unicode/ucoleitr.h"
 #include "unicode/coll.h"
 #include "unicode/uiter.h"
 #include "unicode/ustring.h"
@@ -328,6 +330,90 @@ long GetSortKey::getOperationsPerIteration()
     return source->count;
 }
 
+//
+// Test case taking a single test data array, calling ucol_getSortKeys
+// or ucol_getSortKeysUTF8 with one reused buffer for all of the keys
+//
+#define KEY_ARENA_SIZE 0x10000
+
+class GetSortKeys : public UPerfFunction
+{
+public:
+    GetSortKeys(const UCollator* coll, const CA_uchar* source16, const CA_char* source8);
+    ~GetSortKeys();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+
+private:
+    const UCollator *coll;
+    int32_t count;
+    const UChar **strings16;
+    const char **strings8;
+    int32_t *lengths;
+    uint8_t *arena;
+    int32_t *keyOffsets;
+};
+
+GetSortKeys::GetSortKeys(const UCollator* coll, const CA_uchar* source16, const CA_char* source8)
+    :   coll(coll),
+        count(source16 != NULL ? source16->count : source8->count),
+        strings16(NULL),
+        strings8(NULL)
+{
+    if (source16 != NULL) {
+        strings16 = new const UChar *[count];
+    } else {
+        strings8 = new const char *[count];
+    }
+    lengths = new int32_t[count];
+    for (int32_t i = 0; i < count; i++) {
+        if (source16 != NULL) {
+            strings16[i] = source16->dataOf(i);
+            lengths[i] = source16->lengthOf(i);
+        } else {
+            strings8[i] = source8->dataOf(i);
+            lengths[i] = source8->lengthOf(i);
+        }
+    }
+    arena = new uint8_t[KEY_ARENA_SIZE];
+    keyOffsets = new int32_t[count + 1];
+}
+
+GetSortKeys::~GetSortKeys()
+{
+    delete[] strings16;
+    delete[] strings8;
+    delete[] lengths;
+    delete[] arena;
+    delete[] keyOffsets;
+}
+
+void GetSortKeys::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    // Start over at the beginning of the arena whenever it is full.
+    for (int32_t start = 0; start < count && U_SUCCESS(*status);) {
+        int32_t numKeys;
+        if (strings16 != NULL) {
+            numKeys = ucol_getSortKeys(coll, strings16 + start, lengths + start, count - start,
+                                       arena, KEY_ARENA_SIZE, keyOffsets, status);
+        } else {
+            numKeys = ucol_getSortKeysUTF8(coll, strings8 + start, lengths + start, count - start,
+                                           arena, KEY_ARENA_SIZE, keyOffsets, status);
+        }
+        if (numKeys == 0) {
+            *status = U_BUFFER_OVERFLOW_ERROR;
+        }
+        start += numKeys;
+    }
+}
+
+long GetSortKeys::getOperationsPerIteration()
+{
+    return count;
+}
+
 //
 // Test case taking a single test data array in UTF-16, calling ucol_nextSortKeyPart for each for the
 // given buffer size
@@ -462,6 +548,83 @@ long NextSortKeyPartUTF8::getEventsPerIteration()
     return events;
 }
 
+//
+// Test case taking a single test data array, iterating over the collation elements
+// of each string with ucol_next() or ucol_nextCEs()
+//
+class NextCEs : public UPerfFunction
+{
+public:
+    NextCEs(const UCollator* coll, const CA_uchar* source16, const CA_char* source8, UBool bulk);
+    ~NextCEs();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+    virtual long getEventsPerIteration();
+
+private:
+    const UCollator *coll;
+    const CA_uchar *source16;
+    const CA_char *source8;
+    UBool bulk;
+    UCollationElements *elems;
+    long events;
+};
+
+NextCEs::NextCEs(const UCollator* coll, const CA_uchar* source16, const CA_char* source8, UBool bulk)
+    :   coll(coll),
+        source16(source16),
+        source8(source8),
+        bulk(bulk),
+        elems(NULL),
+        events(0)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    elems = ucol_openElements(coll, NULL, 0, &status);
+}
+
+NextCEs::~NextCEs()
+{
+    ucol_closeElements(elems);
+}
+
+void NextCEs::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    const int32_t capacity = 64;
+    int64_t ces[capacity];
+    int32_t count = source16 != NULL ? source16->count : source8->count;
+    events = 0;
+    for (int32_t i = 0; i < count && U_SUCCESS(*status); i++) {
+        if (source16 != NULL) {
+            ucol_setText(elems, source16->dataOf(i), source16->lengthOf(i), status);
+        } else {
+            ucol_setTextUTF8(elems, source8->dataOf(i), source8->lengthOf(i), status);
+        }
+        if (bulk) {
+            int32_t length;
+            do {
+                length = ucol_nextCEs(elems, ces, capacity, NULL, status);
+                events += length;
+            } while (length == capacity);
+        } else {
+            while (ucol_next(elems, status) != UCOL_NULLORDER) {
+                events++;
+            }
+        }
+    }
+}
+
+long NextCEs::getOperationsPerIteration()
+{
+    return source16 != NULL ? source16->count : source8->count;
+}
+
+long NextCEs::getEventsPerIteration()
+{
+    return events;
+}
+
 // CPP API test cases
 
 //
@@ -841,6 +1004,101 @@ void UniStrSort::call(UErrorCode* status) {
     ops = cc.counter;
 }
 
+//
+// Test case sorting an array of UnicodeString pointers with std::sort() and Collator::compare().
+// Counts strings rather than comparisons, for comparison with SortStrings.
+//
+class UniStrStdSort : public UniStrCollPerfFunction {
+public:
+    UniStrStdSort(const Collator& coll, const UCollator *ucoll, const CA_uchar* data16)
+            : UniStrCollPerfFunction(coll, ucoll, data16),
+              dest(new UnicodeString*[d16->count]) {}
+    virtual ~UniStrStdSort();
+    virtual void call(UErrorCode* status);
+
+private:
+    UnicodeString** dest;  // aliases only
+};
+
+UniStrStdSort::~UniStrStdSort() {
+    delete[] dest;
+}
+
+void UniStrStdSort::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    int32_t count = d16->count;
+    memcpy(dest, source, count * sizeof(UnicodeString *));
+    const Collator &c = coll;
+    std::sort(dest, dest + count, [&c](const UnicodeString *left, const UnicodeString *right) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        return c.compare(*left, *right, errorCode) == UCOL_LESS;
+    });
+    ops = count;
+}
+
+//
+// Test case sorting an array of strings with ucol_sortStrings()
+// or ucol_sortStringsUTF8() and the given number of threads.
+//
+class SortStrings : public CollPerfFunction {
+public:
+    SortStrings(const Collator& coll, const UCollator *ucoll,
+                const CA_uchar* data16, const CA_char* data8, int32_t numThreads);
+    virtual ~SortStrings();
+    virtual void call(UErrorCode* status);
+
+private:
+    int32_t count;
+    int32_t numThreads;
+    const UChar **strings16;
+    const char **strings8;
+    int32_t *lengths;
+    int32_t *permutation;
+};
+
+SortStrings::SortStrings(const Collator& coll, const UCollator *ucoll,
+                         const CA_uchar* data16, const CA_char* data8, int32_t numThreads)
+        : CollPerfFunction(coll, ucoll),
+          count(data16 != NULL ? data16->count : data8->count),
+          numThreads(numThreads),
+          strings16(NULL), strings8(NULL),
+          lengths(new int32_t[count]),
+          permutation(new int32_t[count]) {
+    if (data16 != NULL) {
+        strings16 = new const UChar *[count];
+    } else {
+        strings8 = new const char *[count];
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        if (data16 != NULL) {
+            strings16[i] = data16->dataOf(i);
+            lengths[i] = data16->lengthOf(i);
+        } else {
+            strings8[i] = data8->dataOf(i);
+            lengths[i] = data8->lengthOf(i);
+        }
+    }
+}
+
+SortStrings::~SortStrings() {
+    delete[] strings16;
+    delete[] strings8;
+    delete[] lengths;
+    delete[] permutation;
+}
+
+void SortStrings::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    if (strings16 != NULL) {
+        ucol_sortStrings(ucoll, strings16, lengths, count, permutation, numThreads, status);
+    } else {
+        ucol_sortStringsUTF8(ucoll, strings8, lengths, count, permutation, numThreads, status);
+    }
+    ops = count;
+}
+
 namespace {
 
 int32_t U_CALLCONV
@@ -1093,6 +1351,8 @@ class CollPerf2Test : public UPerfTest
 
     UPerfFunction* TestGetSortKey();
     UPerfFunction* TestGetSortKeyNull();
+    UPerfFunction* TestGetSortKeys();
+    UPerfFunction* TestGetSortKeysUTF8();
 
     UPerfFunction* TestNextSortKeyPart_4All();
     UPerfFunction* TestNextSortKeyPart_4x2();
@@ -1108,6 +1368,10 @@ class CollPerf2Test : public UPerfTest
     UPerfFunction* TestNextSortKeyPartUTF8_32All();
     UPerfFunction* TestNextSortKeyPartUTF8_32x2();
 
+    UPerfFunction* TestNext();
+    UPerfFunction* TestNextCEs();
+    UPerfFunction* TestNextCEsUTF8();
+
     UPerfFunction* TestCppCompare();
     UPerfFunction* TestCppCompareNull();
     UPerfFunction* TestCppCompareSimilar();
@@ -1120,6 +1384,10 @@ class CollPerf2Test : public UPerfTest
     UPerfFunction* TestCppGetCollationKeyNull();
 
     UPerfFunction* TestUniStrSort();
+    UPerfFunction* TestUniStrStdSort();
+    UPerfFunction* TestSortStrings();
+    UPerfFunction* TestSortStringsUTF8();
+    UPerfFunction* TestSortStrings4Threads();
     UPerfFunction* TestStringPieceSortCpp();
     UPerfFunction* TestStringPieceSortC();
 
@@ -1402,6 +1670,8 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
 
     TESTCASE_AUTO(TestGetSortKey);
     TESTCASE_AUTO(TestGetSortKeyNull);
+    TESTCASE_AUTO(TestGetSortKeys);
+    TESTCASE_AUTO(TestGetSortKeysUTF8);
 
     TESTCASE_AUTO(TestNextSortKeyPart_4All);
     TESTCASE_AUTO(TestNextSortKeyPart_4x4);
@@ -1415,6 +1685,10 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestNextSortKeyPartUTF8_32All);
     TESTCASE_AUTO(TestNextSortKeyPartUTF8_32x2);
 
+    TESTCASE_AUTO(TestNext);
+    TESTCASE_AUTO(TestNextCEs);
+    TESTCASE_AUTO(TestNextCEsUTF8);
+
     TESTCASE_AUTO(TestCppCompare);
     TESTCASE_AUTO(TestCppCompareNull);
     TESTCASE_AUTO(TestCppCompareSimilar);
@@ -1427,6 +1701,10 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestCppGetCollationKeyNull);
 
     TESTCASE_AUTO(TestUniStrSort);
+    TESTCASE_AUTO(TestUniStrStdSort);
+    TESTCASE_AUTO(TestSortStrings);
+    TESTCASE_AUTO(TestSortStringsUTF8);
+    TESTCASE_AUTO(TestSortStrings4Threads);
     TESTCASE_AUTO(TestStringPieceSortCpp);
     TESTCASE_AUTO(TestStringPieceSortC);
 
@@ -1528,6 +1806,26 @@ UPerfFunction* CollPerf2Test::TestGetSortKeyNull()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestGetSortKeys()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *source = getData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, source, NULL);
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeysUTF8()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_char *source = getData8(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, NULL, source);
+}
+
 UPerfFunction* CollPerf2Test::TestNextSortKeyPart_4All()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -1638,6 +1936,39 @@ UPerfFunction* CollPerf2Test::TestNextSortKeyPartUTF8_32x2()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestNext()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    NextCEs *testCase = new NextCEs(coll, getData16(status), NULL, FALSE);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestNextCEs()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    NextCEs *testCase = new NextCEs(coll, getData16(status), NULL, TRUE);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestNextCEsUTF8()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    NextCEs *testCase = new NextCEs(coll, NULL, getData8(status), TRUE);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestCppCompare()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -1736,6 +2067,46 @@ UPerfFunction* CollPerf2Test::TestUniStrSort() {
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestUniStrStdSort() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new UniStrStdSort(*collObj, coll, getRandomData16(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestSortStrings() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new SortStrings(*collObj, coll, getRandomData16(status), NULL, 1);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestSortStringsUTF8() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new SortStrings(*collObj, coll, NULL, getRandomData8(status), 1);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestSortStrings4Threads() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new SortStrings(*collObj, coll, getRandomData16(status), NULL, 4);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestStringPieceSortCpp() {
     UErrorCode status = U_ZERO_ERROR;
     UPerfFunction *testCase = new StringPieceSortCpp(*collObj, coll, getRandomData8(status));
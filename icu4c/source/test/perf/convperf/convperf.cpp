@@ -116,6 +116,22 @@ UPerfFunction* ConverterPerformanceTest::runIndexedTest(int32_t index, UBool exe
         TESTCASE(52,TestWinANSI_ISO2022JP_ToUnicode);
         TESTCASE(53,TestWinANSI_ISO2022JP_FromUnicode);
 
+        TESTCASE(54,TestICU_ASCII_Windows1252_ToUnicode);
+        TESTCASE(55,TestICU_ASCII_Windows1252_FromUnicode);
+        TESTCASE(56,TestICU_ASCII_SJIS_ToUnicode);
+        TESTCASE(57,TestICU_ASCII_SJIS_FromUnicode);
+        TESTCASE(58,TestICU_ASCII_EUCKR_ToUnicode);
+        TESTCASE(59,TestICU_ASCII_EUCKR_FromUnicode);
+        TESTCASE(60,TestICU_ASCII_GBK_ToUnicode);
+        TESTCASE(61,TestICU_ASCII_GBK_FromUnicode);
+
+        TESTCASE(62,TestICU_Latin8_ToUTF8);
+        TESTCASE(63,TestICU_SJIS_ToUTF8);
+        TESTCASE(64,TestICU_GB2312_ToUTF8);
+        TESTCASE(65,TestICU_ASCII_Windows1252_ToUTF8);
+        TESTCASE(66,TestICU_ASCII_SJIS_ToUTF8);
+        TESTCASE(67,TestICU_ASCII_GBK_ToUTF8);
+
         default: 
             name = ""; 
             return NULL;
@@ -657,3 +673,133 @@ UPerfFunction*  ConverterPerformanceTest::TestWinANSI_ISO2022JP_ToUnicode(){
     }
     return pf;
 }
+
+//################
+// Mostly-ASCII text like CSV exports and mail headers,
+// which ASCII-compatible SBCS and MBCS converters copy in blocks.
+
+static const char asciiLine[]=
+    "2018-10-29,100042,\"Smith, John\",john.smith@example.com,+1 555 0100,42.50,USD,shipped\r\n";
+
+static const char *getASCIIEncSource(int32_t &length) {
+    static char source[100*(sizeof(asciiLine)-1)];
+    if(source[0]==0) {
+        for(int32_t i=0; i<100; ++i) {
+            uprv_memcpy(source+i*(sizeof(asciiLine)-1), asciiLine, sizeof(asciiLine)-1);
+        }
+    }
+    length=UPRV_LENGTHOF(source);
+    return source;
+}
+
+static const UChar *getASCIIUniSource(int32_t &length) {
+    static UChar source[100*(sizeof(asciiLine)-1)];
+    if(source[0]==0) {
+        const char *enc=getASCIIEncSource(length);
+        for(int32_t i=0; i<length; ++i) {
+            source[i]=(UChar)(uint8_t)enc[i];
+        }
+    }
+    length=UPRV_LENGTHOF(source);
+    return source;
+}
+
+static UPerfFunction *createASCIIToUnicode(const char *name) {
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t length;
+    const char *source = getASCIIEncSource(length);
+    UPerfFunction* pf = new ICUToUnicodePerfFunction(name, source, length, status);
+    if(U_FAILURE(status)){
+        delete pf;
+        return NULL;
+    }
+    return pf;
+}
+
+static UPerfFunction *createASCIIFromUnicode(const char *name) {
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t length;
+    const UChar *source = getASCIIUniSource(length);
+    UPerfFunction* pf = new ICUFromUnicodePerfFunction(name, source, length, status);
+    if(U_FAILURE(status)){
+        delete pf;
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_Windows1252_ToUnicode(){
+    return createASCIIToUnicode("windows-1252");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_Windows1252_FromUnicode(){
+    return createASCIIFromUnicode("windows-1252");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_SJIS_ToUnicode(){
+    return createASCIIToUnicode("sjis");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_SJIS_FromUnicode(){
+    return createASCIIFromUnicode("sjis");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_EUCKR_ToUnicode(){
+    return createASCIIToUnicode("euc-kr");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_EUCKR_FromUnicode(){
+    return createASCIIFromUnicode("euc-kr");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_GBK_ToUnicode(){
+    return createASCIIToUnicode("gbk");
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_GBK_FromUnicode(){
+    return createASCIIFromUnicode("gbk");
+}
+
+//################
+// Legacy charset to UTF-8 with ucnv_convertEx(),
+// which SBCS and DBCS converters do without the UTF-16 pivot.
+
+static UPerfFunction *createToUTF8(const char *name, const char *source, int32_t length) {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUToUTF8PerfFunction(name, source, length, status);
+    if(U_FAILURE(status)){
+        delete pf;
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Latin8_ToUTF8(){
+    return createToUTF8("iso-8859-8", (const char *)latin8_encSource, UPRV_LENGTHOF(latin8_encSource));
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_SJIS_ToUTF8(){
+    return createToUTF8("sjis", (const char *)sjis_encSource, UPRV_LENGTHOF(sjis_encSource));
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_GB2312_ToUTF8(){
+    return createToUTF8("gb2312", (const char *)gb2312_encSource, UPRV_LENGTHOF(gb2312_encSource));
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_Windows1252_ToUTF8(){
+    int32_t length;
+    const char *source = getASCIIEncSource(length);
+    return createToUTF8("windows-1252", source, length);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_SJIS_ToUTF8(){
+    int32_t length;
+    const char *source = getASCIIEncSource(length);
+    return createToUTF8("sjis", source, length);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_GBK_ToUTF8(){
+    int32_t length;
+    const char *source = getASCIIEncSource(length);
+    return createToUTF8("gbk", source, length);
+}
@@ -117,6 +117,54 @@ class ICUFromUnicodePerfFunction : public UPerfFunction{
     }
 };
 
+class ICUToUTF8PerfFunction : public UPerfFunction{
+private:
+    UConverter* conv;
+    UConverter* utf8;
+    const char* src;
+    int32_t srcLen;
+    char* target;
+    char* targetLimit;
+    UChar pivot[1024];
+
+public:
+    ICUToUTF8PerfFunction(const char* name,  const char* source, int32_t sourceLen, UErrorCode& status){
+        conv = ucnv_open(name,&status);
+        utf8 = ucnv_open("UTF-8",&status);
+        src = source;
+        srcLen = sourceLen;
+        target = NULL;
+        targetLimit = NULL;
+        if(U_FAILURE(status)){
+            return;
+        }
+        // enough for 3 UTF-8 bytes per source byte
+        target=(char*)malloc(srcLen*3);
+        targetLimit = target + srcLen*3;
+        if(target == NULL){
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+    }
+    virtual void call(UErrorCode* status){
+        const char* mySrc = src;
+        const char* sourceLimit = src + srcLen;
+        char* myTarget = target;
+        UChar *pivotSource = pivot, *pivotTarget = pivot;
+        ucnv_convertEx(utf8, conv, &myTarget, targetLimit, &mySrc, sourceLimit,
+                       pivot, &pivotSource, &pivotTarget, pivot + UPRV_LENGTHOF(pivot),
+                       TRUE, TRUE, status);
+    }
+    virtual long getOperationsPerIteration(void){
+        return srcLen;
+    }
+    ~ICUToUTF8PerfFunction(){
+        free(target);
+        ucnv_close(utf8);
+        ucnv_close(conv);
+    }
+};
+
 class ICUOpenAllConvertersFunction : public UPerfFunction{
 private:
     UBool cleanup;
@@ -566,6 +614,22 @@ class  ConverterPerformanceTest : public UPerfTest{
     UPerfFunction* TestWinIML2_ISO2022JP_ToUnicode();
     UPerfFunction* TestWinIML2_ISO2022JP_FromUnicode(); 
 
+    UPerfFunction* TestICU_ASCII_Windows1252_ToUnicode();
+    UPerfFunction* TestICU_ASCII_Windows1252_FromUnicode();
+    UPerfFunction* TestICU_ASCII_SJIS_ToUnicode();
+    UPerfFunction* TestICU_ASCII_SJIS_FromUnicode();
+    UPerfFunction* TestICU_ASCII_EUCKR_ToUnicode();
+    UPerfFunction* TestICU_ASCII_EUCKR_FromUnicode();
+    UPerfFunction* TestICU_ASCII_GBK_ToUnicode();
+    UPerfFunction* TestICU_ASCII_GBK_FromUnicode();
+
+    UPerfFunction* TestICU_Latin8_ToUTF8();
+    UPerfFunction* TestICU_SJIS_ToUTF8();
+    UPerfFunction* TestICU_GB2312_ToUTF8();
+    UPerfFunction* TestICU_ASCII_Windows1252_ToUTF8();
+    UPerfFunction* TestICU_ASCII_SJIS_ToUTF8();
+    UPerfFunction* TestICU_ASCII_GBK_ToUTF8();
+
 };
 
 #endif
@@ -24,6 +24,9 @@
  *  ./dicttrieperf --sourcedir <ICU build tree>/data/out/tmp --passes 3 --iterations 1000
  * or
  *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/thaidict.txt --passes 3 --iterations 250
+ * or, for the Chinese/Japanese dictionary which the CjkBreakEngine matches with
+ * ucharstriematchesbuffer:
+ *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/dictionaries/cjdict.txt --passes 3 --iterations 10 ucharstriematches ucharstriematchesbuffer
  */
 
 #include <stdio.h>
@@ -460,6 +463,57 @@ class UCharsTrieDictMatches : public UCharsTrieDictLookup {
     }
 };
 
+// Same as ucharsTrieMatches() but reading the UTF-16 text directly,
+// like UCharsDictionaryMatcher::matches(const UChar *...) used by the CjkBreakEngine.
+static int32_t
+ucharsTrieMatchesBuffer(UCharsTrie &trie,
+                        const UChar *s, int32_t length,
+                        int32_t *lengths, int &count, int limit ) {
+    count=0;
+    int32_t numChars=0;
+    for(int32_t i=0; i<length;) {
+        UChar32 c;
+        U16_NEXT(s, i, length, c);
+        UStringTrieResult result= numChars==0 ? trie.first(c) : trie.next(c);
+        ++numChars;
+        if(USTRINGTRIE_HAS_VALUE(result)) {
+            if(count<limit) {
+                lengths[count++]=numChars;
+            }
+            if(result==USTRINGTRIE_FINAL_VALUE) {
+                break;
+            }
+        } else if(result==USTRINGTRIE_NO_MATCH) {
+            break;
+        }
+    }
+    return numChars;
+}
+
+class UCharsTrieDictMatchesBuffer : public UCharsTrieDictLookup {
+public:
+    UCharsTrieDictMatchesBuffer(const DictionaryTriePerfTest &perfTest)
+            : UCharsTrieDictLookup(perfTest) {}
+
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        int32_t lengths[20];
+        const ULine *lines=perf.getCachedLines();
+        int32_t numLines=perf.getNumLines();
+        for(int32_t i=0; i<numLines; ++i) {
+            // Skip comment lines (start with a character below 'A').
+            if(lines[i].name[0]<0x41) {
+                continue;
+            }
+            int32_t count=0;
+            ucharsTrieMatchesBuffer(*trie, lines[i].name, lines[i].len,
+                                    lengths, count, UPRV_LENGTHOF(lengths));
+            if(count==0 || lengths[count-1]!=lines[i].len) {
+                fprintf(stderr, "word %ld (0-based) not found\n", (long)i);
+            }
+        }
+    }
+};
+
 class UCharsTrieDictContains : public UCharsTrieDictLookup {
 public:
     UCharsTrieDictContains(const DictionaryTriePerfTest &perfTest)
@@ -670,6 +724,12 @@ UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                 return new BytesTrieDictContains(*this);
             }
             break;
+        case 4:
+            name="ucharstriematchesbuffer";
+            if(exec) {
+                return new UCharsTrieDictMatchesBuffer(*this);
+            }
+            break;
         default:
             name="";
             break;
@@ -6,12 +6,16 @@
 
 #include <stdio.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "unicode/utypes.h"
 #include "unicode/bytestream.h"
 #include "unicode/normalizer2.h"
 #include "unicode/stringpiece.h"
+#include "unicode/uniset.h"
 #include "unicode/unistr.h"
+#include "unicode/unorm2.h"
 #include "unicode/utf8.h"
 #include "unicode/utimer.h"
 #include "cmemory.h"
@@ -31,6 +35,7 @@ class CommonChars {
     static UnicodeString getLowercaseLatin1(int32_t minLength) { return extend(lowercaseLatin1, minLength); }
     static UnicodeString getASCII(int32_t minLength) { return extend(ascii, minLength); }
     static UnicodeString getJapanese(int32_t minLength) { return extend(japanese, minLength); }
+    static UnicodeString getVietnamese(int32_t minLength) { return extend(vietnamese, minLength); }
 
     // Returns an array of UTF-8 offsets, one per code point.
     // Assumes all BMP characters.
@@ -66,6 +71,7 @@ class CommonChars {
     static const UChar *const ascii;
     static const UChar *const japanese;
     static const UChar *const arabic;
+    static const UChar *const vietnamese;
 };
 
 const UChar *const CommonChars::latin1 =
@@ -180,6 +186,12 @@ const UChar *const CommonChars::arabic =
       u"الأخرى بتخصيص رقم لكل واحد "
       u"منها. قبل اختراع يونيكود كان هناك ";
 
+const UChar *const CommonChars::vietnamese =
+      // Many letters with two diacritics each.
+      u"Tiếng Việt là ngôn ngữ của người Việt và là ngôn ngữ chính thức tại Việt Nam. "
+      u"Đây là tiếng mẹ đẻ của khoảng 85% dân cư Việt Nam cùng với hơn 4 triệu người Việt hải ngoại. "
+      u"Tiếng Việt còn là ngôn ngữ thứ hai của các dân tộc thiểu số tại Việt Nam.\n";
+
 // TODO: class BenchmarkPerCodePoint?
 
 class Operation {
@@ -206,7 +218,7 @@ double measure(Operation &op, int32_t pieceLength) {
         double seconds = op.call(iterations, pieceLength);
         if (seconds >= 1) {
             if (iterations > 1) {
-                return seconds / (iterations * pieceLength);
+                return seconds / ((double)iterations * pieceLength);
             } else {
                 // Run it once more, to avoid measuring only the warm-up.
                 return op.call(1, pieceLength) / (iterations * pieceLength);
@@ -294,12 +306,202 @@ double NormalizeUTF8::call(int32_t iterations, int32_t pieceLength) {
         int32_t start8 = offsets[start];
         int32_t limit8 = offsets[start + pieceLength];
         icu::StringPiece piece(s + start8, limit8 - start8);
+        dest.clear();
         norm2.normalizeUTF8(0, piece, sink, nullptr, errorCode);
         start = (start + pieceLength) % limit;
     }
     return utimer_getElapsedSeconds(&startTime);
 }
 
+class IsNormalizedUTF16 : public Operation {
+public:
+    IsNormalizedUTF16(const Normalizer2 &n2, const UnicodeString &text) :
+            norm2(n2), src(text), s(src.getBuffer()) {}
+    virtual ~IsNormalizedUTF16();
+    virtual double call(int32_t iterations, int32_t pieceLength);
+
+private:
+    const Normalizer2 &norm2;
+    UnicodeString src;
+    const UChar *s;
+};
+
+IsNormalizedUTF16::~IsNormalizedUTF16() {}
+
+// Assumes all BMP characters.
+double IsNormalizedUTF16::call(int32_t iterations, int32_t pieceLength) {
+    int32_t start = 0;
+    int32_t limit = src.length() - pieceLength;
+    UnicodeString piece;
+    UErrorCode errorCode = U_ZERO_ERROR;
+    utimer_getTime(&startTime);
+    for (int32_t i = 0; i < iterations; ++i) {
+        piece.setTo(FALSE, s + start, pieceLength);
+        norm2.isNormalized(piece, errorCode);
+        start = (start + pieceLength) % limit;
+    }
+    return utimer_getElapsedSeconds(&startTime);
+}
+
+// Search keys the long way: Full case folding, then NFKC_Casefold,
+// then removal of Default_Ignorable_Code_Point characters.
+// NFKC_Casefold alone yields the same result.
+class SearchKeyThreePass : public Operation {
+public:
+    SearchKeyThreePass(const Normalizer2 &n2, const UnicodeString &text, UErrorCode &errorCode) :
+            norm2(n2), ignorables(u"[:Default_Ignorable_Code_Point:]", errorCode),
+            normalizedSink(&normalized) {
+        ignorables.freeze();
+        offsets = CommonChars::toUTF8WithOffsets(text, src, numCodePoints);
+        s = src.data();
+    }
+    virtual ~SearchKeyThreePass();
+    virtual double call(int32_t iterations, int32_t pieceLength);
+
+private:
+    const Normalizer2 &norm2;
+    icu::UnicodeSet ignorables;
+    std::string src;
+    const char *s;
+    int32_t *offsets;
+    int32_t numCodePoints;
+    std::string folded8;
+    std::string normalized;
+    icu::StringByteSink<std::string> normalizedSink;
+    std::string dest;
+};
+
+SearchKeyThreePass::~SearchKeyThreePass() {
+    delete[] offsets;
+}
+
+double SearchKeyThreePass::call(int32_t iterations, int32_t pieceLength) {
+    int32_t start = 0;
+    int32_t limit = numCodePoints - pieceLength;
+    UErrorCode errorCode = U_ZERO_ERROR;
+    utimer_getTime(&startTime);
+    for (int32_t i = 0; i < iterations; ++i) {
+        int32_t start8 = offsets[start];
+        int32_t limit8 = offsets[start + pieceLength];
+        icu::StringPiece piece(s + start8, limit8 - start8);
+        UnicodeString folded = UnicodeString::fromUTF8(piece).foldCase();
+        folded8.clear();
+        folded.toUTF8String(folded8);
+        normalized.clear();
+        norm2.normalizeUTF8(0, folded8, normalizedSink, nullptr, errorCode);
+        dest.clear();
+        const char *p = normalized.data();
+        int32_t length = (int32_t)normalized.length();
+        for (int32_t j = 0; j < length;) {
+            int32_t spanLength = ignorables.spanUTF8(p + j, length - j, USET_SPAN_NOT_CONTAINED);
+            dest.append(p + j, spanLength);
+            j += spanLength;
+            j += ignorables.spanUTF8(p + j, length - j, USET_SPAN_CONTAINED);
+        }
+        start = (start + pieceLength) % limit;
+    }
+    return utimer_getElapsedSeconds(&startTime);
+}
+
+// Many short strings, as for normalizing names or tags,
+// to compare the per-call overhead with the batch API.
+class ShortStrings {
+public:
+    ShortStrings(const UnicodeString &text, int32_t count) :
+            src16(text), pieces(count), starts16(count), lengths16(count) {
+        offsets = CommonChars::toUTF8WithOffsets(text, src8, numCodePoints);
+        int32_t start = 0;
+        for (int32_t i = 0; i < count; ++i) {
+            // 3..16 code points each.
+            int32_t pieceLength = 3 + i % 14;
+            if (start + pieceLength > numCodePoints) {
+                start = 0;
+            }
+            int32_t start8 = offsets[start];
+            int32_t limit8 = offsets[start + pieceLength];
+            pieces[i].set(src8.data() + start8, limit8 - start8);
+            // Assumes all BMP characters.
+            starts16[i] = src16.getBuffer() + start;
+            lengths16[i] = pieceLength;
+            start += pieceLength;
+        }
+    }
+    ~ShortStrings() { delete[] offsets; }
+
+    int32_t size() const { return (int32_t)pieces.size(); }
+
+    UnicodeString src16;
+    std::string src8;
+    int32_t *offsets;
+    int32_t numCodePoints;
+    std::vector<icu::StringPiece> pieces;
+    std::vector<const UChar *> starts16;
+    std::vector<int32_t> lengths16;
+};
+
+const int32_t kBatchSize = 10000000;
+
+void printBatchResult(const char *name, const char *variant, int32_t count, double seconds) {
+    printf("%s/%s  %12f ns/string\n", name, variant, seconds * 1000000000 / count);
+}
+
+void benchmarkBatch(const char *name, const Normalizer2 &n2, const UnicodeString &text) {
+    ShortStrings strings(text, kBatchSize);
+    int32_t count = strings.size();
+    int32_t maxThreads = (int32_t)std::thread::hardware_concurrency();
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UTimer startTime;
+    std::string dest;
+    dest.reserve(strings.src8.length() * 2);
+    icu::StringByteSink<std::string> sink(&dest);
+
+    utimer_getTime(&startTime);
+    for (int32_t i = 0; i < count; ++i) {
+        n2.normalizeUTF8(0, strings.pieces[i], sink, nullptr, errorCode);
+    }
+    printBatchResult(name, "normalizeUTF8-loop", count, utimer_getElapsedSeconds(&startTime));
+
+    std::vector<int32_t> offsets(count + 1);
+    for (int32_t numThreads = 1;; numThreads = maxThreads) {
+        dest.clear();
+        utimer_getTime(&startTime);
+        n2.normalizeUTF8Batch(strings.pieces.data(), count, sink, offsets.data(),
+                              numThreads, errorCode);
+        double seconds = utimer_getElapsedSeconds(&startTime);
+        char variant[64];
+        sprintf(variant, "normalizeUTF8Batch-%dthreads", (int)numThreads);
+        printBatchResult(name, variant, count, seconds);
+        if (numThreads >= maxThreads) {
+            break;
+        }
+    }
+
+    const UNormalizer2 *un2 = reinterpret_cast<const UNormalizer2 *>(&n2);
+    std::vector<UNormalizationCheckResult> results(count);
+    utimer_getTime(&startTime);
+    for (int32_t i = 0; i < count; ++i) {
+        results[i] = unorm2_quickCheck(un2, strings.starts16[i], strings.lengths16[i], &errorCode);
+    }
+    printBatchResult(name, "unorm2_quickCheck-loop", count, utimer_getElapsedSeconds(&startTime));
+
+    for (int32_t numThreads = 1;; numThreads = maxThreads) {
+        utimer_getTime(&startTime);
+        unorm2_quickCheckBatch(un2, strings.starts16.data(), strings.lengths16.data(), count,
+                               results.data(), numThreads, &errorCode);
+        double seconds = utimer_getElapsedSeconds(&startTime);
+        char variant[64];
+        sprintf(variant, "unorm2_quickCheckBatch-%dthreads", (int)numThreads);
+        printBatchResult(name, variant, count, seconds);
+        if (numThreads >= maxThreads) {
+            break;
+        }
+    }
+    if (U_FAILURE(errorCode)) {
+        fprintf(stderr, "simplenormperf: %s batch failed - %s\n", name, u_errorName(errorCode));
+    }
+    puts("");
+}
+
 }  // namespace
 
 extern int main(int /*argc*/, const char * /*argv*/[]) {
@@ -309,10 +511,13 @@ extern int main(int /*argc*/, const char * /*argv*/[]) {
     UErrorCode errorCode = U_ZERO_ERROR;
     const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
     const Normalizer2 *nfkc_cf = Normalizer2::getNFKCCasefoldInstance(errorCode);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *fcd = Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode);
     if (U_FAILURE(errorCode)) {
         fprintf(stderr,
                 "simplenormperf: failed to get Normalizer2 instances - %s\n",
                 u_errorName(errorCode));
+        return 1;
     }
     {
         // Base line: Should remain in the fast loop without trie lookups.
@@ -324,6 +529,62 @@ extern int main(int /*argc*/, const char * /*argv*/[]) {
         NormalizeUTF8 op(*nfc, CommonChars::getJapanese(maxLength));
         benchmark("NFC/UTF-8/japanese", op);
     }
+    // Block-skip fast paths: Long runs below the minimum "no/maybe" code point
+    // should be skipped 16 or 32 bytes at a time.
+    {
+        NormalizeUTF16 op(*nfc, CommonChars::getASCII(maxLength));
+        benchmark("NFC/UTF-16/ascii", op);
+    }
+    {
+        NormalizeUTF16 op(*nfc, CommonChars::getMixed(maxLength));
+        benchmark("NFC/UTF-16/mixed", op);
+    }
+    {
+        NormalizeUTF8 op(*nfc, CommonChars::getASCII(maxLength));
+        benchmark("NFC/UTF-8/ascii", op);
+    }
+    {
+        NormalizeUTF8 op(*nfc, CommonChars::getLatin1(maxLength));
+        benchmark("NFC/UTF-8/latin1", op);
+    }
+    {
+        NormalizeUTF8 op(*nfc, CommonChars::getMixed(maxLength));
+        benchmark("NFC/UTF-8/mixed", op);
+    }
+    {
+        IsNormalizedUTF16 op(*nfc, CommonChars::getLatin1(maxLength));
+        benchmark("NFC/isNormalized/UTF-16/latin1", op);
+    }
+    {
+        NormalizeUTF16 op(*nfd, CommonChars::getASCII(maxLength));
+        benchmark("NFD/UTF-16/ascii", op);
+    }
+    {
+        NormalizeUTF16 op(*fcd, CommonChars::getLatin1(maxLength));
+        benchmark("FCD/UTF-16/latin1", op);
+    }
+    {
+        // Native UTF-8 decomposition, without conversion to UTF-16.
+        NormalizeUTF8 op(*nfd, CommonChars::getLatin1(maxLength));
+        benchmark("NFD/UTF-8/latin1", op);
+    }
+    {
+        NormalizeUTF8 op(*nfd, CommonChars::getMixed(maxLength));
+        benchmark("NFD/UTF-8/mixed", op);
+    }
+    {
+        NormalizeUTF8 op(*fcd, CommonChars::getMixed(maxLength));
+        benchmark("FCD/UTF-8/mixed", op);
+    }
+    {
+        // Recomposition of many combining marks: compositions lookups dominate.
+        NormalizeUTF16 op(*nfc, nfd->normalize(CommonChars::getVietnamese(maxLength), errorCode));
+        benchmark("NFC/UTF-16/vietnameseNFD", op);
+    }
+    {
+        NormalizeUTF8 op(*nfc, nfd->normalize(CommonChars::getVietnamese(maxLength), errorCode));
+        benchmark("NFC/UTF-8/vietnameseNFD", op);
+    }
     {
         NormalizeUTF16 op(*nfkc_cf, CommonChars::getMixed(maxLength));
         benchmark("NFKC_CF/UTF-16/mixed", op);
@@ -348,5 +609,30 @@ extern int main(int /*argc*/, const char * /*argv*/[]) {
         NormalizeUTF8 op(*nfkc_cf, CommonChars::getJapanese(maxLength));
         benchmark("NFKC_CF/UTF-8/japanese", op);
     }
+    // Search keys: NFKC_Casefold in one pass vs. case folding + NFKC_Casefold + ignorables removal.
+    // Mostly-ASCII text should use the ASCII lowercasing fast path.
+    {
+        NormalizeUTF8 op(*nfkc_cf, CommonChars::getASCII(maxLength));
+        benchmark("NFKC_CF/UTF-8/ascii", op);
+    }
+    {
+        NormalizeUTF8 op(*nfkc_cf, CommonChars::getLatin1(maxLength));
+        benchmark("NFKC_CF/UTF-8/latin1", op);
+    }
+    {
+        SearchKeyThreePass op(*nfkc_cf, CommonChars::getASCII(maxLength), errorCode);
+        benchmark("SearchKey3Pass/UTF-8/ascii", op);
+    }
+    {
+        SearchKeyThreePass op(*nfkc_cf, CommonChars::getLatin1(maxLength), errorCode);
+        benchmark("SearchKey3Pass/UTF-8/latin1", op);
+    }
+    {
+        SearchKeyThreePass op(*nfkc_cf, CommonChars::getMixed(maxLength), errorCode);
+        benchmark("SearchKey3Pass/UTF-8/mixed", op);
+    }
+    // Ten million short strings, one call each vs. one batch call.
+    benchmarkBatch("NFC/batch/mixed", *nfc, CommonChars::getMixed(maxLength));
+    benchmarkBatch("NFKC_CF/batch/mixed", *nfkc_cf, CommonChars::getMixed(maxLength));
     return 0;
 }
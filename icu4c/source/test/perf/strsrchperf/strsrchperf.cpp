@@ -14,12 +14,16 @@
  * ICU4C 
  */
 
+#include "unicode/ustring.h"
 #include "strsrchperf.h"
 
 StringSearchPerformanceTest::StringSearchPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status)
 :UPerfTest(argc,argv,status){
     int32_t start, end;
     srch = NULL;
+    srch8 = NULL;
+    src8 = NULL;
+    src8Len = 0;
     pttrn = NULL;
     if(status== U_ILLEGAL_ARGUMENT_ERROR || line_mode){
        fprintf(stderr,gUsageString, "strsrchperf");
@@ -71,7 +75,20 @@ StringSearchPerformanceTest::StringSearchPerformanceTest(int32_t argc, const cha
         fprintf(stderr, "FAILED to create UPerfTest object. Error: %s\n", u_errorName(status));
         return;
     }
-    
+
+    /* The same text in UTF-8, for the UTF-8 tests. */
+    u_strToUTF8(NULL, 0, &src8Len, src, srcLen, &status);
+    if (status == U_BUFFER_OVERFLOW_ERROR) {
+        status = U_ZERO_ERROR;
+    }
+    src8 = (char*)malloc(src8Len + 1);
+    u_strToUTF8(src8, src8Len + 1, &src8Len, src, srcLen, &status);
+    srch8 = usearch_open(pttrn, pttrnLen, src, srcLen, locale, NULL, &status);
+
+    if(U_FAILURE(status)){
+        fprintf(stderr, "FAILED to create UPerfTest object. Error: %s\n", u_errorName(status));
+        return;
+    }
 }
 
 StringSearchPerformanceTest::~StringSearchPerformanceTest() {
@@ -81,12 +98,19 @@ StringSearchPerformanceTest::~StringSearchPerformanceTest() {
     if (srch != NULL) {
         usearch_close(srch);
     }
+    if (srch8 != NULL) {
+        usearch_close(srch8);
+    }
+    free(src8);
 }
 
 UPerfFunction* StringSearchPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char *&name, char *par) {
     switch (index) {
         TESTCASE(0,Test_ICU_Forward_Search);
         TESTCASE(1,Test_ICU_Backward_Search);
+        TESTCASE(2,Test_ICU_Forward_Skip_Search);
+        TESTCASE(3,Test_ICU_Forward_Search_UTF8);
+        TESTCASE(4,Test_ICU_Forward_Skip_Search_UTF8);
 
         default: 
             name = ""; 
@@ -105,6 +129,21 @@ UPerfFunction* StringSearchPerformanceTest::Test_ICU_Backward_Search(){
     return func;
 }
 
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Forward_Skip_Search(){
+    StringSearchPerfFunction* func = new StringSearchPerfFunction(ICUForwardSkipSearch, srch, src, srcLen, pttrn, pttrnLen);
+    return func;
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Forward_Search_UTF8(){
+    StringSearchUTF8PerfFunction* func = new StringSearchUTF8PerfFunction(ICUForwardSearchUTF8, srch8, src8, src8Len, srcLen);
+    return func;
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Forward_Skip_Search_UTF8(){
+    StringSearchUTF8PerfFunction* func = new StringSearchUTF8PerfFunction(ICUForwardSkipSearchUTF8, srch8, src8, src8Len, srcLen);
+    return func;
+}
+
 int main (int argc, const char* argv[]) {
     UErrorCode status = U_ZERO_ERROR;
     StringSearchPerformanceTest test(argc, argv, status);
@@ -17,6 +17,7 @@
 #include <stdio.h>
 
 typedef void (*StrSrchFn)(UStringSearch* srch, const UChar* src,int32_t srcLen, const UChar* pttrn, int32_t pttrnLen, UErrorCode* status);
+typedef void (*StrSrchUTF8Fn)(UStringSearch* srch, const char* src, int32_t srcLen, UErrorCode* status);
 
 class StringSearchPerfFunction : public UPerfFunction {
 private:
@@ -46,13 +47,43 @@ class StringSearchPerfFunction : public UPerfFunction {
     }
 };
 
+class StringSearchUTF8PerfFunction : public UPerfFunction {
+private:
+    StrSrchUTF8Fn fn;
+    const char* src;
+    int32_t srcLen;
+    int32_t ops;
+    UStringSearch* srch;
+
+public:
+    virtual void call(UErrorCode* status) {
+        (*fn)(srch, src, srcLen, status);
+    }
+
+    // Count UTF-16 code units like the UTF-16 tests, so that the results are comparable.
+    virtual long getOperationsPerIteration() {
+        return (long) ops;
+    }
+
+    StringSearchUTF8PerfFunction(StrSrchUTF8Fn func, UStringSearch* search, const char* source, int32_t sourceLen, int32_t utf16Len) {
+        fn = func;
+        src = source;
+        srcLen = sourceLen;
+        ops = utf16Len;
+        srch = search;
+    }
+};
+
 class StringSearchPerformanceTest : public UPerfTest {
 private:
     const UChar* src;
     int32_t srcLen;
+    char* src8;
+    int32_t src8Len;
     UChar* pttrn;
     int32_t pttrnLen;
     UStringSearch* srch;
+    UStringSearch* srch8;
     
 public:
     StringSearchPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status);
@@ -60,6 +91,9 @@ class StringSearchPerformanceTest : public UPerfTest {
     virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = NULL);
     UPerfFunction* Test_ICU_Forward_Search();
     UPerfFunction* Test_ICU_Backward_Search();
+    UPerfFunction* Test_ICU_Forward_Skip_Search();
+    UPerfFunction* Test_ICU_Forward_Search_UTF8();
+    UPerfFunction* Test_ICU_Forward_Skip_Search_UTF8();
 };
 
 
@@ -72,6 +106,28 @@ void ICUForwardSearch(UStringSearch *srch, const UChar* source, int32_t sourceLe
     }
 }
 
+void ICUForwardSkipSearch(UStringSearch *srch, const UChar* source, int32_t sourceLen, const UChar* pattern, int32_t patternLen, UErrorCode* status) {
+    usearch_setAttribute(srch, USEARCH_SKIP_SEARCH, USEARCH_ON, status);
+    ICUForwardSearch(srch, source, sourceLen, pattern, patternLen, status);
+    usearch_setAttribute(srch, USEARCH_SKIP_SEARCH, USEARCH_OFF, status);
+}
+
+void ICUForwardSearchUTF8(UStringSearch *srch, const char* source, int32_t sourceLen, UErrorCode* status) {
+    int32_t match;
+
+    usearch_setTextUTF8(srch, source, sourceLen, status);
+    match = usearch_first(srch, status);
+    while (match != USEARCH_DONE) {
+        match = usearch_next(srch, status);
+    }
+}
+
+void ICUForwardSkipSearchUTF8(UStringSearch *srch, const char* source, int32_t sourceLen, UErrorCode* status) {
+    usearch_setAttribute(srch, USEARCH_SKIP_SEARCH, USEARCH_ON, status);
+    ICUForwardSearchUTF8(srch, source, sourceLen, status);
+    usearch_setAttribute(srch, USEARCH_SKIP_SEARCH, USEARCH_OFF, status);
+}
+
 void ICUBackwardSearch(UStringSearch *srch, const UChar* source, int32_t sourceLen, const UChar* pattern, int32_t patternLen, UErrorCode* status) {
     int32_t match;
     
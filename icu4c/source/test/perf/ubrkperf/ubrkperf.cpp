@@ -160,6 +160,26 @@ UPerfFunction* BreakIteratorPerformanceTest::TestICUIsBound()
   return new ICUIsBound(locale, m_mode_, m_file_, m_fileLen_);
 }
 
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetBoundaries()
+{
+  return new ICUGetBoundaries(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetAllBoundaries()
+{
+  return new ICUGetAllBoundaries(locale, m_mode_, m_file_, m_fileLen_, 1);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetAllBoundaries4Threads()
+{
+  return new ICUGetAllBoundaries(locale, m_mode_, m_file_, m_fileLen_, 4);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUForwardUTF8()
+{
+  return new ICUForwardUTF8(locale, m_mode_, m_file_, m_fileLen_);
+}
+
 UPerfFunction* BreakIteratorPerformanceTest::TestDarwinForward()
 {
   return NULL;
@@ -179,6 +199,10 @@ UPerfFunction* BreakIteratorPerformanceTest::runIndexedTest(int32_t index, UBool
 		TESTCASE(1, TestICUIsBound);
 		TESTCASE(2, TestDarwinForward);
 		TESTCASE(3, TestDarwinIsBound);
+		TESTCASE(4, TestICUGetBoundaries);
+		TESTCASE(5, TestICUGetAllBoundaries);
+		TESTCASE(6, TestICUGetAllBoundaries4Threads);
+		TESTCASE(7, TestICUForwardUTF8);
         default: 
             name = ""; 
             return NULL;
@@ -190,17 +214,15 @@ UOption options[]={
                       UOPTION_DEF( "mode",        'm', UOPT_REQUIRES_ARG)
                   };
 
+static const char modeUsage[] =
+    "\t-m or --mode        Required mode for breakiterator: char, word, line or sentence\n";
 
 BreakIteratorPerformanceTest::BreakIteratorPerformanceTest(int32_t argc, const char* argv[], UErrorCode& status)
-: UPerfTest(argc,argv,status),
+: UPerfTest(argc,argv,options,UPRV_LENGTHOF(options),modeUsage,status),
 m_mode_(NULL),
 m_file_(NULL),
 m_fileLen_(0)
 {
-
-    _remainingArgc = u_parseArgs(_remainingArgc, (char**)argv, UPRV_LENGTHOF(options), options);
-
-
     if(options[0].doesOccur) {
       m_mode_ = options[0].value;
       switch(options[0].value[0]) {
@@ -221,7 +243,7 @@ m_fileLen_(0)
 
     if(status== U_ILLEGAL_ARGUMENT_ERROR){
        fprintf(stderr, gUsageString, "ubrkperf");
-       fprintf(stderr, "\t-m or --mode        Required mode for breakiterator: char, word, line or sentence\n");
+       fprintf(stderr, "%s", modeUsage);
 
        return;
     }
@@ -15,6 +15,9 @@
 #include "unicode/uperf.h"
 
 #include <unicode/brkiter.h>
+#include <unicode/rbbi.h>
+#include <unicode/ustring.h>
+#include <unicode/utext.h>
 
 class ICUBreakFunction : public UPerfFunction {
 protected:
@@ -107,6 +110,124 @@ class ICUForward : public ICUBreakFunction {
   }
 };
 
+class ICUGetBoundaries : public ICUBreakFunction {
+private:
+  enum { kCapacity = 1024 };
+  RuleBasedBreakIterator *m_rbbi_;
+  UnicodeString m_text_;  // The iterator keeps a pointer to it.
+  int32_t m_boundaries_[kCapacity];
+  int32_t m_ruleStatus_[kCapacity];
+
+  int32_t countBoundaries() {
+    int32_t count = 0;
+    int32_t start = 0;
+    int32_t length;
+    do {
+      length = m_rbbi_->getBoundaries(start, m_boundaries_, m_ruleStatus_, kCapacity, m_status_);
+      count += length;
+      if (length > 0) {
+        start = m_boundaries_[length - 1];
+      }
+    } while (length == kCapacity && U_SUCCESS(m_status_));
+    return count;
+  }
+public:
+  ICUGetBoundaries(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_rbbi_(dynamic_cast<RuleBasedBreakIterator *>(m_brkIt_)),
+      m_text_(FALSE, m_file_, m_fileLen_)
+  {
+    if (m_rbbi_ == NULL) {
+      if (U_SUCCESS(m_status_)) {
+        m_status_ = U_UNSUPPORTED_ERROR;
+      }
+      return;
+    }
+    m_rbbi_->setText(m_text_);
+    m_noBreaks_ = countBoundaries();
+  }
+  virtual void call(UErrorCode *status)
+  {
+    m_noBreaks_ = countBoundaries();
+  }
+};
+
+class ICUGetAllBoundaries : public ICUBreakFunction {
+private:
+  RuleBasedBreakIterator *m_rbbi_;
+  UnicodeString m_text_;  // The iterator keeps a pointer to it.
+  int32_t m_numThreads_;
+  int32_t *m_boundaries_;
+public:
+  ICUGetAllBoundaries(const char *locale, const char *mode, const UChar *file, int32_t file_len,
+                      int32_t numThreads) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_rbbi_(dynamic_cast<RuleBasedBreakIterator *>(m_brkIt_)),
+      m_text_(FALSE, m_file_, m_fileLen_),
+      m_numThreads_(numThreads),
+      m_boundaries_(NULL)
+  {
+    if (m_rbbi_ == NULL) {
+      if (U_SUCCESS(m_status_)) {
+        m_status_ = U_UNSUPPORTED_ERROR;
+      }
+      return;
+    }
+    m_rbbi_->setText(m_text_);
+    UErrorCode status = U_ZERO_ERROR;
+    m_noBreaks_ = m_rbbi_->getAllBoundaries(NULL, NULL, 0, m_numThreads_, status);
+    m_boundaries_ = new int32_t[m_noBreaks_];
+  }
+  ~ICUGetAllBoundaries() { delete[] m_boundaries_; }
+  virtual void call(UErrorCode *status)
+  {
+    m_noBreaks_ = m_rbbi_->getAllBoundaries(m_boundaries_, NULL, m_noBreaks_, m_numThreads_, *status);
+  }
+};
+
+class ICUForwardUTF8 : public ICUBreakFunction {
+private:
+  char *m_utf8_;
+  UText *m_text_;
+public:
+  ICUForwardUTF8(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_utf8_(NULL),
+      m_text_(NULL)
+  {
+    if (U_FAILURE(m_status_)) {
+      return;
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t utf8Length = 0;
+    u_strToUTF8(NULL, 0, &utf8Length, m_file_, m_fileLen_, &status);
+    m_status_ = U_ZERO_ERROR;
+    m_utf8_ = new char[utf8Length];
+    u_strToUTF8(m_utf8_, utf8Length, NULL, m_file_, m_fileLen_, &m_status_);
+    m_text_ = utext_openUTF8(NULL, m_utf8_, utf8Length, &m_status_);
+    m_brkIt_->setText(m_text_, m_status_);
+    m_noBreaks_ = 0;
+    m_brkIt_->first();
+    while(m_brkIt_->next() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+  ~ICUForwardUTF8() {
+    delete m_brkIt_;  // Before the text that it refers to.
+    m_brkIt_ = NULL;
+    utext_close(m_text_);
+    delete[] m_utf8_;
+  }
+  virtual void call(UErrorCode *status)
+  {
+    m_noBreaks_ = 0;
+    m_brkIt_->first();
+    while(m_brkIt_->next() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+};
+
 class DarwinBreakFunction : public UPerfFunction {
 public:
   virtual void call(UErrorCode *status) {};
@@ -127,6 +248,10 @@ class BreakIteratorPerformanceTest : public UPerfTest {
 
   UPerfFunction* TestICUForward();
   UPerfFunction* TestICUIsBound();
+  UPerfFunction* TestICUGetBoundaries();
+  UPerfFunction* TestICUGetAllBoundaries();
+  UPerfFunction* TestICUGetAllBoundaries4Threads();
+  UPerfFunction* TestICUForwardUTF8();
 
   UPerfFunction* TestDarwinForward();
   UPerfFunction* TestDarwinIsBound();
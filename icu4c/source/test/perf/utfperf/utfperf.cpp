@@ -21,9 +21,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
 #include "unicode/uperf.h"
+#include "unicode/ustring.h"
 #include "cmemory.h" // for UPRV_LENGTHOF
 #include "uoptions.h"
+#include "utfsimd.h"
 
 /* definitions and text buffers */
 
@@ -50,13 +55,17 @@ enum {
     CHARSET,
     CHUNK_LENGTH,
     PIVOT_LENGTH,
+    TEXT,
+    THREADS,
     UTFPERF_OPTIONS_COUNT
 };
 
 static UOption options[UTFPERF_OPTIONS_COUNT]={
     UOPTION_DEF("charset",  '\x01', UOPT_REQUIRES_ARG),
     UOPTION_DEF("chunk",    '\x01', UOPT_REQUIRES_ARG),
-    UOPTION_DEF("pivot",    '\x01', UOPT_REQUIRES_ARG)
+    UOPTION_DEF("pivot",    '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("text",     '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("threads",  '\x01', UOPT_REQUIRES_ARG)
 };
 
 static const char *const utfperf_usage =
@@ -64,7 +73,26 @@ static const char *const utfperf_usage =
     "\t            Default: UTF-8\n"
     "\t--chunk     Length (in bytes) of charset output chunks. [4096]\n"
     "\t--pivot     Length (in UChars) of the UTF-16 pivot buffer, if applicable.\n"
-    "\t            [1024]\n";
+    "\t            [1024]\n"
+    "\t--text      Generated input text instead of a file: ascii, latin, cjk or emoji.\n"
+    "\t--threads   Number of threads for OpenClose. [1]\n";
+
+// Sample lines for --text, repeated to fill the input buffer.
+static const struct {
+    const char *name;
+    const char *line;
+} sampleTexts[] = {
+    { "ascii", "The quick brown fox jumps over the lazy dog; 0123456789.\\n" },
+    { "latin", "Voix ambigu\\u00EB d'un c\\u0153ur qui, au z\\u00E9phyr, pr\\u00E9f\\u00E8re "
+               "les jattes de kiwis. Gr\\u00F6\\u00DFe \\u00DCbung \\u00E0 la fa\\u00E7on.\\n" },
+    { "cjk", "\\u6211\\u80FD\\u541E\\u4E0B\\u73BB\\u7483\\u800C\\u4E0D\\u4F24\\u8EAB\\u4F53\\u3002"
+             "\\u79C1\\u306F\\u30AC\\u30E9\\u30B9\\u3092\\u98DF\\u3079\\u3089\\u308C\\u307E\\u3059\\u3002"
+             "\\uC720\\uB9AC\\uB97C \\uBA39\\uC744 \\uC218 \\uC788\\uC5B4\\uC694 2018\\u5E74\\n" },
+    { "emoji", "Great job \\U0001F44D\\U0001F389 see you soon \\U0001F600\\U0001F600 "
+               "\\u2764\\uFE0F \\U0001F680\\U0001F469\\u200D\\U0001F4BB ok\\n" }
+};
+
+#define TEXT_CAPACITY (200*1000)
 
 // Test object.
 class  UtfPerformanceTest : public UPerfTest{
@@ -86,8 +114,21 @@ class  UtfPerformanceTest : public UPerfTest{
                 status = U_ILLEGAL_ARGUMENT_ERROR;
             }
 
+            numThreads = atoi(options[THREADS].value);
+            if (numThreads < 1 || MAX_THREADS < numThreads) {
+                fprintf(stderr, "error: number of threads must be 1..%ld\n", (long)MAX_THREADS);
+                status = U_ILLEGAL_ARGUMENT_ERROR;
+            }
+
             int32_t inputLength;
-            UPerfTest::getBuffer(inputLength, status);
+            if (options[TEXT].doesOccur) {
+                generateText(options[TEXT].value, status);
+            } else {
+                UPerfTest::getBuffer(inputLength, status);
+            }
+            if (U_FAILURE(status)) {
+                return;
+            }
             countInputCodePoints = u_countChar32(buffer, bufferLen);
             u_strToUTF8(utf8, (int32_t)sizeof(utf8), &utf8Length, buffer, bufferLen, &status);
         }
@@ -98,8 +139,35 @@ class  UtfPerformanceTest : public UPerfTest{
     const UChar *getBuffer() const { return buffer; }
     int32_t getBufferLen() const { return bufferLen; }
 
+    static const int32_t MAX_THREADS = 256;
+
     const char *charset;
-    int32_t chunkLength, pivotLength;
+    int32_t chunkLength, pivotLength, numThreads;
+
+private:
+    void generateText(const char *name, UErrorCode &status) {
+        const char *line = NULL;
+        for (int32_t i = 0; i < UPRV_LENGTHOF(sampleTexts); ++i) {
+            if (strcmp(name, sampleTexts[i].name) == 0) {
+                line = sampleTexts[i].line;
+            }
+        }
+        if (line == NULL) {
+            fprintf(stderr, "error: unknown --text %s\n", name);
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        UChar unescaped[200];
+        int32_t lineLength = u_unescape(line, unescaped, UPRV_LENGTHOF(unescaped));
+        buffer = (UChar *)uprv_malloc(U_SIZEOF_UCHAR * TEXT_CAPACITY);
+        if (buffer == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        for (bufferLen = 0; (bufferLen + lineLength) <= TEXT_CAPACITY; bufferLen += lineLength) {
+            u_memcpy(buffer + bufferLen, unescaped, lineLength);
+        }
+    }
 };
 
 U_CDECL_BEGIN
@@ -328,11 +396,146 @@ class FromUTF8 : public Command {
     int32_t input8Length;
 };
 
+// Test u_strFromUTF8(), u_strToUTF8() and the UTF-8 converter on whole strings,
+// with the vector code or with only the code point loops.
+class UTF8Transcode : public UPerfFunction {
+public:
+    enum Function { STR_FROM_UTF8, STR_TO_UTF8, TO_UNICODE, FROM_UNICODE };
+
+    static UPerfFunction* get(const UtfPerformanceTest &testcase, Function function, UBool vector) {
+        UTF8Transcode * t = new UTF8Transcode(testcase, function, vector);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual ~UTF8Transcode() {
+        ucnv_close(cnv);
+    }
+    virtual long getOperationsPerIteration(){
+        return countInputCodePoints;
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        icu::UTFSIMD::setLevel(vector ? icu::UTFSIMD::SHUFFLE : icu::UTFSIMD::SCALAR);
+        switch (function) {
+        case STR_FROM_UTF8:
+            u_strFromUTF8(output, OUTPUT_CAPACITY, &outputLength, utf8, utf8Length, pErrorCode);
+            break;
+        case STR_TO_UTF8:
+            u_strToUTF8(intermediate, OUTPUT_CAPACITY, &encodedLength, input, inputLength, pErrorCode);
+            break;
+        case TO_UNICODE: {
+            const char *pIn = utf8;
+            UChar *pOut = output;
+            ucnv_resetToUnicode(cnv);
+            ucnv_toUnicode(cnv, &pOut, output + OUTPUT_CAPACITY, &pIn, utf8 + utf8Length,
+                           NULL, TRUE, pErrorCode);
+            outputLength = (int32_t)(pOut - output);
+            break;
+        }
+        case FROM_UNICODE: {
+            const UChar *pIn = input;
+            char *pOut = intermediate;
+            ucnv_resetFromUnicode(cnv);
+            ucnv_fromUnicode(cnv, &pOut, intermediate + OUTPUT_CAPACITY, &pIn, input + inputLength,
+                             NULL, TRUE, pErrorCode);
+            encodedLength = (int32_t)(pOut - intermediate);
+            break;
+        }
+        }
+    }
+private:
+    UTF8Transcode(const UtfPerformanceTest &testcase, Function function, UBool vector)
+            : input(testcase.getBuffer()), inputLength(testcase.getBufferLen()),
+              function(function), vector(vector), errorCode(U_ZERO_ERROR) {
+        cnv = ucnv_open("UTF-8", &errorCode);
+    }
+
+    const UChar *input;
+    int32_t inputLength;
+    Function function;
+    UBool vector;
+    UErrorCode errorCode;
+    UConverter *cnv;
+};
+
+// Test ucnv_open()/ucnv_close() of cached table converters on --threads threads at once,
+// to see how the converter cache lookup scales with the number of threads.
+// Each operation is one open+close; the time per operation should stay about the same
+// up to the number of cores.
+class OpenClose : public UPerfFunction {
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        OpenClose * t = new OpenClose(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return (long)numThreads * OPENS_PER_THREAD;
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        std::vector<std::thread> threads;
+        std::vector<UErrorCode> errorCodes(numThreads, U_ZERO_ERROR);
+        for (int32_t t = 1; t < numThreads; ++t) {
+            threads.emplace_back(&OpenClose::openClose, t, &errorCodes[t]);
+        }
+        openClose(0, &errorCodes[0]);
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        for (UErrorCode errorCode : errorCodes) {
+            if (U_FAILURE(errorCode)) {
+                *pErrorCode = errorCode;
+            }
+        }
+    }
+private:
+    static const int32_t OPENS_PER_THREAD = 10000;
+    static const char *const names[];
+
+    OpenClose(const UtfPerformanceTest &testcase)
+            : numThreads(testcase.numThreads), errorCode(U_ZERO_ERROR) {
+        // Load the converter data once so that call() only finds it in the cache.
+        for (int32_t i = 0; i < NAMES_LENGTH && U_SUCCESS(errorCode); ++i) {
+            ucnv_close(ucnv_open(names[i], &errorCode));
+        }
+    }
+
+    static void openClose(int32_t threadIndex, UErrorCode *pErrorCode) {
+        for (int32_t i = 0; i < OPENS_PER_THREAD && U_SUCCESS(*pErrorCode); ++i) {
+            ucnv_close(ucnv_open(names[(threadIndex + i) % NAMES_LENGTH], pErrorCode));
+        }
+    }
+
+    static const int32_t NAMES_LENGTH = 8;
+    int32_t numThreads;
+    UErrorCode errorCode;
+};
+
+const char *const OpenClose::names[OpenClose::NAMES_LENGTH] = {
+    "windows-1252", "iso-8859-8", "ibm-37", "Shift_JIS", "GBK", "Big5", "EUC-KR", "GB18030"
+};
+
 UPerfFunction* UtfPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* par) {
     switch (index) {
         case 0: name = "Roundtrip";     if (exec) return Roundtrip::get(*this); break;
         case 1: name = "FromUnicode";   if (exec) return FromUnicode::get(*this); break;
         case 2: name = "FromUTF8";      if (exec) return FromUTF8::get(*this); break;
+        case 3: name = "StrFromUTF8";   if (exec) return UTF8Transcode::get(*this, UTF8Transcode::STR_FROM_UTF8, TRUE); break;
+        case 4: name = "StrFromUTF8Scalar"; if (exec) return UTF8Transcode::get(*this, UTF8Transcode::STR_FROM_UTF8, FALSE); break;
+        case 5: name = "StrToUTF8";     if (exec) return UTF8Transcode::get(*this, UTF8Transcode::STR_TO_UTF8, TRUE); break;
+        case 6: name = "StrToUTF8Scalar"; if (exec) return UTF8Transcode::get(*this, UTF8Transcode::STR_TO_UTF8, FALSE); break;
+        case 7: name = "ToUnicodeUTF8"; if (exec) return UTF8Transcode::get(*this, UTF8Transcode::TO_UNICODE, TRUE); break;
+        case 8: name = "ToUnicodeUTF8Scalar"; if (exec) return UTF8Transcode::get(*this, UTF8Transcode::TO_UNICODE, FALSE); break;
+        case 9: name = "FromUnicodeUTF8"; if (exec) return UTF8Transcode::get(*this, UTF8Transcode::FROM_UNICODE, TRUE); break;
+        case 10: name = "FromUnicodeUTF8Scalar"; if (exec) return UTF8Transcode::get(*this, UTF8Transcode::FROM_UNICODE, FALSE); break;
+        case 11: name = "OpenClose";    if (exec) return OpenClose::get(*this); break;
         default: name = ""; break;
     }
     return NULL;
@@ -344,6 +547,7 @@ int main(int argc, const char *argv[])
     options[CHARSET].value = "UTF-8";
     options[CHUNK_LENGTH].value = "4096";
     options[PIVOT_LENGTH].value = "1024";
+    options[THREADS].value = "1";
 
     UErrorCode status = U_ZERO_ERROR;
     UtfPerformanceTest test(argc, argv, status);
@@ -221,7 +221,8 @@ def generate_other(config, glob, common_vars):
             input_files = [InFile("testnorm.txt")],
             output_files = [OutFile("testnorm.nrm")],
             tool = IcuTool("gennorm2"),
-            args = "-s {IN_DIR} {INPUT_FILES[0]} -o {OUT_DIR}/{OUTPUT_FILES[0]}",
+            # Without the compositions hash table, to test the compositions list fallback.
+            args = "-s {IN_DIR} {INPUT_FILES[0]} -o {OUT_DIR}/{OUTPUT_FILES[0]} --no-comp-hash",
             format_with = {}
         ),
         SingleExecutionRequest(
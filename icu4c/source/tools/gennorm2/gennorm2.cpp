@@ -62,7 +62,8 @@ enum {
     UNICODE_VERSION,
     WRITE_C_SOURCE,
     WRITE_COMBINED_DATA,
-    OPT_FAST
+    OPT_FAST,
+    OPT_NO_COMP_HASH
 };
 
 static UOption options[]={
@@ -75,7 +76,8 @@ static UOption options[]={
     UOPTION_DEF("unicode", 'u', UOPT_REQUIRES_ARG),
     UOPTION_DEF("csource", '\1', UOPT_NO_ARG),
     UOPTION_DEF("combined", '\1', UOPT_NO_ARG),
-    UOPTION_DEF("fast", '\1', UOPT_NO_ARG)
+    UOPTION_DEF("fast", '\1', UOPT_NO_ARG),
+    UOPTION_DEF("no-comp-hash", '\1', UOPT_NO_ARG)
 };
 
 extern "C" int
@@ -131,7 +133,9 @@ main(int argc, char* argv[]) {
             "\t                    which might increase its size  (Writes fully decomposed\n"
             "\t                    regular mappings instead of delta mappings.\n"
             "\t                    You should measure the runtime speed to make sure that\n"
-            "\t                    this is a good trade-off.)\n");
+            "\t                    this is a good trade-off.)\n"
+            "\t      --no-comp-hash  omit the compositions hash table which speeds up\n"
+            "\t                    composition but makes the data larger\n");
         return argc<0 ? U_ILLEGAL_ARGUMENT_ERROR : U_ZERO_ERROR;
     }
 
@@ -166,6 +170,9 @@ main(int argc, char* argv[]) {
     if(options[OPT_FAST].doesOccur) {
         builder->setOptimization(Normalizer2DataBuilder::OPTIMIZE_FAST);
     }
+    if(options[OPT_NO_COMP_HASH].doesOccur) {
+        builder->setWriteCompositionsHash(FALSE);
+    }
 
     // prepare the filename beginning with the source dir
     CharString filename(options[SOURCEDIR].value, errorCode);
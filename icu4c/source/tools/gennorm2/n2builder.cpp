@@ -95,7 +95,9 @@ const HangulIterator::Range HangulIterator::ranges[4]={
 Normalizer2DataBuilder::Normalizer2DataBuilder(UErrorCode &errorCode) :
         norms(errorCode),
         phase(0), overrideHandling(OVERRIDE_PREVIOUS), optimization(OPTIMIZE_NORMAL),
-        norm16TrieBytes(nullptr), norm16TrieLength(0) {
+        writeCompositionsHash(TRUE),
+        norm16TrieBytes(nullptr), norm16TrieLength(0),
+        compositionsHash(nullptr), compositionsHashLength(0) {
     memset(unicodeVersion, 0, sizeof(unicodeVersion));
     memset(indexes, 0, sizeof(indexes));
     memset(smallFCD, 0, sizeof(smallFCD));
@@ -103,6 +105,7 @@ Normalizer2DataBuilder::Normalizer2DataBuilder(UErrorCode &errorCode) :
 
 Normalizer2DataBuilder::~Normalizer2DataBuilder() {
     delete[] norm16TrieBytes;
+    delete[] compositionsHash;
 }
 
 void
@@ -554,6 +557,98 @@ void Normalizer2DataBuilder::setHangulData(UMutableCPTrie *norm16Trie) {
     errorCode.assertSuccess();
 }
 
+/**
+ * Builds the optional hash table of all (starter, trail) composition pairs.
+ * Requires the final extraData and indexes[IX_MIN_YES_NO] and [IX_MIN_MAYBE_YES].
+ */
+void Normalizer2DataBuilder::buildCompositionsHash() {
+    int32_t normsLength=norms.length();
+    int32_t numPairs=0;
+    if(writeCompositionsHash) {
+        for(int32_t i=1; i<normsLength; ++i) {
+            int32_t length;
+            norms.getNormRefByIndex(i).getCompositionPairs(length);
+            numPairs+=length;
+        }
+    }
+    if(numPairs==0) {
+        return;
+    }
+    // At most half of the slots are occupied.
+    int32_t bits=1;
+    while((1<<bits)<2*numPairs) {
+        ++bits;
+    }
+    if(bits>Normalizer2Impl::COMP_HASH_MAX_BITS) {
+        fprintf(stderr,
+                "gennorm2 error: "
+                "too many composition pairs (%ld) for the compositions hash table\n",
+                (long)numPairs);
+        exit(U_BUFFER_OVERFLOW_ERROR);
+    }
+    uint32_t mask=((uint32_t)1<<bits)-1;
+    compositionsHashLength=1+(2<<bits);
+    compositionsHash=new uint32_t[compositionsHashLength];
+    compositionsHash[0]=bits;
+    for(int32_t i=1; i<compositionsHashLength; i+=2) {
+        compositionsHash[i]=0;
+        compositionsHash[i+1]=0xffffffff;
+    }
+    // Compositions list offsets from the start of the maybeYesCompositions,
+    // which is also the start of our extraData.
+    int32_t maybeYesLength=
+        (Normalizer2Impl::MIN_NORMAL_MAYBE_YES-indexes[Normalizer2Impl::IX_MIN_MAYBE_YES])>>
+        Normalizer2Impl::OFFSET_SHIFT;
+    for(int32_t i=1; i<normsLength; ++i) {
+        const Norm &norm=norms.getNormRefByIndex(i);
+        int32_t length;
+        const CompositionPair *pairs=norm.getCompositionPairs(length);
+        if(length==0) {
+            continue;
+        }
+        int32_t listOffset;
+        switch(norm.type) {
+        case Norm::YES_YES_COMBINES_FWD:
+            listOffset=maybeYesLength+norm.offset;
+            break;
+        case Norm::YES_NO_COMBINES_FWD: {
+            // The compositions list follows the mapping.
+            int32_t mapping=maybeYesLength+
+                (indexes[Normalizer2Impl::IX_MIN_YES_NO]>>Normalizer2Impl::OFFSET_SHIFT)+
+                norm.offset;
+            listOffset=mapping+1+(extraData[mapping]&Normalizer2Impl::MAPPING_LENGTH_MASK);
+            break;
+        }
+        case Norm::MAYBE_YES_COMBINES_FWD:
+            listOffset=norm.offset;
+            break;
+        default:
+            fprintf(stderr,
+                    "gennorm2 error: "
+                    "unexpected Norm::Type %d with a compositions list\n", (int)norm.type);
+            exit(U_INTERNAL_PROGRAM_ERROR);
+        }
+        U_ASSERT(listOffset<=0xffff);
+        for(int32_t j=0; j<length; ++j) {
+            const CompositionPair &pair=pairs[j];
+            uint32_t compositeAndFwd=(uint32_t)pair.composite<<1;
+            if(norms.getNormRef(pair.composite).compositions!=nullptr) {
+                compositeAndFwd|=1;
+            }
+            uint32_t key=((uint32_t)listOffset<<16)|(uint32_t)(pair.trail&0xffff);
+            uint32_t value=
+                ((uint32_t)(pair.trail>>16)<<Normalizer2Impl::COMP_HASH_TRAIL_HIGH_SHIFT)|
+                compositeAndFwd;
+            uint32_t slot=Normalizer2Impl::compositionsHashSlot(key, 32-bits);
+            while(compositionsHash[2+2*slot]!=0xffffffff) {
+                slot=(slot+1)&mask;
+            }
+            compositionsHash[1+2*slot]=key;
+            compositionsHash[2+2*slot]=value;
+        }
+    }
+}
+
 LocalUCPTriePointer Normalizer2DataBuilder::processData() {
     // Build composition lists before recursive decomposition,
     // so that we still have the raw, pair-wise mappings.
@@ -608,6 +703,8 @@ LocalUCPTriePointer Normalizer2DataBuilder::processData() {
         extraData.append((UChar)0);
     }
 
+    buildCompositionsHash();
+
     int32_t minNoNoDelta=getMinNoNoDelta();
     U_ASSERT((minNoNoDelta&7)==0);
     if(indexes[Normalizer2Impl::IX_LIMIT_NO_NO]>minNoNoDelta) {
@@ -743,15 +840,21 @@ LocalUCPTriePointer Normalizer2DataBuilder::processData() {
     offset+=extraData.length()*2;
     indexes[Normalizer2Impl::IX_SMALL_FCD_OFFSET]=offset;
     offset+=sizeof(smallFCD);
+    indexes[Normalizer2Impl::IX_COMPOSITIONS_HASH_OFFSET]=offset;
+    offset+=compositionsHashLength*4;
     int32_t totalSize=offset;
-    for(int32_t i=Normalizer2Impl::IX_RESERVED3_OFFSET; i<=Normalizer2Impl::IX_TOTAL_SIZE; ++i) {
+    for(int32_t i=Normalizer2Impl::IX_RESERVED4_OFFSET; i<=Normalizer2Impl::IX_TOTAL_SIZE; ++i) {
         indexes[i]=totalSize;
     }
+    if(compositionsHashLength>0) {
+        dataInfo.formatVersion[1]=1;
+    }
 
     if(beVerbose) {
         printf("size of normalization trie:         %5ld bytes\n", (long)norm16TrieLength);
         printf("size of 16-bit extra data:          %5ld uint16_t\n", (long)extraData.length());
         printf("size of small-FCD data:             %5ld bytes\n", (long)sizeof(smallFCD));
+        printf("size of compositions hash:          %5ld uint32_t\n", (long)compositionsHashLength);
         printf("size of binary data file contents:  %5ld bytes\n", (long)totalSize);
         printf("minDecompNoCodePoint:              U+%04lX\n", (long)indexes[Normalizer2Impl::IX_MIN_DECOMP_NO_CP]);
         printf("minCompNoMaybeCodePoint:           U+%04lX\n", (long)indexes[Normalizer2Impl::IX_MIN_COMP_NO_MAYBE_CP]);
@@ -791,6 +894,7 @@ void Normalizer2DataBuilder::writeBinaryFile(const char *filename) {
     udata_writeBlock(pData, norm16TrieBytes, norm16TrieLength);
     udata_writeUString(pData, toUCharPtr(extraData.getBuffer()), extraData.length());
     udata_writeBlock(pData, smallFCD, sizeof(smallFCD));
+    udata_writeBlock(pData, compositionsHash, compositionsHashLength*4);
     int32_t writtenSize=udata_finish(pData, errorCode);
     if(errorCode.isFailure()) {
         fprintf(stderr, "gennorm2: error %s writing the output file\n", errorCode.errorName());
@@ -841,6 +945,13 @@ Normalizer2DataBuilder::writeCSourceFile(const char *filename) {
     usrc_writeArray(f, line, extraData.getBuffer(), 16, extraData.length(), "\n};\n\n");
     sprintf(line, "static const uint8_t %s_smallFCD[%%ld]={\n", name);
     usrc_writeArray(f, line, smallFCD, 8, sizeof(smallFCD), "\n};\n\n");
+    if(compositionsHashLength>0) {
+        sprintf(line, "static const uint32_t %s_compositionsHash[%%ld]={\n", name);
+        usrc_writeArray(f, line, compositionsHash, 32, compositionsHashLength, "\n};\n\n");
+    } else {
+        // Empty per the indexes; C does not allow zero-length arrays.
+        fprintf(f, "static const uint32_t %s_compositionsHash[1]={ 0 };\n\n", name);
+    }
 
     fputs("#endif  // INCLUDED_FROM_NORMALIZER2_CPP\n", f);
     fclose(f);